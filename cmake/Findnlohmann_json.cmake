@@ -8,8 +8,20 @@ find_path(NLOHMANN_JSON_INCLUDE_DIR
         "${CMAKE_CURRENT_SOURCE_DIR}/../external")
 mark_as_advanced(NLOHMANN_JSON_INCLUDE_DIR)
 
+if (NLOHMANN_JSON_INCLUDE_DIR)
+    file(STRINGS "${NLOHMANN_JSON_INCLUDE_DIR}/nlohmann/json.hpp" nlohmann_json_version_lines
+            REGEX "^#define NLOHMANN_JSON_VERSION_(MAJOR|MINOR|PATCH) [0-9]+")
+    foreach (part MAJOR MINOR PATCH)
+        string(REGEX REPLACE ".*#define NLOHMANN_JSON_VERSION_${part} ([0-9]+).*" "\\1"
+                nlohmann_json_VERSION_${part} "${nlohmann_json_version_lines}")
+    endforeach ()
+    set(nlohmann_json_VERSION
+            "${nlohmann_json_VERSION_MAJOR}.${nlohmann_json_VERSION_MINOR}.${nlohmann_json_VERSION_PATCH}")
+endif ()
+
 find_package_handle_standard_args(nlohmann_json
-        REQUIRED_VARS NLOHMANN_JSON_INCLUDE_DIR)
+        REQUIRED_VARS NLOHMANN_JSON_INCLUDE_DIR
+        VERSION_VAR nlohmann_json_VERSION)
 
 if (nlohmann_json_FOUND)
     set(NLOHMANN_JSON_INCLUDE_DIRS ${NLOHMANN_JSON_INCLUDE_DIR})
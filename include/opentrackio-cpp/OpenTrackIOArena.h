@@ -0,0 +1,143 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+namespace opentrackio
+{
+    /**
+    * Monotonic arena for JSON DOMs. Allocating is a pointer bump through blocks taken from the heap, freeing is a
+    * no-op and reset() rewinds to the first block, keeping every block for the next round. Once an arena has grown
+    * to fit the DOMs of a sample, or a batch of them, generating them again doesn't touch the heap.
+    * An arena is used by one thread at a time, giving each thread its own avoids contending on the heap. */
+    class JsonArena
+    {
+    public:
+        struct Stats
+        {
+            /** Allocations served by the arena. */
+            uint64_t allocations = 0;
+
+            /** Bytes handed out, including the header of each allocation. */
+            uint64_t bytesAllocated = 0;
+
+            /** Blocks taken from the heap, reset() keeps them so this stops growing once the arena fits. */
+            uint64_t blocks = 0;
+
+            /** Bytes held in blocks. */
+            std::size_t bytesReserved = 0;
+
+            /** The most bytes in use between two resets. */
+            std::size_t peakBytesUsed = 0;
+
+            uint64_t resets = 0;
+        };
+
+        explicit JsonArena(std::size_t blockSize = 16 * 1024);
+        ~JsonArena();
+
+        JsonArena(const JsonArena&) = delete;
+        JsonArena& operator=(const JsonArena&) = delete;
+
+        /**
+        * Returns bytes aligned for any type, taking a new block from the heap if the current one is full. */
+        void* allocate(std::size_t bytes);
+
+        /**
+        * Makes every allocation available again. Anything allocated from the arena must be destroyed first. */
+        void reset();
+
+        [[nodiscard]] const Stats& stats() const { return m_stats; };
+
+        /**
+        * Makes arena the one ArenaAllocator allocates from on this thread until the scope ends. */
+        class Scope
+        {
+        public:
+            explicit Scope(JsonArena& arena);
+            ~Scope();
+
+            Scope(const Scope&) = delete;
+            Scope& operator=(const Scope&) = delete;
+
+        private:
+            JsonArena* m_previous = nullptr;
+        };
+
+        /**
+        * The arena of the innermost Scope on this thread, or nullptr. */
+        static JsonArena* current();
+
+        /**
+        * Used by ArenaAllocator. Allocates from current() or, without one, from the heap, recording which in a
+        * header so that release() frees heap memory wherever it is called and leaves arena memory to reset(). */
+        static void* acquire(std::size_t bytes);
+        static void release(void* p) noexcept;
+
+    private:
+        struct Block
+        {
+            std::byte* data = nullptr;
+            std::size_t size = 0;
+        };
+
+        std::size_t m_blockSize;
+        std::vector<Block> m_blocks{};
+        std::size_t m_block = 0;
+        std::size_t m_offset = 0;
+        std::size_t m_used = 0;
+        Stats m_stats{};
+    };
+
+    /**
+    * Stateless allocator for nlohmann::basic_json, which default-constructs its allocators, that takes memory from
+    * the arena made current by JsonArena::Scope. */
+    template<typename T>
+    class ArenaAllocator
+    {
+    public:
+        using value_type = T;
+
+        ArenaAllocator() noexcept = default;
+
+        template<typename U>
+        ArenaAllocator(const ArenaAllocator<U>&) noexcept {}
+
+        T* allocate(std::size_t n)
+        {
+            static_assert(alignof(T) <= alignof(std::max_align_t), "ArenaAllocator doesn't support over-aligned types.");
+            return static_cast<T*>(JsonArena::acquire(n * sizeof(T)));
+        }
+
+        void deallocate(T* p, std::size_t) noexcept
+        {
+            JsonArena::release(p);
+        }
+
+        template<typename U>
+        bool operator==(const ArenaAllocator<U>&) const noexcept { return true; }
+    };
+
+    using ArenaString = std::basic_string<char, std::char_traits<char>, ArenaAllocator<char>>;
+
+    /**
+    * nlohmann::json with every node and string allocated by ArenaAllocator. */
+    using ArenaJson = nlohmann::basic_json<std::map, std::vector, ArenaString, bool, std::int64_t, std::uint64_t,
+                                           double, ArenaAllocator>;
+} // namespace opentrackio
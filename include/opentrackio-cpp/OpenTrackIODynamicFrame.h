@@ -0,0 +1,202 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <type_traits>
+#include "OpenTrackIOSample.h"
+
+namespace opentrackio
+{
+    /**
+    * The per-frame fields a DynamicFrame can hold. Combine them with |. */
+    enum class FrameFields : uint32_t
+    {
+        NONE = 0,
+        SAMPLE_ID = 1u << 0,
+        SOURCE_ID = 1u << 1,
+        SOURCE_NUMBER = 1u << 2,
+        SAMPLE_TIMESTAMP = 1u << 3,         // timing/sampleTimestamp
+        RECORDED_TIMESTAMP = 1u << 4,       // timing/recordedTimestamp
+        SEQUENCE_NUMBER = 1u << 5,          // timing/sequenceNumber
+        ENCODER_FOCUS = 1u << 6,            // lens/encoders
+        ENCODER_IRIS = 1u << 7,
+        ENCODER_ZOOM = 1u << 8,
+        RAW_ENCODER_FOCUS = 1u << 9,        // lens/rawEncoders
+        RAW_ENCODER_IRIS = 1u << 10,
+        RAW_ENCODER_ZOOM = 1u << 11,
+        PINHOLE_FOCAL_LENGTH = 1u << 12,    // lens/pinholeFocalLength
+        FOCUS_DISTANCE = 1u << 13,          // lens/focusDistance
+        F_STOP = 1u << 14,                  // lens/fStop
+        T_STOP = 1u << 15,                  // lens/tStop
+        ENTRANCE_PUPIL_OFFSET = 1u << 16,   // lens/entrancePupilOffset
+        DISTORTION_OFFSET = 1u << 17,       // lens/distortionOffset
+        PROJECTION_OFFSET = 1u << 18,       // lens/projectionOffset
+        DISTORTION = 1u << 19,              // lens/distortion
+        TRANSFORMS = 1u << 20,
+        ALL = (1u << 21) - 1
+    };
+
+    constexpr FrameFields operator|(FrameFields lhs, FrameFields rhs)
+    {
+        return static_cast<FrameFields>(static_cast<uint32_t>(lhs) | static_cast<uint32_t>(rhs));
+    }
+
+    constexpr FrameFields operator&(FrameFields lhs, FrameFields rhs)
+    {
+        return static_cast<FrameFields>(static_cast<uint32_t>(lhs) & static_cast<uint32_t>(rhs));
+    }
+
+    /**
+    * The fields of a sample that change with every frame, in a fixed layout without pointers so that frames can be
+    * memcpy'd, placed in shared memory or kept in fixed-size ring buffers. Which fields are set is recorded in
+    * present rather than with std::optional, the values of fields that aren't present are zero.
+    * Transforms, distortions and coefficients are held up to the MAX_ counts below and strings up to
+    * MAX_STRING_LENGTH characters. */
+    struct DynamicFrame
+    {
+        static constexpr std::size_t MAX_TRANSFORMS = 4;
+        static constexpr std::size_t MAX_DISTORTIONS = 2;
+        static constexpr std::size_t MAX_COEFFICIENTS = 8;
+        static constexpr std::size_t MAX_STRING_LENGTH = 31;
+
+        /**
+        * Null-terminated string of up to MAX_STRING_LENGTH characters. */
+        struct FixedString
+        {
+            std::array<char, MAX_STRING_LENGTH + 1> data{};
+            uint8_t length = 0;
+            bool present = false;
+
+            [[nodiscard]] std::string_view view() const { return {data.data(), length}; }
+
+            /**
+            * Returns false, leaving the string unset, if value is too long. */
+            bool assign(std::string_view value);
+        };
+
+        /**
+        * Up to MAX_COEFFICIENTS coefficients, the first count of which are set. */
+        struct Coefficients
+        {
+            std::array<double, MAX_COEFFICIENTS> values{};
+            uint8_t count = 0;
+
+            [[nodiscard]] std::span<const double> view() const { return {values.data(), count}; }
+        };
+
+        struct Distortion
+        {
+            Coefficients radial{};
+            Coefficients tangential{};
+            bool hasTangential = false;
+            bool hasOverscan = false;
+            double overscan = 0.0;
+            FixedString model{};
+        };
+
+        struct Transform
+        {
+            opentrackiotypes::Vector3 translation{};
+            opentrackiotypes::Rotation rotation{};
+            opentrackiotypes::Vector3 scale{};
+            bool hasScale = false;
+            FixedString id{};
+        };
+
+        struct Encoders
+        {
+            double focus = 0.0;
+            double iris = 0.0;
+            double zoom = 0.0;
+        };
+
+        struct RawEncoders
+        {
+            uint32_t focus = 0;
+            uint32_t iris = 0;
+            uint32_t zoom = 0;
+        };
+
+        FrameFields present = FrameFields::NONE;
+
+        opentrackiotypes::Uuid sampleId{};
+        opentrackiotypes::Uuid sourceId{};
+        uint32_t sourceNumber = 0;
+
+        opentrackiotypes::Timestamp sampleTimestamp{};
+        opentrackiotypes::Timestamp recordedTimestamp{};
+        uint32_t sequenceNumber = 0;
+
+        Encoders encoders{};
+        RawEncoders rawEncoders{};
+        double pinholeFocalLength = 0.0;
+        double focusDistance = 0.0;
+        double fStop = 0.0;
+        double tStop = 0.0;
+        double entrancePupilOffset = 0.0;
+        opentrackioproperties::Lens::DistortionOffset distortionOffset{};
+        opentrackioproperties::Lens::ProjectionOffset projectionOffset{};
+
+        std::array<Distortion, MAX_DISTORTIONS> distortions{};
+        uint8_t distortionCount = 0;
+
+        std::array<Transform, MAX_TRANSFORMS> transforms{};
+        uint8_t transformCount = 0;
+
+        [[nodiscard]] bool has(FrameFields fields) const { return (present & fields) == fields; }
+
+        [[nodiscard]] std::span<const Distortion> distortionView() const { return {distortions.data(), distortionCount}; }
+        [[nodiscard]] std::span<const Transform> transformView() const { return {transforms.data(), transformCount}; }
+
+        /**
+        * Replaces the frame with the per-frame fields of sample. Returns false, leaving the frame empty, if sample
+        * has more transforms, distortions or coefficients, or longer ids or models, than the frame holds. */
+        bool assign(const OpenTrackIOSample& sample);
+
+        /**
+        * Writes the frame into the per-frame fields of sample, unsetting those that aren't present, and marks them
+        * dirty for getJson(). The other properties of sample, static ones included, are left as they are. */
+        void applyTo(OpenTrackIOSample& sample) const;
+
+        void clear() { *this = DynamicFrame{}; }
+    };
+
+    static_assert(std::is_trivially_copyable_v<DynamicFrame>);
+    static_assert(std::is_standard_layout_v<DynamicFrame>);
+
+    /**
+    * Decodes samples from the wire straight into DynamicFrames. Only the properties with per-frame fields are
+    * parsed, into a sample kept between calls, so once it has warmed up decoding CBOR doesn't allocate. */
+    class DynamicFrameDecoder
+    {
+    public:
+        /**
+        * Returns false if the sample doesn't parse or doesn't fit in frame, see getParseErrors() for the former. */
+        bool decode(std::span<const uint8_t> cbor, DynamicFrame& frame);
+        bool decode(std::string_view json, DynamicFrame& frame);
+
+        [[nodiscard]] const ParseErrors& getParseErrors() const { return m_sample.getParseErrors(); };
+
+    private:
+        static constexpr SampleFields FIELDS = SampleFields::LENS | SampleFields::SAMPLE_ID | SampleFields::SOURCE_ID |
+                                               SampleFields::SOURCE_NUMBER | SampleFields::TIMING |
+                                               SampleFields::TRANSFORMS;
+
+        OpenTrackIOSample m_sample{};
+    };
+} // namespace opentrackio
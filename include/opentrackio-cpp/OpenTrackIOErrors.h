@@ -0,0 +1,126 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace opentrackio
+{
+    /**
+    * What went wrong while parsing a sample. Each code renders to one of the messages that getErrors() returns,
+    * the comment shows its template. */
+    enum class ErrorCode : uint8_t
+    {
+        NOT_OF_TYPE,                    // field: {field} isn't of type: {detail}
+        PATTERN_MISMATCH,               // field: {field} doesn't match the required pattern
+        ELEMENT_PATTERN_MISMATCH,       // field: {field}/element doesn't match required pattern
+        MISSING_FIELDS,                 // field: {field} is missing required fields
+        MISSING_FIELD,                  // field: {field} is missing require field: {detail}
+        MISSING_NAMED_FIELD,            // field: {field} is missing a require field: {detail}
+        REQUIRED_FIELD_MISSING,         // field: {field} is required, however it is missing.
+        REQUIRED_SUBFIELD_MISSING,      // field: {field} is required, however it is missing a subfield(s).
+        NOT_A_NUMBER,                   // field: {field} is not a number: {detail}
+        OUT_OF_RANGE,                   // field: {field} is outside the expected range {detail}.
+        INVALID_STRING,                 // field: {field} has an invalid string value.
+        INVALID_ENUMERATION,            // field: {field} isn't a valid enumeration
+        WRONG_SIZE,                     // field: {field} isn't of size {context}: {detail}
+        VERSION_MISMATCH,               // version: {field} version mismatch
+        NOT_AN_ARRAY,                   // {field} is not an array.
+        KEY_MISSING_RATIONAL_FIELDS,    // Key: {field} is missing numerator or denominator field.
+        KEY_RATIONAL_NOT_UNSIGNED,      // Key: {field} numerator or denominator field isn't of type: unsigned integer
+        KEY_MISSING_FIELDS,             // Key: {field} {detail} is missing required fields
+        KEY_FIELDS_NOT_DOUBLE,          // Key: {field} {detail} fields aren't of type: double
+        JSON_PARSE_ERROR,               // Unable to initialise OpenTrackIO sample, JSON parse error.
+        CBOR_PARSE_ERROR,               // Unable to initialise OpenTrackIO sample, CBOR parse error: {detail} at byte {context}
+        NO_PROPERTIES                   // Sample contains no properties after parsing JSON.
+    };
+
+    /**
+    * A parse error as recorded on the hot path, only formatted into text by message().
+    * field and detail view strings with static storage duration (schema keys, type names and the like) so that
+    * recording an error never copies or allocates. context holds a number the message needs, e.g. a byte offset. */
+    struct ParseError
+    {
+        ErrorCode code = ErrorCode::NOT_OF_TYPE;
+        std::string_view field{};
+        std::string_view detail{};
+        uint64_t context = 0;
+
+        [[nodiscard]] std::string message() const;
+
+        bool operator==(const ParseError& other) const = default;
+    };
+
+    /**
+    * Fixed-capacity list of the ParseErrors of one parse. Errors past the capacity aren't stored but are still
+    * counted, so a sample is never mistaken for valid however many errors it has. */
+    class ParseErrors
+    {
+    public:
+        static constexpr std::size_t CAPACITY = 64;
+
+        void add(ErrorCode code, std::string_view field = {}, std::string_view detail = {}, uint64_t context = 0)
+        {
+            if (m_size < CAPACITY)
+            {
+                m_errors[m_size++] = ParseError{code, field, detail, context};
+            }
+            else
+            {
+                ++m_dropped;
+            }
+        }
+
+        void append(const ParseErrors& other)
+        {
+            for (const ParseError& error : other.errors())
+            {
+                add(error.code, error.field, error.detail, error.context);
+            }
+            m_dropped += other.m_dropped;
+        }
+
+        [[nodiscard]] std::span<const ParseError> errors() const
+        {
+            return {m_errors.data(), m_size};
+        }
+
+        [[nodiscard]] std::size_t size() const { return m_size + m_dropped; }
+        [[nodiscard]] bool empty() const { return size() == 0; }
+
+        /**
+        * Number of errors that didn't fit in the list. */
+        [[nodiscard]] std::size_t dropped() const { return m_dropped; }
+
+        void clear()
+        {
+            m_size = 0;
+            m_dropped = 0;
+        }
+
+        /**
+        * Appends the message of each error to out, followed by a note of how many were dropped if any were. */
+        void render(std::vector<std::string>& out) const;
+
+    private:
+        std::array<ParseError, CAPACITY> m_errors{};
+        std::size_t m_size = 0;
+        std::size_t m_dropped = 0;
+    };
+} // namespace opentrackio
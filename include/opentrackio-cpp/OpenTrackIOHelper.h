@@ -12,12 +12,45 @@
  */
 
 #pragma once
-#include <format>
-#include <regex>
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
+#ifdef OPENTRACKIO_PMR
+#include <memory_resource>
+#endif
 #include <nlohmann/json.hpp>
+#include "OpenTrackIOErrors.h"
 
 namespace opentrackio
 {
+    namespace opentrackiotypes
+    {
+        /**
+        * The string and vector types of the properties. Building with OPENTRACKIO_PMR makes them the std::pmr ones,
+        * so that a sample constructed with a std::pmr::memory_resource keeps the storage of its properties there. */
+#ifdef OPENTRACKIO_PMR
+        using String = std::pmr::string;
+
+        template<typename T>
+        using Vector = std::pmr::vector<T>;
+
+        template<typename T>
+        using PropertyAllocator = std::pmr::polymorphic_allocator<T>;
+#else
+        using String = std::string;
+
+        template<typename T>
+        using Vector = std::vector<T>;
+
+        template<typename T>
+        using PropertyAllocator = std::allocator<T>;
+#endif
+
+        template<typename T>
+        class CopyOnWrite;
+    } // namespace opentrackiotypes
+
     template<typename T>
     concept Encoder =
     requires(T t)
@@ -33,14 +66,75 @@ namespace opentrackio
         { t.zoom } -> std::convertible_to<std::optional<uint16_t>>;
     };
     
+    /**
+    * Records which nodes of a read-only JSON document were consumed while parsing, so that anything left over
+    * can be reported afterwards without having to copy the document and erase fields from the copy.
+    * Nodes are tracked by address, so the document must outlive (and not be modified during) the parse. */
+    class VisitedFields
+    {
+    public:
+        void markConsumed(const nlohmann::json& node)
+        {
+            m_consumed.push_back(&node);
+        }
+
+        [[nodiscard]] bool isConsumed(const nlohmann::json& node) const
+        {
+            // A sample only has a few dozen fields, a linear scan beats hashing here.
+            return std::find(m_consumed.begin(), m_consumed.end(), &node) != m_consumed.end();
+        }
+
+        /**
+        * Marks an object as consumed if all of its fields have been consumed (or it never had any). */
+        void markConsumedIfEmpty(const nlohmann::json& node)
+        {
+            if (!node.is_object())
+            {
+                return;
+            }
+
+            for (const auto& child : node)
+            {
+                if (!isConsumed(child))
+                {
+                    return;
+                }
+            }
+            markConsumed(node);
+        }
+
+        void clear()
+        {
+            m_consumed.clear();
+        }
+
+        /**
+        * Set while parsing a document the sample owns, see OpenTrackIOSample::initialise(nlohmann::json&&). Strings
+        * and arrays are then moved out of the nodes they're consumed from rather than copied. The nodes themselves
+        * stay where they are, so leftover fields are still found by address. */
+        void setDocumentOwned(bool owned)
+        {
+            m_documentOwned = owned;
+        }
+
+        [[nodiscard]] bool isDocumentOwned() const
+        {
+            return m_documentOwned;
+        }
+
+    private:
+        std::vector<const nlohmann::json*> m_consumed{};
+        bool m_documentOwned = false;
+    };
+
     class OpenTrackIOHelpers
     {
     public:
-        static void clearFieldIfEmpty(nlohmann::json &json, std::string_view fieldStr)
+        static void clearFieldIfEmpty(const nlohmann::json &json, std::string_view fieldStr, VisitedFields &visited)
         {
-            if (json[fieldStr].is_object() && std::distance(json[fieldStr].items().begin(), json[fieldStr].items().end()) == 0)
+            if (const auto it = json.find(fieldStr); it != json.end())
             {
-                json.erase(fieldStr);
+                visited.markConsumedIfEmpty(*it);
             }
         }
         
@@ -56,57 +150,143 @@ namespace opentrackio
                 field = jsonVal.get<T>();
         }
 
+        /**
+        * As above but moving a string out of jsonVal rather than copying it. Only the std::string of nlohmann::json
+        * can be moved, with OPENTRACKIO_PMR strings are still copied into the std::pmr::string. */
         template<typename T>
-        static void iterateJsonArrayAndPopulateVector(const nlohmann::json &jsonVal, std::vector<T> &vec)
+        static void getFieldFromJson(nlohmann::json &&jsonVal, T &outField) noexcept
         {
-            for (const auto &item: jsonVal.items())
+            if constexpr (std::is_same_v<T, nlohmann::json::string_t>)
             {
-                T val;
-                getFieldFromJson(item.value(), val);
-                vec.emplace_back(val);
+                if (jsonVal.is_string())
+                {
+                    outField = std::move(jsonVal.get_ref<nlohmann::json::string_t&>());
+                    return;
+                }
             }
+            outField = jsonVal.get<T>();
+        }
+
+        template<typename T>
+        static void getFieldFromJson(nlohmann::json &&jsonVal, std::optional<T> &field) noexcept
+        {
+            T value{};
+            getFieldFromJson(std::move(jsonVal), value);
+            field = std::move(value);
         }
 
+        /**
+        * Moves out of jsonVal if the document being parsed is owned, see VisitedFields::isDocumentOwned(). The
+        * parse only holds const references to the document, but an owned document isn't const itself. */
         template<typename T>
-        static void iterateJsonArrayAndPopulateVector(const nlohmann::json &jsonVal, std::optional<std::vector<T>> &vec)
+        static void getFieldFromJson(const nlohmann::json &jsonVal, T &outField, const VisitedFields &visited) noexcept
         {
-            std::vector<T> out;
-            for (const auto &item: jsonVal.items())
+            if (visited.isDocumentOwned())
+            {
+                getFieldFromJson(std::move(const_cast<nlohmann::json&>(jsonVal)), outField);
+            }
+            else
             {
-                T val;
-                getFieldFromJson(item.value(), val);
-                out.emplace_back(val);
+                getFieldFromJson(jsonVal, outField);
             }
+        }
 
+        template<typename Container>
+        static void iterateJsonArrayAndPopulateVector(const nlohmann::json &jsonVal, Container &vec)
+        {
+            for (const auto &item: jsonVal)
+            {
+                typename Container::value_type val;
+                getFieldFromJson(item, val);
+                vec.emplace_back(std::move(val));
+            }
+        }
+
+        template<typename Container>
+        static void iterateJsonArrayAndPopulateVector(nlohmann::json &&jsonVal, Container &vec)
+        {
+            for (auto &item: jsonVal)
+            {
+                typename Container::value_type val;
+                getFieldFromJson(std::move(item), val);
+                vec.emplace_back(std::move(val));
+            }
+        }
+
+        template<typename Container>
+        static void iterateJsonArrayAndPopulateVector(const nlohmann::json &jsonVal, std::optional<Container> &vec)
+        {
+            Container out;
+            iterateJsonArrayAndPopulateVector(jsonVal, out);
+            vec = std::move(out);
+        }
+
+        template<typename Container>
+        static void iterateJsonArrayAndPopulateVector(nlohmann::json &&jsonVal, std::optional<Container> &vec)
+        {
+            Container out;
+            iterateJsonArrayAndPopulateVector(std::move(jsonVal), out);
             vec = std::move(out);
         }
 
+        template<typename Container>
+        static void iterateJsonArrayAndPopulateVector(const nlohmann::json &jsonVal, opentrackiotypes::CopyOnWrite<Container> &vec)
+        {
+            Container out;
+            iterateJsonArrayAndPopulateVector(jsonVal, out);
+            vec = std::move(out);
+        }
+
+        template<typename Container>
+        static void iterateJsonArrayAndPopulateVector(nlohmann::json &&jsonVal, opentrackiotypes::CopyOnWrite<Container> &vec)
+        {
+            Container out;
+            iterateJsonArrayAndPopulateVector(std::move(jsonVal), out);
+            vec = std::move(out);
+        }
+
+        /**
+        * Moves out of jsonVal if the document being parsed is owned, as getFieldFromJson() above. */
+        template<typename Output>
+        static void iterateJsonArrayAndPopulateVector(const nlohmann::json &jsonVal, Output &vec, const VisitedFields &visited)
+        {
+            if (visited.isDocumentOwned())
+            {
+                iterateJsonArrayAndPopulateVector(std::move(const_cast<nlohmann::json&>(jsonVal)), vec);
+            }
+            else
+            {
+                iterateJsonArrayAndPopulateVector(jsonVal, vec);
+            }
+        }
+
         template<typename T>
-        static void assignField(nlohmann::json &json, std::string_view fieldStr, std::optional<T> &field,
-                         std::string_view typeStr, std::vector<std::string> &errors)
+        static void assignField(const nlohmann::json &json, std::string_view fieldStr, std::optional<T> &field,
+                         std::string_view typeStr, ParseErrors &errors, VisitedFields &visited)
         {
-            if (json.contains(fieldStr))
+            if (const auto it = json.find(fieldStr); it != json.end())
             {
-                getFieldFromJson(json[fieldStr], field);
-                json.erase(fieldStr);
+                getFieldFromJson(*it, field, visited);
+                visited.markConsumed(*it);
             }
         }
         
         template<Encoder T>
-        static void assignField(nlohmann::json &json, std::string_view fieldStr, std::optional<T> &field,
-                         std::string_view typeStr, std::vector<std::string> &errors)
+        static void assignField(const nlohmann::json &json, std::string_view fieldStr, std::optional<T> &field,
+                         std::string_view typeStr, ParseErrors &errors, VisitedFields &visited)
         {
-            if (!json.contains(fieldStr))
+            const auto it = json.find(fieldStr);
+            if (it == json.end())
             {
                 field = std::nullopt;
                 return;
             }
 
             field = T{};
-            auto &encoderJson = json[fieldStr];
-            assignField(encoderJson, "focus", field->focus, typeStr, errors);
-            assignField(encoderJson, "iris", field->iris, typeStr, errors);
-            assignField(encoderJson, "zoom", field->zoom, typeStr, errors);
+            const auto &encoderJson = *it;
+            assignField(encoderJson, "focus", field->focus, typeStr, errors, visited);
+            assignField(encoderJson, "iris", field->iris, typeStr, errors, visited);
+            assignField(encoderJson, "zoom", field->zoom, typeStr, errors, visited);
 
             if (!(field->focus.has_value() && field->iris.has_value() && field->zoom.has_value()))
             {
@@ -114,49 +294,51 @@ namespace opentrackio
                 return;
             }
 
-            json.erase(fieldStr);
+            visited.markConsumed(encoderJson);
+        }
+
+        /**
+        * Arrays held copy-on-write, i.e. calibrationHistory, are unset unless the field is an array. */
+        template<typename Container>
+        static void assignField(const nlohmann::json &json, std::string_view fieldStr, opentrackiotypes::CopyOnWrite<Container> &field,
+                         std::string_view typeStr, ParseErrors &errors, VisitedFields &visited)
+        {
+            const auto it = json.find(fieldStr);
+            if (it == json.end() || !it->is_array())
+            {
+                field = std::nullopt;
+                return;
+            }
+
+            Container vec{};
+            iterateJsonArrayAndPopulateVector(*it, vec, visited);
+
+            field = std::move(vec);
+            visited.markConsumed(*it);
         }
 
-        static void assignRegexField(nlohmann::json &json, std::string_view fieldStr, std::optional<std::string> &field,
-                              const std::regex &pattern, std::vector<std::string> &errors)
+        static void assignPatternField(const nlohmann::json &json, std::string_view fieldStr, std::optional<opentrackiotypes::String> &field,
+                              bool (*matchesPattern)(std::string_view), ParseErrors &errors, VisitedFields &visited)
         {
-            if (json.contains(fieldStr))
+            if (const auto it = json.find(fieldStr); it != json.end())
             {
-                if (!json[fieldStr].is_string())
+                if (!it->is_string())
                 {
-                    errors.emplace_back(std::format("field: {} isn't of type: string", fieldStr));
+                    errors.add(ErrorCode::NOT_OF_TYPE, fieldStr, "string");
                     field = std::nullopt;
                     return;
                 }
 
-                getFieldFromJson(json[fieldStr], field);
+                getFieldFromJson(*it, field, visited);
 
-                if (std::smatch res; !std::regex_match(field.value(), res, pattern))
+                if (!matchesPattern(field.value()))
                 {
-                    errors.emplace_back(std::format("field: {} doesn't match the required pattern", fieldStr));
+                    errors.add(ErrorCode::PATTERN_MISMATCH, fieldStr);
                     field = std::nullopt;
                     return;
                 }
-                json.erase(fieldStr);
+                visited.markConsumed(*it);
             }
         }  
     };
-
-    template<>
-    inline void OpenTrackIOHelpers::assignField<std::vector<std::string>>(nlohmann::json &json, std::string_view fieldStr,
-                                                 std::optional<std::vector<std::string>> &field,
-                                                 std::string_view typeStr, std::vector<std::string> &errors)
-    {
-        if (!json.contains(fieldStr) || !json[fieldStr].is_array())
-        {
-            field = std::nullopt;
-            return;
-        }
-
-        std::vector<std::string> vec{};
-        iterateJsonArrayAndPopulateVector(json[fieldStr], vec);
-
-        field = std::move(vec);
-        json.erase(fieldStr);
-    }
 } // namespace opentrackio
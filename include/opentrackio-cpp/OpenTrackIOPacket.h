@@ -0,0 +1,177 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string_view>
+#include "OpenTrackIOSample.h"
+
+namespace opentrackio
+{
+    /**
+    * Encoding of the payload of a packet, as carried in its header. */
+    enum class PayloadEncoding : uint8_t
+    {
+        JSON = 0x01,
+        CBOR = 0x02
+    };
+
+    /**
+    * Why decodePacket() rejected a datagram. */
+    enum class PacketError : uint8_t
+    {
+        NONE,
+        TOO_SHORT,              // Shorter than a header.
+        BAD_IDENTIFIER,         // Doesn't start with "OTrk".
+        UNKNOWN_ENCODING,       // Encoding is neither JSON nor CBOR.
+        LENGTH_MISMATCH,        // Payload length doesn't match the bytes that follow the header.
+        BAD_CHECKSUM            // Checksum doesn't match the header and payload.
+    };
+
+    [[nodiscard]] std::string_view toString(PacketError error);
+
+    /**
+    * Each source sends to its own multicast group, 235.135.1.<source number>, on the same UDP port. */
+    constexpr uint16_t DEFAULT_TRANSPORT_PORT = 55555;
+
+    /**
+    * The multicast group of sourceNumber as an IPv4 address in host byte order. */
+    constexpr uint32_t multicastGroup(uint8_t sourceNumber)
+    {
+        return (235u << 24) | (135u << 16) | (1u << 8) | sourceNumber;
+    }
+
+    /**
+    * The system calls OpenTrackIOReceiver and OpenTrackIOSender move datagrams with. */
+    enum class TransportBackend : uint8_t
+    {
+        SOCKETS,    // recvmmsg() and sendmmsg().
+        IO_URING    // io_uring, falling back to SOCKETS if the kernel doesn't support or allow it.
+    };
+
+    /**
+    * The OpenTrackIO transport header that precedes the payload of each datagram, 16 bytes in network byte order:
+    *   identifier "OTrk" (32 bits), reserved (8), encoding (8), sequence number (16), segment offset (32),
+    *   last segment flag (1) and payload length (15), Fletcher-16 checksum (16).
+    * The checksum covers the 14 bytes before it and the payload. A payload too large for one datagram is split
+    * into segments, each with its byte offset into the payload, and only the last has lastSegment set. */
+    struct PacketHeader
+    {
+        static constexpr std::size_t SIZE = 16;
+        static constexpr std::array<uint8_t, 4> IDENTIFIER = {'O', 'T', 'r', 'k'};
+        static constexpr std::size_t MAX_PAYLOAD_LENGTH = 0x7FFF;
+
+        PayloadEncoding encoding = PayloadEncoding::JSON;
+        uint16_t sequenceNumber = 0;
+        uint32_t segmentOffset = 0;
+        bool lastSegment = true;
+        uint16_t payloadLength = 0;
+        uint16_t checksum = 0;
+
+        /**
+        * Whether the packet carries a whole payload rather than one segment of it. */
+        [[nodiscard]] bool isComplete() const { return segmentOffset == 0 && lastSegment; }
+
+        bool operator==(const PacketHeader& other) const = default;
+    };
+
+    /**
+    * A datagram decoded by decodePacket(), payload views the datagram. */
+    struct Packet
+    {
+        PacketHeader header{};
+        std::span<const uint8_t> payload{};
+    };
+
+    /**
+    * Running Fletcher-16 checksum, modulo 255. Blocks are summed with SSE2 where available, deferring the modulo
+    * to once every 2 KiB, so checksumming a datagram costs a fraction of a byte-at-a-time loop. */
+    class Fletcher16
+    {
+    public:
+        void update(std::span<const uint8_t> data);
+
+        /**
+        * The checksum of everything passed to update() so far, the second sum in the high byte. */
+        [[nodiscard]] uint16_t value() const { return static_cast<uint16_t>((m_sum2 << 8) | m_sum1); }
+
+        [[nodiscard]] static uint16_t compute(std::span<const uint8_t> data);
+
+    private:
+        uint32_t m_sum1 = 0;
+        uint32_t m_sum2 = 0;
+    };
+
+    /**
+    * Byte-at-a-time Fletcher-16, the reference the vectorised checksum is tested against. */
+    [[nodiscard]] uint16_t fletcher16Scalar(std::span<const uint8_t> data);
+
+    /**
+    * Writes header, with its payloadLength and checksum filled in from payload, followed by payload into datagram.
+    * Returns the size of the datagram or std::nullopt if payload is over MAX_PAYLOAD_LENGTH or datagram is too
+    * small. */
+    std::optional<std::size_t> encodePacket(const PacketHeader& header, std::span<const uint8_t> payload,
+                                            std::span<uint8_t> datagram);
+
+    /**
+    * Validates the header of datagram and its checksum. On success packet holds the header and a view of the
+    * payload, otherwise packet is left as it was. Neither copies nor allocates. */
+    PacketError decodePacket(std::span<const uint8_t> datagram, Packet& packet);
+
+    /**
+    * Splits a payload into datagrams of at most maxDatagramSize bytes, written one at a time into buffers the
+    * caller provides, e.g. the slots of a send queue. payload must outlive the segmenter. */
+    class PacketSegmenter
+    {
+    public:
+        /** A 1500 byte Ethernet MTU less the IPv4 and UDP headers. */
+        static constexpr std::size_t DEFAULT_MAX_DATAGRAM_SIZE = 1472;
+
+        PacketSegmenter(PayloadEncoding encoding, uint16_t sequenceNumber, std::span<const uint8_t> payload,
+                        std::size_t maxDatagramSize = DEFAULT_MAX_DATAGRAM_SIZE);
+
+        /**
+        * Writes the next segment into datagram and returns its size, or std::nullopt if there are no segments left
+        * or datagram is too small for the next one. */
+        std::optional<std::size_t> next(std::span<uint8_t> datagram);
+
+        [[nodiscard]] bool done() const { return !m_pending; }
+
+        /**
+        * Number of datagrams the payload takes, one for an empty payload. */
+        [[nodiscard]] std::size_t segmentCount() const;
+
+    private:
+        PayloadEncoding m_encoding;
+        uint16_t m_sequenceNumber;
+        std::span<const uint8_t> m_payload;
+        std::size_t m_maxSegmentLength;
+        std::size_t m_offset = 0;
+
+        // Set until the last segment is written, an empty payload still takes one.
+        bool m_pending = true;
+    };
+
+    /**
+    * Parses payload into sample with the initialise() overload for encoding, the text one for JSON. */
+    bool initialiseFromPayload(OpenTrackIOSample& sample, PayloadEncoding encoding, std::span<const uint8_t> payload);
+
+    /**
+    * Parses the payload of a whole, unsegmented, packet into sample. Returns false without touching sample if the
+    * packet is a segment, those have to be reassembled first. */
+    bool initialiseFromPacket(OpenTrackIOSample& sample, const Packet& packet);
+} // namespace opentrackio
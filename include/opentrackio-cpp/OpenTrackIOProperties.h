@@ -31,7 +31,7 @@ namespace opentrackio::opentrackioproperties
     {
         opentrackiotypes::Rational rational{};
 
-        static std::optional<Duration> parse(nlohmann::json& json, std::vector<std::string>& errors);
+        static std::optional<Duration> parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited);
     };
 
     struct Camera
@@ -54,23 +54,23 @@ namespace opentrackio::opentrackioproperties
 
         /**
         * Non-blank string identifying camera firmware version. */
-        std::optional<std::string> firmwareVersion = std::nullopt;
+        std::optional<opentrackiotypes::InternedString> firmwareVersion = std::nullopt;
 
         /**
         * Non-blank string containing user-determined camera identifier. */
-        std::optional<std::string> label = std::nullopt;
+        std::optional<opentrackiotypes::InternedString> label = std::nullopt;
 
         /**
         * Non-blank string naming camera manufacturer. */
-        std::optional<std::string> make = std::nullopt;
+        std::optional<opentrackiotypes::InternedString> make = std::nullopt;
 
         /**
         * Non-blank string identifying camera model. */
-        std::optional<std::string> model = std::nullopt;
+        std::optional<opentrackiotypes::InternedString> model = std::nullopt;
 
         /**
         * Non-blank string uniquely identifying the camera.*/
-        std::optional<std::string> serialNumber = std::nullopt;
+        std::optional<opentrackiotypes::InternedString> serialNumber = std::nullopt;
 
         /**
         * Capture frame rate of the camera
@@ -80,7 +80,7 @@ namespace opentrackio::opentrackioproperties
         /**
         * URN identifying the ASC Framing Decision List used by the camera.
         * Pattern: ^urn:uuid:[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}$ */
-        std::optional<std::string> fdlLink = std::nullopt;
+        std::optional<opentrackiotypes::String> fdlLink = std::nullopt;
 
         /**
         * Arithmetic ISO scale as defined in ISO 12232 */
@@ -92,9 +92,14 @@ namespace opentrackio::opentrackioproperties
         * Units: Degree */
         std::optional<double> shutterAngle = std::nullopt;
 
-        static std::optional<Camera> parse(nlohmann::json& json, std::vector<std::string>& errors);
+        static std::optional<Camera> parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited);
     };
 
+    /**
+    * Every field of a camera is static, so samples hold it copy-on-write: copies of a sample, and the samples of a
+    * source whose static object hasn't changed, share one Camera until one of them is written to. */
+    using SharedCamera = opentrackiotypes::CopyOnWrite<Camera>;
+
     /**
     * Position of the stage origin in global ENU and geodetic coordinates
     * (E, N, U, lat0, lon0, h0). Note this may be dynamic e.g. if the stage is inside
@@ -109,16 +114,21 @@ namespace opentrackio::opentrackioproperties
         double lon0;
         double h0;
 
-        static std::optional<GlobalStage> parse(nlohmann::json& json, std::vector<std::string>& errors);
+        static std::optional<GlobalStage> parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited);
     };
 
     struct Lens
     {
+        /**
+        * Coefficient lists are stored inline up to the six radial coefficients of the Brown-Conrady model, the most
+        * any common model sends, and only allocate beyond that. */
+        using Coefficients = opentrackiotypes::SmallVector<double, 6>;
+
         /**
         * This list provides optional custom additional coefficients for a
         * particular lens model. The meaning of which would require negotiation
         * between a particular producer and consumer. */
-        std::optional<std::vector<double>> custom = std::nullopt;
+        std::optional<Coefficients> custom = std::nullopt;
 
         /**
         * Coefficients for calculating the distortion characteristics of a lens
@@ -126,12 +136,12 @@ namespace opentrackio::opentrackioproperties
         * and the tangential distortion (p1-N). */
         struct Distortion
         {
-            std::vector<double> radial{};
-            std::optional<std::vector<double>> tangential = std::nullopt;
-            std::optional<std::string> model = std::nullopt;
+            Coefficients radial{};
+            std::optional<Coefficients> tangential = std::nullopt;
+            std::optional<opentrackiotypes::String> model = std::nullopt;
             std::optional<double> overscan = std::nullopt;
         };
-        std::optional<std::vector<Distortion>> distortion = std::nullopt;
+        std::optional<opentrackiotypes::Vector<Distortion>> distortion = std::nullopt;
 
         /**
         * Static maximum overscan factor on lens distortion. This is an alternative to providing dynamic
@@ -200,7 +210,7 @@ namespace opentrackio::opentrackioproperties
      
         /**
         * Non-blank string identifying lens firmware version. */
-        std::optional<std::string> firmwareVersion = std::nullopt;
+        std::optional<opentrackiotypes::InternedString> firmwareVersion = std::nullopt;
 
         /**
         * Focus distance/position of the lens.
@@ -209,11 +219,11 @@ namespace opentrackio::opentrackioproperties
 
         /**
         * Non-blank string naming lens manufacturer. */
-        std::optional<std::string> make = std::nullopt;
+        std::optional<opentrackiotypes::InternedString> make = std::nullopt;
 
         /**
         * Non-blank string identifying lens model. */
-        std::optional<std::string> model = std::nullopt;
+        std::optional<opentrackiotypes::InternedString> model = std::nullopt;
 
         /**
         * Nominal focal length of the lens.
@@ -222,8 +232,9 @@ namespace opentrackio::opentrackioproperties
         * Units: Millimeters */
         std::optional<double> nominalFocalLength = std::nullopt;
 
-        /** List of free strings that describe the history of calibrations of the lens */
-        std::optional<std::vector<std::string>> calibrationHistory = std::nullopt;
+        /** List of free strings that describe the history of calibrations of the lens.
+        * Held copy-on-write as it's static, see SharedCamera. */
+        opentrackiotypes::CopyOnWrite<opentrackiotypes::Vector<opentrackiotypes::String>> calibrationHistory = std::nullopt;
 
         /**
         * Offset in X and Y of the centre of perspective projection of the virtual camera
@@ -248,27 +259,27 @@ namespace opentrackio::opentrackioproperties
 
         /**
         * Non-blank string uniquely identifying the lens.*/
-        std::optional<std::string> serialNumber = std::nullopt;        
+        std::optional<opentrackiotypes::InternedString> serialNumber = std::nullopt;        
         
         /**
         * The linear t-number of the lens, equal to the F-number of the lens divided by the square root of the
         * transmittance of the lens. */
         std::optional<double> tStop = std::nullopt;
 
-        static std::optional<Lens> parse(nlohmann::json& json, std::vector<std::string>& errors);
+        static std::optional<Lens> parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited);
     };
     
     struct Protocol
     {
         /**
         * Name of the protocol in which the sample is being employed, and version of that protocol. */
-        std::string name;
+        opentrackiotypes::String name;
 
         /**
         * Version as integers e.g. 1.0.0 */
-        std::vector<uint16_t> version;
+        opentrackiotypes::Vector<uint16_t> version;
 
-        static std::optional<Protocol> parse(nlohmann::json& json, std::vector<std::string>& errors);
+        static std::optional<Protocol> parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited);
     };
 
     struct RelatedSampleIds
@@ -277,9 +288,22 @@ namespace opentrackio::opentrackioproperties
         * List of sampleId properties of samples related to this sample.
         * The existence of a sample with a given sampleId is not guaranteed
         * Pattern: ^urn:uuid:[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}$ */
-        std::vector<std::string> samples;
+        opentrackiotypes::Vector<opentrackiotypes::Uuid> samples;
 
-        static std::optional<RelatedSampleIds> parse(nlohmann::json& json, std::vector<std::string>& errors);
+        /**
+        * The samples in their URN form. */
+        [[nodiscard]] std::vector<std::string> urns() const
+        {
+            std::vector<std::string> out{};
+            out.reserve(samples.size());
+            for (const auto& sample : samples)
+            {
+                out.push_back(sample.toUrn());
+            }
+            return out;
+        }
+
+        static std::optional<RelatedSampleIds> parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited);
     };
 
     struct SampleId
@@ -287,9 +311,11 @@ namespace opentrackio::opentrackioproperties
         /**
         * URN serving as unique identifier of the sample in which data is being transported.
         * Pattern: ^urn:uuid:[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}$ */
-        std::string id;
+        opentrackiotypes::Uuid id{};
+
+        [[nodiscard]] std::string urn() const { return id.toUrn(); }
 
-        static std::optional<SampleId> parse(nlohmann::json& json, std::vector<std::string>& errors);
+        static std::optional<SampleId> parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited);
     };
     
     struct SourceId
@@ -297,9 +323,11 @@ namespace opentrackio::opentrackioproperties
         /**
         * URN serving as unique identifier of the source from which data is being transported
         * pattern: ^urn:uuid:[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}$ */
-        std::string id;
+        opentrackiotypes::Uuid id{};
 
-        static std::optional<SourceId> parse(nlohmann::json& json, std::vector<std::string>& errors);
+        [[nodiscard]] std::string urn() const { return id.toUrn(); }
+
+        static std::optional<SourceId> parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited);
     };
 
     struct SourceNumber
@@ -309,7 +337,7 @@ namespace opentrackio::opentrackioproperties
 	    * This is most important in the case where a source is producing multiple streams of samples. */
         uint32_t value;
 
-        static std::optional<SourceNumber> parse(nlohmann::json& json, std::vector<std::string>& errors);
+        static std::optional<SourceNumber> parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited);
     };
 
     struct Timing
@@ -402,7 +430,7 @@ namespace opentrackio::opentrackioproperties
 
                 /**
                 * The unique identifier (usually MAC address) of the current PTP leader (grandmaster). */
-                std::string leaderIdentity;
+                opentrackiotypes::String leaderIdentity;
 
                 /**
                 * The priority values of the leader used in the Best Master Clock Algorithm (BMCA).
@@ -472,30 +500,30 @@ namespace opentrackio::opentrackioproperties
         * field allows for finer division of the frame, e.g. interlaced frames have two sub-frames, one per field. */
         std::optional<opentrackiotypes::Timecode> timecode = std::nullopt;
 
-        static std::optional<Timing> parse(nlohmann::json& json, std::vector<std::string>& errors);
+        static std::optional<Timing> parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited);
         
     private:
-        static std::optional<Synchronization> parseSynchronization(nlohmann::json& json, std::vector<std::string>& errors);
-        static std::optional<Synchronization::Ptp> parsePtp(nlohmann::json& json, std::vector<std::string>& errors);
+        static std::optional<Synchronization> parseSynchronization(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited);
+        static std::optional<Synchronization::Ptp> parsePtp(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited);
     };
 
     struct Tracker
     {
         /**
          * 	Non-blank string identifying tracking device firmware version. */
-        std::optional<std::string> firmwareVersion = std::nullopt;
+        std::optional<opentrackiotypes::InternedString> firmwareVersion = std::nullopt;
 
         /**
         * Non-blank string naming tracking device manufacturer. */
-        std::optional<std::string> make = std::nullopt;
+        std::optional<opentrackiotypes::InternedString> make = std::nullopt;
 
         /**
         * Non-blank string identifying tracking device model. */
-        std::optional<std::string> model = std::nullopt;
+        std::optional<opentrackiotypes::InternedString> model = std::nullopt;
 
         /**
         * Non-blank string containing notes about tracking system. */
-        std::optional<std::string> notes = std::nullopt;
+        std::optional<opentrackiotypes::String> notes = std::nullopt;
 
         /**
         * Boolean indicating whether tracking system is recording data. */
@@ -503,17 +531,17 @@ namespace opentrackio::opentrackioproperties
 
         /**
         * Non-blank string uniquely identifying the tracking device.*/
-        std::optional<std::string> serialNumber = std::nullopt;
+        std::optional<opentrackiotypes::InternedString> serialNumber = std::nullopt;
 
         /**
         * Non-blank string describing the recording slate. */
-        std::optional<std::string> slate = std::nullopt;
+        std::optional<opentrackiotypes::String> slate = std::nullopt;
 
         /**
         * Non-blank string describing status of tracking system. */
-        std::optional<std::string> status = std::nullopt;
+        std::optional<opentrackiotypes::String> status = std::nullopt;
 
-        static std::optional<Tracker> parse(nlohmann::json& json, std::vector<std::string>& errors);
+        static std::optional<Tracker> parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited);
     };    
 
     /**
@@ -533,8 +561,33 @@ namespace opentrackio::opentrackioproperties
      */
     struct Transforms
     {
-        std::vector<opentrackiotypes::Transform> transforms{};
+        /**
+        * Chains are stored inline up to three transforms, e.g. stage, crane and camera, and only allocate beyond that. */
+        using Chain = opentrackiotypes::SmallVector<opentrackiotypes::Transform, 3>;
 
-        static std::optional<Transforms> parse(nlohmann::json& json, std::vector<std::string>& errors);
+        Chain transforms{};
+
+        static std::optional<Transforms> parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited);
+    };
+
+    /**
+    * The properties parsed from a sample's static object: camera, duration and the static fields of lens and
+    * tracker. Blocks are immutable once built and shared between every sample whose static object was the same,
+    * see OpenTrackIOSample::getStaticBlock(). */
+    struct StaticBlock
+    {
+        /**
+        * Assigned to the samples the block is used for without copying. */
+        SharedCamera camera = std::nullopt;
+        std::optional<Duration> duration = std::nullopt;
+
+        /**
+        * Only firmwareVersion, make, model, nominalFocalLength, serialNumber, distortionOverscanMax,
+        * undistortionOverscanMax and calibrationHistory are set. */
+        std::optional<Lens> lens = std::nullopt;
+
+        /**
+        * Only firmwareVersion, make, model and serialNumber are set. */
+        std::optional<Tracker> tracker = std::nullopt;
     };
 } // namespace opentrackio::opentrackioproperties
@@ -0,0 +1,152 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <bitset>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+#include "OpenTrackIOPacket.h"
+
+namespace opentrackio
+{
+    /**
+    * What PacketReassembler::add() did with a packet. */
+    enum class SegmentResult : uint8_t
+    {
+        COMPLETE,       // The packet completed its payload, see PacketReassembler::Payload.
+        PENDING,        // Stored, the payload still misses segments.
+        DUPLICATE,      // A segment already stored, or one of a payload already completed. Dropped.
+        CONFLICTING,    // Overlaps or doesn't line up with the segments already stored, or changes encoding. Dropped.
+        TOO_LARGE       // The payload wouldn't fit in a slot. Dropped.
+    };
+
+    /**
+    * Reassembles payloads that were split over several packets, keyed by the source they came from and their
+    * sequence number. Memory is bounded: the slots and their buffers are allocated once, up front, and a payload
+    * that doesn't complete within the timeout is dropped, as is the oldest payload in progress when a new one
+    * needs its slot. Finding a payload's slot and recording a segment take constant time, a slot being one of the
+    * WAYS slots its key hashes to.
+    *
+    * Every segment but the last must be the same length, as PacketSegmenter writes them, which is what lets a
+    * segment's place be checked against those already stored in constant time. A segment that repeats one
+    * already stored is a DUPLICATE, one that would overlap another or leave a gap that no segment could fill is
+    * CONFLICTING. */
+    class PacketReassembler
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr std::size_t WAYS = 4;
+        static constexpr std::size_t MAX_SEGMENTS = 256;
+        static constexpr std::size_t DEFAULT_SLOT_COUNT = 16;
+        static constexpr std::size_t DEFAULT_MAX_PAYLOAD_SIZE = 64 * 1024;
+        static constexpr std::chrono::milliseconds DEFAULT_TIMEOUT{100};
+
+        /**
+        * A complete payload. payload views either the packet it came in, if it wasn't segmented, or a slot of the
+        * reassembler, and is valid until the next call to add(). */
+        struct Payload
+        {
+            uint64_t source = 0;
+            uint16_t sequenceNumber = 0;
+            PayloadEncoding encoding = PayloadEncoding::JSON;
+            std::span<const uint8_t> payload{};
+        };
+
+        struct Stats
+        {
+            uint64_t completed = 0;
+            uint64_t duplicates = 0;
+            uint64_t conflicting = 0;
+            uint64_t tooLarge = 0;
+
+            /** Payloads dropped incomplete because they timed out. */
+            uint64_t timedOut = 0;
+
+            /** Payloads dropped incomplete to free a slot for a newer one. */
+            uint64_t evicted = 0;
+        };
+
+        /**
+        * slotCount is rounded up to a multiple of WAYS, each slot holds a payload of up to maxPayloadSize bytes. */
+        explicit PacketReassembler(std::size_t slotCount = DEFAULT_SLOT_COUNT,
+                                   std::size_t maxPayloadSize = DEFAULT_MAX_PAYLOAD_SIZE,
+                                   Clock::duration timeout = DEFAULT_TIMEOUT);
+
+        /**
+        * Adds a decoded packet from source, any number that tells the senders apart e.g. their address and port.
+        * A packet that isn't segmented completes at once without being copied. */
+        SegmentResult add(uint64_t source, const Packet& packet, Clock::time_point now, Payload& complete);
+
+        /**
+        * Drops the payloads that have been in progress for longer than the timeout and returns how many.
+        * add() drops those it comes across, call this to release the others e.g. once per frame. */
+        std::size_t expire(Clock::time_point now);
+
+        [[nodiscard]] const Stats& stats() const { return m_stats; }
+        [[nodiscard]] std::size_t slotCount() const { return m_slots.size(); }
+        [[nodiscard]] std::size_t maxPayloadSize() const { return m_maxPayloadSize; }
+
+    private:
+        enum class SlotState : uint8_t
+        {
+            FREE,
+            ASSEMBLING,
+
+            // Kept so that late duplicates of its segments are recognised, until the slot is needed.
+            COMPLETED
+        };
+
+        struct Slot
+        {
+            SlotState state = SlotState::FREE;
+            PayloadEncoding encoding = PayloadEncoding::JSON;
+            uint16_t sequenceNumber = 0;
+            uint64_t source = 0;
+            Clock::time_point started{};
+
+            // Length of every segment but the last, 0 until a segment other than the last has arrived.
+            uint32_t segmentLength = 0;
+            bool hasLast = false;
+            uint32_t lastOffset = 0;
+            uint32_t lastLength = 0;
+
+            // Index of the highest segment other than the last that has arrived.
+            uint32_t highestIndex = 0;
+            uint32_t received = 0;
+            std::bitset<MAX_SEGMENTS> segments{};
+            uint8_t* buffer = nullptr;
+        };
+
+        [[nodiscard]] std::size_t bucketOf(uint64_t source, uint16_t sequenceNumber) const;
+
+        /**
+        * The slot holding the payload, or the one to start it in: a free one, else the oldest. */
+        Slot& findSlot(uint64_t source, uint16_t sequenceNumber, Clock::time_point now);
+
+        SegmentResult store(Slot& slot, const Packet& packet);
+
+        /**
+        * Whether the last segment lines up with segments of length segmentLength, up to and including highest. */
+        static bool lastFits(const Slot& slot, uint32_t segmentLength, uint32_t highest);
+
+        std::vector<Slot> m_slots;
+        std::vector<uint8_t> m_storage;
+        std::size_t m_maxPayloadSize;
+        Clock::duration m_timeout;
+        Stats m_stats{};
+    };
+} // namespace opentrackio
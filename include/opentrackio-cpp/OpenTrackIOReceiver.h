@@ -0,0 +1,185 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <system_error>
+#include <thread>
+#include <vector>
+#include "OpenTrackIOPacket.h"
+#include "OpenTrackIOReassembler.h"
+#include "OpenTrackIOSample.h"
+
+struct sockaddr_in;
+
+namespace opentrackio
+{
+    /**
+    * Reference receiver for the OpenTrackIO transport, Linux only. Joins the multicast groups of the given sources
+    * and reads datagrams a batch per recvmmsg() call into buffers that are allocated once and reused, then decodes,
+    * reassembles and parses them into a sample kept per worker and hands each sample to a handler.
+    *
+    * Each worker has its own socket, bound to the shared port with SO_REUSEPORT. Linux delivers multicast to every
+    * socket on the port rather than balancing it between them, so the groups are what is sharded: worker i joins
+    * every workers-th source from the i-th, and IP_MULTICAST_ALL is cleared so it only receives the groups it
+    * joined. Unicast datagrams sent to the port are balanced between the workers by the kernel.
+    *
+    * With the IO_URING backend each worker instead keeps a multishot receive armed on an io_uring, which the kernel
+    * completes into a ring of buffers registered up front, and the worker reads the completions from memory shared
+    * with the kernel. A busy worker then makes no system calls at all, an idle one one per wait. */
+    class OpenTrackIOReceiver
+    {
+    public:
+        struct Settings
+        {
+            /** Sources whose multicast groups to join, none to only receive unicast. */
+            std::vector<uint8_t> sourceNumbers{1};
+            uint16_t port = DEFAULT_TRANSPORT_PORT;
+
+            /** IPv4 address of the interface to join the groups on, 0 to let the kernel choose. In host byte order. */
+            uint32_t interfaceAddress = 0;
+
+            /** Worker sockets, capped at the number of sources when there are any. */
+            std::size_t workers = 1;
+
+            /** Most datagrams read per recvmmsg() call, or completions handled per receive() with IO_URING. */
+            std::size_t batchSize = 64;
+
+            /** Larger datagrams are truncated and dropped. */
+            std::size_t maxDatagramSize = 9000;
+
+            /** SO_RCVBUF for each socket, 0 to keep the system default. */
+            int receiveBufferSize = 0;
+
+            /**
+            * IO_URING falls back to SOCKETS where io_uring is missing, disabled, or older than Linux 6.0, or the
+            * library was built against uAPI headers that old. */
+            TransportBackend backend = TransportBackend::SOCKETS;
+
+            std::size_t reassemblySlots = PacketReassembler::DEFAULT_SLOT_COUNT;
+            std::size_t maxPayloadSize = PacketReassembler::DEFAULT_MAX_PAYLOAD_SIZE;
+            PacketReassembler::Clock::duration reassemblyTimeout = PacketReassembler::DEFAULT_TIMEOUT;
+        };
+
+        struct Stats
+        {
+            /** receive() calls that returned datagrams. */
+            uint64_t batches = 0;
+            uint64_t datagrams = 0;
+            uint64_t bytes = 0;
+
+            /** Datagrams over maxDatagramSize. */
+            uint64_t truncated = 0;
+
+            /** Datagrams that decodePacket() rejected. */
+            uint64_t badPackets = 0;
+
+            /** Segments the reassembler dropped as duplicates, conflicting or too large. */
+            uint64_t droppedSegments = 0;
+
+            /** Payloads parsed into a sample and handed on. */
+            uint64_t samples = 0;
+
+            /** Payloads that didn't parse. */
+            uint64_t parseFailures = 0;
+
+            /** recvmmsg() and poll(), or io_uring_enter(), calls made. */
+            uint64_t systemCalls = 0;
+
+            /**
+            * recvmmsg() and poll() calls, or receive completions with IO_URING, that failed for a reason other than
+            * there being nothing to read. See error(worker) for the last one's. */
+            uint64_t receiveErrors = 0;
+        };
+
+        /**
+        * Called on the worker's thread with each sample it parses and the source it came from, the sender's IPv4
+        * address in the high 32 bits and its port in the low 16. The sample is reused for the worker's next one. */
+        using SampleHandler = std::function<void(const OpenTrackIOSample& sample, uint64_t source)>;
+
+        explicit OpenTrackIOReceiver(Settings settings);
+        ~OpenTrackIOReceiver();
+
+        OpenTrackIOReceiver(const OpenTrackIOReceiver&) = delete;
+        OpenTrackIOReceiver& operator=(const OpenTrackIOReceiver&) = delete;
+
+        /**
+        * Opens, binds and joins the sockets of the workers. Returns false, closing any it opened, if one of them
+        * fails, see error(). */
+        bool open();
+
+        /**
+        * Opens the sockets if they aren't already and starts a thread per worker that receives until stop(). */
+        bool start(SampleHandler handler);
+        void stop();
+
+        /**
+        * Reads one batch on worker's socket, waiting up to timeout for the first datagram, and handles it on the
+        * calling thread. Lets an application with its own threads or event loop drive the workers rather than
+        * start() them. Returns the number of datagrams read. If the socket fails it waits out timeout, so that
+        * calling it again in a loop doesn't spin, counts a receive error and records it in error(worker). */
+        std::size_t receive(std::size_t worker, const SampleHandler& handler, std::chrono::milliseconds timeout);
+
+        [[nodiscard]] std::size_t workerCount() const { return m_workers.size(); }
+
+        /**
+        * The backend open() settled on. */
+        [[nodiscard]] TransportBackend backend() const { return m_backend; }
+        [[nodiscard]] std::error_code error() const { return m_error; }
+
+        /**
+        * Why the last of worker's receive() calls that counted a receive error failed, kept per worker as they run
+        * on their own threads. Safe to call while they run. */
+        [[nodiscard]] std::error_code error(std::size_t worker) const;
+
+        /**
+        * Totals over the workers. Safe to call while they run. */
+        [[nodiscard]] Stats stats() const;
+
+    private:
+        struct Worker;
+
+        struct Counts;
+
+        void close();
+
+        /**
+        * Sets up the io_uring and buffers of every worker. Returns false, leaving none set up, if that fails for any
+        * of them. */
+        bool openRings();
+
+        /**
+        * Arms the worker's multishot receive from the calling thread. */
+        static void armReceive(Worker& worker);
+
+        std::size_t receiveSockets(Worker& worker, const SampleHandler& handler, std::chrono::milliseconds timeout);
+        std::size_t receiveRing(Worker& worker, const SampleHandler& handler, std::chrono::milliseconds timeout);
+
+        /**
+        * Decodes, reassembles and parses one datagram, counting what happened to it. */
+        static void handleDatagram(Worker& worker, std::span<const uint8_t> datagram, const sockaddr_in& sender,
+                                   PacketReassembler::Clock::time_point now, const SampleHandler& handler,
+                                   Counts& counts);
+
+        Settings m_settings;
+        TransportBackend m_backend = TransportBackend::SOCKETS;
+        std::vector<std::unique_ptr<Worker>> m_workers{};
+        std::vector<std::jthread> m_threads{};
+        std::error_code m_error{};
+    };
+} // namespace opentrackio
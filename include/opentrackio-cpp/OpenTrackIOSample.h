@@ -12,16 +12,62 @@
  */
 
 #pragma once
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
 #include <optional>
 #include <span>
 #include <nlohmann/json.hpp>
+#include "OpenTrackIOArena.h"
+#include "OpenTrackIOErrors.h"
 #include "OpenTrackIOProperties.h"
+#include "OpenTrackIOSaxParser.h"
 
 namespace opentrackio
 {
+    /**
+    * Properties, or parts of properties, that initialise() can be restricted to. Combine them with |.
+    * Top level flags select a whole property, the nested flags select one part of it and leave the rest of the
+    * property unset. */
+    enum class SampleFields : uint32_t
+    {
+        NONE = 0,
+        CAMERA = 1u << 0,
+        DURATION = 1u << 1,
+        GLOBAL_STAGE = 1u << 2,
+        LENS = 1u << 3,                     // static/lens and lens
+        STATIC_LENS = 1u << 4,              // static/lens
+        LENS_ENCODERS = 1u << 5,            // lens/encoders
+        LENS_RAW_ENCODERS = 1u << 6,        // lens/rawEncoders
+        LENS_DISTORTION = 1u << 7,          // lens/distortion, lens/distortionOffset and lens/projectionOffset
+        PROTOCOL = 1u << 8,
+        RELATED_SAMPLE_IDS = 1u << 9,
+        SAMPLE_ID = 1u << 10,
+        SOURCE_ID = 1u << 11,
+        SOURCE_NUMBER = 1u << 12,
+        TIMING = 1u << 13,
+        TIMING_SAMPLE_TIMESTAMP = 1u << 14, // timing/sampleTimestamp
+        TIMING_SYNCHRONIZATION = 1u << 15,  // timing/synchronization
+        TIMING_TIMECODE = 1u << 16,         // timing/timecode
+        TRACKER = 1u << 17,                 // static/tracker and tracker
+        TRANSFORMS = 1u << 18,
+        ALL = 0xFFFFFFFF
+    };
+
+    constexpr SampleFields operator|(SampleFields lhs, SampleFields rhs)
+    {
+        return static_cast<SampleFields>(static_cast<uint32_t>(lhs) | static_cast<uint32_t>(rhs));
+    }
+
+    constexpr SampleFields operator&(SampleFields lhs, SampleFields rhs)
+    {
+        return static_cast<SampleFields>(static_cast<uint32_t>(lhs) & static_cast<uint32_t>(rhs));
+    }
+
     struct OpenTrackIOSample
     {
-        std::optional<opentrackioproperties::Camera> camera = std::nullopt;
+        opentrackioproperties::SharedCamera camera = std::nullopt;
         std::optional<opentrackioproperties::Duration> duration = std::nullopt;
         std::optional<opentrackioproperties::GlobalStage> globalStage = std::nullopt;
         std::optional<opentrackioproperties::Lens> lens = std::nullopt;
@@ -35,33 +81,192 @@ namespace opentrackio
         std::optional<opentrackioproperties::Transforms> transforms = std::nullopt;
 
         OpenTrackIOSample() = default;
+
+#ifdef OPENTRACKIO_PMR
+        /**
+        * The text and CBOR initialise() overloads allocate the strings and vectors of the properties from resource,
+        * so that the samples of a frame can share a std::pmr::monotonic_buffer_resource and be released with it.
+        * The resource must outlive the sample. Properties from initialise(const nlohmann::json&), and those of
+        * copies, use the default resource. */
+        explicit OpenTrackIOSample(std::pmr::memory_resource* resource) : m_parser{resource} {}
+#endif
+
+        /**
+        * Every initialise() replaces the properties, errors and warnings of the previous one so a sample can be
+        * reused for each frame of a stream. The text and CBOR overloads refill the strings and vectors of the
+        * previous properties rather than reallocating them, so once a reused sample has grown to fit the stream,
+        * parsing CBOR into it doesn't allocate. Parsing text still makes a handful of small allocations per call,
+        * as nlohmann::json::sax_parse() builds a fresh lexer and parser with their token and nesting buffers each
+        * time, but nothing in proportion to the properties. */
         bool initialise(const nlohmann::json& json);
         bool initialise(const std::string_view jsonString);
         bool initialise(std::span<const uint8_t> cbor);
-        const std::vector<std::string>& getErrors() { return m_errorMessages; };
+
+        /**
+        * As initialise(const nlohmann::json&) for a DOM the caller hands over, e.g. one it built only to pass in.
+        * Strings, including those of arrays, are moved out of it rather than copied unless the properties hold them
+        * as std::pmr::string or interned. json is left null. */
+        bool initialise(nlohmann::json&& json);
+
+        /**
+        * As above but only the given fields are parsed, the other properties are left unset. Values outside of fields
+        * are stepped over by the CBOR decoder and dropped as they are tokenised from text, so they are neither stored
+        * nor validated and don't produce errors or leftover warnings. */
+        bool initialise(const std::string_view jsonString, SampleFields fields);
+        bool initialise(std::span<const uint8_t> cbor, SampleFields fields);
+
+        /**
+        * Errors are recorded as ParseErrors while parsing and only formatted into messages the first time
+        * getErrors() is called after an initialise(), so rejecting a bad sample doesn't allocate. */
+        const std::vector<std::string>& getErrors();
+        const ParseErrors& getParseErrors() const { return m_errors; };
         const std::vector<std::string>& getWarnings() { return m_warningMessages; };
-        const nlohmann::json& getJson();
+
+        /**
+        * The sample as a nlohmann::json DOM, generated on first use and kept until the properties change.
+        * Any number of threads can call getJson() on a sample that isn't being modified: the first call generates
+        * the JSON exactly once while the others wait for it, and every call after that is lock-free. */
+        const nlohmann::json& getJson() const;
+
+        /**
+        * As above but generated afresh into a DOM whose nodes and strings are allocated from arena, so that threads
+        * generating JSON for many samples each bump through their own arena rather than contending on the heap.
+        * Once arena has grown to fit, generating doesn't touch the heap, although destroying the DOM still takes
+        * nlohmann's small flattening stack from it. The DOM must be destroyed before arena is reset. */
+        ArenaJson getJson(JsonArena& arena) const;
+
+        /**
+        * Tracked access to the properties: each returns its property to assign or change in place and marks its
+        * section dirty, so the next getJson() regenerates that section without a markDirty() call. Don't hold the
+        * reference across a getJson(), changes made after it are only picked up once the section is marked again. */
+        opentrackioproperties::SharedCamera& mutateCamera() { markDirty(SampleFields::CAMERA); return camera; }
+        std::optional<opentrackioproperties::Duration>& mutateDuration() { markDirty(SampleFields::DURATION); return duration; }
+        std::optional<opentrackioproperties::GlobalStage>& mutateGlobalStage() { markDirty(SampleFields::GLOBAL_STAGE); return globalStage; }
+        std::optional<opentrackioproperties::Lens>& mutateLens() { markDirty(SampleFields::LENS); return lens; }
+        std::optional<opentrackioproperties::Protocol>& mutateProtocol() { markDirty(SampleFields::PROTOCOL); return protocol; }
+        std::optional<opentrackioproperties::RelatedSampleIds>& mutateRelatedSampleIds() { markDirty(SampleFields::RELATED_SAMPLE_IDS); return relatedSampleIds; }
+        std::optional<opentrackioproperties::SampleId>& mutateSampleId() { markDirty(SampleFields::SAMPLE_ID); return sampleId; }
+        std::optional<opentrackioproperties::SourceId>& mutateSourceId() { markDirty(SampleFields::SOURCE_ID); return sourceId; }
+        std::optional<opentrackioproperties::SourceNumber>& mutateSourceNumber() { markDirty(SampleFields::SOURCE_NUMBER); return sourceNumber; }
+        std::optional<opentrackioproperties::Timing>& mutateTiming() { markDirty(SampleFields::TIMING); return timing; }
+        std::optional<opentrackioproperties::Tracker>& mutateTracker() { markDirty(SampleFields::TRACKER); return tracker; }
+        std::optional<opentrackioproperties::Transforms>& mutateTransforms() { markDirty(SampleFields::TRANSFORMS); return transforms; }
+
+        /**
+        * getJson() keeps the JSON it generates until the next initialise() or reset(). The mutate accessors above
+        * mark what they hand out, after changing the public properties directly mark the sections that changed here
+        * instead, or getJson() keeps returning the old JSON. Either way the next getJson() regenerates only the
+        * marked keys, keeping the rest of the cached JSON. The flags below lens and timing regenerate the whole of
+        * lens or timing. serializeJson() and serializeCbor() always write the current properties and don't need
+        * marking. */
+        void markDirty(SampleFields sections);
+
+        /**
+        * Writes the sample as JSON text, byte-identical to getJson().dump() but straight from the properties.
+        * The first overload appends to out, the second returns the number of characters written to buffer or
+        * std::nullopt if it was too small. */
+        void serializeJson(std::string& out) const;
+        std::optional<std::size_t> serializeJson(std::span<char> buffer) const;
+
+        /**
+        * Writes the sample as CBOR, byte-identical to nlohmann::json::to_cbor(getJson()) but straight from the
+        * properties. Returns the number of bytes written to buffer or std::nullopt if it is smaller than
+        * serializedCborSize(), which can be used to size the buffer exactly beforehand. */
+        std::optional<std::size_t> serializeCbor(std::span<uint8_t> buffer) const;
+        [[nodiscard]] std::size_t serializedCborSize() const;
+
+        /**
+        * Unsets every property and clears the errors, warnings and cached JSON. The storage of the properties is
+        * kept for the next text or CBOR initialise() to refill, although only CBOR then parses without allocating,
+        * see initialise(). */
+        void reset();
+
+        /**
+        * The static properties of the last text or CBOR initialise(), shared with every other sample parsed by
+        * this one that had the same static object, or nullptr if they weren't cached. A sample parses a stream of
+        * sources, its cache holds the static object last seen from each. */
+        [[nodiscard]] std::shared_ptr<const opentrackioproperties::StaticBlock> getStaticBlock() const { return m_staticBlock; };
+        [[nodiscard]] OpenTrackIOSaxParser::StaticCacheStats getStaticCacheStats() const { return m_parser.staticCacheStats(); };
+
+        /**
+        * How many sources' static objects the sample caches, OpenTrackIOSaxParser::DEFAULT_STATIC_CACHE_CAPACITY
+        * unless changed. Raise it for a sample that parses more sources than that, 0 disables the cache. */
+        void setStaticCacheCapacity(std::size_t sources) { m_parser.setStaticCacheCapacity(sources); };
         
     private:
-        void generateJson();
-        void parseCameraToJson(nlohmann::json& baseJson);
-        void parseDurationToJson(nlohmann::json& baseJson);
-        void parseGlobalStageToJson(nlohmann::json& baseJson);
-        void parseLensToJson(nlohmann::json& baseJson);
-        void parseProtocolToJson(nlohmann::json& baseJson);
-        void parseRelatedSampleIdsToJson(nlohmann::json& baseJson);
-        void parseSampleIdToJson(nlohmann::json& baseJson);
-        void parseSourceIdToJson(nlohmann::json& baseJson);
-        void parseSourceNumberToJson(nlohmann::json& baseJson);
-        void parseTimingToJson(nlohmann::json& baseJson);
-        void parseTrackerToJson(nlohmann::json& baseJson);
-        void parseTransformsToJson(nlohmann::json& baseJson);
+        /**
+        * The JSON generated by getJson(), published once per change to the properties. The first reader generates
+        * it under a lock, later readers only load an atomic flag. Copies take the JSON as it stands. */
+        class JsonCache
+        {
+        public:
+            JsonCache() = default;
+            JsonCache(const JsonCache& other);
+            JsonCache& operator=(const JsonCache& other);
+
+            /**
+            * Returns the JSON, first passing it to update along with the dirty sections unless it's up to date. */
+            template<typename Update>
+            const nlohmann::json& get(const Update& update) const
+            {
+                if (!m_ready.load(std::memory_order_acquire))
+                {
+                    std::scoped_lock lock{m_mutex};
+                    if (!m_ready.load(std::memory_order_relaxed))
+                    {
+                        update(m_json, m_dirty);
+                        m_dirty = SampleFields::NONE;
+                        m_ready.store(true, std::memory_order_release);
+                    }
+                }
+                return m_json;
+            }
+
+            void markDirty(SampleFields sections);
+            void clear();
+
+        private:
+            mutable std::mutex m_mutex{};
+            mutable std::atomic<bool> m_ready = false;
+            mutable nlohmann::json m_json{};
+            mutable SampleFields m_dirty = SampleFields::ALL;
+        };
+
+        template<typename Json>
+        void updateJson(Json& j, SampleFields sections) const;
+        template<typename Json> void parseCameraToJson(Json& baseJson) const;
+        template<typename Json> void parseDurationToJson(Json& baseJson) const;
+        template<typename Json> void parseGlobalStageToJson(Json& baseJson) const;
+        template<typename Json> void parseLensToJson(Json& baseJson) const;
+        template<typename Json> void parseProtocolToJson(Json& baseJson) const;
+        template<typename Json> void parseRelatedSampleIdsToJson(Json& baseJson) const;
+        template<typename Json> void parseSampleIdToJson(Json& baseJson) const;
+        template<typename Json> void parseSourceIdToJson(Json& baseJson) const;
+        template<typename Json> void parseSourceNumberToJson(Json& baseJson) const;
+        template<typename Json> void parseTimingToJson(Json& baseJson) const;
+        template<typename Json> void parseTrackerToJson(Json& baseJson) const;
+        template<typename Json> void parseTransformsToJson(Json& baseJson) const;
 
         [[nodiscard]] bool isEmpty() const;
+
+        /**
+        * Shared body of the DOM initialise() overloads, m_visitedFields says whether json can be moved from. */
+        bool parseDocument(const nlohmann::json& json);
+
+        /**
+        * Shared tail of the text and CBOR initialise() overloads once the SAX parser has assigned the properties. */
+        bool completeStreamingParse(const std::vector<std::string>& remainingFields);
         void warnForRemainingFields(const nlohmann::json& json);
         
-        std::optional<nlohmann::json> m_json = std::nullopt;
+        void clearMessages();
+
+        JsonCache m_json{};
+        OpenTrackIOSaxParser m_parser{};
+        std::shared_ptr<const opentrackioproperties::StaticBlock> m_staticBlock{};
+        VisitedFields m_visitedFields{};
+        ParseErrors m_errors{};
         std::vector<std::string> m_errorMessages{};
+        bool m_errorMessagesRendered = true;
         std::vector<std::string> m_warningMessages{};
     };
 } // namespace opentrackio
@@ -0,0 +1,145 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstdint>
+#include <memory>
+#ifdef OPENTRACKIO_PMR
+#include <memory_resource>
+#endif
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "OpenTrackIOErrors.h"
+
+namespace opentrackio
+{
+    struct OpenTrackIOSample;
+    enum class SampleFields : uint32_t;
+
+    namespace opentrackioproperties
+    {
+        struct StaticBlock;
+    }
+
+    /**
+    * Streaming parser that fills the properties of an OpenTrackIOSample straight from JSON text using
+    * nlohmann's SAX interface, without building a nlohmann::json DOM first.
+    * Values are routed into a fixed table of known fields by a key-path state machine as the tokens arrive and are
+    * then validated with the same rules and error text as the parse() functions in OpenTrackIOProperties.
+    * CBOR is read by a dedicated decoder that feeds the same state machine.
+    * A parser keeps its buffers between parses, along with the storage of the properties passed to recycle(), so
+    * that parsing a stream of similar samples stops allocating once they have grown to fit.
+    * The static object of each source is cached by its sourceId along with its raw bytes, while a source keeps
+    * sending the same bytes its static object is stepped over and the properties are copied from the cached block
+    * instead of being parsed again. */
+    class OpenTrackIOSaxParser
+    {
+    public:
+        /**
+        * Why, and where, a CBOR payload couldn't be decoded. */
+        struct CborError
+        {
+            std::string_view description{};
+
+            /** 1-based offset of the byte at which decoding stopped. */
+            std::size_t byte = 0;
+        };
+
+        /**
+        * Parses that carried a static object, split by whether it was found in the cache. */
+        struct StaticCacheStats
+        {
+            uint64_t hits = 0;
+            uint64_t misses = 0;
+        };
+
+        /**
+        * Sources whose static objects are cached unless setStaticCacheCapacity() says otherwise. */
+        static constexpr std::size_t DEFAULT_STATIC_CACHE_CAPACITY = 16;
+
+        OpenTrackIOSaxParser();
+        ~OpenTrackIOSaxParser();
+
+#ifdef OPENTRACKIO_PMR
+        /**
+        * Allocates the strings and vectors of the properties it assigns from resource, which must outlive the
+        * parser and every sample it has parsed. */
+        explicit OpenTrackIOSaxParser(std::pmr::memory_resource* resource);
+#endif
+
+        /**
+        * The buffers are only a cache so copies start without any, and use the default memory resource. The static
+        * cache capacity is copied. */
+        OpenTrackIOSaxParser(const OpenTrackIOSaxParser& other);
+        OpenTrackIOSaxParser& operator=(const OpenTrackIOSaxParser& other);
+        OpenTrackIOSaxParser(OpenTrackIOSaxParser&& other) noexcept;
+        OpenTrackIOSaxParser& operator=(OpenTrackIOSaxParser&& other) noexcept;
+
+        /**
+        * Parses jsonString and assigns every property of the sample (properties that aren't present are reset).
+        * Validation errors are appended to errors and, if there were none, fields that no property consumed are
+        * appended to warnings, both in the same order that OpenTrackIOSample::initialise(const nlohmann::json&)
+        * reports them.
+        * Only the properties in fields are assigned, values outside of them are dropped without being stored.
+        * Returns false, leaving the sample untouched, if jsonString isn't valid JSON. */
+        bool parse(std::string_view jsonString,
+                   SampleFields fields,
+                   OpenTrackIOSample& sample,
+                   ParseErrors& errors,
+                   std::vector<std::string>& warnings);
+
+        /**
+        * As above for an RFC 8949 CBOR payload, accepting the same encodings as nlohmann::json::from_cbor.
+        * Values outside of fields are stepped over without being decoded. Decoding never throws, if the payload is
+        * malformed false is returned with the reason in cborError. */
+        bool parse(std::span<const uint8_t> cbor,
+                   SampleFields fields,
+                   OpenTrackIOSample& sample,
+                   ParseErrors& errors,
+                   std::vector<std::string>& warnings,
+                   CborError& cborError);
+
+        /**
+        * Unsets every property of sample, keeping their strings and vectors for the next parse to fill. */
+        void recycle(OpenTrackIOSample& sample);
+
+        /**
+        * The static block assigned by the last parse, either found in the cache or added to it, otherwise nullptr.
+        * Static objects are only cached from samples that have a sourceId, were parsed with every static property
+        * in fields and had no errors or leftover static fields. */
+        [[nodiscard]] std::shared_ptr<const opentrackioproperties::StaticBlock> staticBlock() const;
+        [[nodiscard]] StaticCacheStats staticCacheStats() const;
+
+        /**
+        * Most sources whose static object is cached, 0 to cache none. Once it is full a new source replaces a
+        * pseudo-randomly chosen one, so that a sample parsing a few more sources than fit in rotation still finds
+        * most of them. Shrinking it evicts sources straight away. */
+        void setStaticCacheCapacity(std::size_t sources);
+        [[nodiscard]] std::size_t staticCacheCapacity() const { return m_staticCacheCapacity; }
+
+    private:
+        struct State;
+        State& state();
+
+        /**
+        * Created on first use so that constructing a sample doesn't allocate. */
+        std::unique_ptr<State> m_state{};
+        std::size_t m_staticCacheCapacity = DEFAULT_STATIC_CACHE_CAPACITY;
+
+#ifdef OPENTRACKIO_PMR
+        std::pmr::memory_resource* m_resource = std::pmr::get_default_resource();
+#endif
+    };
+} // namespace opentrackio
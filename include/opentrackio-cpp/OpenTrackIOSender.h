@@ -0,0 +1,157 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <system_error>
+#include <vector>
+#include "OpenTrackIOPacket.h"
+#include "OpenTrackIOSample.h"
+
+namespace opentrackio
+{
+    /**
+    * Reference sender for the OpenTrackIO transport, Linux only. Samples from any number of sources are serialised
+    * and framed straight into a queue of datagrams, each addressed to its source's multicast group, and the queue
+    * is sent with as few sendmmsg() calls as it takes. Queueing the samples of a frame and flushing once costs one
+    * system call rather than one per datagram.
+    *
+    * flushPaced() spreads the queue over a frame interval in small bursts instead of sending it at once, so that
+    * many sources publishing on the same frame edge don't hit the switch as one microburst.
+    *
+    * With the IO_URING backend the queue is submitted to an io_uring as one send per datagram instead, still one
+    * system call per flush or burst. */
+    class OpenTrackIOSender
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        struct Settings
+        {
+            uint16_t port = DEFAULT_TRANSPORT_PORT;
+
+            /** IPv4 address of the interface to send from, 0 to let the kernel choose. In host byte order. */
+            uint32_t interfaceAddress = 0;
+
+            uint8_t multicastTtl = 1;
+
+            /** Whether the sending host receives its own datagrams, needed when both ends are on it. */
+            bool multicastLoop = true;
+
+            PayloadEncoding encoding = PayloadEncoding::CBOR;
+            std::size_t maxDatagramSize = PacketSegmenter::DEFAULT_MAX_DATAGRAM_SIZE;
+
+            /** Datagrams the queue holds, queueing more first flushes it. */
+            std::size_t queueCapacity = 256;
+
+            /** Datagrams sent together at each step of flushPaced(). */
+            std::size_t burstSize = 4;
+
+            /** SO_SNDBUF for the socket, 0 to keep the system default. */
+            int sendBufferSize = 0;
+
+            /**
+            * IO_URING falls back to SOCKETS where io_uring is missing or disabled, or the library was built
+            * against uAPI headers older than Linux 6.0. */
+            TransportBackend backend = TransportBackend::SOCKETS;
+        };
+
+        struct Stats
+        {
+            uint64_t samples = 0;
+            uint64_t datagrams = 0;
+            uint64_t bytes = 0;
+
+            /** sendmmsg(), or io_uring_enter(), calls made. */
+            uint64_t sendCalls = 0;
+
+            /** Times the queue filled up and was flushed by queue() rather than by the caller. */
+            uint64_t overflowFlushes = 0;
+
+            /** Datagrams dropped because sending them failed, see error(). */
+            uint64_t failed = 0;
+        };
+
+        explicit OpenTrackIOSender(Settings settings);
+        ~OpenTrackIOSender();
+
+        OpenTrackIOSender(const OpenTrackIOSender&) = delete;
+        OpenTrackIOSender& operator=(const OpenTrackIOSender&) = delete;
+
+        /**
+        * Opens and configures the socket. Returns false if that fails, see error(). */
+        bool open();
+
+        /**
+        * Serialises sample in the configured encoding and queues it for the multicast group of sourceNumber, split
+        * over as many datagrams as it takes. Returns false, queueing nothing, if the sample is larger than the queue,
+        * as queueing it would overwrite its own first segments.
+        *
+        * Sequence numbers count the payloads of the sender rather than of each source, as receivers reassemble
+        * segments by the address and port they came from and the sequence number, whatever their group. */
+        bool queue(const OpenTrackIOSample& sample, uint8_t sourceNumber);
+
+        /**
+        * As above for a payload that is already serialised. */
+        bool queue(PayloadEncoding encoding, std::span<const uint8_t> payload, uint8_t sourceNumber);
+
+        /**
+        * Sends every queued datagram now. Returns the number sent. */
+        std::size_t flush();
+
+        /**
+        * Sends the queued datagrams in bursts of burstSize spread evenly over interval, starting now, sleeping
+        * between them. Returns the number sent once the last burst has gone. */
+        std::size_t flushPaced(Clock::duration interval);
+
+        /**
+        * The frame interval of sample from timing/sampleRate, for flushPaced(), or std::nullopt if it has none. */
+        [[nodiscard]] static std::optional<Clock::duration> frameInterval(const OpenTrackIOSample& sample);
+
+        /**
+        * The backend open() settled on. */
+        [[nodiscard]] TransportBackend backend() const { return m_backend; }
+
+        [[nodiscard]] std::size_t queued() const { return m_queued; }
+        [[nodiscard]] const Stats& stats() const { return m_stats; }
+        [[nodiscard]] std::error_code error() const { return m_error; }
+
+    private:
+        struct Queue;
+
+        /**
+        * Sends count queued datagrams from first, in as many system calls as it takes. */
+        std::size_t send(std::size_t first, std::size_t count);
+        std::size_t sendRing(std::size_t first, std::size_t count);
+
+        Settings m_settings;
+        TransportBackend m_backend = TransportBackend::SOCKETS;
+        int m_socket = -1;
+        std::unique_ptr<Queue> m_queue;
+        std::size_t m_queued = 0;
+        uint16_t m_sequenceNumber = 0;
+
+        // Reused to serialise each sample into.
+        std::vector<uint8_t> m_cbor{};
+        std::string m_json{};
+
+        Stats m_stats{};
+        std::error_code m_error{};
+    };
+} // namespace opentrackio
@@ -0,0 +1,51 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <string>
+
+namespace opentrackio
+{
+    struct OpenTrackIOSample;
+
+    /**
+    * Writes the properties of an OpenTrackIOSample as JSON text or CBOR without building a nlohmann::json DOM.
+    * The output is byte-identical to OpenTrackIOSample::getJson().dump() and nlohmann::json::to_cbor(getJson()):
+    * keys are written in the same sorted order, numbers are encoded by the same rules and strings are escaped the same
+    * way. Strings are written as they are stored, so invalid UTF-8 is copied through where dump() would throw. */
+    class OpenTrackIOSerializer
+    {
+    public:
+        /**
+        * Appends the sample as JSON text to out. Nothing is allocated once out has enough capacity. */
+        static void writeJson(const OpenTrackIOSample& sample, std::string& out);
+
+        /**
+        * Writes the sample as JSON text to the start of buffer, returning the number of characters written or
+        * std::nullopt if buffer is too small to hold all of them. */
+        static std::optional<std::size_t> writeJson(const OpenTrackIOSample& sample, std::span<char> buffer);
+
+        /**
+        * Writes the sample as CBOR to the start of buffer, returning the number of bytes written or std::nullopt if
+        * buffer is smaller than cborSize(sample). */
+        static std::optional<std::size_t> writeCbor(const OpenTrackIOSample& sample, std::span<uint8_t> buffer);
+
+        /**
+        * Number of bytes writeCbor() needs for the sample, computed without writing anything. */
+        static std::size_t cborSize(const OpenTrackIOSample& sample);
+    };
+} // namespace opentrackio
@@ -0,0 +1,157 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+
+namespace opentrackio::opentrackiotypes
+{
+    class StringPool;
+
+    /**
+    * Handle to a string held by a StringPool. The string is immutable and lives as long as the pool, so handles
+    * are copied as a pointer and two handles from the same pool are equal exactly when they point at the same
+    * string. A string the pool had no room left for is held by its handles instead, and compared by its contents.
+    * A default constructed handle is the empty string. */
+    class InternedString
+    {
+    public:
+        InternedString() = default;
+
+        /**
+        * Interns value in StringPool::global(). */
+        static InternedString intern(std::string_view value);
+
+        [[nodiscard]] std::string_view view() const noexcept { return *m_value; }
+        [[nodiscard]] const char* c_str() const noexcept { return m_value->c_str(); }
+        [[nodiscard]] const char* data() const noexcept { return m_value->data(); }
+        [[nodiscard]] std::size_t size() const noexcept { return m_value->size(); }
+        [[nodiscard]] bool empty() const noexcept { return m_value->empty(); }
+
+        /**
+        * Whether the string is held by a pool rather than by the handles to it. */
+        [[nodiscard]] bool isPooled() const noexcept { return m_value.use_count() == 0; }
+
+        operator std::string_view() const noexcept { return view(); }
+
+        friend bool operator==(const InternedString& lhs, const InternedString& rhs) noexcept
+        {
+            return lhs.m_value == rhs.m_value || ((!lhs.isPooled() || !rhs.isPooled()) && lhs.view() == rhs.view());
+        }
+
+        friend bool operator==(const InternedString& lhs, std::string_view rhs) noexcept { return lhs.view() == rhs; }
+
+    private:
+        friend class StringPool;
+
+        // A pooled string is pointed at with no owner, so copying its handles costs no reference counting.
+        explicit InternedString(const std::string* value) : m_value{std::shared_ptr<void>{}, value}
+        {
+        }
+
+        explicit InternedString(std::shared_ptr<const std::string> value) : m_value{std::move(value)}
+        {
+        }
+
+        static const std::string EMPTY;
+
+        std::shared_ptr<const std::string> m_value{std::shared_ptr<void>{}, &EMPTY};
+    };
+
+    /**
+    * Set of distinct strings, each stored once for the life of the pool. Looking up a string that is already in the
+    * pool is lock-free and doesn't allocate, only adding a new one takes a lock. Nothing is ever removed, the pool
+    * is meant for the handful of makes, models and serial numbers of a production rather than arbitrary text.
+    *
+    * As those strings come off the network, the pool holds at most capacity() bytes of them, so that a sender
+    * making up new ones can't grow it without bound. Past that, intern() hands out strings that aren't pooled but
+    * held by their handles, which costs an allocation each and a comparison of contents. */
+    class StringPool
+    {
+    public:
+        static constexpr std::size_t DEFAULT_CAPACITY = 1024 * 1024;
+
+        explicit StringPool(std::size_t capacity = DEFAULT_CAPACITY) : m_capacity{capacity}
+        {
+        }
+
+        ~StringPool();
+
+        StringPool(const StringPool&) = delete;
+        StringPool& operator=(const StringPool&) = delete;
+
+        /**
+        * The pool the parse functions intern the static metadata of samples in. */
+        static StringPool& global();
+
+        InternedString intern(std::string_view value);
+
+        /**
+        * Number of distinct strings in the pool. */
+        [[nodiscard]] std::size_t size() const { return m_size.load(std::memory_order_relaxed); }
+
+        /**
+        * Total length of the strings in the pool, and the most it is allowed to grow to. Lowering the capacity below
+        * the pool's current size only stops it growing further. */
+        [[nodiscard]] std::size_t bytes() const { return m_bytes.load(std::memory_order_relaxed); }
+        [[nodiscard]] std::size_t capacity() const { return m_capacity.load(std::memory_order_relaxed); }
+        void setCapacity(std::size_t capacity) { m_capacity.store(capacity, std::memory_order_relaxed); }
+
+    private:
+        struct Entry
+        {
+            std::string value;
+            std::size_t hash = 0;
+            const Entry* next = nullptr;
+        };
+
+        static constexpr std::size_t BUCKET_COUNT = 256;
+
+        /**
+        * Entry holding value in the chain starting at head, or nullptr. */
+        static const Entry* find(const Entry* head, std::string_view value, std::size_t hash);
+
+        /**
+        * Chains are only ever prepended to, under m_mutex, with entries that are complete before they're published,
+        * so readers can walk them without a lock. */
+        std::array<std::atomic<const Entry*>, BUCKET_COUNT> m_buckets{};
+        std::atomic<std::size_t> m_size = 0;
+        std::atomic<std::size_t> m_bytes = 0;
+        std::atomic<std::size_t> m_capacity;
+        std::mutex m_mutex{};
+    };
+
+    /**
+    * nlohmann::json conversions, an InternedString is a JSON string. */
+    template<typename BasicJsonType>
+    void to_json(BasicJsonType& json, const InternedString& value)
+    {
+        json = typename BasicJsonType::string_t(value.view());
+    }
+
+    template<typename BasicJsonType>
+    void from_json(const BasicJsonType& json, InternedString& value)
+    {
+        if (!json.is_string())
+        {
+            throw BasicJsonType::type_error::create(302, std::string("type must be string, but is ") + json.type_name(), &json);
+        }
+        value = InternedString::intern(json.template get_ref<const typename BasicJsonType::string_t&>());
+    }
+} // namespace opentrackio::opentrackiotypes
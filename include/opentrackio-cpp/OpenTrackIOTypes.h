@@ -12,15 +12,507 @@
  */
 
 #pragma once
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <compare>
+#include <concepts>
+#include <cstddef>
+#include <cstring>
+#include <functional>
+#include <initializer_list>
+#include <iterator>
+#include <memory>
+#include <new>
 #include <optional>
+#include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
 #include <vector>
-#include <format>
 #include <nlohmann/json.hpp>
 #include "opentrackio-cpp/OpenTrackIOHelper.h"
+#include "opentrackio-cpp/OpenTrackIOStringPool.h"
 
 namespace opentrackio::opentrackiotypes
 {
+    /**
+    * Vector that keeps up to N elements inside itself and only allocates once it grows past them, from Allocator.
+    * The arrays of a sample are short, so sized to fit they cost no allocation and sit in the struct that holds them.
+    * Moving a vector that fits inside moves its elements one by one rather than handing over a pointer. */
+    template<typename T, std::size_t N, typename Allocator = PropertyAllocator<T>>
+    class SmallVector
+    {
+        static_assert(N > 0, "SmallVector needs room for at least one element inside.");
+
+        using Traits = std::allocator_traits<Allocator>;
+
+    public:
+        using value_type = T;
+        using allocator_type = Allocator;
+        using size_type = std::size_t;
+        using difference_type = std::ptrdiff_t;
+        using reference = T&;
+        using const_reference = const T&;
+        using pointer = T*;
+        using const_pointer = const T*;
+        using iterator = T*;
+        using const_iterator = const T*;
+
+        static constexpr size_type INLINE_CAPACITY = N;
+
+        SmallVector() = default;
+
+        explicit SmallVector(const Allocator& allocator) noexcept : m_allocator{allocator}
+        {
+        }
+
+        SmallVector(std::initializer_list<T> values, const Allocator& allocator = Allocator()) : m_allocator{allocator}
+        {
+            assign(values.begin(), values.end());
+        }
+
+        SmallVector(const SmallVector& other) : m_allocator{Traits::select_on_container_copy_construction(other.m_allocator)}
+        {
+            assign(other.begin(), other.end());
+        }
+
+        SmallVector(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>) : m_allocator{other.m_allocator}
+        {
+            if (other.isInline())
+            {
+                for (T& value : other)
+                {
+                    Traits::construct(m_allocator, m_data + m_size, std::move(value));
+                    ++m_size;
+                }
+                other.clear();
+            }
+            else
+            {
+                takeStorage(other);
+            }
+        }
+
+        ~SmallVector()
+        {
+            clear();
+            deallocate();
+        }
+
+        /**
+        * Assigning keeps this vector's allocator, as the std::allocator and std::pmr::polymorphic_allocator
+        * containers do. */
+        SmallVector& operator=(const SmallVector& other)
+        {
+            if (this != &other)
+            {
+                assign(other.begin(), other.end());
+            }
+            return *this;
+        }
+
+        SmallVector& operator=(SmallVector&& other) noexcept(std::is_nothrow_move_constructible_v<T>)
+        {
+            if (this == &other)
+            {
+                return *this;
+            }
+
+            // Spilled storage can only be taken over if this vector's allocator can free it.
+            if (!other.isInline() && m_allocator == other.m_allocator)
+            {
+                clear();
+                deallocate();
+                takeStorage(other);
+            }
+            else
+            {
+                assign(std::make_move_iterator(other.begin()), std::make_move_iterator(other.end()));
+                other.clear();
+            }
+            return *this;
+        }
+
+        template<typename ForwardIt>
+        void assign(ForwardIt first, ForwardIt last)
+        {
+            clear();
+            reserve(static_cast<size_type>(std::distance(first, last)));
+            for (; first != last; ++first)
+            {
+                Traits::construct(m_allocator, m_data + m_size, *first);
+                ++m_size;
+            }
+        }
+
+        void assign(std::initializer_list<T> values)
+        {
+            assign(values.begin(), values.end());
+        }
+
+        [[nodiscard]] allocator_type get_allocator() const noexcept { return m_allocator; }
+
+        [[nodiscard]] T* data() noexcept { return m_data; }
+        [[nodiscard]] const T* data() const noexcept { return m_data; }
+        [[nodiscard]] iterator begin() noexcept { return m_data; }
+        [[nodiscard]] const_iterator begin() const noexcept { return m_data; }
+        [[nodiscard]] iterator end() noexcept { return m_data + m_size; }
+        [[nodiscard]] const_iterator end() const noexcept { return m_data + m_size; }
+
+        [[nodiscard]] T& operator[](size_type i) noexcept { return m_data[i]; }
+        [[nodiscard]] const T& operator[](size_type i) const noexcept { return m_data[i]; }
+        [[nodiscard]] T& front() noexcept { return m_data[0]; }
+        [[nodiscard]] const T& front() const noexcept { return m_data[0]; }
+        [[nodiscard]] T& back() noexcept { return m_data[m_size - 1]; }
+        [[nodiscard]] const T& back() const noexcept { return m_data[m_size - 1]; }
+
+        [[nodiscard]] bool empty() const noexcept { return m_size == 0; }
+        [[nodiscard]] size_type size() const noexcept { return m_size; }
+        [[nodiscard]] size_type capacity() const noexcept { return m_capacity; }
+
+        /**
+        * Whether the elements have outgrown the inline storage and live in allocated storage. */
+        [[nodiscard]] bool isSpilled() const noexcept { return !isInline(); }
+
+        void reserve(size_type capacity)
+        {
+            if (capacity > m_capacity)
+            {
+                reallocate(capacity);
+            }
+        }
+
+        void resize(size_type size)
+        {
+            while (m_size > size)
+            {
+                pop_back();
+            }
+            reserve(size);
+            while (m_size < size)
+            {
+                Traits::construct(m_allocator, m_data + m_size);
+                ++m_size;
+            }
+        }
+
+        template<typename... Args>
+        T& emplace_back(Args&&... args)
+        {
+            if (m_size == m_capacity)
+            {
+                // Constructed before the elements are moved out, args may refer to one of them.
+                const size_type capacity = m_capacity * 2;
+                T* data = Traits::allocate(m_allocator, capacity);
+                Traits::construct(m_allocator, data + m_size, std::forward<Args>(args)...);
+                moveElementsTo(data, capacity);
+            }
+            else
+            {
+                Traits::construct(m_allocator, m_data + m_size, std::forward<Args>(args)...);
+            }
+            return m_data[m_size++];
+        }
+
+        void push_back(const T& value) { emplace_back(value); }
+        void push_back(T&& value) { emplace_back(std::move(value)); }
+
+        void pop_back() noexcept
+        {
+            Traits::destroy(m_allocator, m_data + --m_size);
+        }
+
+        void clear() noexcept
+        {
+            while (m_size > 0)
+            {
+                pop_back();
+            }
+        }
+
+        friend bool operator==(const SmallVector& lhs, const SmallVector& rhs)
+        {
+            return std::equal(lhs.begin(), lhs.end(), rhs.begin(), rhs.end());
+        }
+
+    private:
+        [[nodiscard]] T* inlineData() noexcept { return std::launder(reinterpret_cast<T*>(m_inline)); }
+        [[nodiscard]] const T* inlineData() const noexcept { return std::launder(reinterpret_cast<const T*>(m_inline)); }
+        [[nodiscard]] bool isInline() const noexcept { return m_data == inlineData(); }
+
+        void reallocate(size_type capacity)
+        {
+            moveElementsTo(Traits::allocate(m_allocator, capacity), capacity);
+        }
+
+        /**
+        * Moves the elements into data, allocated from m_allocator, and frees the storage they were in. */
+        void moveElementsTo(T* data, size_type capacity)
+        {
+            for (size_type i = 0; i < m_size; ++i)
+            {
+                Traits::construct(m_allocator, data + i, std::move_if_noexcept(m_data[i]));
+                Traits::destroy(m_allocator, m_data + i);
+            }
+            deallocate();
+            m_data = data;
+            m_capacity = capacity;
+        }
+
+        void deallocate() noexcept
+        {
+            if (!isInline())
+            {
+                Traits::deallocate(m_allocator, m_data, m_capacity);
+                m_data = inlineData();
+                m_capacity = N;
+            }
+        }
+
+        void takeStorage(SmallVector& other) noexcept
+        {
+            m_data = std::exchange(other.m_data, other.inlineData());
+            m_size = std::exchange(other.m_size, 0);
+            m_capacity = std::exchange(other.m_capacity, N);
+        }
+
+        alignas(T) std::byte m_inline[N * sizeof(T)];
+        T* m_data = inlineData();
+        size_type m_size = 0;
+        size_type m_capacity = N;
+        [[no_unique_address]] Allocator m_allocator{};
+    };
+
+    /**
+    * nlohmann::json conversions, a SmallVector is an array like the std::vector it stands in for. */
+    template<typename BasicJsonType, typename T, std::size_t N, typename Allocator>
+    void to_json(BasicJsonType& json, const SmallVector<T, N, Allocator>& values)
+    {
+        json = BasicJsonType::array();
+        for (const T& value : values)
+        {
+            json.push_back(value);
+        }
+    }
+
+    template<typename BasicJsonType, typename T, std::size_t N, typename Allocator>
+    void from_json(const BasicJsonType& json, SmallVector<T, N, Allocator>& values)
+    {
+        if (!json.is_array())
+        {
+            throw BasicJsonType::type_error::create(302, std::string("type must be array, but is ") + json.type_name(), &json);
+        }
+
+        values.clear();
+        values.reserve(json.size());
+        for (const auto& item : json)
+        {
+            values.push_back(item.template get<T>());
+        }
+    }
+
+    /**
+    * Optional value whose copies share one immutable instance until one of them is written to. Reading never
+    * copies, whether or not the handle is const, as value(), * and -> only give const access. Writing in place goes
+    * through mutate(), which first gives the handle an instance of its own if the current one is shared, so writes
+    * can't be seen through the other copies. Otherwise it is used like a std::optional, which it replaces for
+    * properties that are copied far more often than they change.
+    * Unsetting a handle that doesn't share its instance keeps the instance for the next value to be assigned into,
+    * and moving a handle moves the kept instance with it. */
+    template<typename T>
+    class CopyOnWrite
+    {
+    public:
+        using value_type = T;
+
+        CopyOnWrite() = default;
+        CopyOnWrite(std::nullopt_t) noexcept {}
+        CopyOnWrite(const T& value) { emplace(value); }
+        CopyOnWrite(T&& value) { emplace(std::move(value)); }
+        CopyOnWrite(const std::optional<T>& value) { *this = value; }
+        CopyOnWrite(std::optional<T>&& value) { *this = std::move(value); }
+
+        CopyOnWrite(const CopyOnWrite& other) : m_engaged{other.m_engaged}
+        {
+            if (other.m_engaged)
+            {
+                m_value = other.m_value;
+            }
+        }
+
+        CopyOnWrite(CopyOnWrite&& other) noexcept
+            : m_value{std::move(other.m_value)}, m_engaged{std::exchange(other.m_engaged, false)}
+        {
+        }
+
+        CopyOnWrite& operator=(const CopyOnWrite& other)
+        {
+            if (this != &other)
+            {
+                m_value = other.m_engaged ? other.m_value : nullptr;
+                m_engaged = other.m_engaged;
+            }
+            return *this;
+        }
+
+        CopyOnWrite& operator=(CopyOnWrite&& other) noexcept
+        {
+            if (this != &other)
+            {
+                m_value = std::move(other.m_value);
+                m_engaged = std::exchange(other.m_engaged, false);
+            }
+            return *this;
+        }
+
+        CopyOnWrite& operator=(std::nullopt_t) noexcept
+        {
+            reset();
+            return *this;
+        }
+
+        CopyOnWrite& operator=(const T& value)
+        {
+            emplace(value);
+            return *this;
+        }
+
+        CopyOnWrite& operator=(T&& value)
+        {
+            emplace(std::move(value));
+            return *this;
+        }
+
+        CopyOnWrite& operator=(const std::optional<T>& value)
+        {
+            value.has_value() ? static_cast<void>(emplace(value.value())) : reset();
+            return *this;
+        }
+
+        CopyOnWrite& operator=(std::optional<T>&& value)
+        {
+            value.has_value() ? static_cast<void>(emplace(std::move(value.value()))) : reset();
+            return *this;
+        }
+
+        [[nodiscard]] bool has_value() const noexcept { return m_engaged; }
+        explicit operator bool() const noexcept { return m_engaged; }
+
+        [[nodiscard]] const T& value() const
+        {
+            if (!m_engaged)
+            {
+                throw std::bad_optional_access();
+            }
+            return *m_value;
+        }
+
+        const T& operator*() const noexcept { return *m_value; }
+        const T* operator->() const noexcept { return m_value.get(); }
+
+        /**
+        * The value for writing in place, copied first if the instance is shared. */
+        [[nodiscard]] T& mutate()
+        {
+            if (!m_engaged)
+            {
+                throw std::bad_optional_access();
+            }
+            if (isShared())
+            {
+                m_value = std::make_shared<T>(std::as_const(*m_value));
+            }
+            return *m_value;
+        }
+
+        /**
+        * Assigns T{args...} into the kept instance if there's one that isn't shared, or into a new one otherwise.
+        * The value is always move-assigned into a default constructed T, so that with OPENTRACKIO_PMR the shared
+        * instance never refers to the memory resource of the sample it was parsed into. */
+        template<typename... Args>
+        T& emplace(Args&&... args)
+        {
+            if (m_value == nullptr || isShared())
+            {
+                m_value = std::make_shared<T>();
+            }
+
+            if constexpr (sizeof...(Args) == 1 && (std::is_same_v<std::remove_cvref_t<Args>, T> && ...))
+            {
+                *m_value = (std::forward<Args>(args), ...);
+            }
+            else
+            {
+                *m_value = T(std::forward<Args>(args)...);
+            }
+            m_engaged = true;
+            return *m_value;
+        }
+
+        /**
+        * Sets the handle and returns its value for writing in place. Unlike emplace() the instance kept when the
+        * handle was unset is returned as it was left, so that its storage can be refilled, and only a handle that had
+        * none gets a default constructed T. */
+        T& reuse()
+        {
+            if (m_value == nullptr || isShared())
+            {
+                m_value = std::make_shared<T>();
+            }
+            m_engaged = true;
+            return *m_value;
+        }
+
+        void reset() noexcept
+        {
+            if (isShared())
+            {
+                m_value = nullptr;
+            }
+            m_engaged = false;
+        }
+
+        /**
+        * Whether other handles hold the same instance, in which case the next write through this one copies it. */
+        [[nodiscard]] bool isShared() const noexcept
+        {
+            if (m_value == nullptr)
+            {
+                return false;
+            }
+            if (m_value.use_count() > 1)
+            {
+                return true;
+            }
+
+            // Pairs with the release of the last other handle, whose reads must happen before our writes.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            return false;
+        }
+
+        friend bool operator==(const CopyOnWrite& lhs, std::nullopt_t) noexcept { return !lhs.m_engaged; }
+
+        friend bool operator==(const CopyOnWrite& lhs, const CopyOnWrite& rhs) requires std::equality_comparable<T>
+        {
+            if (lhs.m_engaged != rhs.m_engaged)
+            {
+                return false;
+            }
+            return !lhs.m_engaged || lhs.m_value == rhs.m_value || *lhs.m_value == *rhs.m_value;
+        }
+
+        friend bool operator==(const CopyOnWrite& lhs, const T& rhs) requires std::equality_comparable<T>
+        {
+            return lhs.m_engaged && *lhs.m_value == rhs;
+        }
+
+    private:
+        std::shared_ptr<T> m_value{};
+        bool m_engaged = false;
+    };
+
     struct Rational
     {
         uint32_t numerator = 0;
@@ -33,25 +525,29 @@ namespace opentrackio::opentrackiotypes
         {
         };
 
-        static std::optional<Rational> parse(nlohmann::json& json,
+        static std::optional<Rational> parse(const nlohmann::json& json,
                                              std::string_view fieldStr,
-                                             std::vector<std::string>& errors)
+                                             ParseErrors& errors,
+                                             VisitedFields& visited)
         {
-            const auto& rationalJson = json[fieldStr];
+            const auto it = json.find(fieldStr);
+            if (it != json.end())
+            {
+                visited.markConsumed(*it);
+            }
 
             uint32_t num;
             uint32_t denom;
-            if (!rationalJson.contains("num") || !rationalJson.contains("denom"))
+            if (it == json.end() || !it->contains("num") || !it->contains("denom"))
             {
-                errors.emplace_back(std::format("Key: {} is missing numerator or denominator field.", fieldStr));
+                errors.add(ErrorCode::KEY_MISSING_RATIONAL_FIELDS, fieldStr);
                 return std::nullopt;
             }
 
+            const auto& rationalJson = *it;
             if (!rationalJson.at("num").is_number_unsigned() || !rationalJson.at("denom").is_number_unsigned())
             {
-                errors.
-                        emplace_back(std::format("Key: {} numerator or denominator field isn't of type: unsigned integer",
-                                                 fieldStr));
+                errors.add(ErrorCode::KEY_RATIONAL_NOT_UNSIGNED, fieldStr);
                 return std::nullopt;
             }
 
@@ -76,16 +572,18 @@ namespace opentrackio::opentrackiotypes
         {
         };
 
-        static std::optional<Vector3> parse(nlohmann::json& json,
+        static std::optional<Vector3> parse(const nlohmann::json& json,
                                             std::string_view fieldStr,
-                                            std::vector<std::string>& errors)
+                                            ParseErrors& errors,
+                                            VisitedFields& visited)
         {
-            const auto& vecJson = json[fieldStr];
+            const auto& vecJson = json.at(fieldStr);
+            visited.markConsumed(vecJson);
 
             Vector3 vec{};
             if (!vecJson.contains("x") || !vecJson.contains("y") || !vecJson.contains("z"))
             {
-                errors.emplace_back(std::format("Key: {} Vector3 is missing required fields", fieldStr));
+                errors.add(ErrorCode::KEY_MISSING_FIELDS, fieldStr, "Vector3");
                 return std::nullopt;
             }
 
@@ -93,7 +591,7 @@ namespace opentrackio::opentrackiotypes
                 !vecJson.at("y").is_number() ||
                 !vecJson.at("z").is_number())
             {
-                errors.emplace_back(std::format("Key: {} Vector3 fields aren't of type: double", fieldStr));
+                errors.add(ErrorCode::KEY_FIELDS_NOT_DOUBLE, fieldStr, "Vector3");
                 return std::nullopt;
             }
 
@@ -119,16 +617,18 @@ namespace opentrackio::opentrackiotypes
         {
         };
 
-        static std::optional<Rotation> parse(nlohmann::json& json,
+        static std::optional<Rotation> parse(const nlohmann::json& json,
                                              std::string_view fieldStr,
-                                             std::vector<std::string>& errors)
+                                             ParseErrors& errors,
+                                             VisitedFields& visited)
         {
-            const auto& rotJson = json[fieldStr];
+            const auto& rotJson = json.at(fieldStr);
+            visited.markConsumed(rotJson);
 
             Rotation rot{};
             if (!rotJson.contains("pan") || !rotJson.contains("tilt") || !rotJson.contains("roll"))
             {
-                errors.emplace_back(std::format("Key: {} Rotation is missing required fields", fieldStr));
+                errors.add(ErrorCode::KEY_MISSING_FIELDS, fieldStr, "Rotation");
                 return std::nullopt;
             }
 
@@ -136,7 +636,7 @@ namespace opentrackio::opentrackiotypes
                 !rotJson.at("tilt").is_number() ||
                 !rotJson.at("roll").is_number())
             {
-                errors.emplace_back(std::format("Key: {} Rotation fields aren't of type: double", fieldStr));
+                errors.add(ErrorCode::KEY_FIELDS_NOT_DOUBLE, fieldStr, "Rotation");
                 return std::nullopt;
             }
 
@@ -176,35 +676,36 @@ namespace opentrackio::opentrackiotypes
         {
         };
 
-        static std::optional<Timecode> parse(nlohmann::json& json,
+        static std::optional<Timecode> parse(const nlohmann::json& json,
                                              std::string_view fieldStr,
-                                             std::vector<std::string>& errors)
+                                             ParseErrors& errors,
+                                             VisitedFields& visited)
         {
-            auto& tcJson = json[fieldStr];
+            const auto& tcJson = json.at(fieldStr);
 
             std::optional<uint8_t> hours = std::nullopt;
             std::optional<uint8_t> minutes = std::nullopt;
             std::optional<uint8_t> seconds = std::nullopt;
             std::optional<uint8_t> frames = std::nullopt;
-            const std::optional<Rational> frameRate = Rational::parse(tcJson, "frameRate", errors);
+            const std::optional<Rational> frameRate = Rational::parse(tcJson, "frameRate", errors, visited);
 
-            OpenTrackIOHelpers::assignField(tcJson, "hours", hours, "uint8", errors);
-            OpenTrackIOHelpers::assignField(tcJson, "minutes", minutes, "uint8", errors);
-            OpenTrackIOHelpers::assignField(tcJson, "seconds", seconds, "uint8", errors);
-            OpenTrackIOHelpers::assignField(tcJson, "frames", frames, "uint8", errors);
+            OpenTrackIOHelpers::assignField(tcJson, "hours", hours, "uint8", errors, visited);
+            OpenTrackIOHelpers::assignField(tcJson, "minutes", minutes, "uint8", errors, visited);
+            OpenTrackIOHelpers::assignField(tcJson, "seconds", seconds, "uint8", errors, visited);
+            OpenTrackIOHelpers::assignField(tcJson, "frames", frames, "uint8", errors, visited);
 
             if (!hours.has_value() || !minutes.has_value() || !seconds.has_value() || !frames.has_value() || !frameRate.
                 has_value())
             {
-                errors.emplace_back("field: timing/timecode is missing required fields");
+                errors.add(ErrorCode::MISSING_FIELDS, "timing/timecode");
                 return std::nullopt;
             }
 
             std::optional<uint32_t> subFrame;
-            OpenTrackIOHelpers::assignField(tcJson, "subFrame", subFrame, "uint32_t", errors);
+            OpenTrackIOHelpers::assignField(tcJson, "subFrame", subFrame, "uint32_t", errors, visited);
 
             std::optional<bool> dropFrame;
-            OpenTrackIOHelpers::assignField(tcJson, "dropFrame", dropFrame, "boolean", errors);
+            OpenTrackIOHelpers::assignField(tcJson, "dropFrame", dropFrame, "boolean", errors, visited);
 
             return Timecode{
                 hours.value(),
@@ -230,21 +731,22 @@ namespace opentrackio::opentrackiotypes
         {
         };
 
-        static std::optional<Timestamp> parse(nlohmann::json& json,
+        static std::optional<Timestamp> parse(const nlohmann::json& json,
                                               std::string_view fieldStr,
-                                              std::vector<std::string>& errors)
+                                              ParseErrors& errors,
+                                              VisitedFields& visited)
         {
-            auto& tsJson = json[fieldStr];
+            const auto& tsJson = json.at(fieldStr);
 
             std::optional<uint64_t> seconds = std::nullopt;
             std::optional<uint32_t> nanoseconds = std::nullopt;
 
-            OpenTrackIOHelpers::assignField(tsJson, "seconds", seconds, "uint64", errors);
-            OpenTrackIOHelpers::assignField(tsJson, "nanoseconds", nanoseconds, "uint32", errors);
+            OpenTrackIOHelpers::assignField(tsJson, "seconds", seconds, "uint64", errors, visited);
+            OpenTrackIOHelpers::assignField(tsJson, "nanoseconds", nanoseconds, "uint32", errors, visited);
 
             if (!seconds.has_value() || !nanoseconds.has_value())
             {
-                errors.emplace_back("field: timestamp is missing required fields");
+                errors.add(ErrorCode::MISSING_FIELDS, "timestamp");
                 return std::nullopt;
             }
 
@@ -266,21 +768,22 @@ namespace opentrackio::opentrackiotypes
         {
         };
 
-        static std::optional<Dimensions<T> > parse(nlohmann::json& json,
+        static std::optional<Dimensions<T> > parse(const nlohmann::json& json,
                                                    std::string_view fieldStr,
-                                                   std::vector<std::string>& errors)
+                                                   ParseErrors& errors,
+                                                   VisitedFields& visited)
         {
-            auto& dimJson = json[fieldStr];
+            const auto& dimJson = json.at(fieldStr);
 
             std::optional<T> width = std::nullopt;
             std::optional<T> height = std::nullopt;
 
-            OpenTrackIOHelpers::assignField(dimJson, "width", width, "double", errors);
-            OpenTrackIOHelpers::assignField(dimJson, "height", height, "double", errors);
+            OpenTrackIOHelpers::assignField(dimJson, "width", width, "double", errors, visited);
+            OpenTrackIOHelpers::assignField(dimJson, "height", height, "double", errors, visited);
 
             if (!width.has_value() || !height.has_value())
             {
-                errors.emplace_back(std::format("Key: {} dimensions is missing required fields", fieldStr));
+                errors.add(ErrorCode::KEY_MISSING_FIELDS, fieldStr, "dimensions");
                 return std::nullopt;
             }
 
@@ -288,12 +791,112 @@ namespace opentrackio::opentrackiotypes
         }
     };
 
+    /**
+    * 128-bit UUID held as its 16 bytes in the order they're written, as used by the sampleId, sourceId and
+    * relatedSampleIds properties. It's a trivially copyable value that compares, orders and hashes by its bytes,
+    * so the order matches that of the URN strings.
+    * Converts from and to the URN form: ^urn:uuid:[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}$ */
+    struct Uuid
+    {
+        static constexpr std::string_view URN_PREFIX = "urn:uuid:";
+        static constexpr std::size_t URN_LENGTH = 45;
+
+        std::array<uint8_t, 16> bytes{};
+
+        /**
+        * Returns std::nullopt unless urn matches the pattern exactly, upper case hex digits included. */
+        static constexpr std::optional<Uuid> fromUrn(std::string_view urn)
+        {
+            if (urn.size() != URN_LENGTH || !urn.starts_with(URN_PREFIX))
+            {
+                return std::nullopt;
+            }
+
+            Uuid uuid{};
+            std::size_t position = URN_PREFIX.size();
+            for (std::size_t i = 0; i < uuid.bytes.size(); ++i)
+            {
+                if (isHyphenBefore(i) && urn[position++] != '-')
+                {
+                    return std::nullopt;
+                }
+
+                const uint8_t high = HEX_VALUES[static_cast<uint8_t>(urn[position])];
+                const uint8_t low = HEX_VALUES[static_cast<uint8_t>(urn[position + 1])];
+                if ((high | low) == INVALID_HEX)
+                {
+                    return std::nullopt;
+                }
+                uuid.bytes[i] = static_cast<uint8_t>((high << 4) | low);
+                position += 2;
+            }
+            return uuid;
+        }
+
+        /**
+        * Writes the URN form into out without allocating. */
+        constexpr void toUrn(std::span<char, URN_LENGTH> out) const
+        {
+            constexpr std::string_view hexDigits = "0123456789abcdef";
+
+            std::copy(URN_PREFIX.begin(), URN_PREFIX.end(), out.begin());
+            std::size_t position = URN_PREFIX.size();
+            for (std::size_t i = 0; i < bytes.size(); ++i)
+            {
+                if (isHyphenBefore(i))
+                {
+                    out[position++] = '-';
+                }
+                out[position++] = hexDigits[bytes[i] >> 4];
+                out[position++] = hexDigits[bytes[i] & 0xF];
+            }
+        }
+
+        [[nodiscard]] std::string toUrn() const
+        {
+            std::string urn(URN_LENGTH, '\0');
+            toUrn(std::span<char, URN_LENGTH>{urn.data(), URN_LENGTH});
+            return urn;
+        }
+
+        constexpr auto operator<=>(const Uuid&) const = default;
+
+    private:
+        /**
+        * Bit pattern that only a lookup of an invalid character can produce when two lookups are ORed. */
+        static constexpr uint8_t INVALID_HEX = 0xFF;
+
+        static constexpr std::array<uint8_t, 256> HEX_VALUES = []
+        {
+            std::array<uint8_t, 256> values{};
+            values.fill(INVALID_HEX);
+            for (uint8_t i = 0; i < 10; ++i)
+            {
+                values['0' + i] = i;
+            }
+            for (uint8_t i = 0; i < 6; ++i)
+            {
+                values['a' + i] = static_cast<uint8_t>(10 + i);
+            }
+            return values;
+        }();
+
+        /**
+        * The hyphens of the 8-4-4-4-12 digit groups come before bytes 4, 6, 8 and 10. */
+        static constexpr bool isHyphenBefore(std::size_t byte)
+        {
+            return byte == 4 || byte == 6 || byte == 8 || byte == 10;
+        }
+    };
+
+    static_assert(sizeof(Uuid) == 16 && std::is_trivially_copyable_v<Uuid>);
+
     struct Transform
     {
         Vector3 translation{};
         Rotation rotation{};
         std::optional<Vector3> scale = std::nullopt;
-        std::optional<std::string> id = std::nullopt;
+        std::optional<String> id = std::nullopt;
 
         Transform() = default;
 
@@ -302,7 +905,7 @@ namespace opentrackio::opentrackiotypes
         {
         };
 
-        static std::optional<Transform> parse(nlohmann::json& json, std::vector<std::string>& errors)
+        static std::optional<Transform> parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited)
         {
             Transform tf{};
 
@@ -315,11 +918,8 @@ namespace opentrackio::opentrackiotypes
                 return std::nullopt;
             }
 
-            translation = Vector3::parse(json, "translation", errors);
-            json.erase("translation");
-
-            rotation = Rotation::parse(json, "rotation", errors);
-            json.erase("rotation");
+            translation = Vector3::parse(json, "translation", errors, visited);
+            rotation = Rotation::parse(json, "rotation", errors, visited);
 
             if (!translation.has_value() || !rotation.has_value())
             {
@@ -332,13 +932,27 @@ namespace opentrackio::opentrackiotypes
             // Non-required fields ------
             if (json.contains("scale"))
             {
-                tf.scale = Vector3::parse(json, "scale", errors);
-                json.erase("scale");
+                tf.scale = Vector3::parse(json, "scale", errors, visited);
             }
 
-            OpenTrackIOHelpers::assignField(json, "id", tf.id, "string", errors);
+            OpenTrackIOHelpers::assignField(json, "id", tf.id, "string", errors, visited);
 
             return tf;
         }
     };
 } // namespace opentrackio::opentrackiotypes
+
+template<>
+struct std::hash<opentrackio::opentrackiotypes::Uuid>
+{
+    std::size_t operator()(const opentrackio::opentrackiotypes::Uuid& uuid) const noexcept
+    {
+        uint64_t high = 0;
+        uint64_t low = 0;
+        std::memcpy(&high, uuid.bytes.data(), sizeof(high));
+        std::memcpy(&low, uuid.bytes.data() + sizeof(high), sizeof(low));
+
+        // Version 1 UUIDs only vary in some of their bytes, so mix both halves rather than taking either one.
+        return static_cast<std::size_t>(high ^ (low * 0x9E3779B97F4A7C15ull) ^ (low >> 29));
+    }
+};
@@ -0,0 +1,117 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <system_error>
+#include <linux/io_uring.h>
+
+namespace opentrackio
+{
+    /**
+    * The little of io_uring the transport's IO_URING backend needs, over the raw system calls: a ring whose
+    * submission and completion queues are mapped into the process, and optionally a ring of provided buffers that
+    * multishot receives pick from. Completions are read straight from the mapped queue, so a busy ring is drained
+    * without entering the kernel at all. Not thread safe.
+    *
+    * Needs the uAPI headers of Linux 6.0 or later, the build leaves it out and defines no OPENTRACKIO_IO_URING
+    * where they are older. */
+    class IoUring
+    {
+    public:
+        IoUring() = default;
+        ~IoUring();
+
+        IoUring(const IoUring&) = delete;
+        IoUring& operator=(const IoUring&) = delete;
+
+        /**
+        * Sets up a ring with room for entries submissions and completionEntries completions, both rounded up to
+        * powers of 2 by the kernel. Returns false, see error(), if io_uring is missing, disabled, or too old to wait
+        * with a timeout. */
+        bool open(unsigned int entries, unsigned int completionEntries);
+        void close();
+        [[nodiscard]] bool isOpen() const { return m_fd >= 0; }
+
+        /**
+        * The next submission queue entry, zeroed, or nullptr if the queue is full. */
+        io_uring_sqe* getSqe();
+
+        /**
+        * Submits the entries got and not yet submitted and waits for at least waitFor completions, for at most
+        * timeout if it is positive. Doesn't enter the kernel if there is nothing to submit or wait for. Returns the
+        * number submitted, or -errno, -ETIME if the wait timed out. */
+        int submit(unsigned int waitFor = 0, std::chrono::milliseconds timeout = {});
+
+        /**
+        * Completions are read in place: the ready() oldest are completion(0) to completion(ready() - 1), until
+        * consume() hands their slots back to the kernel. */
+        [[nodiscard]] unsigned int ready() const;
+        [[nodiscard]] const io_uring_cqe& completion(unsigned int index) const;
+        void consume(unsigned int count);
+
+        /**
+        * Registers count buffers of size bytes each, carved out of storage, as the provided buffer group group and
+        * hands them all to the kernel. count must be a power of 2 no greater than 32768. */
+        bool registerBufferRing(uint16_t group, std::span<uint8_t> storage, std::size_t size, uint16_t count);
+
+        [[nodiscard]] uint8_t* buffer(uint16_t id) const { return m_buffers + id * m_bufferSize; }
+
+        /**
+        * Hands buffer id back to the kernel. Takes effect at the next commitBuffers(), so a batch of them is
+        * published with one store. */
+        void recycleBuffer(uint16_t id);
+        void commitBuffers();
+
+        /**
+        * io_uring_enter() calls made. */
+        [[nodiscard]] uint64_t enterCalls() const { return m_enterCalls; }
+        [[nodiscard]] std::error_code error() const { return m_error; }
+
+    private:
+        bool fail(int error);
+
+        int m_fd = -1;
+        std::error_code m_error{};
+        uint64_t m_enterCalls = 0;
+
+        void* m_rings = nullptr;
+        std::size_t m_ringsSize = 0;
+        io_uring_sqe* m_sqes = nullptr;
+        std::size_t m_sqesSize = 0;
+
+        unsigned int* m_sqHead = nullptr;
+        unsigned int* m_sqTail = nullptr;
+        unsigned int m_sqMask = 0;
+        unsigned int m_sqEntries = 0;
+
+        // Tail of the entries got, published to m_sqTail by submit().
+        unsigned int m_sqPending = 0;
+
+        unsigned int* m_cqHead = nullptr;
+        unsigned int* m_cqTail = nullptr;
+        unsigned int m_cqMask = 0;
+        io_uring_cqe* m_cqes = nullptr;
+
+        // Entries of the io_uring_buf_ring, whose bufs member C++ lays out 8 bytes in rather than at the start.
+        io_uring_buf* m_bufferRing = nullptr;
+        std::size_t m_bufferRingSize = 0;
+        uint16_t m_bufferMask = 0;
+        uint16_t m_bufferTail = 0;
+        uint8_t* m_buffers = nullptr;
+        std::size_t m_bufferSize = 0;
+    };
+} // namespace opentrackio
@@ -0,0 +1,121 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "opentrackio-cpp/OpenTrackIOArena.h"
+#include <algorithm>
+#include <new>
+
+namespace opentrackio
+{
+    namespace
+    {
+        constexpr std::size_t ALIGNMENT = alignof(std::max_align_t);
+
+        thread_local JsonArena* t_currentArena = nullptr;
+
+        /**
+        * Precedes every allocation made by ArenaAllocator, padded so the allocation after it stays aligned. */
+        struct alignas(std::max_align_t) AllocationHeader
+        {
+            bool fromArena = false;
+        };
+
+        std::size_t alignUp(std::size_t bytes)
+        {
+            return (bytes + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+        }
+    } // namespace
+
+    JsonArena::JsonArena(std::size_t blockSize) : m_blockSize{std::max(alignUp(blockSize), ALIGNMENT)}
+    {
+    }
+
+    JsonArena::~JsonArena()
+    {
+        for (const auto& block : m_blocks)
+        {
+            ::operator delete(block.data);
+        }
+    }
+
+    void* JsonArena::allocate(std::size_t bytes)
+    {
+        bytes = alignUp(std::max<std::size_t>(bytes, 1));
+
+        while (m_block < m_blocks.size() && m_offset + bytes > m_blocks[m_block].size)
+        {
+            // Whatever is left of a full block is skipped until the next reset().
+            ++m_block;
+            m_offset = 0;
+        }
+
+        if (m_block == m_blocks.size())
+        {
+            const std::size_t size = std::max(bytes, m_blockSize);
+            m_blocks.push_back({static_cast<std::byte*>(::operator new(size)), size});
+            ++m_stats.blocks;
+            m_stats.bytesReserved += size;
+            m_offset = 0;
+        }
+
+        void* p = m_blocks[m_block].data + m_offset;
+        m_offset += bytes;
+        m_used += bytes;
+
+        ++m_stats.allocations;
+        m_stats.bytesAllocated += bytes;
+        m_stats.peakBytesUsed = std::max(m_stats.peakBytesUsed, m_used);
+        return p;
+    }
+
+    void JsonArena::reset()
+    {
+        m_block = 0;
+        m_offset = 0;
+        m_used = 0;
+        ++m_stats.resets;
+    }
+
+    JsonArena::Scope::Scope(JsonArena& arena) : m_previous{t_currentArena}
+    {
+        t_currentArena = &arena;
+    }
+
+    JsonArena::Scope::~Scope()
+    {
+        t_currentArena = m_previous;
+    }
+
+    JsonArena* JsonArena::current()
+    {
+        return t_currentArena;
+    }
+
+    void* JsonArena::acquire(std::size_t bytes)
+    {
+        const std::size_t total = sizeof(AllocationHeader) + bytes;
+        JsonArena* arena = t_currentArena;
+        void* memory = arena != nullptr ? arena->allocate(total) : ::operator new(total);
+        auto* header = new (memory) AllocationHeader{arena != nullptr};
+        return header + 1;
+    }
+
+    void JsonArena::release(void* p) noexcept
+    {
+        auto* header = static_cast<AllocationHeader*>(p) - 1;
+        if (!header->fromArena)
+        {
+            ::operator delete(header);
+        }
+    }
+} // namespace opentrackio
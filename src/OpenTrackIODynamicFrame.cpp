@@ -0,0 +1,387 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "opentrackio-cpp/OpenTrackIODynamicFrame.h"
+#include <algorithm>
+#include <optional>
+
+namespace opentrackio
+{
+    namespace
+    {
+        using opentrackioproperties::Lens;
+
+        constexpr FrameFields TIMING_FIELDS = FrameFields::SAMPLE_TIMESTAMP | FrameFields::RECORDED_TIMESTAMP |
+                                              FrameFields::SEQUENCE_NUMBER;
+
+        constexpr FrameFields LENS_FIELDS = FrameFields::ENCODER_FOCUS | FrameFields::ENCODER_IRIS |
+                                            FrameFields::ENCODER_ZOOM | FrameFields::RAW_ENCODER_FOCUS |
+                                            FrameFields::RAW_ENCODER_IRIS | FrameFields::RAW_ENCODER_ZOOM |
+                                            FrameFields::PINHOLE_FOCAL_LENGTH | FrameFields::FOCUS_DISTANCE |
+                                            FrameFields::F_STOP | FrameFields::T_STOP |
+                                            FrameFields::ENTRANCE_PUPIL_OFFSET | FrameFields::DISTORTION_OFFSET |
+                                            FrameFields::PROJECTION_OFFSET | FrameFields::DISTORTION;
+
+        bool hasAny(const DynamicFrame& frame, FrameFields fields)
+        {
+            return (frame.present & fields) != FrameFields::NONE;
+        }
+
+        template<typename T>
+        void copyIfSet(DynamicFrame& frame, FrameFields field, T& out, const std::optional<T>& value)
+        {
+            if (value.has_value())
+            {
+                out = value.value();
+                frame.present = frame.present | field;
+            }
+        }
+
+        template<typename T>
+        std::optional<T> valueIfPresent(const DynamicFrame& frame, FrameFields field, const T& value)
+        {
+            if (!frame.has(field))
+            {
+                return std::nullopt;
+            }
+            return value;
+        }
+
+        bool copyCoefficients(DynamicFrame::Coefficients& out, const Lens::Coefficients& coefficients)
+        {
+            if (coefficients.size() > DynamicFrame::MAX_COEFFICIENTS)
+            {
+                return false;
+            }
+
+            std::copy(coefficients.begin(), coefficients.end(), out.values.begin());
+            out.count = static_cast<uint8_t>(coefficients.size());
+            return true;
+        }
+
+        bool copyString(DynamicFrame::FixedString& out, const std::optional<opentrackiotypes::String>& value)
+        {
+            return !value.has_value() || out.assign(value.value());
+        }
+
+        /**
+        * Assigns in place so that a string the property already holds is refilled rather than reallocated. */
+        void assignString(std::optional<opentrackiotypes::String>& out, const DynamicFrame::FixedString& value)
+        {
+            if (!value.present)
+            {
+                out.reset();
+                return;
+            }
+
+            if (!out.has_value())
+            {
+                out.emplace();
+            }
+            out->assign(value.view());
+        }
+
+        bool copyLens(DynamicFrame& frame, const Lens& lens)
+        {
+            if (lens.encoders.has_value())
+            {
+                copyIfSet(frame, FrameFields::ENCODER_FOCUS, frame.encoders.focus, lens.encoders->focus);
+                copyIfSet(frame, FrameFields::ENCODER_IRIS, frame.encoders.iris, lens.encoders->iris);
+                copyIfSet(frame, FrameFields::ENCODER_ZOOM, frame.encoders.zoom, lens.encoders->zoom);
+            }
+
+            if (lens.rawEncoders.has_value())
+            {
+                copyIfSet(frame, FrameFields::RAW_ENCODER_FOCUS, frame.rawEncoders.focus, lens.rawEncoders->focus);
+                copyIfSet(frame, FrameFields::RAW_ENCODER_IRIS, frame.rawEncoders.iris, lens.rawEncoders->iris);
+                copyIfSet(frame, FrameFields::RAW_ENCODER_ZOOM, frame.rawEncoders.zoom, lens.rawEncoders->zoom);
+            }
+
+            copyIfSet(frame, FrameFields::PINHOLE_FOCAL_LENGTH, frame.pinholeFocalLength, lens.pinholeFocalLength);
+            copyIfSet(frame, FrameFields::FOCUS_DISTANCE, frame.focusDistance, lens.focusDistance);
+            copyIfSet(frame, FrameFields::F_STOP, frame.fStop, lens.fStop);
+            copyIfSet(frame, FrameFields::T_STOP, frame.tStop, lens.tStop);
+            copyIfSet(frame, FrameFields::ENTRANCE_PUPIL_OFFSET, frame.entrancePupilOffset, lens.entrancePupilOffset);
+            copyIfSet(frame, FrameFields::DISTORTION_OFFSET, frame.distortionOffset, lens.distortionOffset);
+            copyIfSet(frame, FrameFields::PROJECTION_OFFSET, frame.projectionOffset, lens.projectionOffset);
+
+            if (!lens.distortion.has_value())
+            {
+                return true;
+            }
+
+            if (lens.distortion->size() > DynamicFrame::MAX_DISTORTIONS)
+            {
+                return false;
+            }
+
+            for (const auto& distortion : lens.distortion.value())
+            {
+                auto& out = frame.distortions[frame.distortionCount++];
+                if (!copyCoefficients(out.radial, distortion.radial) || !copyString(out.model, distortion.model))
+                {
+                    return false;
+                }
+
+                if (distortion.tangential.has_value())
+                {
+                    if (!copyCoefficients(out.tangential, distortion.tangential.value()))
+                    {
+                        return false;
+                    }
+                    out.hasTangential = true;
+                }
+
+                if (distortion.overscan.has_value())
+                {
+                    out.overscan = distortion.overscan.value();
+                    out.hasOverscan = true;
+                }
+            }
+            frame.present = frame.present | FrameFields::DISTORTION;
+            return true;
+        }
+
+        bool copyTransforms(DynamicFrame& frame, const opentrackioproperties::Transforms& transforms)
+        {
+            if (transforms.transforms.size() > DynamicFrame::MAX_TRANSFORMS)
+            {
+                return false;
+            }
+
+            for (const auto& transform : transforms.transforms)
+            {
+                auto& out = frame.transforms[frame.transformCount++];
+                out.translation = transform.translation;
+                out.rotation = transform.rotation;
+                if (transform.scale.has_value())
+                {
+                    out.scale = transform.scale.value();
+                    out.hasScale = true;
+                }
+
+                if (!copyString(out.id, transform.id))
+                {
+                    return false;
+                }
+            }
+            frame.present = frame.present | FrameFields::TRANSFORMS;
+            return true;
+        }
+
+        void applyLens(const DynamicFrame& frame, Lens& lens)
+        {
+            if (hasAny(frame, FrameFields::ENCODER_FOCUS | FrameFields::ENCODER_IRIS | FrameFields::ENCODER_ZOOM))
+            {
+                lens.encoders = Lens::Encoders{
+                    valueIfPresent(frame, FrameFields::ENCODER_FOCUS, frame.encoders.focus),
+                    valueIfPresent(frame, FrameFields::ENCODER_IRIS, frame.encoders.iris),
+                    valueIfPresent(frame, FrameFields::ENCODER_ZOOM, frame.encoders.zoom)
+                };
+            }
+            else
+            {
+                lens.encoders.reset();
+            }
+
+            if (hasAny(frame, FrameFields::RAW_ENCODER_FOCUS | FrameFields::RAW_ENCODER_IRIS | FrameFields::RAW_ENCODER_ZOOM))
+            {
+                lens.rawEncoders = Lens::RawEncoders{
+                    valueIfPresent(frame, FrameFields::RAW_ENCODER_FOCUS, frame.rawEncoders.focus),
+                    valueIfPresent(frame, FrameFields::RAW_ENCODER_IRIS, frame.rawEncoders.iris),
+                    valueIfPresent(frame, FrameFields::RAW_ENCODER_ZOOM, frame.rawEncoders.zoom)
+                };
+            }
+            else
+            {
+                lens.rawEncoders.reset();
+            }
+
+            lens.pinholeFocalLength = valueIfPresent(frame, FrameFields::PINHOLE_FOCAL_LENGTH, frame.pinholeFocalLength);
+            lens.focusDistance = valueIfPresent(frame, FrameFields::FOCUS_DISTANCE, frame.focusDistance);
+            lens.fStop = valueIfPresent(frame, FrameFields::F_STOP, frame.fStop);
+            lens.tStop = valueIfPresent(frame, FrameFields::T_STOP, frame.tStop);
+            lens.entrancePupilOffset = valueIfPresent(frame, FrameFields::ENTRANCE_PUPIL_OFFSET, frame.entrancePupilOffset);
+            lens.distortionOffset = valueIfPresent(frame, FrameFields::DISTORTION_OFFSET, frame.distortionOffset);
+            lens.projectionOffset = valueIfPresent(frame, FrameFields::PROJECTION_OFFSET, frame.projectionOffset);
+
+            if (!frame.has(FrameFields::DISTORTION))
+            {
+                lens.distortion.reset();
+                return;
+            }
+
+            if (!lens.distortion.has_value())
+            {
+                lens.distortion.emplace();
+            }
+
+            auto& distortions = lens.distortion.value();
+            distortions.resize(frame.distortionCount);
+            for (std::size_t i = 0; i < frame.distortionCount; ++i)
+            {
+                const auto& from = frame.distortions[i];
+                auto& out = distortions[i];
+
+                const auto radial = from.radial.view();
+                out.radial.assign(radial.begin(), radial.end());
+
+                if (from.hasTangential)
+                {
+                    if (!out.tangential.has_value())
+                    {
+                        out.tangential.emplace();
+                    }
+                    const auto tangential = from.tangential.view();
+                    out.tangential->assign(tangential.begin(), tangential.end());
+                }
+                else
+                {
+                    out.tangential.reset();
+                }
+
+                out.overscan = from.hasOverscan ? std::optional<double>{from.overscan} : std::nullopt;
+                assignString(out.model, from.model);
+            }
+        }
+    } // namespace
+
+    bool DynamicFrame::FixedString::assign(std::string_view value)
+    {
+        if (value.size() > MAX_STRING_LENGTH)
+        {
+            *this = FixedString{};
+            return false;
+        }
+
+        std::copy(value.begin(), value.end(), data.begin());
+        data[value.size()] = '\0';
+        length = static_cast<uint8_t>(value.size());
+        present = true;
+        return true;
+    }
+
+    bool DynamicFrame::assign(const OpenTrackIOSample& sample)
+    {
+        clear();
+
+        if (sample.sampleId.has_value())
+        {
+            sampleId = sample.sampleId->id;
+            present = present | FrameFields::SAMPLE_ID;
+        }
+
+        if (sample.sourceId.has_value())
+        {
+            sourceId = sample.sourceId->id;
+            present = present | FrameFields::SOURCE_ID;
+        }
+
+        if (sample.sourceNumber.has_value())
+        {
+            sourceNumber = sample.sourceNumber->value;
+            present = present | FrameFields::SOURCE_NUMBER;
+        }
+
+        if (sample.timing.has_value())
+        {
+            copyIfSet(*this, FrameFields::SAMPLE_TIMESTAMP, sampleTimestamp, sample.timing->sampleTimestamp);
+            copyIfSet(*this, FrameFields::RECORDED_TIMESTAMP, recordedTimestamp, sample.timing->recordedTimestamp);
+            copyIfSet(*this, FrameFields::SEQUENCE_NUMBER, sequenceNumber, sample.timing->sequenceNumber);
+        }
+
+        if ((sample.lens.has_value() && !copyLens(*this, sample.lens.value())) ||
+            (sample.transforms.has_value() && !copyTransforms(*this, sample.transforms.value())))
+        {
+            clear();
+            return false;
+        }
+        return true;
+    }
+
+    void DynamicFrame::applyTo(OpenTrackIOSample& sample) const
+    {
+        sample.sampleId = valueIfPresent(*this, FrameFields::SAMPLE_ID, opentrackioproperties::SampleId{sampleId});
+        sample.sourceId = valueIfPresent(*this, FrameFields::SOURCE_ID, opentrackioproperties::SourceId{sourceId});
+        sample.sourceNumber = valueIfPresent(*this, FrameFields::SOURCE_NUMBER, opentrackioproperties::SourceNumber{sourceNumber});
+
+        if (hasAny(*this, TIMING_FIELDS) && !sample.timing.has_value())
+        {
+            sample.timing.emplace();
+        }
+
+        if (sample.timing.has_value())
+        {
+            sample.timing->sampleTimestamp = valueIfPresent(*this, FrameFields::SAMPLE_TIMESTAMP, sampleTimestamp);
+            sample.timing->recordedTimestamp = valueIfPresent(*this, FrameFields::RECORDED_TIMESTAMP, recordedTimestamp);
+            sample.timing->sequenceNumber = valueIfPresent(*this, FrameFields::SEQUENCE_NUMBER, sequenceNumber);
+        }
+
+        if (hasAny(*this, LENS_FIELDS) && !sample.lens.has_value())
+        {
+            sample.lens.emplace();
+        }
+
+        if (sample.lens.has_value())
+        {
+            applyLens(*this, sample.lens.value());
+        }
+
+        if (has(FrameFields::TRANSFORMS))
+        {
+            if (!sample.transforms.has_value())
+            {
+                sample.transforms.emplace();
+            }
+
+            auto& chain = sample.transforms->transforms;
+            chain.resize(transformCount);
+            for (std::size_t i = 0; i < transformCount; ++i)
+            {
+                const Transform& from = transforms[i];
+                auto& out = chain[i];
+                out.translation = from.translation;
+                out.rotation = from.rotation;
+                out.scale = from.hasScale ? std::optional<opentrackiotypes::Vector3>{from.scale} : std::nullopt;
+                assignString(out.id, from.id);
+            }
+        }
+        else
+        {
+            sample.transforms.reset();
+        }
+
+        sample.markDirty(SampleFields::SAMPLE_ID | SampleFields::SOURCE_ID | SampleFields::SOURCE_NUMBER |
+                         SampleFields::TIMING | SampleFields::LENS | SampleFields::TRANSFORMS);
+    }
+
+    bool DynamicFrameDecoder::decode(std::span<const uint8_t> cbor, DynamicFrame& frame)
+    {
+        if (!m_sample.initialise(cbor, FIELDS))
+        {
+            frame.clear();
+            return false;
+        }
+        return frame.assign(m_sample);
+    }
+
+    bool DynamicFrameDecoder::decode(std::string_view json, DynamicFrame& frame)
+    {
+        if (!m_sample.initialise(json, FIELDS))
+        {
+            frame.clear();
+            return false;
+        }
+        return frame.assign(m_sample);
+    }
+} // namespace opentrackio
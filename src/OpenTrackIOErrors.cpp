@@ -0,0 +1,84 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "opentrackio-cpp/OpenTrackIOErrors.h"
+#include <format>
+
+namespace opentrackio
+{
+    std::string ParseError::message() const
+    {
+        switch (code)
+        {
+            case ErrorCode::NOT_OF_TYPE:
+                return std::format("field: {} isn't of type: {}", field, detail);
+            case ErrorCode::PATTERN_MISMATCH:
+                return std::format("field: {} doesn't match the required pattern", field);
+            case ErrorCode::ELEMENT_PATTERN_MISMATCH:
+                return std::format("field: {}/element doesn't match required pattern", field);
+            case ErrorCode::MISSING_FIELDS:
+                return std::format("field: {} is missing required fields", field);
+            case ErrorCode::MISSING_FIELD:
+                return std::format("field: {} is missing require field: {}", field, detail);
+            case ErrorCode::MISSING_NAMED_FIELD:
+                return std::format("field: {} is missing a require field: {}", field, detail);
+            case ErrorCode::REQUIRED_FIELD_MISSING:
+                return std::format("field: {} is required, however it is missing.", field);
+            case ErrorCode::REQUIRED_SUBFIELD_MISSING:
+                return std::format("field: {} is required, however it is missing a subfield(s).", field);
+            case ErrorCode::NOT_A_NUMBER:
+                return std::format("field: {} is not a number: {}", field, detail);
+            case ErrorCode::OUT_OF_RANGE:
+                return std::format("field: {} is outside the expected range {}.", field, detail);
+            case ErrorCode::INVALID_STRING:
+                return std::format("field: {} has an invalid string value.", field);
+            case ErrorCode::INVALID_ENUMERATION:
+                return std::format("field: {} isn't a valid enumeration", field);
+            case ErrorCode::WRONG_SIZE:
+                return std::format("field: {} isn't of size {}: {}", field, context, detail);
+            case ErrorCode::VERSION_MISMATCH:
+                return std::format("version: {} version mismatch", field);
+            case ErrorCode::NOT_AN_ARRAY:
+                return std::format("{} is not an array.", field);
+            case ErrorCode::KEY_MISSING_RATIONAL_FIELDS:
+                return std::format("Key: {} is missing numerator or denominator field.", field);
+            case ErrorCode::KEY_RATIONAL_NOT_UNSIGNED:
+                return std::format("Key: {} numerator or denominator field isn't of type: unsigned integer", field);
+            case ErrorCode::KEY_MISSING_FIELDS:
+                return std::format("Key: {} {} is missing required fields", field, detail);
+            case ErrorCode::KEY_FIELDS_NOT_DOUBLE:
+                return std::format("Key: {} {} fields aren't of type: double", field, detail);
+            case ErrorCode::JSON_PARSE_ERROR:
+                return "Unable to initialise OpenTrackIO sample, JSON parse error.";
+            case ErrorCode::CBOR_PARSE_ERROR:
+                return std::format("Unable to initialise OpenTrackIO sample, CBOR parse error: {} at byte {}", detail, context);
+            case ErrorCode::NO_PROPERTIES:
+                return "Sample contains no properties after parsing JSON.";
+        }
+        return {};
+    }
+
+    void ParseErrors::render(std::vector<std::string>& out) const
+    {
+        out.reserve(out.size() + m_size + (m_dropped > 0 ? 1 : 0));
+        for (const ParseError& error : errors())
+        {
+            out.emplace_back(error.message());
+        }
+
+        if (m_dropped > 0)
+        {
+            out.emplace_back(std::format("{} further errors weren't recorded.", m_dropped));
+        }
+    }
+} // namespace opentrackio
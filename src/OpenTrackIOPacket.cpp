@@ -0,0 +1,314 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "opentrackio-cpp/OpenTrackIOPacket.h"
+#include <algorithm>
+#include <cstring>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OPENTRACKIO_PACKET_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace opentrackio
+{
+    namespace
+    {
+        constexpr uint32_t MODULUS = 255;
+
+        // Bytes the scalar loop sums before reducing, few enough that the second sum stays below 2^32.
+        constexpr std::size_t SCALAR_CHUNK = 4096;
+
+        // Offset of the checksum in the header, which it covers up to.
+        constexpr std::size_t CHECKSUM_OFFSET = 14;
+
+        void updateScalar(uint32_t& sum1, uint32_t& sum2, const uint8_t* data, std::size_t size)
+        {
+            while (size > 0)
+            {
+                const std::size_t chunk = std::min(size, SCALAR_CHUNK);
+                for (std::size_t i = 0; i < chunk; ++i)
+                {
+                    sum1 += data[i];
+                    sum2 += sum1;
+                }
+                sum1 %= MODULUS;
+                sum2 %= MODULUS;
+                data += chunk;
+                size -= chunk;
+            }
+        }
+
+#ifdef OPENTRACKIO_PACKET_SSE2
+        constexpr std::size_t BLOCK_SIZE = 16;
+
+        // Blocks summed before reducing, the most for which the column sums stay below 2^15 for _mm_madd_epi16.
+        constexpr std::size_t MAX_BLOCKS = 128;
+
+        uint32_t horizontalSum(__m128i v)
+        {
+            v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2)));
+            v = _mm_add_epi32(v, _mm_shuffle_epi32(v, _MM_SHUFFLE(2, 3, 0, 1)));
+            return static_cast<uint32_t>(_mm_cvtsi128_si32(v));
+        }
+
+        /**
+        * Adds blocks of 16 bytes to the sums. Over n bytes b[i] the first sum grows by the sum of the bytes and the
+        * second by n times the first sum plus the sum of (n - i) * b[i]. With n = 16 * blocks and i = 16 * k + j for
+        * block k, n - i splits into 16 * (blocks - 1 - k), which sums as the first sum before each block, and
+        * 16 - j, which weights the column sums of byte j across the blocks. */
+        void updateBlocks(uint32_t& sum1, uint32_t& sum2, const uint8_t* data, std::size_t blocks)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i lowWeights = _mm_setr_epi16(16, 15, 14, 13, 12, 11, 10, 9);
+            const __m128i highWeights = _mm_setr_epi16(8, 7, 6, 5, 4, 3, 2, 1);
+
+            __m128i blockSums = zero;
+            __m128i prefixSums = zero;
+            __m128i lowColumns = zero;
+            __m128i highColumns = zero;
+
+            for (std::size_t k = 0; k < blocks; ++k)
+            {
+                const __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + k * BLOCK_SIZE));
+                prefixSums = _mm_add_epi32(prefixSums, blockSums);
+                blockSums = _mm_add_epi32(blockSums, _mm_sad_epu8(block, zero));
+                lowColumns = _mm_add_epi16(lowColumns, _mm_unpacklo_epi8(block, zero));
+                highColumns = _mm_add_epi16(highColumns, _mm_unpackhi_epi8(block, zero));
+            }
+
+            const __m128i weighted = _mm_add_epi32(_mm_madd_epi16(lowColumns, lowWeights),
+                                                   _mm_madd_epi16(highColumns, highWeights));
+
+            sum2 += static_cast<uint32_t>(blocks * BLOCK_SIZE) * sum1 + BLOCK_SIZE * horizontalSum(prefixSums) +
+                    horizontalSum(weighted);
+            sum1 += horizontalSum(blockSums);
+            sum1 %= MODULUS;
+            sum2 %= MODULUS;
+        }
+#endif
+
+        void writeBigEndian16(uint8_t* out, uint16_t value)
+        {
+            out[0] = static_cast<uint8_t>(value >> 8);
+            out[1] = static_cast<uint8_t>(value);
+        }
+
+        void writeBigEndian32(uint8_t* out, uint32_t value)
+        {
+            out[0] = static_cast<uint8_t>(value >> 24);
+            out[1] = static_cast<uint8_t>(value >> 16);
+            out[2] = static_cast<uint8_t>(value >> 8);
+            out[3] = static_cast<uint8_t>(value);
+        }
+
+        uint16_t readBigEndian16(const uint8_t* in)
+        {
+            return static_cast<uint16_t>((in[0] << 8) | in[1]);
+        }
+
+        uint32_t readBigEndian32(const uint8_t* in)
+        {
+            return (static_cast<uint32_t>(in[0]) << 24) | (static_cast<uint32_t>(in[1]) << 16) |
+                   (static_cast<uint32_t>(in[2]) << 8) | static_cast<uint32_t>(in[3]);
+        }
+
+        /**
+        * Checksum of a datagram, skipping the checksum field itself. */
+        uint16_t datagramChecksum(std::span<const uint8_t> datagram)
+        {
+            Fletcher16 checksum;
+            checksum.update(datagram.first(CHECKSUM_OFFSET));
+            checksum.update(datagram.subspan(PacketHeader::SIZE));
+            return checksum.value();
+        }
+    } // namespace
+
+    std::string_view toString(PacketError error)
+    {
+        switch (error)
+        {
+            case PacketError::NONE: return "none";
+            case PacketError::TOO_SHORT: return "datagram is shorter than a packet header";
+            case PacketError::BAD_IDENTIFIER: return "datagram doesn't start with the OTrk identifier";
+            case PacketError::UNKNOWN_ENCODING: return "payload encoding is neither JSON nor CBOR";
+            case PacketError::LENGTH_MISMATCH: return "payload length doesn't match the datagram";
+            case PacketError::BAD_CHECKSUM: return "checksum doesn't match";
+        }
+        return "unknown packet error";
+    }
+
+    void Fletcher16::update(std::span<const uint8_t> data)
+    {
+        const uint8_t* bytes = data.data();
+        std::size_t remaining = data.size();
+
+#ifdef OPENTRACKIO_PACKET_SSE2
+        while (remaining >= BLOCK_SIZE)
+        {
+            const std::size_t blocks = std::min(remaining / BLOCK_SIZE, MAX_BLOCKS);
+            updateBlocks(m_sum1, m_sum2, bytes, blocks);
+            bytes += blocks * BLOCK_SIZE;
+            remaining -= blocks * BLOCK_SIZE;
+        }
+#endif
+
+        updateScalar(m_sum1, m_sum2, bytes, remaining);
+    }
+
+    uint16_t Fletcher16::compute(std::span<const uint8_t> data)
+    {
+        Fletcher16 checksum;
+        checksum.update(data);
+        return checksum.value();
+    }
+
+    uint16_t fletcher16Scalar(std::span<const uint8_t> data)
+    {
+        uint32_t sum1 = 0;
+        uint32_t sum2 = 0;
+        for (const uint8_t byte : data)
+        {
+            sum1 = (sum1 + byte) % MODULUS;
+            sum2 = (sum2 + sum1) % MODULUS;
+        }
+        return static_cast<uint16_t>((sum2 << 8) | sum1);
+    }
+
+    std::optional<std::size_t> encodePacket(const PacketHeader& header, std::span<const uint8_t> payload,
+                                            std::span<uint8_t> datagram)
+    {
+        const std::size_t size = PacketHeader::SIZE + payload.size();
+        if (payload.size() > PacketHeader::MAX_PAYLOAD_LENGTH || datagram.size() < size)
+        {
+            return std::nullopt;
+        }
+
+        uint8_t* out = datagram.data();
+        std::memcpy(out, PacketHeader::IDENTIFIER.data(), PacketHeader::IDENTIFIER.size());
+        out[4] = 0;
+        out[5] = static_cast<uint8_t>(header.encoding);
+        writeBigEndian16(out + 6, header.sequenceNumber);
+        writeBigEndian32(out + 8, header.segmentOffset);
+        writeBigEndian16(out + 12, static_cast<uint16_t>((header.lastSegment ? 0x8000 : 0) | payload.size()));
+        if (!payload.empty())
+        {
+            std::memcpy(out + PacketHeader::SIZE, payload.data(), payload.size());
+        }
+        writeBigEndian16(out + CHECKSUM_OFFSET, datagramChecksum(datagram.first(size)));
+        return size;
+    }
+
+    PacketError decodePacket(std::span<const uint8_t> datagram, Packet& packet)
+    {
+        if (datagram.size() < PacketHeader::SIZE)
+        {
+            return PacketError::TOO_SHORT;
+        }
+
+        const uint8_t* in = datagram.data();
+        if (std::memcmp(in, PacketHeader::IDENTIFIER.data(), PacketHeader::IDENTIFIER.size()) != 0)
+        {
+            return PacketError::BAD_IDENTIFIER;
+        }
+
+        const auto encoding = static_cast<PayloadEncoding>(in[5]);
+        if (encoding != PayloadEncoding::JSON && encoding != PayloadEncoding::CBOR)
+        {
+            return PacketError::UNKNOWN_ENCODING;
+        }
+
+        const uint16_t lengthField = readBigEndian16(in + 12);
+        const auto payloadLength = static_cast<uint16_t>(lengthField & PacketHeader::MAX_PAYLOAD_LENGTH);
+        if (datagram.size() - PacketHeader::SIZE != payloadLength)
+        {
+            return PacketError::LENGTH_MISMATCH;
+        }
+
+        const uint16_t checksum = readBigEndian16(in + CHECKSUM_OFFSET);
+        if (datagramChecksum(datagram) != checksum)
+        {
+            return PacketError::BAD_CHECKSUM;
+        }
+
+        packet.header.encoding = encoding;
+        packet.header.sequenceNumber = readBigEndian16(in + 6);
+        packet.header.segmentOffset = readBigEndian32(in + 8);
+        packet.header.lastSegment = (lengthField & 0x8000) != 0;
+        packet.header.payloadLength = payloadLength;
+        packet.header.checksum = checksum;
+        packet.payload = datagram.subspan(PacketHeader::SIZE);
+        return PacketError::NONE;
+    }
+
+    PacketSegmenter::PacketSegmenter(PayloadEncoding encoding, uint16_t sequenceNumber,
+                                     std::span<const uint8_t> payload, std::size_t maxDatagramSize)
+        : m_encoding{encoding},
+          m_sequenceNumber{sequenceNumber},
+          m_payload{payload},
+          m_maxSegmentLength{std::clamp<std::size_t>(maxDatagramSize - std::min(maxDatagramSize, PacketHeader::SIZE),
+                                                     1, PacketHeader::MAX_PAYLOAD_LENGTH)}
+    {
+    }
+
+    std::optional<std::size_t> PacketSegmenter::next(std::span<uint8_t> datagram)
+    {
+        if (!m_pending)
+        {
+            return std::nullopt;
+        }
+
+        const std::size_t length = std::min(m_payload.size() - m_offset, m_maxSegmentLength);
+        const bool last = m_offset + length == m_payload.size();
+
+        PacketHeader header{};
+        header.encoding = m_encoding;
+        header.sequenceNumber = m_sequenceNumber;
+        header.segmentOffset = static_cast<uint32_t>(m_offset);
+        header.lastSegment = last;
+
+        const std::optional<std::size_t> size = encodePacket(header, m_payload.subspan(m_offset, length), datagram);
+        if (size.has_value())
+        {
+            m_offset += length;
+            m_pending = !last;
+        }
+        return size;
+    }
+
+    std::size_t PacketSegmenter::segmentCount() const
+    {
+        return std::max<std::size_t>(1, (m_payload.size() + m_maxSegmentLength - 1) / m_maxSegmentLength);
+    }
+
+    bool initialiseFromPayload(OpenTrackIOSample& sample, PayloadEncoding encoding, std::span<const uint8_t> payload)
+    {
+        switch (encoding)
+        {
+            case PayloadEncoding::JSON:
+                return sample.initialise(std::string_view{reinterpret_cast<const char*>(payload.data()), payload.size()});
+            case PayloadEncoding::CBOR:
+                return sample.initialise(payload);
+        }
+        return false;
+    }
+
+    bool initialiseFromPacket(OpenTrackIOSample& sample, const Packet& packet)
+    {
+        if (!packet.header.isComplete())
+        {
+            return false;
+        }
+        return initialiseFromPayload(sample, packet.header.encoding, packet.payload);
+    }
+} // namespace opentrackio
@@ -13,11 +13,11 @@
 
 #include "opentrackio-cpp/OpenTrackIOProperties.h"
 #include "opentrackio-cpp/OpenTrackIOHelper.h"
-#include <regex>
+#include "opentrackio-cpp/OpenTrackIOValidation.h"
 
 namespace opentrackio::opentrackioproperties
 {
-    std::optional<Camera> Camera::parse(nlohmann::json &json, std::vector<std::string>& errors)
+    std::optional<Camera> Camera::parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited)
     {
         if (!json.contains("static") || !json["static"].contains("camera"))
         {
@@ -26,62 +26,59 @@ namespace opentrackio::opentrackioproperties
 
         if (!json["static"]["camera"].is_object())
         {
-            errors.emplace_back("field: camera isn't of type: object");
+            errors.add(ErrorCode::NOT_OF_TYPE, "camera", "object");
             return std::nullopt;
         }
 
         Camera cam{};
-        auto& cameraJson = json["static"]["camera"];
+        const auto& cameraJson = json["static"]["camera"];
 
         if (cameraJson.contains("activeSensorPhysicalDimensions"))
         {
             cam.activeSensorPhysicalDimensions = opentrackiotypes::Dimensions<double>::parse(
-                    cameraJson, "activeSensorPhysicalDimensions", errors);
-            cameraJson.erase("activeSensorPhysicalDimensions");
+                    cameraJson, "activeSensorPhysicalDimensions", errors, visited);
+            visited.markConsumed(cameraJson.at("activeSensorPhysicalDimensions"));
         }
 
         if (cameraJson.contains("activeSensorResolution"))
         {
             cam.activeSensorResolution = opentrackiotypes::Dimensions<uint32_t>::parse(cameraJson,
-                   "activeSensorResolution", errors);
-            cameraJson.erase("activeSensorResolution");
+                   "activeSensorResolution", errors, visited);
+            visited.markConsumed(cameraJson.at("activeSensorResolution"));
         }
 
         if (cameraJson.contains("anamorphicSqueeze"))
         {
-            cam.anamorphicSqueeze = opentrackiotypes::Rational::parse(cameraJson, "anamorphicSqueeze", errors);
-            cameraJson.erase("anamorphicSqueeze");
+            cam.anamorphicSqueeze = opentrackiotypes::Rational::parse(cameraJson, "anamorphicSqueeze", errors, visited);
         }
 
-        OpenTrackIOHelpers::assignField(cameraJson, "firmwareVersion", cam.firmwareVersion, "string", errors);
-        OpenTrackIOHelpers::assignField(cameraJson, "label", cam.label, "string", errors);
-        OpenTrackIOHelpers::assignField(cameraJson, "make", cam.make, "string", errors);
-        OpenTrackIOHelpers::assignField(cameraJson, "model", cam.model, "string", errors);
-        OpenTrackIOHelpers::assignField(cameraJson, "serialNumber", cam.serialNumber, "string", errors);
+        OpenTrackIOHelpers::assignField(cameraJson, "firmwareVersion", cam.firmwareVersion, "string", errors, visited);
+        OpenTrackIOHelpers::assignField(cameraJson, "label", cam.label, "string", errors, visited);
+        OpenTrackIOHelpers::assignField(cameraJson, "make", cam.make, "string", errors, visited);
+        OpenTrackIOHelpers::assignField(cameraJson, "model", cam.model, "string", errors, visited);
+        OpenTrackIOHelpers::assignField(cameraJson, "serialNumber", cam.serialNumber, "string", errors, visited);
 
         if (cameraJson.contains("captureFrameRate"))
         {
-            cam.captureFrameRate = opentrackiotypes::Rational::parse(cameraJson, "captureFrameRate", errors);
-            cameraJson.erase("captureFrameRate");
+            cam.captureFrameRate = opentrackiotypes::Rational::parse(cameraJson, "captureFrameRate", errors, visited);
         }
 
-        const std::regex pattern{R"(^urn:uuid:[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}$)"};
-        OpenTrackIOHelpers::assignRegexField(cameraJson, "fdlLink", cam.fdlLink, pattern, errors);
+        OpenTrackIOHelpers::assignPatternField(cameraJson, "fdlLink", cam.fdlLink, opentrackiovalidation::isUrnUuid, errors, visited);
 
-        OpenTrackIOHelpers::assignField(cameraJson, "isoSpeed", cam.isoSpeed, "uint32", errors);
-        OpenTrackIOHelpers::assignField(cameraJson, "shutterAngle", cam.shutterAngle, "double", errors);
+        OpenTrackIOHelpers::assignField(cameraJson, "isoSpeed", cam.isoSpeed, "uint32", errors, visited);
+        OpenTrackIOHelpers::assignField(cameraJson, "shutterAngle", cam.shutterAngle, "double", errors, visited);
 
         if (cam.shutterAngle.has_value() && cam.shutterAngle.value() > 360)
         {
-            errors.emplace_back("field: shutterAngle is outside the expected range 1 - 360.");
+            errors.add(ErrorCode::OUT_OF_RANGE, "shutterAngle", "1 - 360");
             cam.shutterAngle = std::nullopt;
         }
 
-        OpenTrackIOHelpers::clearFieldIfEmpty(json["static"], "camera");
+        OpenTrackIOHelpers::clearFieldIfEmpty(json["static"], "camera", visited);
         return cam;
     }
 
-    std::optional<Duration> Duration::parse(nlohmann::json &json, std::vector<std::string>& errors)
+    std::optional<Duration> Duration::parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited)
     {
         if (!json.contains("static") || !json["static"].contains("duration"))
         {
@@ -90,28 +87,28 @@ namespace opentrackio::opentrackioproperties
 
         if (!json["static"]["duration"].is_object())
         {
-            errors.emplace_back("field: duration isn't of type: object");
+            errors.add(ErrorCode::NOT_OF_TYPE, "duration", "object");
             return std::nullopt;
         }
 
-        auto& durationJson = json["static"]["duration"];
+        const auto& durationJson = json["static"]["duration"];
         std::optional<uint32_t> numerator = std::nullopt;
         std::optional<uint32_t> denominator = std::nullopt;
 
-        OpenTrackIOHelpers::assignField(durationJson, "num", numerator, "uint64", errors);
-        OpenTrackIOHelpers::assignField(durationJson, "denom", denominator, "uint64", errors);
+        OpenTrackIOHelpers::assignField(durationJson, "num", numerator, "uint64", errors, visited);
+        OpenTrackIOHelpers::assignField(durationJson, "denom", denominator, "uint64", errors, visited);
 
         if (!numerator.has_value() || !denominator.has_value())
         {
-            errors.emplace_back("field: duration is missing required fields");
+            errors.add(ErrorCode::MISSING_FIELDS, "duration");
             return std::nullopt;
         }
 
-        OpenTrackIOHelpers::clearFieldIfEmpty(json["static"], "duration");
+        OpenTrackIOHelpers::clearFieldIfEmpty(json["static"], "duration", visited);
         return Duration{{numerator.value(), denominator.value()}};
     }
 
-    std::optional<GlobalStage> GlobalStage::parse(nlohmann::json &json, std::vector<std::string>& errors)
+    std::optional<GlobalStage> GlobalStage::parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited)
     {
         if (!json.contains("globalStage"))
         {
@@ -120,7 +117,7 @@ namespace opentrackio::opentrackioproperties
 
         if (!json["globalStage"].is_object())
         {
-            errors.emplace_back("field: globalStage isn't of type: object");
+            errors.add(ErrorCode::NOT_OF_TYPE, "globalStage", "object");
             return std::nullopt;
         }
 
@@ -131,13 +128,13 @@ namespace opentrackio::opentrackioproperties
         {
             if (!gsJson.contains(fieldStr))
             {
-                errors.emplace_back(std::format("field: globalStage is missing require field: {}", fieldStr));
+                errors.add(ErrorCode::MISSING_FIELD, "globalStage", fieldStr);
                 return false;
             }
 
             if (!gsJson.at(fieldStr).is_number())
             {
-                errors.emplace_back(std::format("field: globalStage is not a number: {}", fieldStr));
+                errors.add(ErrorCode::NOT_A_NUMBER, "globalStage", fieldStr);
                 return false;
             }
 
@@ -155,11 +152,11 @@ namespace opentrackio::opentrackioproperties
             return std::nullopt;
         }
 
-        json.erase("globalStage");
+        visited.markConsumed(json.at("globalStage"));
         return gs;
     }
 
-    std::optional<Lens> Lens::parse(nlohmann::json &json, std::vector<std::string>& errors)
+    std::optional<Lens> Lens::parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited)
     {
         if (!json.contains("lens") && (!json.contains("static") || !json["static"].contains("lens")))
         {
@@ -171,43 +168,43 @@ namespace opentrackio::opentrackioproperties
         // ------- Static Fields
         if (json.contains("static") && json["static"].contains("lens"))
         {
-            auto& lensJson = json["static"]["lens"];
-            OpenTrackIOHelpers::assignField(lensJson, "firmwareVersion", lens.firmwareVersion, "string", errors);
-            OpenTrackIOHelpers::assignField(lensJson, "make", lens.make, "string", errors);
-            OpenTrackIOHelpers::assignField(lensJson, "model", lens.model, "string", errors);
-            OpenTrackIOHelpers::assignField(lensJson, "nominalFocalLength", lens.nominalFocalLength, "double", errors);
-            OpenTrackIOHelpers::assignField(lensJson, "serialNumber", lens.serialNumber, "string", errors);
-            OpenTrackIOHelpers::assignField(lensJson, "distortionOverscanMax", lens.distortionOverscanMax, "double", errors);
-            OpenTrackIOHelpers::assignField(lensJson, "undistortionOverscanMax", lens.undistortionOverscanMax, "double", errors);
-            OpenTrackIOHelpers::assignField(lensJson, "calibrationHistory", lens.calibrationHistory, "string", errors);
+            const auto& lensJson = json["static"]["lens"];
+            OpenTrackIOHelpers::assignField(lensJson, "firmwareVersion", lens.firmwareVersion, "string", errors, visited);
+            OpenTrackIOHelpers::assignField(lensJson, "make", lens.make, "string", errors, visited);
+            OpenTrackIOHelpers::assignField(lensJson, "model", lens.model, "string", errors, visited);
+            OpenTrackIOHelpers::assignField(lensJson, "nominalFocalLength", lens.nominalFocalLength, "double", errors, visited);
+            OpenTrackIOHelpers::assignField(lensJson, "serialNumber", lens.serialNumber, "string", errors, visited);
+            OpenTrackIOHelpers::assignField(lensJson, "distortionOverscanMax", lens.distortionOverscanMax, "double", errors, visited);
+            OpenTrackIOHelpers::assignField(lensJson, "undistortionOverscanMax", lens.undistortionOverscanMax, "double", errors, visited);
+            OpenTrackIOHelpers::assignField(lensJson, "calibrationHistory", lens.calibrationHistory, "string", errors, visited);
 
-            OpenTrackIOHelpers::clearFieldIfEmpty(json["static"], "lens");
+            OpenTrackIOHelpers::clearFieldIfEmpty(json["static"], "lens", visited);
         }
 
         // ------- Standard Fields
         if (json.contains("lens"))
         {
-            auto& lensJson = json["lens"];
+            const auto& lensJson = json["lens"];
             if (lensJson.contains("custom") && lensJson["custom"].is_array())
             {
                 OpenTrackIOHelpers::iterateJsonArrayAndPopulateVector(lensJson["custom"], lens.custom);
-                lensJson.erase("custom");
+                visited.markConsumed(lensJson.at("custom"));
             }
 
             if (lensJson.contains("distortion") && lensJson["distortion"].is_array())
             {
-                lens.distortion = std::vector<Distortion>{};
-                for (auto& dist : lensJson["distortion"])
+                lens.distortion = opentrackiotypes::Vector<Distortion>{};
+                for (const auto& dist : lensJson["distortion"])
                 {
-                    std::optional<std::vector<double>> radial = std::nullopt;
-                    std::optional<std::vector<double>> tangential = std::nullopt;
+                    std::optional<Coefficients> radial = std::nullopt;
+                    std::optional<Coefficients> tangential = std::nullopt;
                     std::optional<double> overscan = std::nullopt;
-                    std::optional<std::string> model = std::nullopt;
+                    std::optional<opentrackiotypes::String> model = std::nullopt;
 
-                    OpenTrackIOHelpers::assignField(dist, "radial", radial, "double", errors);
-                    OpenTrackIOHelpers::assignField(dist, "tangential", tangential, "double", errors);
-                    OpenTrackIOHelpers::assignField(dist, "model", model, "string", errors);
-                    OpenTrackIOHelpers::assignField(dist, "overscan", overscan, "double", errors);
+                    OpenTrackIOHelpers::assignField(dist, "radial", radial, "double", errors, visited);
+                    OpenTrackIOHelpers::assignField(dist, "tangential", tangential, "double", errors, visited);
+                    OpenTrackIOHelpers::assignField(dist, "model", model, "string", errors, visited);
+                    OpenTrackIOHelpers::assignField(dist, "overscan", overscan, "double", errors, visited);
 
                     if (radial.has_value())
                     {
@@ -219,7 +216,7 @@ namespace opentrackio::opentrackioproperties
                         lens.distortion->emplace_back(d);
                     }
                 }
-                lensJson.erase("distortion");
+                visited.markConsumed(lensJson.at("distortion"));
             }
 
             if (lensJson.contains("distortionOffset"))
@@ -227,18 +224,18 @@ namespace opentrackio::opentrackioproperties
                 std::optional<double> x = std::nullopt;
                 std::optional<double> y = std::nullopt;
 
-                OpenTrackIOHelpers::assignField(lensJson["distortionOffset"], "x", x, "double", errors);
-                OpenTrackIOHelpers::assignField(lensJson["distortionOffset"], "y", y, "double", errors);
+                OpenTrackIOHelpers::assignField(lensJson["distortionOffset"], "x", x, "double", errors, visited);
+                OpenTrackIOHelpers::assignField(lensJson["distortionOffset"], "y", y, "double", errors, visited);
 
                 if (x.has_value() && y.has_value())
                 {
                     lens.distortionOffset = DistortionOffset{x.value(), y.value()};
                 }
-                lensJson.erase("distortionOffset");
+                visited.markConsumed(lensJson.at("distortionOffset"));
             }
 
-            OpenTrackIOHelpers::assignField(lensJson, "encoders", lens.encoders, "double", errors);
-            OpenTrackIOHelpers::assignField(lensJson, "entrancePupilOffset", lens.entrancePupilOffset, "double", errors);
+            OpenTrackIOHelpers::assignField(lensJson, "encoders", lens.encoders, "double", errors, visited);
+            OpenTrackIOHelpers::assignField(lensJson, "entrancePupilOffset", lens.entrancePupilOffset, "double", errors, visited);
 
             if (lensJson.contains("exposureFalloff"))
             {
@@ -246,25 +243,25 @@ namespace opentrackio::opentrackioproperties
                 std::optional<double> a2 = std::nullopt;
                 std::optional<double> a3 = std::nullopt;
 
-                OpenTrackIOHelpers::assignField(lensJson["exposureFalloff"], "a1", a1, "double", errors);
-                OpenTrackIOHelpers::assignField(lensJson["exposureFalloff"], "a2", a2, "double", errors);
-                OpenTrackIOHelpers::assignField(lensJson["exposureFalloff"], "a3", a3, "double", errors);
+                OpenTrackIOHelpers::assignField(lensJson["exposureFalloff"], "a1", a1, "double", errors, visited);
+                OpenTrackIOHelpers::assignField(lensJson["exposureFalloff"], "a2", a2, "double", errors, visited);
+                OpenTrackIOHelpers::assignField(lensJson["exposureFalloff"], "a3", a3, "double", errors, visited);
 
                 if (a1.has_value())
                 {
                     lens.exposureFalloff = ExposureFalloff{a1.value(), a2, a3};
                 }
-                lensJson.erase("exposureFalloff");
+                visited.markConsumed(lensJson.at("exposureFalloff"));
             }
 
-            OpenTrackIOHelpers::assignField(lensJson, "fStop", lens.fStop, "double", errors);
-            OpenTrackIOHelpers::assignField(lensJson, "pinholeFocalLength", lens.pinholeFocalLength, "double", errors);
-            OpenTrackIOHelpers::assignField(lensJson, "focusDistance", lens.focusDistance, "double", errors);
+            OpenTrackIOHelpers::assignField(lensJson, "fStop", lens.fStop, "double", errors, visited);
+            OpenTrackIOHelpers::assignField(lensJson, "pinholeFocalLength", lens.pinholeFocalLength, "double", errors, visited);
+            OpenTrackIOHelpers::assignField(lensJson, "focusDistance", lens.focusDistance, "double", errors, visited);
 
             if (lensJson.contains("calibrationHistory") && lensJson["calibrationHistory"].is_array())
             {
-                OpenTrackIOHelpers::iterateJsonArrayAndPopulateVector(lensJson["calibrationHistory"], lens.calibrationHistory);
-                lensJson.erase("calibrationHistory");
+                OpenTrackIOHelpers::iterateJsonArrayAndPopulateVector(lensJson["calibrationHistory"], lens.calibrationHistory, visited);
+                visited.markConsumed(lensJson.at("calibrationHistory"));
             }
 
             if (lensJson.contains("projectionOffset"))
@@ -272,34 +269,34 @@ namespace opentrackio::opentrackioproperties
                 std::optional<double> x = std::nullopt;
                 std::optional<double> y = std::nullopt;
 
-                OpenTrackIOHelpers::assignField(lensJson["projectionOffset"], "x", x, "double", errors);
-                OpenTrackIOHelpers::assignField(lensJson["projectionOffset"], "y", y, "double", errors);
+                OpenTrackIOHelpers::assignField(lensJson["projectionOffset"], "x", x, "double", errors, visited);
+                OpenTrackIOHelpers::assignField(lensJson["projectionOffset"], "y", y, "double", errors, visited);
 
                 if (x.has_value() && y.has_value())
                 {
                     lens.projectionOffset = ProjectionOffset{x.value(), y.value()};
                 }
-                lensJson.erase("projectionOffset");
+                visited.markConsumed(lensJson.at("projectionOffset"));
             }
 
             if (lensJson.contains("rawEncoders"))
             {
                 lens.rawEncoders = RawEncoders{};
-                OpenTrackIOHelpers::assignField(lensJson["rawEncoders"], "focus", lens.rawEncoders->focus, "unit32", errors);
-                OpenTrackIOHelpers::assignField(lensJson["rawEncoders"], "iris", lens.rawEncoders->iris, "uint32", errors);
-                OpenTrackIOHelpers::assignField(lensJson["rawEncoders"], "zoom", lens.rawEncoders->zoom, "uint32", errors);
-                lensJson.erase("rawEncoders");
+                OpenTrackIOHelpers::assignField(lensJson["rawEncoders"], "focus", lens.rawEncoders->focus, "unit32", errors, visited);
+                OpenTrackIOHelpers::assignField(lensJson["rawEncoders"], "iris", lens.rawEncoders->iris, "uint32", errors, visited);
+                OpenTrackIOHelpers::assignField(lensJson["rawEncoders"], "zoom", lens.rawEncoders->zoom, "uint32", errors, visited);
+                visited.markConsumed(lensJson.at("rawEncoders"));
             }
 
-            OpenTrackIOHelpers::assignField(lensJson, "tStop", lens.tStop, "double", errors);
+            OpenTrackIOHelpers::assignField(lensJson, "tStop", lens.tStop, "double", errors, visited);
 
-            OpenTrackIOHelpers::clearFieldIfEmpty(json, "lens");
+            OpenTrackIOHelpers::clearFieldIfEmpty(json, "lens", visited);
         }
 
         return lens;
     }
 
-    std::optional<Protocol> Protocol::parse(nlohmann::json &json, std::vector<std::string>& errors)
+    std::optional<Protocol> Protocol::parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited)
     {
         if (!json.contains("protocol"))
         {
@@ -307,39 +304,41 @@ namespace opentrackio::opentrackioproperties
         }
 
         Protocol pro{};
-        auto& proJson = json["protocol"];
+        const auto& proJson = json["protocol"];
 
         if (!proJson.contains("name"))
         {
-            errors.emplace_back(std::format("field: protocol is missing a require field: name"));
+            errors.add(ErrorCode::MISSING_NAMED_FIELD, "protocol", "name");
             return std::nullopt;
         }
 
         if (!proJson["name"].is_string())
         {
-            errors.emplace_back("field: protocol name isn't of type: string");
+            errors.add(ErrorCode::NOT_OF_TYPE, "protocol name", "string");
             return std::nullopt;
         }
 
-        OpenTrackIOHelpers::getFieldFromJson(proJson["name"], pro.name);
+        OpenTrackIOHelpers::getFieldFromJson(proJson["name"], pro.name, visited);
 
-        if (!proJson["version"].is_array())
+        const auto versionIt = proJson.find("version");
+        if (versionIt == proJson.end() || !versionIt->is_array())
         {
-            errors.emplace_back("field: protocol version isn't of type: [int, int, int]");
+            errors.add(ErrorCode::NOT_OF_TYPE, "protocol version", "[int, int, int]");
             return std::nullopt;
         }
 
-        if (proJson["version"].size() != 3)
+        const auto& versionJson = *versionIt;
+        if (versionJson.size() != 3)
         {
-            errors.emplace_back("field: protocol version isn't of size 3: [int, int, int]");
+            errors.add(ErrorCode::WRONG_SIZE, "protocol version", "[int, int, int]", 3);
             return std::nullopt;
         }
 
-        if (proJson["version"][0] != OPEN_TRACK_IO_PROTOCOL_MAJOR_VERSION ||
-            proJson["version"][1] != OPEN_TRACK_IO_PROTOCOL_MINOR_VERSION ||
-            proJson["version"][2] != OPEN_TRACK_IO_PROTOCOL_PATCH)
+        if (versionJson[0] != OPEN_TRACK_IO_PROTOCOL_MAJOR_VERSION ||
+            versionJson[1] != OPEN_TRACK_IO_PROTOCOL_MINOR_VERSION ||
+            versionJson[2] != OPEN_TRACK_IO_PROTOCOL_PATCH)
         {
-            errors.emplace_back("version: protocol version mismatch");
+            errors.add(ErrorCode::VERSION_MISMATCH, "protocol");
             return std::nullopt;
         }
 
@@ -349,11 +348,11 @@ namespace opentrackio::opentrackioproperties
             OPEN_TRACK_IO_PROTOCOL_PATCH
         };
 
-        json.erase("protocol");
+        visited.markConsumed(json.at("protocol"));
         return pro;
     }
 
-    std::optional<RelatedSampleIds> RelatedSampleIds::parse(nlohmann::json &json, std::vector<std::string>& errors)
+    std::optional<RelatedSampleIds> RelatedSampleIds::parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited)
     {
         if (!json.contains("relatedSampleIds"))
         {
@@ -362,81 +361,74 @@ namespace opentrackio::opentrackioproperties
 
         if (!json["relatedSampleIds"].is_array())
         {
-            errors.emplace_back("field: relatedSampleIds isn't of type: array");
+            errors.add(ErrorCode::NOT_OF_TYPE, "relatedSampleIds", "array");
             return std::nullopt;
         }
 
         RelatedSampleIds rs{};
         const auto& rsJson = json["relatedSampleIds"];
-        const std::regex pattern{R"(^urn:uuid:[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}$)"};
 
         for (const auto& item : rsJson.items())
         {
-            std::string str;
-
             if (!item.value().is_string())
             {
-                errors.emplace_back("field: relatedSampleIds/element isn't of type: string");
+                errors.add(ErrorCode::NOT_OF_TYPE, "relatedSampleIds/element", "string");
                 continue;
             }
 
-            OpenTrackIOHelpers::getFieldFromJson(item.value(), str);
-
             // Check the string received to ensure that it matches the pattern described by the spec.
-            if (std::smatch res; !std::regex_match(str, res, pattern))
+            const std::optional<opentrackiotypes::Uuid> uuid =
+                    opentrackiotypes::Uuid::fromUrn(item.value().get_ref<const nlohmann::json::string_t&>());
+            if (!uuid.has_value())
             {
-                errors.emplace_back("field: relatedSampleIds/element doesn't match required pattern");
+                errors.add(ErrorCode::ELEMENT_PATTERN_MISMATCH, "relatedSampleIds");
                 continue;
             }
 
-            rs.samples.emplace_back(std::move(str));
+            rs.samples.push_back(uuid.value());
         }
 
-        json.erase("relatedSampleIds");
+        visited.markConsumed(json.at("relatedSampleIds"));
         return rs;
     }
 
-    std::optional<SampleId> SampleId::parse(nlohmann::json &json, std::vector<std::string>& errors)
+    std::optional<SampleId> SampleId::parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited)
     {
         if (!json.contains("sampleId"))
         {
             return std::nullopt;
         }
 
-        std::optional<std::string> str;
-        const std::regex pattern{R"(^urn:uuid:[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}$)"};
-        OpenTrackIOHelpers::assignRegexField(json, "sampleId", str, pattern, errors);
+        std::optional<opentrackiotypes::String> str;
+        OpenTrackIOHelpers::assignPatternField(json, "sampleId", str, opentrackiovalidation::isUrnUuid, errors, visited);
 
         if (!str.has_value())
         {
             return std::nullopt;
         }
 
-        json.erase("sampleId");
-        return SampleId{std::move(str.value())};
+        return SampleId{opentrackiotypes::Uuid::fromUrn(str.value()).value()};
     }
 
-    std::optional<SourceId> SourceId::parse(nlohmann::json &json, std::vector<std::string> &errors)
+    std::optional<SourceId> SourceId::parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited)
     {
         if (!json.contains("sourceId"))
         {
             return std::nullopt;
         }
 
-        std::optional<std::string> str;
-        const std::regex pattern{R"(^urn:uuid:[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}$)"};
-        OpenTrackIOHelpers::assignRegexField(json, "sourceId", str, pattern, errors);
+        std::optional<opentrackiotypes::String> str;
+        OpenTrackIOHelpers::assignPatternField(json, "sourceId", str, opentrackiovalidation::isUrnUuid, errors, visited);
 
         if (!str.has_value())
         {
             return std::nullopt;
         }
 
-        json.erase("sourceId");
-        return SourceId{std::move(str.value())};
+        return SourceId{opentrackiotypes::Uuid::fromUrn(str.value()).value()};
     }
 
-    std::optional<SourceNumber> SourceNumber::parse(nlohmann::json &json, std::vector<std::string> &errors)
+    std::optional<SourceNumber> SourceNumber::parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited)
     {
         if (!json.contains("sourceNumber"))
         {
@@ -444,18 +436,17 @@ namespace opentrackio::opentrackioproperties
         }
 
         std::optional<uint32_t> val;
-        OpenTrackIOHelpers::assignField(json, "sourceNumber", val, "uint32", errors);
+        OpenTrackIOHelpers::assignField(json, "sourceNumber", val, "uint32", errors, visited);
 
         if (!val.has_value())
         {
             return std::nullopt;
         }
 
-        json.erase("sourceNumber");
         return SourceNumber{val.value()};
     }
 
-    std::optional<Timing> Timing::parse(nlohmann::json &json, std::vector<std::string>& errors)
+    std::optional<Timing> Timing::parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited)
     {
         if (!json.contains("timing"))
         {
@@ -464,117 +455,113 @@ namespace opentrackio::opentrackioproperties
 
         if (!json["timing"].is_object())
         {
-            errors.emplace_back("field: timing isn't of type: object");
+            errors.add(ErrorCode::NOT_OF_TYPE, "timing", "object");
             return std::nullopt;
         }
 
         Timing timing{};
-        auto& timingJson = json["timing"];
+        const auto& timingJson = json["timing"];
 
         if (timingJson.contains("sampleRate"))
         {
-            timing.sampleRate = opentrackiotypes::Rational::parse(timingJson, "sampleRate", errors);
-            timingJson.erase("sampleRate");
+            timing.sampleRate = opentrackiotypes::Rational::parse(timingJson, "sampleRate", errors, visited);
         }
 
         std::optional<std::string> str;
-        OpenTrackIOHelpers::assignField(timingJson, "mode", str, "string", errors);
+        OpenTrackIOHelpers::assignField(timingJson, "mode", str, "string", errors, visited);
         if (str.has_value() && (str == "external" || str == "internal"))
         {
             timing.mode = str == "external" ? Mode::EXTERNAL : Mode::INTERNAL;
-            timingJson.erase("mode");
         }
         else if (str.has_value())
         {
-            errors.emplace_back("field: timing/mode has an invalid string value.");
+            errors.add(ErrorCode::INVALID_STRING, "timing/mode");
             timing.mode = std::nullopt;
         }
 
         if (timingJson.contains("recordedTimestamp"))
         {
-            timing.recordedTimestamp = opentrackiotypes::Timestamp::parse(timingJson, "recordedTimestamp", errors);
-            timingJson.erase("recordedTimestamp");
+            timing.recordedTimestamp = opentrackiotypes::Timestamp::parse(timingJson, "recordedTimestamp", errors, visited);
+            visited.markConsumed(timingJson.at("recordedTimestamp"));
         }
 
         if (timingJson.contains("sampleTimestamp"))
         {
-            timing.sampleTimestamp = opentrackiotypes::Timestamp::parse(timingJson, "sampleTimestamp", errors);
-            timingJson.erase("sampleTimestamp");
+            timing.sampleTimestamp = opentrackiotypes::Timestamp::parse(timingJson, "sampleTimestamp", errors, visited);
+            visited.markConsumed(timingJson.at("sampleTimestamp"));
         }
 
-        OpenTrackIOHelpers::assignField(timingJson, "sequenceNumber", timing.sequenceNumber, "uint16", errors);
+        OpenTrackIOHelpers::assignField(timingJson, "sequenceNumber", timing.sequenceNumber, "uint16", errors, visited);
 
         if (timingJson.contains("synchronization"))
         {
-            timing.synchronization = parseSynchronization(timingJson, errors);
-            OpenTrackIOHelpers::clearFieldIfEmpty(timingJson, "synchronization");
+            timing.synchronization = parseSynchronization(timingJson, errors, visited);
+            OpenTrackIOHelpers::clearFieldIfEmpty(timingJson, "synchronization", visited);
         }
 
         if (timingJson.contains("timecode"))
         {
-            timing.timecode = opentrackiotypes::Timecode::parse(timingJson, "timecode", errors);
-            timingJson.erase("timecode");
+            timing.timecode = opentrackiotypes::Timecode::parse(timingJson, "timecode", errors, visited);
+            visited.markConsumed(timingJson.at("timecode"));
         }
 
-        OpenTrackIOHelpers::clearFieldIfEmpty(json, "timing");
+        OpenTrackIOHelpers::clearFieldIfEmpty(json, "timing", visited);
         return timing;
     }
 
     std::optional<Timing::Synchronization>
-    Timing::parseSynchronization(nlohmann::json &json, std::vector<std::string> &errors)
+    Timing::parseSynchronization(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited)
     {
         Synchronization outSync{};
-        auto& syncJson = json["synchronization"];
+        const auto& syncJson = json["synchronization"];
 
         // Required Fields -------
         const bool hasRequired = syncJson.contains("locked") && syncJson.contains("source");
         if (!hasRequired)
         {
-            errors.emplace_back("field: timing/synchronization is missing required fields");
+            errors.add(ErrorCode::MISSING_FIELDS, "timing/synchronization");
             return std::nullopt;
         }
 
         if (syncJson.contains("frequency"))
         {
-            std::optional<opentrackiotypes::Rational> freq = opentrackiotypes::Rational::parse(syncJson, "frequency", errors);
+            std::optional<opentrackiotypes::Rational> freq = opentrackiotypes::Rational::parse(syncJson, "frequency", errors, visited);
             if (!freq.has_value())
             {
-                errors.emplace_back("field: timing/synchronization/frequency is missing required fields");
+                errors.add(ErrorCode::MISSING_FIELDS, "timing/synchronization/frequency");
                 return std::nullopt;
             }
             outSync.frequency = freq.value();
-            syncJson.erase("frequency");
         }
 
         if (!syncJson.contains("locked"))
         {
-            errors.emplace_back("field: timing/synchronization is missing require field: locked");
+            errors.add(ErrorCode::MISSING_FIELD, "timing/synchronization", "locked");
             return std::nullopt;
         }
 
         if (!syncJson["locked"].is_boolean())
         {
-            errors.emplace_back("field: timing/synchronization/locked isn't of type: bool");
+            errors.add(ErrorCode::NOT_OF_TYPE, "timing/synchronization/locked", "bool");
             return std::nullopt;
         }
 
         OpenTrackIOHelpers::getFieldFromJson(syncJson["locked"], outSync.locked);
-        syncJson.erase("locked");
+        visited.markConsumed(syncJson.at("locked"));
 
         if (!syncJson.contains("source"))
         {
-            errors.emplace_back("field: timing/synchronization is missing require field: source");
+            errors.add(ErrorCode::MISSING_FIELD, "timing/synchronization", "source");
             return std::nullopt;
         }
 
         if (!syncJson["source"].is_string())
         {
-            errors.emplace_back("field: timing/synchronization/source isn't of type: string");
+            errors.add(ErrorCode::NOT_OF_TYPE, "timing/synchronization/source", "string");
             return std::nullopt;
         }
 
-        std::string str;
-        OpenTrackIOHelpers::getFieldFromJson(syncJson["source"], str);
+        const std::string_view str = syncJson["source"].get_ref<const nlohmann::json::string_t&>();
 
         if (str == "genlock")
         {
@@ -594,49 +581,49 @@ namespace opentrackio::opentrackioproperties
         }
         else
         {
-            errors.emplace_back("field: timing/synchronization/source isn't a valid enumeration");
+            errors.add(ErrorCode::INVALID_ENUMERATION, "timing/synchronization/source");
             return std::nullopt;
         }
-        syncJson.erase("source");
+        visited.markConsumed(syncJson.at("source"));
 
         // Non-Required Fields --------
         if (syncJson.contains("offsets"))
         {
             outSync.offsets = Synchronization::Offsets{};
-            OpenTrackIOHelpers::assignField(syncJson["offsets"], "translation", outSync.offsets->translation, "double", errors);
-            OpenTrackIOHelpers::assignField(syncJson["offsets"], "rotation", outSync.offsets->rotation, "double", errors);
-            OpenTrackIOHelpers::assignField(syncJson["offsets"], "lensEncoders", outSync.offsets->lensEncoders, "double", errors);
+            OpenTrackIOHelpers::assignField(syncJson["offsets"], "translation", outSync.offsets->translation, "double", errors, visited);
+            OpenTrackIOHelpers::assignField(syncJson["offsets"], "rotation", outSync.offsets->rotation, "double", errors, visited);
+            OpenTrackIOHelpers::assignField(syncJson["offsets"], "lensEncoders", outSync.offsets->lensEncoders, "double", errors, visited);
 
             if (!outSync.offsets->translation.has_value() && !outSync.offsets->rotation.has_value() &&
                 !outSync.offsets->lensEncoders.has_value())
             {
                 outSync.offsets = std::nullopt;
             }
-            syncJson.erase("offsets");
+            visited.markConsumed(syncJson.at("offsets"));
         }
 
-        OpenTrackIOHelpers::assignField(syncJson, "present", outSync.present, "bool", errors);
+        OpenTrackIOHelpers::assignField(syncJson, "present", outSync.present, "bool", errors, visited);
 
         if (syncJson.contains("ptp"))
         {
             if (outSync.source == Synchronization::SourceType::PTP)
             {
-                outSync.ptp = parsePtp(syncJson, errors);
+                outSync.ptp = parsePtp(syncJson, errors, visited);
             }
-            OpenTrackIOHelpers::clearFieldIfEmpty(syncJson, "ptp");
+            OpenTrackIOHelpers::clearFieldIfEmpty(syncJson, "ptp", visited);
         }
 
         return outSync;
     }
 
     std::optional<Timing::Synchronization::Ptp>
-    Timing::parsePtp(nlohmann::json& json, std::vector<std::string>& errors)
+    Timing::parsePtp(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited)
     {
         Synchronization::Ptp outPtp{};
-        auto& ptpJson = json["ptp"];
+        const auto& ptpJson = json["ptp"];
 
         std::optional<std::string> profileStr;
-        OpenTrackIOHelpers::assignField(ptpJson, "profile", profileStr, "string", errors);
+        OpenTrackIOHelpers::assignField(ptpJson, "profile", profileStr, "string", errors, visited);
         bool successfullyAssignedProfileField = false;
         if (profileStr.has_value())
         {
@@ -660,33 +647,31 @@ namespace opentrackio::opentrackioproperties
         }
         else
         {
-            errors.emplace_back("field: timing/synchronization/ptp/profile is required, however it is missing.");
+            errors.add(ErrorCode::REQUIRED_FIELD_MISSING, "timing/synchronization/ptp/profile");
             return std::nullopt;
         }
 
         if (!successfullyAssignedProfileField)
         {
-            errors.emplace_back("field: profile has an invalid string value.");
+            errors.add(ErrorCode::INVALID_STRING, "profile");
             return std::nullopt;
         }
-        ptpJson.erase("profile");
 
         std::optional<uint16_t> domain;
-        OpenTrackIOHelpers::assignField(ptpJson, "domain", domain, "uint16", errors);
+        OpenTrackIOHelpers::assignField(ptpJson, "domain", domain, "uint16", errors, visited);
         if (!domain.has_value())
         {
-            errors.emplace_back("field: timing/synchronization/ptp/domain is required, however it is missing.");
+            errors.add(ErrorCode::REQUIRED_FIELD_MISSING, "timing/synchronization/ptp/domain");
             return std::nullopt;
         }
         outPtp.domain = domain.value();
 
-        std::optional<std::string> leaderIdentity;
-        const std::regex pattern{R"((?:^[0-9a-f]{2}(?::[0-9a-f]{2}){5}$)|(?:^[0-9a-f]{2}(?:-[0-9a-f]{2}){5}$))"};
-        OpenTrackIOHelpers::assignRegexField(ptpJson, "leaderIdentity", leaderIdentity, pattern, errors);
+        std::optional<opentrackiotypes::String> leaderIdentity;
+        OpenTrackIOHelpers::assignPatternField(ptpJson, "leaderIdentity", leaderIdentity, opentrackiovalidation::isMacAddress, errors, visited);
 
         if (!leaderIdentity.has_value())
         {
-            errors.emplace_back("field: timing/synchronization/ptp/leaderIdentity is required, however it is missing.");
+            errors.add(ErrorCode::REQUIRED_FIELD_MISSING, "timing/synchronization/ptp/leaderIdentity");
             return std::nullopt;
         }
         outPtp.leaderIdentity = leaderIdentity.value();
@@ -694,15 +679,18 @@ namespace opentrackio::opentrackioproperties
         std::optional<uint8_t> priority1;
         std::optional<uint8_t> priority2;
         constexpr auto leaderPrioritiesStr = "leaderPriorities";
-        OpenTrackIOHelpers::assignField(ptpJson[leaderPrioritiesStr], "priority1", priority1, "uint8", errors);
-        OpenTrackIOHelpers::assignField(ptpJson[leaderPrioritiesStr], "priority2", priority2, "uint8", errors);
+        if (const auto prioritiesIt = ptpJson.find(leaderPrioritiesStr); prioritiesIt != ptpJson.end())
+        {
+            OpenTrackIOHelpers::assignField(*prioritiesIt, "priority1", priority1, "uint8", errors, visited);
+            OpenTrackIOHelpers::assignField(*prioritiesIt, "priority2", priority2, "uint8", errors, visited);
+        }
 
         if (!priority1.has_value() || !priority2.has_value())
         {
-            errors.emplace_back("field: timing/synchronization/ptp/leaderPriorities is required, however it is missing a subfield(s).");
+            errors.add(ErrorCode::REQUIRED_SUBFIELD_MISSING, "timing/synchronization/ptp/leaderPriorities");
             return std::nullopt;
         }
-        OpenTrackIOHelpers::clearFieldIfEmpty(ptpJson, leaderPrioritiesStr);
+        OpenTrackIOHelpers::clearFieldIfEmpty(ptpJson, leaderPrioritiesStr, visited);
 
         outPtp.leaderPriorities = Synchronization::Ptp::LeaderPriorities{
             priority1.value(),
@@ -710,27 +698,27 @@ namespace opentrackio::opentrackioproperties
         };
 
         std::optional<double> leaderAccuracy;
-        OpenTrackIOHelpers::assignField(ptpJson, "leaderAccuracy", leaderAccuracy, "double", errors);
+        OpenTrackIOHelpers::assignField(ptpJson, "leaderAccuracy", leaderAccuracy, "double", errors, visited);
         if (!leaderAccuracy.has_value())
         {
-            errors.emplace_back("field: timing/synchronization/ptp/leaderAccuracy is required, however it is missing.");
+            errors.add(ErrorCode::REQUIRED_FIELD_MISSING, "timing/synchronization/ptp/leaderAccuracy");
             return std::nullopt;
         }
         outPtp.leaderAccuracy = leaderAccuracy.value();
 
         std::optional<double> meanPathDelay;
-        OpenTrackIOHelpers::assignField(ptpJson, "meanPathDelay", meanPathDelay, "double", errors);
+        OpenTrackIOHelpers::assignField(ptpJson, "meanPathDelay", meanPathDelay, "double", errors, visited);
         if (!meanPathDelay.has_value())
         {
-            errors.emplace_back("field: timing/synchronization/ptp/meanPathDelay is required, however it is missing.");
+            errors.add(ErrorCode::REQUIRED_FIELD_MISSING, "timing/synchronization/ptp/meanPathDelay");
             return std::nullopt;
         }
         outPtp.meanPathDelay = meanPathDelay.value();
 
-        OpenTrackIOHelpers::assignField(ptpJson, "vlan", outPtp.vlan, "uint32", errors);
+        OpenTrackIOHelpers::assignField(ptpJson, "vlan", outPtp.vlan, "uint32", errors, visited);
 
         std::optional<std::string> leaderTimeSourceStr;
-        OpenTrackIOHelpers::assignField(ptpJson, "leaderTimeSource", leaderTimeSourceStr, "string", errors);
+        OpenTrackIOHelpers::assignField(ptpJson, "leaderTimeSource", leaderTimeSourceStr, "string", errors, visited);
         if (leaderTimeSourceStr.has_value())
         {
             if (leaderTimeSourceStr == "GNSS")
@@ -750,7 +738,7 @@ namespace opentrackio::opentrackioproperties
         return outPtp;
     }
 
-    std::optional<Tracker> Tracker::parse(nlohmann::json &json, std::vector<std::string>& errors)
+    std::optional<Tracker> Tracker::parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited)
     {
         if (!json.contains("tracker") && (!json.contains("static") || !json["static"].contains("tracker")))
         {
@@ -762,31 +750,31 @@ namespace opentrackio::opentrackioproperties
         // ------- Static Fields
         if (json.contains("static") && json["static"].contains("tracker"))
         {
-            auto& tkrJson = json["static"]["tracker"];
-            OpenTrackIOHelpers::assignField(tkrJson, "firmwareVersion", tkr.firmwareVersion, "string", errors);
-            OpenTrackIOHelpers::assignField(tkrJson, "make", tkr.make, "string", errors);
-            OpenTrackIOHelpers::assignField(tkrJson, "model", tkr.model, "string", errors);
-            OpenTrackIOHelpers::assignField(tkrJson, "serialNumber", tkr.serialNumber, "string", errors);
+            const auto& tkrJson = json["static"]["tracker"];
+            OpenTrackIOHelpers::assignField(tkrJson, "firmwareVersion", tkr.firmwareVersion, "string", errors, visited);
+            OpenTrackIOHelpers::assignField(tkrJson, "make", tkr.make, "string", errors, visited);
+            OpenTrackIOHelpers::assignField(tkrJson, "model", tkr.model, "string", errors, visited);
+            OpenTrackIOHelpers::assignField(tkrJson, "serialNumber", tkr.serialNumber, "string", errors, visited);
 
-            OpenTrackIOHelpers::clearFieldIfEmpty(json["static"], "tracker");
+            OpenTrackIOHelpers::clearFieldIfEmpty(json["static"], "tracker", visited);
         }
 
         // ------- Standard Fields
         if (json.contains("tracker"))
         {
-            auto& tkrJson = json["tracker"];
-            OpenTrackIOHelpers::assignField(tkrJson, "notes", tkr.notes, "string", errors);
-            OpenTrackIOHelpers::assignField(tkrJson, "recording", tkr.recording, "boolean", errors);
-            OpenTrackIOHelpers::assignField(tkrJson, "slate", tkr.slate, "string", errors);
-            OpenTrackIOHelpers::assignField(tkrJson, "status", tkr.status, "string", errors);
+            const auto& tkrJson = json["tracker"];
+            OpenTrackIOHelpers::assignField(tkrJson, "notes", tkr.notes, "string", errors, visited);
+            OpenTrackIOHelpers::assignField(tkrJson, "recording", tkr.recording, "boolean", errors, visited);
+            OpenTrackIOHelpers::assignField(tkrJson, "slate", tkr.slate, "string", errors, visited);
+            OpenTrackIOHelpers::assignField(tkrJson, "status", tkr.status, "string", errors, visited);
 
-            OpenTrackIOHelpers::clearFieldIfEmpty(json, "tracker");
+            OpenTrackIOHelpers::clearFieldIfEmpty(json, "tracker", visited);
         }
 
         return tkr;
     }
 
-    std::optional<Transforms> Transforms::parse(nlohmann::json &json, std::vector<std::string>& errors)
+    std::optional<Transforms> Transforms::parse(const nlohmann::json& json, ParseErrors& errors, VisitedFields& visited)
     {
         if (!json.contains("transforms"))
         {
@@ -795,25 +783,25 @@ namespace opentrackio::opentrackioproperties
 
         if (!json["transforms"].is_array())
         {
-            errors.emplace_back("Transforms is not an array.");
+            errors.add(ErrorCode::NOT_AN_ARRAY, "Transforms");
             return std::nullopt;
         }
 
         Transforms tfs{};
-        auto& tfsJson = json["transforms"];
+        const auto& tfsJson = json["transforms"];
 
-        for (auto& item : tfsJson.items())
+        for (const auto& item : tfsJson.items())
         {
-            auto& transformJson = item.value();
-            auto tf = opentrackiotypes::Transform::parse(transformJson, errors);
+            const auto& transformJson = item.value();
+            auto tf = opentrackiotypes::Transform::parse(transformJson, errors, visited);
 
             if (tf.has_value())
             {
-                tfs.transforms.emplace_back(tf.value());
+                tfs.transforms.emplace_back(std::move(tf.value()));
             }
         }
 
-        json.erase("transforms");
+        visited.markConsumed(json.at("transforms"));
         return tfs;
     }
 } // opentrackioproperties
@@ -0,0 +1,260 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "opentrackio-cpp/OpenTrackIOReassembler.h"
+#include <algorithm>
+#include <cstring>
+
+namespace opentrackio
+{
+    PacketReassembler::PacketReassembler(std::size_t slotCount, std::size_t maxPayloadSize, Clock::duration timeout)
+        : m_slots((std::max<std::size_t>(slotCount, 1) + WAYS - 1) / WAYS * WAYS),
+          m_storage(m_slots.size() * maxPayloadSize),
+          m_maxPayloadSize{maxPayloadSize},
+          m_timeout{timeout}
+    {
+        for (std::size_t i = 0; i < m_slots.size(); ++i)
+        {
+            m_slots[i].buffer = m_storage.data() + i * maxPayloadSize;
+        }
+    }
+
+    SegmentResult PacketReassembler::add(uint64_t source, const Packet& packet, Clock::time_point now, Payload& complete)
+    {
+        const PacketHeader& header = packet.header;
+        if (header.isComplete())
+        {
+            complete = Payload{source, header.sequenceNumber, header.encoding, packet.payload};
+            ++m_stats.completed;
+            return SegmentResult::COMPLETE;
+        }
+
+        if (static_cast<uint64_t>(header.segmentOffset) + packet.payload.size() > m_maxPayloadSize)
+        {
+            ++m_stats.tooLarge;
+            return SegmentResult::TOO_LARGE;
+        }
+
+        Slot& slot = findSlot(source, header.sequenceNumber, now);
+        if (slot.state == SlotState::FREE)
+        {
+            slot.state = SlotState::ASSEMBLING;
+            slot.encoding = header.encoding;
+        }
+
+        const SegmentResult result = store(slot, packet);
+        switch (result)
+        {
+            case SegmentResult::COMPLETE:
+                slot.state = SlotState::COMPLETED;
+                complete = Payload{source, header.sequenceNumber, slot.encoding,
+                                   {slot.buffer, slot.lastOffset + slot.lastLength}};
+                ++m_stats.completed;
+                break;
+            case SegmentResult::PENDING:
+                break;
+            case SegmentResult::DUPLICATE:
+                ++m_stats.duplicates;
+                break;
+            case SegmentResult::CONFLICTING:
+                ++m_stats.conflicting;
+                break;
+            case SegmentResult::TOO_LARGE:
+                ++m_stats.tooLarge;
+                break;
+        }
+
+        // Don't hold a slot for a payload whose only segment was dropped.
+        if (slot.state == SlotState::ASSEMBLING && slot.received == 0 && !slot.hasLast)
+        {
+            slot.state = SlotState::FREE;
+        }
+        return result;
+    }
+
+    std::size_t PacketReassembler::expire(Clock::time_point now)
+    {
+        std::size_t expired = 0;
+        for (Slot& slot : m_slots)
+        {
+            if (slot.state != SlotState::FREE && now - slot.started > m_timeout)
+            {
+                if (slot.state == SlotState::ASSEMBLING)
+                {
+                    ++expired;
+                }
+                slot.state = SlotState::FREE;
+            }
+        }
+        m_stats.timedOut += expired;
+        return expired;
+    }
+
+    std::size_t PacketReassembler::bucketOf(uint64_t source, uint16_t sequenceNumber) const
+    {
+        uint64_t hash = source ^ (sequenceNumber * 0x9E3779B97F4A7C15ull);
+        hash ^= hash >> 32;
+        hash *= 0xD6E8FEB86659FD93ull;
+        hash ^= hash >> 32;
+        return static_cast<std::size_t>(hash % (m_slots.size() / WAYS));
+    }
+
+    PacketReassembler::Slot& PacketReassembler::findSlot(uint64_t source, uint16_t sequenceNumber, Clock::time_point now)
+    {
+        Slot* const bucket = m_slots.data() + bucketOf(source, sequenceNumber) * WAYS;
+
+        // Lower is a better slot to take: free, then completed, then timed out, then the oldest in progress.
+        const auto rank = [this, now](const Slot& slot)
+        {
+            switch (slot.state)
+            {
+                case SlotState::FREE: return 0;
+                case SlotState::COMPLETED: return 1;
+                case SlotState::ASSEMBLING: return now - slot.started > m_timeout ? 2 : 3;
+            }
+            return 3;
+        };
+
+        Slot* victim = nullptr;
+        for (std::size_t i = 0; i < WAYS; ++i)
+        {
+            Slot& slot = bucket[i];
+            if (slot.state != SlotState::FREE && slot.source == source && slot.sequenceNumber == sequenceNumber)
+            {
+                if (now - slot.started <= m_timeout)
+                {
+                    return slot;
+                }
+
+                // A sequence number that has come round again, or a payload that never completed.
+                victim = &slot;
+                break;
+            }
+
+            if (victim == nullptr || rank(slot) < rank(*victim) ||
+                (rank(slot) == rank(*victim) && slot.started < victim->started))
+            {
+                victim = &slot;
+            }
+        }
+
+        switch (rank(*victim))
+        {
+            case 2:
+                ++m_stats.timedOut;
+                break;
+            case 3:
+                ++m_stats.evicted;
+                break;
+            default:
+                break;
+        }
+
+        uint8_t* const buffer = victim->buffer;
+        *victim = Slot{};
+        victim->buffer = buffer;
+        victim->source = source;
+        victim->sequenceNumber = sequenceNumber;
+        victim->started = now;
+        return *victim;
+    }
+
+    SegmentResult PacketReassembler::store(Slot& slot, const Packet& packet)
+    {
+        if (slot.state == SlotState::COMPLETED)
+        {
+            return SegmentResult::DUPLICATE;
+        }
+        if (packet.header.encoding != slot.encoding)
+        {
+            return SegmentResult::CONFLICTING;
+        }
+
+        const uint32_t offset = packet.header.segmentOffset;
+        const auto length = static_cast<uint32_t>(packet.payload.size());
+
+        if (packet.header.lastSegment)
+        {
+            if (slot.hasLast)
+            {
+                return offset == slot.lastOffset && length == slot.lastLength ? SegmentResult::DUPLICATE
+                                                                              : SegmentResult::CONFLICTING;
+            }
+
+            slot.lastOffset = offset;
+            slot.lastLength = length;
+            if (slot.segmentLength != 0)
+            {
+                if (!lastFits(slot, slot.segmentLength, slot.highestIndex))
+                {
+                    return SegmentResult::CONFLICTING;
+                }
+                slot.segments.set(offset / slot.segmentLength);
+                ++slot.received;
+            }
+            slot.hasLast = true;
+        }
+        else
+        {
+            // The first segment other than the last sets the length of them all.
+            const bool first = slot.segmentLength == 0;
+            const uint32_t segmentLength = first ? length : slot.segmentLength;
+            if (length == 0 || length != segmentLength || offset % segmentLength != 0)
+            {
+                return SegmentResult::CONFLICTING;
+            }
+
+            const uint32_t index = offset / segmentLength;
+            if (index >= MAX_SEGMENTS)
+            {
+                return SegmentResult::TOO_LARGE;
+            }
+            if (slot.segments.test(index))
+            {
+                return SegmentResult::DUPLICATE;
+            }
+            if (slot.hasLast && (first ? !lastFits(slot, segmentLength, index) : index >= slot.lastOffset / segmentLength))
+            {
+                return SegmentResult::CONFLICTING;
+            }
+
+            slot.segments.set(index);
+            ++slot.received;
+            slot.highestIndex = std::max(slot.highestIndex, index);
+            slot.segmentLength = segmentLength;
+            if (first && slot.hasLast)
+            {
+                slot.segments.set(slot.lastOffset / segmentLength);
+                ++slot.received;
+            }
+        }
+
+        if (length > 0)
+        {
+            std::memcpy(slot.buffer + offset, packet.payload.data(), length);
+        }
+
+        if (slot.hasLast && slot.segmentLength != 0 && slot.received == slot.lastOffset / slot.segmentLength + 1)
+        {
+            return SegmentResult::COMPLETE;
+        }
+        return SegmentResult::PENDING;
+    }
+
+    bool PacketReassembler::lastFits(const Slot& slot, uint32_t segmentLength, uint32_t highest)
+    {
+        const uint32_t lastIndex = slot.lastOffset / segmentLength;
+        return slot.lastOffset % segmentLength == 0 && slot.lastLength <= segmentLength &&
+               lastIndex < MAX_SEGMENTS && lastIndex > highest;
+    }
+} // namespace opentrackio
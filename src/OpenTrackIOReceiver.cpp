@@ -0,0 +1,638 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "opentrackio-cpp/OpenTrackIOReceiver.h"
+#include <algorithm>
+#include <bit>
+#include <cerrno>
+#include <cstring>
+#ifdef OPENTRACKIO_IO_URING
+#include "opentrackio-cpp/OpenTrackIOUring.h"
+#endif
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+namespace opentrackio
+{
+    namespace
+    {
+        // How long a worker thread waits for datagrams before checking whether it has been stopped.
+        constexpr std::chrono::milliseconds STOP_POLL_INTERVAL{100};
+
+        /**
+        * Whether a failed receive only means there was nothing to read yet. */
+        bool isNothingToRead(int error)
+        {
+            return error == EAGAIN || error == EWOULDBLOCK || error == EINTR;
+        }
+
+        /**
+        * Adds to a counter only its worker writes, so a plain load and store will do. */
+        void bump(std::atomic<uint64_t>& counter, uint64_t amount)
+        {
+            counter.store(counter.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+        }
+
+#ifdef OPENTRACKIO_IO_URING
+        // The provided buffer group the multishot receives pick from.
+        constexpr uint16_t BUFFER_GROUP = 0;
+
+        // user_data of the io_uring requests, to tell their completions apart.
+        constexpr uint64_t RECEIVE = 1;
+        constexpr uint64_t CANCEL = 2;
+        constexpr uint64_t PROBE = 3;
+
+        bool submitReceive(IoUring& ring, int socket, msghdr& message, uint64_t userData)
+        {
+            io_uring_sqe* const sqe = ring.getSqe();
+            if (sqe == nullptr)
+            {
+                return false;
+            }
+            sqe->opcode = IORING_OP_RECVMSG;
+            sqe->fd = socket;
+            sqe->addr = reinterpret_cast<uint64_t>(&message);
+            sqe->ioprio = IORING_RECV_MULTISHOT;
+            sqe->flags = IOSQE_BUFFER_SELECT;
+            sqe->buf_group = BUFFER_GROUP;
+            sqe->user_data = userData;
+            return ring.submit() == 1;
+        }
+
+        bool submitCancel(IoUring& ring, uint64_t userData)
+        {
+            io_uring_sqe* const sqe = ring.getSqe();
+            if (sqe == nullptr)
+            {
+                return false;
+            }
+            sqe->opcode = IORING_OP_ASYNC_CANCEL;
+            sqe->addr = userData;
+            sqe->user_data = CANCEL;
+            return ring.submit() == 1;
+        }
+
+        /**
+        * Whether the kernel supports multishot receives, which came in Linux 6.0, tried on a socket of its own so
+        * that no datagram is lost to the probe. Leaves no completions behind. */
+        bool supportsMultishotReceive(IoUring& ring, msghdr& message)
+        {
+            const int probe = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+            if (probe < 0)
+            {
+                return false;
+            }
+
+            // A kernel without them rejects one as soon as it is submitted, otherwise it runs until cancelled.
+            bool finished = false;
+            bool supported = submitReceive(ring, probe, message, PROBE);
+            bool cancelled = false;
+            for (int attempt = 0; supported && !finished && attempt < 10; ++attempt)
+            {
+                const unsigned int ready = ring.ready();
+                for (unsigned int i = 0; i < ready; ++i)
+                {
+                    const io_uring_cqe& cqe = ring.completion(i);
+                    if (cqe.user_data == PROBE && (cqe.flags & IORING_CQE_F_MORE) == 0)
+                    {
+                        finished = true;
+                        supported = cqe.res != -EINVAL;
+                    }
+                }
+                ring.consume(ready);
+
+                if (!finished)
+                {
+                    cancelled = cancelled || submitCancel(ring, PROBE);
+                    ring.submit(1, std::chrono::milliseconds(100));
+                }
+            }
+
+            ::close(probe);
+            return supported && finished;
+        }
+#endif
+    } // namespace
+
+    struct OpenTrackIOReceiver::Worker
+    {
+        explicit Worker(const Settings& settings)
+            : buffers(settings.batchSize * settings.maxDatagramSize),
+              iovecs(settings.batchSize),
+              addresses(settings.batchSize),
+              messages(settings.batchSize),
+              reassembler{settings.reassemblySlots, settings.maxPayloadSize, settings.reassemblyTimeout}
+        {
+            for (std::size_t i = 0; i < messages.size(); ++i)
+            {
+                iovecs[i].iov_base = buffers.data() + i * settings.maxDatagramSize;
+                iovecs[i].iov_len = settings.maxDatagramSize;
+                messages[i].msg_hdr.msg_iov = &iovecs[i];
+                messages[i].msg_hdr.msg_iovlen = 1;
+                messages[i].msg_hdr.msg_name = &addresses[i];
+            }
+        }
+
+        ~Worker()
+        {
+            if (socket >= 0)
+            {
+                ::close(socket);
+            }
+        }
+
+        Worker(const Worker&) = delete;
+        Worker& operator=(const Worker&) = delete;
+
+        int socket = -1;
+
+        // The ring of batchSize datagram buffers recvmmsg() reads into, and the headers that point at them.
+        std::vector<uint8_t> buffers;
+        std::vector<iovec> iovecs;
+        std::vector<sockaddr_in> addresses;
+        std::vector<mmsghdr> messages;
+
+        PacketReassembler reassembler;
+        OpenTrackIOSample sample{};
+
+#ifdef OPENTRACKIO_IO_URING
+        // With IO_URING, the registered buffers, each a io_uring_recvmsg_out header, the sender's address and a
+        // datagram, and the ring using them, which is declared after them to be closed first.
+        std::vector<uint8_t> ringBuffers{};
+        msghdr ringMessage{};
+        IoUring ring{};
+
+        // The kernel completes a multishot receive on the thread that armed it, so whichever thread receives on
+        // the worker arms it again, after cancelling the receive of the last one.
+        std::thread::id armedBy{};
+        bool cancelling = false;
+#endif
+
+        std::atomic<uint64_t> batches = 0;
+        std::atomic<uint64_t> datagrams = 0;
+        std::atomic<uint64_t> bytes = 0;
+        std::atomic<uint64_t> truncated = 0;
+        std::atomic<uint64_t> badPackets = 0;
+        std::atomic<uint64_t> droppedSegments = 0;
+        std::atomic<uint64_t> samples = 0;
+        std::atomic<uint64_t> parseFailures = 0;
+        std::atomic<uint64_t> systemCalls = 0;
+        std::atomic<uint64_t> receiveErrors = 0;
+
+        // The errno of the last receive error, 0 for none.
+        std::atomic<int> lastError = 0;
+    };
+
+    struct OpenTrackIOReceiver::Counts
+    {
+        uint64_t bytes = 0;
+        uint64_t truncated = 0;
+        uint64_t badPackets = 0;
+        uint64_t droppedSegments = 0;
+        uint64_t samples = 0;
+        uint64_t parseFailures = 0;
+        uint64_t systemCalls = 0;
+        uint64_t receiveErrors = 0;
+    };
+
+    OpenTrackIOReceiver::OpenTrackIOReceiver(Settings settings) : m_settings{std::move(settings)}
+    {
+        m_settings.batchSize = std::max<std::size_t>(m_settings.batchSize, 1);
+    }
+
+    OpenTrackIOReceiver::~OpenTrackIOReceiver()
+    {
+        stop();
+        close();
+    }
+
+    bool OpenTrackIOReceiver::open()
+    {
+        if (!m_workers.empty())
+        {
+            return true;
+        }
+
+        const std::size_t sources = m_settings.sourceNumbers.size();
+        std::size_t workers = std::max<std::size_t>(m_settings.workers, 1);
+        if (sources > 0)
+        {
+            workers = std::min(workers, sources);
+        }
+
+        const auto fail = [this]()
+        {
+            m_error = std::error_code{errno, std::system_category()};
+            close();
+            return false;
+        };
+
+        for (std::size_t i = 0; i < workers; ++i)
+        {
+            auto& worker = *m_workers.emplace_back(std::make_unique<Worker>(m_settings));
+            worker.socket = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+            if (worker.socket < 0)
+            {
+                return fail();
+            }
+
+            const int on = 1;
+            const int off = 0;
+            if (::setsockopt(worker.socket, SOL_SOCKET, SO_REUSEADDR, &on, sizeof(on)) != 0 ||
+                ::setsockopt(worker.socket, SOL_SOCKET, SO_REUSEPORT, &on, sizeof(on)) != 0 ||
+                ::setsockopt(worker.socket, IPPROTO_IP, IP_MULTICAST_ALL, &off, sizeof(off)) != 0)
+            {
+                return fail();
+            }
+
+            if (m_settings.receiveBufferSize > 0 &&
+                ::setsockopt(worker.socket, SOL_SOCKET, SO_RCVBUF, &m_settings.receiveBufferSize,
+                             sizeof(m_settings.receiveBufferSize)) != 0)
+            {
+                return fail();
+            }
+
+            sockaddr_in address{};
+            address.sin_family = AF_INET;
+            address.sin_port = htons(m_settings.port);
+            address.sin_addr.s_addr = htonl(INADDR_ANY);
+            if (::bind(worker.socket, reinterpret_cast<const sockaddr*>(&address), sizeof(address)) != 0)
+            {
+                return fail();
+            }
+
+            for (std::size_t source = i; source < sources; source += workers)
+            {
+                ip_mreq membership{};
+                membership.imr_multiaddr.s_addr = htonl(multicastGroup(m_settings.sourceNumbers[source]));
+                membership.imr_interface.s_addr = htonl(m_settings.interfaceAddress);
+                if (::setsockopt(worker.socket, IPPROTO_IP, IP_ADD_MEMBERSHIP, &membership, sizeof(membership)) != 0)
+                {
+                    return fail();
+                }
+            }
+        }
+
+        m_error = {};
+#ifdef OPENTRACKIO_IO_URING
+        m_backend = m_settings.backend == TransportBackend::IO_URING && openRings() ? TransportBackend::IO_URING
+                                                                                     : TransportBackend::SOCKETS;
+#else
+        m_backend = TransportBackend::SOCKETS;
+#endif
+        return true;
+    }
+
+#ifdef OPENTRACKIO_IO_URING
+    bool OpenTrackIOReceiver::openRings()
+    {
+        // Twice the completions handled per receive(), so the kernel can fill one batch while the last is handled.
+        const auto bufferCount = static_cast<uint16_t>(
+            std::bit_ceil(std::clamp<std::size_t>(2 * m_settings.batchSize, 16, 32768)));
+
+        const auto closeRings = [this]()
+        {
+            for (const auto& worker : m_workers)
+            {
+                worker->ring.close();
+                worker->ringBuffers = {};
+            }
+            return false;
+        };
+
+        const std::size_t bufferSize = sizeof(io_uring_recvmsg_out) + sizeof(sockaddr_in) + m_settings.maxDatagramSize;
+        for (const auto& worker : m_workers)
+        {
+            worker->ringBuffers.resize(bufferCount * bufferSize);
+            worker->ringMessage.msg_namelen = sizeof(sockaddr_in);
+
+            // Every buffer the kernel can fill posts a completion, so a completion queue as large never overflows.
+            if (!worker->ring.open(4, bufferCount) ||
+                !worker->ring.registerBufferRing(BUFFER_GROUP, worker->ringBuffers, bufferSize, bufferCount) ||
+                !supportsMultishotReceive(worker->ring, worker->ringMessage))
+            {
+                return closeRings();
+            }
+        }
+        return true;
+    }
+
+    void OpenTrackIOReceiver::armReceive(Worker& worker)
+    {
+        worker.cancelling = false;
+        worker.armedBy = submitReceive(worker.ring, worker.socket, worker.ringMessage, RECEIVE)
+                             ? std::this_thread::get_id()
+                             : std::thread::id{};
+    }
+#endif
+
+    bool OpenTrackIOReceiver::start(SampleHandler handler)
+    {
+        if (!m_threads.empty())
+        {
+            return true;
+        }
+        if (!open())
+        {
+            return false;
+        }
+
+        for (std::size_t i = 0; i < m_workers.size(); ++i)
+        {
+            m_threads.emplace_back([this, i, handler](std::stop_token stop)
+            {
+                while (!stop.stop_requested())
+                {
+                    receive(i, handler, STOP_POLL_INTERVAL);
+                }
+            });
+        }
+        return true;
+    }
+
+    void OpenTrackIOReceiver::stop()
+    {
+        for (std::jthread& thread : m_threads)
+        {
+            thread.request_stop();
+        }
+        m_threads.clear();
+    }
+
+    void OpenTrackIOReceiver::close()
+    {
+        m_workers.clear();
+    }
+
+    std::size_t OpenTrackIOReceiver::receive(std::size_t index, const SampleHandler& handler,
+                                             std::chrono::milliseconds timeout)
+    {
+        Worker& worker = *m_workers.at(index);
+#ifdef OPENTRACKIO_IO_URING
+        if (m_backend == TransportBackend::IO_URING)
+        {
+            return receiveRing(worker, handler, timeout);
+        }
+#endif
+        return receiveSockets(worker, handler, timeout);
+    }
+
+    std::size_t OpenTrackIOReceiver::receiveSockets(Worker& worker, const SampleHandler& handler,
+                                                    std::chrono::milliseconds timeout)
+    {
+        for (mmsghdr& message : worker.messages)
+        {
+            message.msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            message.msg_hdr.msg_flags = 0;
+        }
+
+        const auto batchSize = static_cast<unsigned int>(worker.messages.size());
+        Counts counts{};
+
+        // Only wait when the socket is empty, so that a busy socket takes one system call per batch.
+        int count = ::recvmmsg(worker.socket, worker.messages.data(), batchSize, MSG_DONTWAIT, nullptr);
+        ++counts.systemCalls;
+        if (count < 0 && isNothingToRead(errno))
+        {
+            pollfd readable{worker.socket, POLLIN, 0};
+            const int polled = ::poll(&readable, 1, static_cast<int>(timeout.count()));
+            ++counts.systemCalls;
+            if (polled > 0)
+            {
+                count = ::recvmmsg(worker.socket, worker.messages.data(), batchSize, MSG_DONTWAIT, nullptr);
+                ++counts.systemCalls;
+            }
+            else if (polled == 0 || errno == EINTR)
+            {
+                count = 0;
+            }
+        }
+        if (count < 0 && !isNothingToRead(errno))
+        {
+            // A failing socket, e.g. EBADF or ENOMEM, fails again straight away, so wait as long as an idle one would.
+            worker.lastError.store(errno, std::memory_order_relaxed);
+            bump(worker.receiveErrors, 1);
+            bump(worker.systemCalls, counts.systemCalls);
+            std::this_thread::sleep_for(timeout);
+            return 0;
+        }
+        if (count <= 0)
+        {
+            bump(worker.systemCalls, counts.systemCalls);
+            return 0;
+        }
+
+        const PacketReassembler::Clock::time_point now = PacketReassembler::Clock::now();
+        for (int i = 0; i < count; ++i)
+        {
+            const mmsghdr& message = worker.messages[i];
+            counts.bytes += message.msg_len;
+            if ((message.msg_hdr.msg_flags & MSG_TRUNC) != 0)
+            {
+                ++counts.truncated;
+                continue;
+            }
+
+            handleDatagram(worker, {static_cast<const uint8_t*>(worker.iovecs[i].iov_base), message.msg_len},
+                           worker.addresses[i], now, handler, counts);
+        }
+        worker.reassembler.expire(now);
+
+        bump(worker.batches, 1);
+        bump(worker.datagrams, static_cast<uint64_t>(count));
+        bump(worker.bytes, counts.bytes);
+        bump(worker.truncated, counts.truncated);
+        bump(worker.badPackets, counts.badPackets);
+        bump(worker.droppedSegments, counts.droppedSegments);
+        bump(worker.samples, counts.samples);
+        bump(worker.parseFailures, counts.parseFailures);
+        bump(worker.systemCalls, counts.systemCalls);
+        return static_cast<std::size_t>(count);
+    }
+
+#ifdef OPENTRACKIO_IO_URING
+    std::size_t OpenTrackIOReceiver::receiveRing(Worker& worker, const SampleHandler& handler,
+                                                 std::chrono::milliseconds timeout)
+    {
+        IoUring& ring = worker.ring;
+        const uint64_t enterCalls = ring.enterCalls();
+
+        if (worker.armedBy != std::this_thread::get_id() && !worker.cancelling)
+        {
+            if (worker.armedBy == std::thread::id{})
+            {
+                armReceive(worker);
+            }
+            else
+            {
+                worker.cancelling = submitCancel(ring, RECEIVE);
+            }
+        }
+
+        // Completions are read from memory the kernel shares, it is only entered to wait when there are none. A zero
+        // timeout polls as it does with SOCKETS, where waiting for one with no timeout would block.
+        if (ring.ready() == 0)
+        {
+            ring.submit(timeout.count() == 0 ? 0 : 1, timeout);
+        }
+        const unsigned int ready = std::min<unsigned int>(ring.ready(), worker.messages.size());
+
+        const PacketReassembler::Clock::time_point now = PacketReassembler::Clock::now();
+        Counts counts{};
+        uint64_t datagrams = 0;
+        bool armed = true;
+        for (unsigned int i = 0; i < ready; ++i)
+        {
+            const io_uring_cqe& cqe = ring.completion(i);
+            if (cqe.user_data != RECEIVE)
+            {
+                continue;
+            }
+
+            // The receive stops when it is cancelled or e.g. runs out of buffers, after handing these back it is
+            // armed again.
+            if ((cqe.flags & IORING_CQE_F_MORE) == 0)
+            {
+                armed = false;
+            }
+            // ENOBUFS only means the handed back buffers haven't been committed yet, ECANCELED that the receive was
+            // cancelled to arm it on another thread.
+            if (cqe.res < 0 && cqe.res != -ENOBUFS && cqe.res != -ECANCELED && !isNothingToRead(-cqe.res))
+            {
+                worker.lastError.store(-cqe.res, std::memory_order_relaxed);
+                ++counts.receiveErrors;
+            }
+            if (cqe.res < 0 || (cqe.flags & IORING_CQE_F_BUFFER) == 0)
+            {
+                continue;
+            }
+
+            const auto id = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+            const uint8_t* const buffer = ring.buffer(id);
+            io_uring_recvmsg_out out{};
+            std::memcpy(&out, buffer, sizeof(out));
+            sockaddr_in sender{};
+            std::memcpy(&sender, buffer + sizeof(out), sizeof(sender));
+
+            ++datagrams;
+            counts.bytes += out.payloadlen;
+            if ((out.flags & MSG_TRUNC) != 0)
+            {
+                ++counts.truncated;
+            }
+            else
+            {
+                const std::size_t offset =
+                    sizeof(out) + worker.ringMessage.msg_namelen + worker.ringMessage.msg_controllen;
+                handleDatagram(worker, {buffer + offset, out.payloadlen}, sender, now, handler, counts);
+            }
+            ring.recycleBuffer(id);
+        }
+        ring.consume(ready);
+        ring.commitBuffers();
+        worker.reassembler.expire(now);
+
+        if (!armed)
+        {
+            armReceive(worker);
+        }
+        counts.systemCalls = ring.enterCalls() - enterCalls;
+
+        bump(worker.systemCalls, counts.systemCalls);
+        bump(worker.receiveErrors, counts.receiveErrors);
+        if (datagrams == 0)
+        {
+            // A receive failing on arming completes at once, so wait as long as an idle one would, as with SOCKETS.
+            if (counts.receiveErrors > 0)
+            {
+                std::this_thread::sleep_for(timeout);
+            }
+            return 0;
+        }
+        bump(worker.batches, 1);
+        bump(worker.datagrams, datagrams);
+        bump(worker.bytes, counts.bytes);
+        bump(worker.truncated, counts.truncated);
+        bump(worker.badPackets, counts.badPackets);
+        bump(worker.droppedSegments, counts.droppedSegments);
+        bump(worker.samples, counts.samples);
+        bump(worker.parseFailures, counts.parseFailures);
+        return static_cast<std::size_t>(datagrams);
+    }
+#endif
+
+    void OpenTrackIOReceiver::handleDatagram(Worker& worker, std::span<const uint8_t> datagram,
+                                             const sockaddr_in& sender, PacketReassembler::Clock::time_point now,
+                                             const SampleHandler& handler, Counts& counts)
+    {
+        Packet packet{};
+        if (decodePacket(datagram, packet) != PacketError::NONE)
+        {
+            ++counts.badPackets;
+            return;
+        }
+
+        const uint64_t source = (static_cast<uint64_t>(ntohl(sender.sin_addr.s_addr)) << 32) | ntohs(sender.sin_port);
+
+        PacketReassembler::Payload complete{};
+        switch (worker.reassembler.add(source, packet, now, complete))
+        {
+            case SegmentResult::COMPLETE:
+                if (initialiseFromPayload(worker.sample, complete.encoding, complete.payload))
+                {
+                    ++counts.samples;
+                    handler(worker.sample, source);
+                }
+                else
+                {
+                    ++counts.parseFailures;
+                }
+                break;
+            case SegmentResult::PENDING:
+                break;
+            case SegmentResult::DUPLICATE:
+            case SegmentResult::CONFLICTING:
+            case SegmentResult::TOO_LARGE:
+                ++counts.droppedSegments;
+                break;
+        }
+    }
+
+    OpenTrackIOReceiver::Stats OpenTrackIOReceiver::stats() const
+    {
+        Stats total{};
+        for (const auto& worker : m_workers)
+        {
+            total.batches += worker->batches.load(std::memory_order_relaxed);
+            total.datagrams += worker->datagrams.load(std::memory_order_relaxed);
+            total.bytes += worker->bytes.load(std::memory_order_relaxed);
+            total.truncated += worker->truncated.load(std::memory_order_relaxed);
+            total.badPackets += worker->badPackets.load(std::memory_order_relaxed);
+            total.droppedSegments += worker->droppedSegments.load(std::memory_order_relaxed);
+            total.samples += worker->samples.load(std::memory_order_relaxed);
+            total.parseFailures += worker->parseFailures.load(std::memory_order_relaxed);
+            total.systemCalls += worker->systemCalls.load(std::memory_order_relaxed);
+            total.receiveErrors += worker->receiveErrors.load(std::memory_order_relaxed);
+        }
+        return total;
+    }
+
+    std::error_code OpenTrackIOReceiver::error(std::size_t worker) const
+    {
+        const int error = m_workers.at(worker)->lastError.load(std::memory_order_relaxed);
+        return error == 0 ? std::error_code{} : std::error_code{error, std::system_category()};
+    }
+} // namespace opentrackio
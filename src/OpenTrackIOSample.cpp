@@ -12,12 +12,15 @@
  */
 
 #include "opentrackio-cpp/OpenTrackIOSample.h"
+#include "opentrackio-cpp/OpenTrackIOSaxParser.h"
+#include "opentrackio-cpp/OpenTrackIOSerializer.h"
+#include <array>
 #include <format>
 
 namespace opentrackio
 {
-    template<typename T>
-    void assignJson(nlohmann::json &json, std::string_view field, const std::optional<T> &value)
+    template<typename Json, typename T>
+    void assignJson(Json& json, std::string_view field, const std::optional<T> &value)
     {
         if (value.has_value())
         {
@@ -25,8 +28,17 @@ namespace opentrackio
         }
     };
 
-    template<typename T>
-    void assignJson(nlohmann::json &json, std::string_view field, const std::optional<opentrackiotypes::Dimensions<T>> &value)
+    template<typename Json, typename T>
+    void assignJson(Json& json, std::string_view field, const opentrackiotypes::CopyOnWrite<T> &value)
+    {
+        if (value.has_value())
+        {
+            json[field] = value.value();
+        }
+    }
+
+    template<typename Json, typename T>
+    void assignJson(Json& json, std::string_view field, const std::optional<opentrackiotypes::Dimensions<T>> &value)
     {
         if (value.has_value())
         {
@@ -35,8 +47,8 @@ namespace opentrackio
         }
     }
 
-    template<>
-    void assignJson(nlohmann::json &json, std::string_view field, const std::optional<opentrackiotypes::Rational> &value)
+    template<typename Json>
+    void assignJson(Json& json, std::string_view field, const std::optional<opentrackiotypes::Rational> &value)
     {
         if (value.has_value())
         {
@@ -45,8 +57,8 @@ namespace opentrackio
         }
     };
 
-    template<>
-    void assignJson(nlohmann::json &json, std::string_view field, const std::optional<opentrackiotypes::Timestamp> &value)
+    template<typename Json>
+    void assignJson(Json& json, std::string_view field, const std::optional<opentrackiotypes::Timestamp> &value)
     {
         if (value.has_value())
         {
@@ -55,125 +67,319 @@ namespace opentrackio
         }
     };
 
+    /**
+    * Formats the URN on the stack so that only the JSON's own string allocates. */
+    template<typename Json>
+    void assignUrn(Json& json, const opentrackiotypes::Uuid& uuid)
+    {
+        std::array<char, opentrackiotypes::Uuid::URN_LENGTH> urn{};
+        uuid.toUrn(urn);
+        json = std::string_view{urn.data(), urn.size()};
+    }
+
     bool OpenTrackIOSample::initialise(const nlohmann::json &json)
     {
-        // Take a copy of the full JSON for referencing later if needed.
-        m_json = json;
+        m_visitedFields.clear();
+        m_visitedFields.setDocumentOwned(false);
+        return parseDocument(json);
+    }
+
+    bool OpenTrackIOSample::initialise(nlohmann::json &&json)
+    {
+        // Taken over first so that what's moved out of is never the caller's, only the local that's discarded.
+        nlohmann::json document = std::move(json);
+        json = nullptr;
+
+        m_visitedFields.clear();
+        m_visitedFields.setDocumentOwned(true);
+        return parseDocument(document);
+    }
 
+    bool OpenTrackIOSample::parseDocument(const nlohmann::json &json)
+    {
         /**
-         * Take a second copy of the original which will have all processed fields removed (this is to check for
-         * leftover fields. */
-
-        nlohmann::json jsonCopy = json;
-        camera = opentrackioproperties::Camera::parse(jsonCopy, m_errorMessages);
-        duration = opentrackioproperties::Duration::parse(jsonCopy, m_errorMessages);
-        globalStage = opentrackioproperties::GlobalStage::parse(jsonCopy, m_errorMessages);
-        lens = opentrackioproperties::Lens::parse(jsonCopy, m_errorMessages);
-        protocol = opentrackioproperties::Protocol::parse(jsonCopy, m_errorMessages);
-        relatedSampleIds = opentrackioproperties::RelatedSampleIds::parse(jsonCopy, m_errorMessages);
-        sampleId = opentrackioproperties::SampleId::parse(jsonCopy, m_errorMessages);
-        sourceId = opentrackioproperties::SourceId::parse(jsonCopy, m_errorMessages);
-        sourceNumber = opentrackioproperties::SourceNumber::parse(jsonCopy, m_errorMessages);
-        timing = opentrackioproperties::Timing::parse(jsonCopy, m_errorMessages);
-        tracker = opentrackioproperties::Tracker::parse(jsonCopy, m_errorMessages);
-        transforms = opentrackioproperties::Transforms::parse(jsonCopy, m_errorMessages);
-
-        if (!m_errorMessages.empty())
+         * The input is only ever read, or moved out of when it's owned. Each property records the fields it consumed
+         * in m_visitedFields so that any leftover fields can be reported afterwards without copying the input and
+         * erasing as we go. */
+        clearMessages();
+        m_staticBlock = nullptr;
+
+        camera = opentrackioproperties::Camera::parse(json, m_errors, m_visitedFields);
+        duration = opentrackioproperties::Duration::parse(json, m_errors, m_visitedFields);
+        globalStage = opentrackioproperties::GlobalStage::parse(json, m_errors, m_visitedFields);
+        lens = opentrackioproperties::Lens::parse(json, m_errors, m_visitedFields);
+        protocol = opentrackioproperties::Protocol::parse(json, m_errors, m_visitedFields);
+        relatedSampleIds = opentrackioproperties::RelatedSampleIds::parse(json, m_errors, m_visitedFields);
+        sampleId = opentrackioproperties::SampleId::parse(json, m_errors, m_visitedFields);
+        sourceId = opentrackioproperties::SourceId::parse(json, m_errors, m_visitedFields);
+        sourceNumber = opentrackioproperties::SourceNumber::parse(json, m_errors, m_visitedFields);
+        timing = opentrackioproperties::Timing::parse(json, m_errors, m_visitedFields);
+        tracker = opentrackioproperties::Tracker::parse(json, m_errors, m_visitedFields);
+        transforms = opentrackioproperties::Transforms::parse(json, m_errors, m_visitedFields);
+
+        if (!m_errors.empty())
         {
             return false;
         }
 
         if (isEmpty())
         {
-            m_errorMessages.emplace_back("Sample contains no properties after parsing JSON.");
+            m_errors.add(ErrorCode::NO_PROPERTIES);
             return false;
         }
 
-        // Check the copy to see if it has remaining fields and if so bubble up warnings.
-        warnForRemainingFields(jsonCopy);
+        // Check for fields that weren't consumed by any property and if so bubble up warnings.
+        warnForRemainingFields(json);
 
         return true;
     }
 
     bool OpenTrackIOSample::initialise(const std::string_view jsonString)
     {
-        constexpr auto parseCallback = nullptr;
-        constexpr bool allowExceptions = false;
-        const nlohmann::json from_string = nlohmann::json::parse(jsonString, parseCallback, allowExceptions);
+        return initialise(jsonString, SampleFields::ALL);
+    }
+
+    bool OpenTrackIOSample::initialise(std::span<const uint8_t> cbor)
+    {
+        return initialise(cbor, SampleFields::ALL);
+    }
+
+    bool OpenTrackIOSample::initialise(const std::string_view jsonString, SampleFields fields)
+    {
+        /**
+         * Text is parsed straight into the properties through the SAX parser rather than building a DOM and
+         * handing it to initialise(const nlohmann::json&). Both report the same errors and warnings. */
+        reset();
 
-        if (from_string.is_discarded())
+        std::vector<std::string> remainingFields{};
+        if (!m_parser.parse(jsonString, fields, *this, m_errors, remainingFields))
         {
-            m_errorMessages.emplace_back("Unable to initialise OpenTrackIO sample, JSON parse error.");
+            m_errors.add(ErrorCode::JSON_PARSE_ERROR);
             return false;
         }
+        m_staticBlock = m_parser.staticBlock();
 
-        return initialise(from_string);
+        return completeStreamingParse(remainingFields);
     }
 
-    bool OpenTrackIOSample::initialise(std::span<const uint8_t> cbor)
+    bool OpenTrackIOSample::initialise(std::span<const uint8_t> cbor, SampleFields fields)
     {
-        try
+        /**
+         * CBOR is decoded straight into the properties, as with text, and malformed payloads are reported through
+         * the return value of the decoder instead of exceptions. */
+        reset();
+
+        std::vector<std::string> remainingFields{};
+        OpenTrackIOSaxParser::CborError cborError{};
+        if (!m_parser.parse(cbor, fields, *this, m_errors, remainingFields, cborError))
         {
-            const nlohmann::json from_cbor = nlohmann::json::from_cbor(cbor);
-            return initialise(from_cbor);
+            m_errors.add(ErrorCode::CBOR_PARSE_ERROR, {}, cborError.description, cborError.byte);
+            return false;
         }
-        catch (const nlohmann::json::parse_error& error)
-        {
-            m_errorMessages.emplace_back(
-                std::string("Unable to initialise OpenTrackIO sample, CBOR parse error: ") +
-                error.what() + " at byte " + std::to_string(error.byte));
+        m_staticBlock = m_parser.staticBlock();
+
+        return completeStreamingParse(remainingFields);
+    }
 
+    bool OpenTrackIOSample::completeStreamingParse(const std::vector<std::string>& remainingFields)
+    {
+        if (!m_errors.empty())
+        {
             return false;
         }
-        catch (...)
-        {
-            m_errorMessages.emplace_back(
-                "Unable to initialise OpenTrackIO sample. Unknown exception occurred during CBOR parsing.");
 
+        if (isEmpty())
+        {
+            m_errors.add(ErrorCode::NO_PROPERTIES);
             return false;
         }
+
+        m_warningMessages.insert(m_warningMessages.end(), remainingFields.begin(), remainingFields.end());
+        return true;
+    }
+
+    void OpenTrackIOSample::reset()
+    {
+        m_parser.recycle(*this);
+        m_staticBlock = nullptr;
+        clearMessages();
+    }
+
+    void OpenTrackIOSample::clearMessages()
+    {
+        m_json.clear();
+        m_errors.clear();
+        m_errorMessagesRendered = false;
+        m_warningMessages.clear();
+    }
+
+    const std::vector<std::string>& OpenTrackIOSample::getErrors()
+    {
+        if (!m_errorMessagesRendered)
+        {
+            m_errorMessages.clear();
+            m_errors.render(m_errorMessages);
+            m_errorMessagesRendered = true;
+        }
+
+        return m_errorMessages;
+    }
+
+    const nlohmann::json &OpenTrackIOSample::getJson() const
+    {
+        return m_json.get([this](nlohmann::json& json, SampleFields sections)
+        {
+            updateJson(json, sections);
+        });
+    }
+
+    ArenaJson OpenTrackIOSample::getJson(JsonArena& arena) const
+    {
+        const JsonArena::Scope scope{arena};
+        ArenaJson json{};
+        updateJson(json, SampleFields::ALL);
+        return json;
+    }
+
+    void OpenTrackIOSample::markDirty(SampleFields sections)
+    {
+        m_json.markDirty(sections);
+    }
+
+    OpenTrackIOSample::JsonCache::JsonCache(const JsonCache& other)
+    {
+        std::scoped_lock lock{other.m_mutex};
+        m_json = other.m_json;
+        m_dirty = other.m_dirty;
+        m_ready.store(other.m_ready.load(std::memory_order_relaxed), std::memory_order_relaxed);
     }
 
-    const nlohmann::json &OpenTrackIOSample::getJson()
+    OpenTrackIOSample::JsonCache& OpenTrackIOSample::JsonCache::operator=(const JsonCache& other)
     {
-        if (!m_json.has_value())
+        if (this != &other)
         {
-            generateJson();
+            std::scoped_lock lock{m_mutex, other.m_mutex};
+            m_json = other.m_json;
+            m_dirty = other.m_dirty;
+            m_ready.store(other.m_ready.load(std::memory_order_relaxed), std::memory_order_relaxed);
         }
+        return *this;
+    }
+
+    void OpenTrackIOSample::JsonCache::markDirty(SampleFields sections)
+    {
+        m_dirty = m_dirty | sections;
+        m_ready.store(false, std::memory_order_relaxed);
+    }
 
-        return m_json.value();
+    void OpenTrackIOSample::JsonCache::clear()
+    {
+        m_json = nullptr;
+        m_dirty = SampleFields::ALL;
+        m_ready.store(false, std::memory_order_relaxed);
     }
 
-    void OpenTrackIOSample::generateJson()
+    void OpenTrackIOSample::serializeJson(std::string& out) const
     {
-        namespace props = opentrackioproperties;
+        OpenTrackIOSerializer::writeJson(*this, out);
+    }
 
-        nlohmann::json j;
+    std::optional<std::size_t> OpenTrackIOSample::serializeJson(std::span<char> buffer) const
+    {
+        return OpenTrackIOSerializer::writeJson(*this, buffer);
+    }
 
-        parseCameraToJson(j);
-        parseDurationToJson(j);
-        parseGlobalStageToJson(j);
-        parseLensToJson(j);
-        parseProtocolToJson(j);
-        parseRelatedSampleIdsToJson(j);
-        parseSampleIdToJson(j);
-        parseSourceIdToJson(j);
-        parseSourceNumberToJson(j);
-        parseTimingToJson(j);
-        parseTrackerToJson(j);
-        parseTransformsToJson(j);
+    std::optional<std::size_t> OpenTrackIOSample::serializeCbor(std::span<uint8_t> buffer) const
+    {
+        return OpenTrackIOSerializer::writeCbor(*this, buffer);
+    }
 
-        m_json = j;
+    std::size_t OpenTrackIOSample::serializedCborSize() const
+    {
+        return OpenTrackIOSerializer::cborSize(*this);
     }
 
-    void OpenTrackIOSample::parseCameraToJson(nlohmann::json& baseJson)
+    template<typename Json>
+    void OpenTrackIOSample::updateJson(Json& j, SampleFields sections) const
+    {
+        constexpr SampleFields LENS_SECTIONS = SampleFields::LENS | SampleFields::STATIC_LENS |
+                                               SampleFields::LENS_ENCODERS | SampleFields::LENS_RAW_ENCODERS |
+                                               SampleFields::LENS_DISTORTION;
+        constexpr SampleFields TIMING_SECTIONS = SampleFields::TIMING | SampleFields::TIMING_SAMPLE_TIMESTAMP |
+                                                 SampleFields::TIMING_SYNCHRONIZATION | SampleFields::TIMING_TIMECODE;
+
+        /**
+        * The keys each section writes at the top level and inside the static object. */
+        struct JsonSection
+        {
+            SampleFields flags;
+            std::string_view key;
+            std::string_view staticKey;
+            void (OpenTrackIOSample::*write)(Json&) const;
+        };
+
+        static constexpr std::array<JsonSection, 12> JSON_SECTIONS{{
+            {SampleFields::CAMERA, "", "camera", &OpenTrackIOSample::parseCameraToJson<Json>},
+            {SampleFields::DURATION, "", "duration", &OpenTrackIOSample::parseDurationToJson<Json>},
+            {SampleFields::GLOBAL_STAGE, "globalStage", "", &OpenTrackIOSample::parseGlobalStageToJson<Json>},
+            {LENS_SECTIONS, "lens", "lens", &OpenTrackIOSample::parseLensToJson<Json>},
+            {SampleFields::PROTOCOL, "protocol", "", &OpenTrackIOSample::parseProtocolToJson<Json>},
+            {SampleFields::RELATED_SAMPLE_IDS, "relatedSampleIds", "", &OpenTrackIOSample::parseRelatedSampleIdsToJson<Json>},
+            {SampleFields::SAMPLE_ID, "sampleId", "", &OpenTrackIOSample::parseSampleIdToJson<Json>},
+            {SampleFields::SOURCE_ID, "sourceId", "", &OpenTrackIOSample::parseSourceIdToJson<Json>},
+            {SampleFields::SOURCE_NUMBER, "sourceNumber", "", &OpenTrackIOSample::parseSourceNumberToJson<Json>},
+            {TIMING_SECTIONS, "timing", "", &OpenTrackIOSample::parseTimingToJson<Json>},
+            {SampleFields::TRACKER, "tracker", "tracker", &OpenTrackIOSample::parseTrackerToJson<Json>},
+            {SampleFields::TRANSFORMS, "transforms", "", &OpenTrackIOSample::parseTransformsToJson<Json>},
+        }};
+
+        for (const auto& [flags, key, staticKey, write] : JSON_SECTIONS)
+        {
+            if ((sections & flags) == SampleFields::NONE)
+            {
+                continue;
+            }
+
+            // The section's keys are written again only if its property is still set.
+            if (j.is_object())
+            {
+                if (!key.empty())
+                {
+                    j.erase(key);
+                }
+
+                if (const auto it = j.find("static"); !staticKey.empty() && it != j.end())
+                {
+                    it->erase(staticKey);
+                }
+            }
+            (this->*write)(j);
+        }
+
+        // Match generating from scratch: no empty static object, and null rather than {} without any properties.
+        if (j.is_object())
+        {
+            if (const auto it = j.find("static"); it != j.end() && it->empty())
+            {
+                j.erase(it);
+            }
+
+            if (j.empty())
+            {
+                j = nullptr;
+            }
+        }
+    }
+
+    template<typename Json>
+    void OpenTrackIOSample::parseCameraToJson(Json& baseJson) const
     {
         if (!camera.has_value())
         {
             return;
         }
 
-        auto& cameraJson = baseJson["static"]["camera"];
+        Json cameraJson = Json::object();
         assignJson(cameraJson, "activeSensorPhysicalDimensions", camera->activeSensorPhysicalDimensions);
         assignJson(cameraJson, "activeSensorResolution", camera->activeSensorResolution);
         assignJson(cameraJson, "anamorphicSqueeze", camera->anamorphicSqueeze);
@@ -186,9 +392,11 @@ namespace opentrackio
         assignJson(cameraJson, "fdlLink", camera->fdlLink);
         assignJson(cameraJson, "isoSpeed", camera->isoSpeed);
         assignJson(cameraJson, "shutterAngle", camera->shutterAngle);
+        baseJson["static"]["camera"] = std::move(cameraJson);
     }
 
-    void OpenTrackIOSample::parseDurationToJson(nlohmann::json &baseJson)
+    template<typename Json>
+    void OpenTrackIOSample::parseDurationToJson(Json& baseJson) const
     {
         if (!duration.has_value())
         {
@@ -199,7 +407,8 @@ namespace opentrackio
         baseJson["static"]["duration"]["denom"] = duration->rational.denominator;
     }
 
-    void OpenTrackIOSample::parseGlobalStageToJson(nlohmann::json &baseJson)
+    template<typename Json>
+    void OpenTrackIOSample::parseGlobalStageToJson(Json& baseJson) const
     {
         if (!globalStage.has_value())
         {
@@ -214,7 +423,8 @@ namespace opentrackio
         baseJson["globalStage"]["h0"] = globalStage->h0;
     }
 
-    void OpenTrackIOSample::parseLensToJson(nlohmann::json& baseJson)
+    template<typename Json>
+    void OpenTrackIOSample::parseLensToJson(Json& baseJson) const
     {
         if (!lens.has_value())
         {
@@ -222,72 +432,88 @@ namespace opentrackio
         }
 
         // ------- Static Fields
-        assignJson(baseJson["static"]["lens"], "firmwareVersion", lens->firmwareVersion);
-        assignJson(baseJson["static"]["lens"], "make", lens->make);
-        assignJson(baseJson["static"]["lens"], "model", lens->model);
-        assignJson(baseJson["static"]["lens"], "nominalFocalLength", lens->nominalFocalLength);
-        assignJson(baseJson["static"]["lens"], "serialNumber", lens->serialNumber);
-        assignJson(baseJson["static"]["lens"], "distortionOverscanMax", lens->distortionOverscanMax);
-        assignJson(baseJson["static"]["lens"], "undistortionOverscanMax", lens->undistortionOverscanMax);
+        Json staticLensJson = Json::object();
+        assignJson(staticLensJson, "firmwareVersion", lens->firmwareVersion);
+        assignJson(staticLensJson, "make", lens->make);
+        assignJson(staticLensJson, "model", lens->model);
+        assignJson(staticLensJson, "nominalFocalLength", lens->nominalFocalLength);
+        assignJson(staticLensJson, "serialNumber", lens->serialNumber);
+        assignJson(staticLensJson, "distortionOverscanMax", lens->distortionOverscanMax);
+        assignJson(staticLensJson, "undistortionOverscanMax", lens->undistortionOverscanMax);
+        assignJson(staticLensJson, "calibrationHistory", lens->calibrationHistory);
+
+        if (!staticLensJson.empty())
+        {
+            baseJson["static"]["lens"] = std::move(staticLensJson);
+        }
 
         // ------- Standard Fields
-        assignJson(baseJson["lens"], "custom", lens->custom);
+        Json lensJson = Json::object();
+        assignJson(lensJson, "custom", lens->custom);
 
-        baseJson["lens"]["distortion"] = nlohmann::json::array();
-        for (const auto& dist : lens->distortion.value())
+        if (lens->distortion.has_value())
         {
-            nlohmann::json distJson{};
-            distJson["radial"] = dist.radial;
-            if (dist.tangential.has_value())
+            auto& distortionJson = lensJson["distortion"] = Json::array();
+            for (const auto& dist : lens->distortion.value())
             {
-                distJson["tangential"] = dist.tangential.value();
+                Json distJson{};
+                distJson["radial"] = dist.radial;
+                assignJson(distJson, "tangential", dist.tangential);
+                assignJson(distJson, "model", dist.model);
+                assignJson(distJson, "overscan", dist.overscan);
+                distortionJson.push_back(std::move(distJson));
             }
-            baseJson["lens"]["distortion"].push_back(distJson);
         }
 
         if (lens->distortionOffset.has_value())
         {
-            baseJson["lens"]["distortionOffset"]["x"] = lens->distortionOffset->x;
-            baseJson["lens"]["distortionOffset"]["y"] = lens->distortionOffset->y;
+            lensJson["distortionOffset"]["x"] = lens->distortionOffset->x;
+            lensJson["distortionOffset"]["y"] = lens->distortionOffset->y;
         }
 
         if (lens->encoders.has_value())
         {
-            assignJson(baseJson["lens"]["encoders"], "focus", lens->encoders->focus);
-            assignJson(baseJson["lens"]["encoders"], "iris", lens->encoders->iris);
-            assignJson(baseJson["lens"]["encoders"], "zoom", lens->encoders->zoom);
+            assignJson(lensJson["encoders"], "focus", lens->encoders->focus);
+            assignJson(lensJson["encoders"], "iris", lens->encoders->iris);
+            assignJson(lensJson["encoders"], "zoom", lens->encoders->zoom);
         }
 
-        assignJson(baseJson["lens"], "entrancePupilOffset", lens->entrancePupilOffset);
+        assignJson(lensJson, "entrancePupilOffset", lens->entrancePupilOffset);
 
         if (lens->exposureFalloff.has_value())
         {
-            baseJson["lens"]["exposureFalloff"]["a1"] = lens->exposureFalloff->a1;
-            assignJson(baseJson["lens"]["exposureFalloff"], "a2", lens->exposureFalloff->a2);
-            assignJson(baseJson["lens"]["exposureFalloff"], "a3", lens->exposureFalloff->a3);
+            lensJson["exposureFalloff"]["a1"] = lens->exposureFalloff->a1;
+            assignJson(lensJson["exposureFalloff"], "a2", lens->exposureFalloff->a2);
+            assignJson(lensJson["exposureFalloff"], "a3", lens->exposureFalloff->a3);
         }
 
-        assignJson(baseJson["lens"], "fStop", lens->fStop);
-        assignJson(baseJson["lens"], "pinholeFocalLength", lens->pinholeFocalLength);
-        assignJson(baseJson["lens"], "focusDistance", lens->focusDistance);
+        assignJson(lensJson, "fStop", lens->fStop);
+        assignJson(lensJson, "pinholeFocalLength", lens->pinholeFocalLength);
+        assignJson(lensJson, "focusDistance", lens->focusDistance);
 
         if (lens->projectionOffset.has_value())
         {
-            baseJson["lens"]["projectionOffset"]["x"] = lens->projectionOffset->x;
-            baseJson["lens"]["projectionOffset"]["y"] = lens->projectionOffset->y;
+            lensJson["projectionOffset"]["x"] = lens->projectionOffset->x;
+            lensJson["projectionOffset"]["y"] = lens->projectionOffset->y;
         }
 
         if (lens->rawEncoders.has_value())
         {
-            assignJson(baseJson["lens"]["rawEncoders"], "focus", lens->rawEncoders->focus);
-            assignJson(baseJson["lens"]["rawEncoders"], "iris", lens->rawEncoders->iris);
-            assignJson(baseJson["lens"]["rawEncoders"], "zoom", lens->rawEncoders->zoom);
+            assignJson(lensJson["rawEncoders"], "focus", lens->rawEncoders->focus);
+            assignJson(lensJson["rawEncoders"], "iris", lens->rawEncoders->iris);
+            assignJson(lensJson["rawEncoders"], "zoom", lens->rawEncoders->zoom);
         }
 
-        assignJson(baseJson["lens"], "tStop", lens->tStop);
+        assignJson(lensJson, "tStop", lens->tStop);
+
+        if (!lensJson.empty())
+        {
+            baseJson["lens"] = std::move(lensJson);
+        }
     }
 
-    void OpenTrackIOSample::parseProtocolToJson(nlohmann::json &baseJson)
+    template<typename Json>
+    void OpenTrackIOSample::parseProtocolToJson(Json& baseJson) const
     {
         if (!protocol.has_value())
         {
@@ -298,37 +524,45 @@ namespace opentrackio
         baseJson["protocol"]["version"] = protocol->version;
     }
 
-    void OpenTrackIOSample::parseRelatedSampleIdsToJson(nlohmann::json &baseJson)
+    template<typename Json>
+    void OpenTrackIOSample::parseRelatedSampleIdsToJson(Json& baseJson) const
     {
         if (!relatedSampleIds.has_value())
         {
             return;
         }
 
-        baseJson["relatedSampleIds"] = relatedSampleIds->samples;
+        auto& samplesJson = baseJson["relatedSampleIds"] = Json::array();
+        for (const auto& sample : relatedSampleIds->samples)
+        {
+            assignUrn(samplesJson.emplace_back(), sample);
+        }
     }
 
-    void OpenTrackIOSample::parseSampleIdToJson(nlohmann::json &baseJson)
+    template<typename Json>
+    void OpenTrackIOSample::parseSampleIdToJson(Json& baseJson) const
     {
         if (!sampleId.has_value())
         {
             return;
         }
 
-        baseJson["sampleId"] = sampleId->id;
+        assignUrn(baseJson["sampleId"], sampleId->id);
     }
 
-    void OpenTrackIOSample::parseSourceIdToJson(nlohmann::json &baseJson)
+    template<typename Json>
+    void OpenTrackIOSample::parseSourceIdToJson(Json& baseJson) const
     {
         if (!sourceId.has_value())
         {
             return;
         }
 
-        baseJson["sourceId"] = sourceId->id;
+        assignUrn(baseJson["sourceId"], sourceId->id);
     }
 
-    void OpenTrackIOSample::parseSourceNumberToJson(nlohmann::json &baseJson)
+    template<typename Json>
+    void OpenTrackIOSample::parseSourceNumberToJson(Json& baseJson) const
     {
         if (!sourceNumber.has_value())
         {
@@ -338,13 +572,15 @@ namespace opentrackio
         baseJson["sourceNumber"] = sourceNumber->value;
     }
 
-    void OpenTrackIOSample::parseTimingToJson(nlohmann::json& baseJson)
+    template<typename Json>
+    void OpenTrackIOSample::parseTimingToJson(Json& baseJson) const
     {
         if (!timing.has_value())
         {
             return;
         }
 
+        baseJson["timing"] = Json::object();
         assignJson(baseJson["timing"], "sampleRate", timing->sampleRate);
         if (timing->mode.has_value())
         {
@@ -389,9 +625,9 @@ namespace opentrackio
 
             assignJson(baseJson["timing"]["synchronization"], "present", timing->synchronization->present);
 
-            auto ptpJson = baseJson["timing"]["synchronization"]["ptp"];
             if (timing->synchronization->ptp.has_value())
             {
+                auto& ptpJson = baseJson["timing"]["synchronization"]["ptp"];
                 const auto& ptp = timing->synchronization->ptp.value();
                 switch (ptp.profile)
                 {
@@ -447,7 +683,8 @@ namespace opentrackio
         }
     }
 
-    void OpenTrackIOSample::parseTrackerToJson(nlohmann::json& baseJson)
+    template<typename Json>
+    void OpenTrackIOSample::parseTrackerToJson(Json& baseJson) const
     {
         if (!tracker.has_value())
         {
@@ -455,38 +692,56 @@ namespace opentrackio
         }
 
         // ------- Static Fields
-        assignJson(baseJson["static"]["tracker"], "firmwareVersion", tracker->firmwareVersion);
-        assignJson(baseJson["static"]["tracker"], "make", tracker->make);
-        assignJson(baseJson["static"]["tracker"], "model", tracker->model);
-        assignJson(baseJson["static"]["tracker"], "serialNumber", tracker->serialNumber);
+        Json staticTrackerJson = Json::object();
+        assignJson(staticTrackerJson, "firmwareVersion", tracker->firmwareVersion);
+        assignJson(staticTrackerJson, "make", tracker->make);
+        assignJson(staticTrackerJson, "model", tracker->model);
+        assignJson(staticTrackerJson, "serialNumber", tracker->serialNumber);
+
+        if (!staticTrackerJson.empty())
+        {
+            baseJson["static"]["tracker"] = std::move(staticTrackerJson);
+        }
 
         // ------- Standard Fields
-        assignJson(baseJson["tracker"], "notes", tracker->notes);
-        assignJson(baseJson["tracker"], "recording", tracker->recording);
-        assignJson(baseJson["tracker"], "slate", tracker->slate);
-        assignJson(baseJson["tracker"], "status", tracker->status);
+        Json trackerJson = Json::object();
+        assignJson(trackerJson, "notes", tracker->notes);
+        assignJson(trackerJson, "recording", tracker->recording);
+        assignJson(trackerJson, "slate", tracker->slate);
+        assignJson(trackerJson, "status", tracker->status);
+
+        if (!trackerJson.empty())
+        {
+            baseJson["tracker"] = std::move(trackerJson);
+        }
     }
 
-    void OpenTrackIOSample::parseTransformsToJson(nlohmann::json& baseJson)
+    template<typename Json>
+    void OpenTrackIOSample::parseTransformsToJson(Json& baseJson) const
     {
         if (!transforms.has_value())
         {
             return;
         }
 
-        baseJson["transforms"] = nlohmann::json::array();
+        // Built in place, temporaries would each allocate again to be destroyed.
+        auto& transformsJson = baseJson["transforms"] = Json::array();
         for (const auto& tf : transforms->transforms)
         {
-            nlohmann::json tfJson{};
-            tfJson["translation"] = {{"x", tf.translation.x}, {"y", tf.translation.y}, {"z", tf.translation.z}};
-            tfJson["rotation"] = {{"pan", tf.rotation.pan}, {"tilt", tf.rotation.tilt}, {"roll", tf.rotation.roll}};
+            auto& tfJson = transformsJson.emplace_back();
+            tfJson["translation"]["x"] = tf.translation.x;
+            tfJson["translation"]["y"] = tf.translation.y;
+            tfJson["translation"]["z"] = tf.translation.z;
+            tfJson["rotation"]["pan"] = tf.rotation.pan;
+            tfJson["rotation"]["tilt"] = tf.rotation.tilt;
+            tfJson["rotation"]["roll"] = tf.rotation.roll;
             assignJson(tfJson, "id", tf.id);
             if (tf.scale.has_value())
             {
-                tfJson["scale"] = {{"x", tf.scale->x}, {"y", tf.scale->y}, {"z", tf.scale->z}};
+                tfJson["scale"]["x"] = tf.scale->x;
+                tfJson["scale"]["y"] = tf.scale->y;
+                tfJson["scale"]["z"] = tf.scale->z;
             }
-
-            baseJson["transforms"].push_back(tfJson);
         }
     }
 
@@ -508,22 +763,23 @@ namespace opentrackio
 
     void OpenTrackIOSample::warnForRemainingFields(const nlohmann::json &json)
     {
-        const std::function<void(const nlohmann::json&)> iterateItemsAndWarn = [&](const nlohmann::json& currentRoot){
-            if (!currentRoot.is_object() || std::distance(currentRoot.items().begin(), currentRoot.items().end()) == 0)
+        if (!json.is_object())
+        {
+            return;
+        }
+
+        for (auto it = json.begin(); it != json.end(); ++it)
+        {
+            if (m_visitedFields.isConsumed(it.value()))
             {
-                return;
+                continue;
             }
 
-            for (const auto& [key, val] : currentRoot.items())
+            if (it.key() != "static")
             {
-                if (key != "static")
-                {
-                    m_warningMessages.push_back(std::format("Key: {} was still remaining after parsing.", key));
-                }
-                iterateItemsAndWarn(val);
+                m_warningMessages.push_back(std::format("Key: {} was still remaining after parsing.", it.key()));
             }
-        };
-
-        iterateItemsAndWarn(json);
+            warnForRemainingFields(it.value());
+        }
     }
 } // namespace opentrackio
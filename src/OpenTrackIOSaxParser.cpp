@@ -0,0 +1,3495 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "opentrackio-cpp/OpenTrackIOSaxParser.h"
+#include "opentrackio-cpp/OpenTrackIOSample.h"
+#include "opentrackio-cpp/OpenTrackIOValidation.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <format>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <random>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+
+namespace opentrackio
+{
+    namespace
+    {
+        /**
+        * Every field of the schema that a property reads, in depth-first order so that the descendants of a field
+        * always directly follow it. Elements of arrays of objects (distortion and transforms) are represented by an
+        * item field with an empty key. */
+        enum class Field : uint8_t
+        {
+            Root,
+            Static,
+            Camera,
+            CameraSensorDimensions,
+            CameraSensorDimensionsWidth,
+            CameraSensorDimensionsHeight,
+            CameraSensorResolution,
+            CameraSensorResolutionWidth,
+            CameraSensorResolutionHeight,
+            CameraAnamorphicSqueeze,
+            CameraAnamorphicSqueezeNum,
+            CameraAnamorphicSqueezeDenom,
+            CameraFirmwareVersion,
+            CameraLabel,
+            CameraMake,
+            CameraModel,
+            CameraSerialNumber,
+            CameraCaptureFrameRate,
+            CameraCaptureFrameRateNum,
+            CameraCaptureFrameRateDenom,
+            CameraFdlLink,
+            CameraIsoSpeed,
+            CameraShutterAngle,
+            Duration,
+            DurationNum,
+            DurationDenom,
+            StaticLens,
+            StaticLensFirmwareVersion,
+            StaticLensMake,
+            StaticLensModel,
+            StaticLensNominalFocalLength,
+            StaticLensSerialNumber,
+            StaticLensDistortionOverscanMax,
+            StaticLensUndistortionOverscanMax,
+            StaticLensCalibrationHistory,
+            StaticTracker,
+            StaticTrackerFirmwareVersion,
+            StaticTrackerMake,
+            StaticTrackerModel,
+            StaticTrackerSerialNumber,
+            GlobalStage,
+            GlobalStageE,
+            GlobalStageN,
+            GlobalStageU,
+            GlobalStageLat0,
+            GlobalStageLon0,
+            GlobalStageH0,
+            Lens,
+            LensCustom,
+            LensDistortion,
+            LensDistortionItem,
+            LensDistortionRadial,
+            LensDistortionTangential,
+            LensDistortionModel,
+            LensDistortionOverscan,
+            LensDistortionOffset,
+            LensDistortionOffsetX,
+            LensDistortionOffsetY,
+            LensEncoders,
+            LensEncodersFocus,
+            LensEncodersIris,
+            LensEncodersZoom,
+            LensEntrancePupilOffset,
+            LensExposureFalloff,
+            LensExposureFalloffA1,
+            LensExposureFalloffA2,
+            LensExposureFalloffA3,
+            LensFStop,
+            LensPinholeFocalLength,
+            LensFocusDistance,
+            LensCalibrationHistory,
+            LensProjectionOffset,
+            LensProjectionOffsetX,
+            LensProjectionOffsetY,
+            LensRawEncoders,
+            LensRawEncodersFocus,
+            LensRawEncodersIris,
+            LensRawEncodersZoom,
+            LensTStop,
+            Protocol,
+            ProtocolName,
+            ProtocolVersion,
+            RelatedSampleIds,
+            SampleId,
+            SourceId,
+            SourceNumber,
+            Timing,
+            TimingSampleRate,
+            TimingSampleRateNum,
+            TimingSampleRateDenom,
+            TimingMode,
+            TimingRecordedTimestamp,
+            TimingRecordedTimestampSeconds,
+            TimingRecordedTimestampNanoseconds,
+            TimingSampleTimestamp,
+            TimingSampleTimestampSeconds,
+            TimingSampleTimestampNanoseconds,
+            TimingSequenceNumber,
+            Synchronization,
+            SynchronizationFrequency,
+            SynchronizationFrequencyNum,
+            SynchronizationFrequencyDenom,
+            SynchronizationLocked,
+            SynchronizationSource,
+            SynchronizationOffsets,
+            SynchronizationOffsetsTranslation,
+            SynchronizationOffsetsRotation,
+            SynchronizationOffsetsLensEncoders,
+            SynchronizationPresent,
+            Ptp,
+            PtpProfile,
+            PtpDomain,
+            PtpLeaderIdentity,
+            PtpLeaderPriorities,
+            PtpLeaderPrioritiesPriority1,
+            PtpLeaderPrioritiesPriority2,
+            PtpLeaderAccuracy,
+            PtpMeanPathDelay,
+            PtpVlan,
+            PtpLeaderTimeSource,
+            Timecode,
+            TimecodeHours,
+            TimecodeMinutes,
+            TimecodeSeconds,
+            TimecodeFrames,
+            TimecodeFrameRate,
+            TimecodeFrameRateNum,
+            TimecodeFrameRateDenom,
+            TimecodeSubFrame,
+            TimecodeDropFrame,
+            Tracker,
+            TrackerNotes,
+            TrackerRecording,
+            TrackerSlate,
+            TrackerStatus,
+            Transforms,
+            TransformsItem,
+            TransformTranslation,
+            TransformTranslationX,
+            TransformTranslationY,
+            TransformTranslationZ,
+            TransformRotation,
+            TransformRotationPan,
+            TransformRotationTilt,
+            TransformRotationRoll,
+            TransformScale,
+            TransformScaleX,
+            TransformScaleY,
+            TransformScaleZ,
+            TransformId,
+            Count
+        };
+
+        constexpr std::size_t FIELD_COUNT = static_cast<std::size_t>(Field::Count);
+
+        constexpr std::size_t index(Field field)
+        {
+            return static_cast<std::size_t>(field);
+        }
+
+        struct FieldInfo
+        {
+            Field field;
+            Field parent;
+            std::string_view key;
+        };
+
+        constexpr std::array<FieldInfo, FIELD_COUNT> FIELDS{{
+            {Field::Root, Field::Root, ""},
+            {Field::Static, Field::Root, "static"},
+            {Field::Camera, Field::Static, "camera"},
+            {Field::CameraSensorDimensions, Field::Camera, "activeSensorPhysicalDimensions"},
+            {Field::CameraSensorDimensionsWidth, Field::CameraSensorDimensions, "width"},
+            {Field::CameraSensorDimensionsHeight, Field::CameraSensorDimensions, "height"},
+            {Field::CameraSensorResolution, Field::Camera, "activeSensorResolution"},
+            {Field::CameraSensorResolutionWidth, Field::CameraSensorResolution, "width"},
+            {Field::CameraSensorResolutionHeight, Field::CameraSensorResolution, "height"},
+            {Field::CameraAnamorphicSqueeze, Field::Camera, "anamorphicSqueeze"},
+            {Field::CameraAnamorphicSqueezeNum, Field::CameraAnamorphicSqueeze, "num"},
+            {Field::CameraAnamorphicSqueezeDenom, Field::CameraAnamorphicSqueeze, "denom"},
+            {Field::CameraFirmwareVersion, Field::Camera, "firmwareVersion"},
+            {Field::CameraLabel, Field::Camera, "label"},
+            {Field::CameraMake, Field::Camera, "make"},
+            {Field::CameraModel, Field::Camera, "model"},
+            {Field::CameraSerialNumber, Field::Camera, "serialNumber"},
+            {Field::CameraCaptureFrameRate, Field::Camera, "captureFrameRate"},
+            {Field::CameraCaptureFrameRateNum, Field::CameraCaptureFrameRate, "num"},
+            {Field::CameraCaptureFrameRateDenom, Field::CameraCaptureFrameRate, "denom"},
+            {Field::CameraFdlLink, Field::Camera, "fdlLink"},
+            {Field::CameraIsoSpeed, Field::Camera, "isoSpeed"},
+            {Field::CameraShutterAngle, Field::Camera, "shutterAngle"},
+            {Field::Duration, Field::Static, "duration"},
+            {Field::DurationNum, Field::Duration, "num"},
+            {Field::DurationDenom, Field::Duration, "denom"},
+            {Field::StaticLens, Field::Static, "lens"},
+            {Field::StaticLensFirmwareVersion, Field::StaticLens, "firmwareVersion"},
+            {Field::StaticLensMake, Field::StaticLens, "make"},
+            {Field::StaticLensModel, Field::StaticLens, "model"},
+            {Field::StaticLensNominalFocalLength, Field::StaticLens, "nominalFocalLength"},
+            {Field::StaticLensSerialNumber, Field::StaticLens, "serialNumber"},
+            {Field::StaticLensDistortionOverscanMax, Field::StaticLens, "distortionOverscanMax"},
+            {Field::StaticLensUndistortionOverscanMax, Field::StaticLens, "undistortionOverscanMax"},
+            {Field::StaticLensCalibrationHistory, Field::StaticLens, "calibrationHistory"},
+            {Field::StaticTracker, Field::Static, "tracker"},
+            {Field::StaticTrackerFirmwareVersion, Field::StaticTracker, "firmwareVersion"},
+            {Field::StaticTrackerMake, Field::StaticTracker, "make"},
+            {Field::StaticTrackerModel, Field::StaticTracker, "model"},
+            {Field::StaticTrackerSerialNumber, Field::StaticTracker, "serialNumber"},
+            {Field::GlobalStage, Field::Root, "globalStage"},
+            {Field::GlobalStageE, Field::GlobalStage, "E"},
+            {Field::GlobalStageN, Field::GlobalStage, "N"},
+            {Field::GlobalStageU, Field::GlobalStage, "U"},
+            {Field::GlobalStageLat0, Field::GlobalStage, "lat0"},
+            {Field::GlobalStageLon0, Field::GlobalStage, "lon0"},
+            {Field::GlobalStageH0, Field::GlobalStage, "h0"},
+            {Field::Lens, Field::Root, "lens"},
+            {Field::LensCustom, Field::Lens, "custom"},
+            {Field::LensDistortion, Field::Lens, "distortion"},
+            {Field::LensDistortionItem, Field::LensDistortion, ""},
+            {Field::LensDistortionRadial, Field::LensDistortionItem, "radial"},
+            {Field::LensDistortionTangential, Field::LensDistortionItem, "tangential"},
+            {Field::LensDistortionModel, Field::LensDistortionItem, "model"},
+            {Field::LensDistortionOverscan, Field::LensDistortionItem, "overscan"},
+            {Field::LensDistortionOffset, Field::Lens, "distortionOffset"},
+            {Field::LensDistortionOffsetX, Field::LensDistortionOffset, "x"},
+            {Field::LensDistortionOffsetY, Field::LensDistortionOffset, "y"},
+            {Field::LensEncoders, Field::Lens, "encoders"},
+            {Field::LensEncodersFocus, Field::LensEncoders, "focus"},
+            {Field::LensEncodersIris, Field::LensEncoders, "iris"},
+            {Field::LensEncodersZoom, Field::LensEncoders, "zoom"},
+            {Field::LensEntrancePupilOffset, Field::Lens, "entrancePupilOffset"},
+            {Field::LensExposureFalloff, Field::Lens, "exposureFalloff"},
+            {Field::LensExposureFalloffA1, Field::LensExposureFalloff, "a1"},
+            {Field::LensExposureFalloffA2, Field::LensExposureFalloff, "a2"},
+            {Field::LensExposureFalloffA3, Field::LensExposureFalloff, "a3"},
+            {Field::LensFStop, Field::Lens, "fStop"},
+            {Field::LensPinholeFocalLength, Field::Lens, "pinholeFocalLength"},
+            {Field::LensFocusDistance, Field::Lens, "focusDistance"},
+            {Field::LensCalibrationHistory, Field::Lens, "calibrationHistory"},
+            {Field::LensProjectionOffset, Field::Lens, "projectionOffset"},
+            {Field::LensProjectionOffsetX, Field::LensProjectionOffset, "x"},
+            {Field::LensProjectionOffsetY, Field::LensProjectionOffset, "y"},
+            {Field::LensRawEncoders, Field::Lens, "rawEncoders"},
+            {Field::LensRawEncodersFocus, Field::LensRawEncoders, "focus"},
+            {Field::LensRawEncodersIris, Field::LensRawEncoders, "iris"},
+            {Field::LensRawEncodersZoom, Field::LensRawEncoders, "zoom"},
+            {Field::LensTStop, Field::Lens, "tStop"},
+            {Field::Protocol, Field::Root, "protocol"},
+            {Field::ProtocolName, Field::Protocol, "name"},
+            {Field::ProtocolVersion, Field::Protocol, "version"},
+            {Field::RelatedSampleIds, Field::Root, "relatedSampleIds"},
+            {Field::SampleId, Field::Root, "sampleId"},
+            {Field::SourceId, Field::Root, "sourceId"},
+            {Field::SourceNumber, Field::Root, "sourceNumber"},
+            {Field::Timing, Field::Root, "timing"},
+            {Field::TimingSampleRate, Field::Timing, "sampleRate"},
+            {Field::TimingSampleRateNum, Field::TimingSampleRate, "num"},
+            {Field::TimingSampleRateDenom, Field::TimingSampleRate, "denom"},
+            {Field::TimingMode, Field::Timing, "mode"},
+            {Field::TimingRecordedTimestamp, Field::Timing, "recordedTimestamp"},
+            {Field::TimingRecordedTimestampSeconds, Field::TimingRecordedTimestamp, "seconds"},
+            {Field::TimingRecordedTimestampNanoseconds, Field::TimingRecordedTimestamp, "nanoseconds"},
+            {Field::TimingSampleTimestamp, Field::Timing, "sampleTimestamp"},
+            {Field::TimingSampleTimestampSeconds, Field::TimingSampleTimestamp, "seconds"},
+            {Field::TimingSampleTimestampNanoseconds, Field::TimingSampleTimestamp, "nanoseconds"},
+            {Field::TimingSequenceNumber, Field::Timing, "sequenceNumber"},
+            {Field::Synchronization, Field::Timing, "synchronization"},
+            {Field::SynchronizationFrequency, Field::Synchronization, "frequency"},
+            {Field::SynchronizationFrequencyNum, Field::SynchronizationFrequency, "num"},
+            {Field::SynchronizationFrequencyDenom, Field::SynchronizationFrequency, "denom"},
+            {Field::SynchronizationLocked, Field::Synchronization, "locked"},
+            {Field::SynchronizationSource, Field::Synchronization, "source"},
+            {Field::SynchronizationOffsets, Field::Synchronization, "offsets"},
+            {Field::SynchronizationOffsetsTranslation, Field::SynchronizationOffsets, "translation"},
+            {Field::SynchronizationOffsetsRotation, Field::SynchronizationOffsets, "rotation"},
+            {Field::SynchronizationOffsetsLensEncoders, Field::SynchronizationOffsets, "lensEncoders"},
+            {Field::SynchronizationPresent, Field::Synchronization, "present"},
+            {Field::Ptp, Field::Synchronization, "ptp"},
+            {Field::PtpProfile, Field::Ptp, "profile"},
+            {Field::PtpDomain, Field::Ptp, "domain"},
+            {Field::PtpLeaderIdentity, Field::Ptp, "leaderIdentity"},
+            {Field::PtpLeaderPriorities, Field::Ptp, "leaderPriorities"},
+            {Field::PtpLeaderPrioritiesPriority1, Field::PtpLeaderPriorities, "priority1"},
+            {Field::PtpLeaderPrioritiesPriority2, Field::PtpLeaderPriorities, "priority2"},
+            {Field::PtpLeaderAccuracy, Field::Ptp, "leaderAccuracy"},
+            {Field::PtpMeanPathDelay, Field::Ptp, "meanPathDelay"},
+            {Field::PtpVlan, Field::Ptp, "vlan"},
+            {Field::PtpLeaderTimeSource, Field::Ptp, "leaderTimeSource"},
+            {Field::Timecode, Field::Timing, "timecode"},
+            {Field::TimecodeHours, Field::Timecode, "hours"},
+            {Field::TimecodeMinutes, Field::Timecode, "minutes"},
+            {Field::TimecodeSeconds, Field::Timecode, "seconds"},
+            {Field::TimecodeFrames, Field::Timecode, "frames"},
+            {Field::TimecodeFrameRate, Field::Timecode, "frameRate"},
+            {Field::TimecodeFrameRateNum, Field::TimecodeFrameRate, "num"},
+            {Field::TimecodeFrameRateDenom, Field::TimecodeFrameRate, "denom"},
+            {Field::TimecodeSubFrame, Field::Timecode, "subFrame"},
+            {Field::TimecodeDropFrame, Field::Timecode, "dropFrame"},
+            {Field::Tracker, Field::Root, "tracker"},
+            {Field::TrackerNotes, Field::Tracker, "notes"},
+            {Field::TrackerRecording, Field::Tracker, "recording"},
+            {Field::TrackerSlate, Field::Tracker, "slate"},
+            {Field::TrackerStatus, Field::Tracker, "status"},
+            {Field::Transforms, Field::Root, "transforms"},
+            {Field::TransformsItem, Field::Transforms, ""},
+            {Field::TransformTranslation, Field::TransformsItem, "translation"},
+            {Field::TransformTranslationX, Field::TransformTranslation, "x"},
+            {Field::TransformTranslationY, Field::TransformTranslation, "y"},
+            {Field::TransformTranslationZ, Field::TransformTranslation, "z"},
+            {Field::TransformRotation, Field::TransformsItem, "rotation"},
+            {Field::TransformRotationPan, Field::TransformRotation, "pan"},
+            {Field::TransformRotationTilt, Field::TransformRotation, "tilt"},
+            {Field::TransformRotationRoll, Field::TransformRotation, "roll"},
+            {Field::TransformScale, Field::TransformsItem, "scale"},
+            {Field::TransformScaleX, Field::TransformScale, "x"},
+            {Field::TransformScaleY, Field::TransformScale, "y"},
+            {Field::TransformScaleZ, Field::TransformScale, "z"},
+            {Field::TransformId, Field::TransformsItem, "id"},
+        }};
+
+        constexpr bool fieldsAreDepthFirst()
+        {
+            for (std::size_t i = 0; i < FIELD_COUNT; ++i)
+            {
+                if (index(FIELDS[i].field) != i || (i != 0 && index(FIELDS[i].parent) >= i))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+        static_assert(fieldsAreDepthFirst(), "FIELDS must list every Field in enum order with parents first.");
+
+        constexpr Field parentOf(Field field)
+        {
+            return FIELDS[index(field)].parent;
+        }
+
+        constexpr std::string_view keyOf(Field field)
+        {
+            return FIELDS[index(field)].key;
+        }
+
+        constexpr bool isAncestor(Field ancestor, Field field)
+        {
+            while (field != Field::Root)
+            {
+                field = parentOf(field);
+                if (field == ancestor)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+        * One past the last descendant of each field. */
+        constexpr std::array<std::size_t, FIELD_COUNT> SUBTREE_ENDS = []
+        {
+            std::array<std::size_t, FIELD_COUNT> ends{};
+            for (std::size_t i = 0; i < FIELD_COUNT; ++i)
+            {
+                std::size_t end = i + 1;
+                while (end < FIELD_COUNT && isAncestor(static_cast<Field>(i), static_cast<Field>(end)))
+                {
+                    ++end;
+                }
+                ends[i] = end;
+            }
+            return ends;
+        }();
+
+        /**
+        * True for the element fields of arrays of objects and everything below them. */
+        constexpr std::array<bool, FIELD_COUNT> IN_ARRAY_ITEM = []
+        {
+            std::array<bool, FIELD_COUNT> inItem{};
+            for (std::size_t i = 1; i < FIELD_COUNT; ++i)
+            {
+                inItem[i] = FIELDS[i].key.empty() || inItem[index(FIELDS[i].parent)];
+            }
+            return inItem;
+        }();
+
+        /**
+        * The subtrees of FIELDS that each SampleFields flag selects. */
+        struct SampleFieldsInfo
+        {
+            SampleFields flag;
+            Field field;
+        };
+
+        constexpr std::array<SampleFieldsInfo, 23> SAMPLE_FIELDS{{
+            {SampleFields::CAMERA, Field::Camera},
+            {SampleFields::DURATION, Field::Duration},
+            {SampleFields::GLOBAL_STAGE, Field::GlobalStage},
+            {SampleFields::LENS, Field::Lens},
+            {SampleFields::LENS, Field::StaticLens},
+            {SampleFields::STATIC_LENS, Field::StaticLens},
+            {SampleFields::LENS_ENCODERS, Field::LensEncoders},
+            {SampleFields::LENS_RAW_ENCODERS, Field::LensRawEncoders},
+            {SampleFields::LENS_DISTORTION, Field::LensDistortion},
+            {SampleFields::LENS_DISTORTION, Field::LensDistortionOffset},
+            {SampleFields::LENS_DISTORTION, Field::LensProjectionOffset},
+            {SampleFields::PROTOCOL, Field::Protocol},
+            {SampleFields::RELATED_SAMPLE_IDS, Field::RelatedSampleIds},
+            {SampleFields::SAMPLE_ID, Field::SampleId},
+            {SampleFields::SOURCE_ID, Field::SourceId},
+            {SampleFields::SOURCE_NUMBER, Field::SourceNumber},
+            {SampleFields::TIMING, Field::Timing},
+            {SampleFields::TIMING_SAMPLE_TIMESTAMP, Field::TimingSampleTimestamp},
+            {SampleFields::TIMING_SYNCHRONIZATION, Field::Synchronization},
+            {SampleFields::TIMING_TIMECODE, Field::Timecode},
+            {SampleFields::TRACKER, Field::Tracker},
+            {SampleFields::TRACKER, Field::StaticTracker},
+            {SampleFields::TRANSFORMS, Field::Transforms},
+        }};
+
+        /**
+        * The fields to parse for a set of SampleFields: every field in a selected subtree plus the objects that
+        * enclose it, which have to be entered to reach it. */
+        std::array<bool, FIELD_COUNT> wantedFields(SampleFields fields)
+        {
+            std::array<bool, FIELD_COUNT> wanted{};
+            wanted[index(Field::Root)] = true;
+
+            for (const auto& [flag, field] : SAMPLE_FIELDS)
+            {
+                if ((fields & flag) == SampleFields::NONE)
+                {
+                    continue;
+                }
+
+                std::fill(wanted.begin() + index(field), wanted.begin() + SUBTREE_ENDS[index(field)], true);
+                for (Field parent = parentOf(field); parent != Field::Root; parent = parentOf(parent))
+                {
+                    wanted[index(parent)] = true;
+                }
+            }
+            return wanted;
+        }
+
+        std::optional<Field> findChild(Field parent, std::string_view key)
+        {
+            for (std::size_t i = index(parent) + 1; i < SUBTREE_ENDS[index(parent)]; i = SUBTREE_ENDS[i])
+            {
+                if (!FIELDS[i].key.empty() && FIELDS[i].key == key)
+                {
+                    return FIELDS[i].field;
+                }
+            }
+            return std::nullopt;
+        }
+
+        std::optional<Field> itemOf(Field array)
+        {
+            const std::size_t first = index(array) + 1;
+            if (first < SUBTREE_ENDS[index(array)] && FIELDS[first].key.empty())
+            {
+                return FIELDS[first].field;
+            }
+            return std::nullopt;
+        }
+
+        /**
+        * Path of a field as its keys joined with '\0'. Sorting these gives the same order as walking the
+        * equivalent nlohmann::json DOM, whose objects keep their keys sorted. */
+        std::string pathOf(Field field)
+        {
+            std::string path;
+            for (; field != Field::Root; field = parentOf(field))
+            {
+                path.insert(0, keyOf(field));
+                path.insert(path.begin(), '\0');
+            }
+            return path;
+        }
+
+        /**
+        * The raw value of one field as it arrived from the SAX stream. */
+        struct Value
+        {
+            enum class Type : uint8_t
+            {
+                ABSENT,
+                NUL,
+                BOOLEAN,
+                INTEGER,
+                UNSIGNED,
+                FLOAT,
+                STRING,
+                BINARY,
+                OBJECT,
+                ARRAY
+            };
+            Type type = Type::ABSENT;
+
+            /**
+            * Set during validation for the same fields that VisitedFields records on the DOM path. */
+            bool consumed = false;
+
+            /**
+            * The object had keys that aren't in FIELDS. */
+            bool hasUnknownFields = false;
+
+            bool boolean = false;
+            int64_t integer = 0;
+            uint64_t unsignedInteger = 0;
+            double floating = 0.0;
+            std::string string{};
+
+            /**
+            * Elements of an array of scalars (custom, radial, relatedSampleIds etc.), the first elementCount of which
+            * belong to the current value. The rest are kept for their storage. */
+            std::vector<Value> elements{};
+            std::size_t elementCount = 0;
+
+            [[nodiscard]] std::span<const Value> items() const
+            {
+                return {elements.data(), elementCount};
+            }
+
+            Value& addItem()
+            {
+                if (elementCount == elements.size())
+                {
+                    elements.emplace_back();
+                }
+
+                Value& item = elements[elementCount++];
+                item.reset();
+                return item;
+            }
+
+            [[nodiscard]] bool isPresent() const { return type != Type::ABSENT; }
+            [[nodiscard]] bool isObject() const { return type == Type::OBJECT; }
+            [[nodiscard]] bool isArray() const { return type == Type::ARRAY; }
+            [[nodiscard]] bool isString() const { return type == Type::STRING; }
+            [[nodiscard]] bool isBoolean() const { return type == Type::BOOLEAN; }
+            [[nodiscard]] bool isNumberUnsigned() const { return type == Type::UNSIGNED; }
+            [[nodiscard]] bool isNumber() const
+            {
+                return type == Type::INTEGER || type == Type::UNSIGNED || type == Type::FLOAT;
+            }
+
+            void reset()
+            {
+                type = Type::ABSENT;
+                consumed = false;
+                hasUnknownFields = false;
+                string.clear();
+                elementCount = 0;
+            }
+
+            /**
+            * Converts the value the same way nlohmann::json::get<T>() does, returning false where get<T>() would throw.
+            * Strings and vectors are assigned in place so that out's existing storage is reused, interned strings are
+            * looked up in StringPool::global(). */
+            template<typename T>
+            bool get(T& out) const
+            {
+                if constexpr (std::is_same_v<T, opentrackiotypes::String>)
+                {
+                    if (!isString())
+                    {
+                        return false;
+                    }
+                    out = string;
+                }
+                else if constexpr (std::is_same_v<T, opentrackiotypes::InternedString>)
+                {
+                    if (!isString())
+                    {
+                        return false;
+                    }
+                    out = opentrackiotypes::InternedString::intern(string);
+                }
+                else if constexpr (std::is_same_v<T, bool>)
+                {
+                    if (!isBoolean())
+                    {
+                        return false;
+                    }
+                    out = boolean;
+                }
+                else if constexpr (std::is_arithmetic_v<T>)
+                {
+                    switch (type)
+                    {
+                        case Type::UNSIGNED: out = static_cast<T>(unsignedInteger); break;
+                        case Type::INTEGER: out = static_cast<T>(integer); break;
+                        case Type::FLOAT: out = static_cast<T>(floating); break;
+                        case Type::BOOLEAN: out = static_cast<T>(boolean); break;
+                        default: return false;
+                    }
+                }
+                else
+                {
+                    if (!isArray())
+                    {
+                        return false;
+                    }
+
+                    out.resize(elementCount);
+                    for (std::size_t i = 0; i < elementCount; ++i)
+                    {
+                        if (!elements[i].get(out[i]))
+                        {
+                            return false;
+                        }
+                    }
+                }
+                return true;
+            }
+
+            /**
+            * Equivalent of comparing a nlohmann::json against an integer with operator==. */
+            [[nodiscard]] bool equals(int64_t val) const
+            {
+                switch (type)
+                {
+                    case Type::UNSIGNED: return val >= 0 && unsignedInteger == static_cast<uint64_t>(val);
+                    case Type::INTEGER: return integer == val;
+                    case Type::FLOAT: return floating == static_cast<double>(val);
+                    default: return false;
+                }
+            }
+        };
+
+        /**
+        * Strings and vectors taken from the properties of a sample before it's parsed again, handed out again as the
+        * new properties are assigned so that their storage is refilled rather than reallocated. Only buffers that
+        * own heap storage are kept. Vectors of strings and numbers keep their stale elements, Value::get() resizes
+        * and overwrites them in place. */
+        class Buffers
+        {
+        public:
+            Buffers() = default;
+
+#ifdef OPENTRACKIO_PMR
+            /**
+            * New buffers are allocated from resource, as is everything they're grown by. */
+            explicit Buffers(std::pmr::memory_resource* resource) : m_resource{resource}
+            {
+            }
+#endif
+
+            template<typename T>
+            T take()
+            {
+                if constexpr (IS_POOLED<T>)
+                {
+                    auto& spares = std::get<std::vector<T>>(m_spares);
+                    if (!spares.empty())
+                    {
+                        T buffer = std::move(spares.back());
+                        spares.pop_back();
+                        return buffer;
+                    }
+                }
+                return make<T>();
+            }
+
+            /**
+            * An empty buffer, without taking a spare. */
+            template<typename T>
+            T make() const
+            {
+#ifdef OPENTRACKIO_PMR
+                if constexpr (IS_POOLED<T>)
+                {
+                    return T(m_resource);
+                }
+#endif
+                return T{};
+            }
+
+            /**
+            * As take() for a buffer that value is about to be copied into. Strings and small vectors short enough to
+            * be stored inside themselves don't need a spare, so they're left for values that do. */
+            template<typename T>
+            T takeFor(const Value& value)
+            {
+                if constexpr (std::is_same_v<T, opentrackiotypes::String>)
+                {
+                    if (value.string.size() <= opentrackiotypes::String{}.capacity())
+                    {
+                        return make<T>();
+                    }
+                }
+                else if constexpr (IS_SMALL_VECTOR<T>)
+                {
+                    if (value.elementCount <= T::INLINE_CAPACITY)
+                    {
+                        return make<T>();
+                    }
+                }
+                return take<T>();
+            }
+
+            /**
+            * Copies from into out, taking a spare for out if it's unset and needs one. */
+            template<typename T>
+            void copy(std::optional<T>& out, const std::optional<T>& from)
+            {
+                if (!from.has_value())
+                {
+                    give(out);
+                    return;
+                }
+
+                if (!out.has_value())
+                {
+                    if constexpr (std::is_same_v<T, opentrackiotypes::String>)
+                    {
+                        out = from->size() > std::string{}.capacity() ? take<T>() : make<T>();
+                    }
+                    else
+                    {
+                        out = take<T>();
+                    }
+                }
+                *out = *from;
+            }
+
+            template<typename T>
+            void give(T& buffer)
+            {
+                static_assert(!std::is_const_v<T>, "A buffer read through a const handle can't be given up");
+                if constexpr (IS_POOLED<T>)
+                {
+                    clear(buffer);
+
+                    auto& spares = std::get<std::vector<T>>(m_spares);
+                    if (hasHeapStorage(buffer) && spares.size() < MAX_SPARES)
+                    {
+                        spares.push_back(std::move(buffer));
+                    }
+                }
+            }
+
+            template<typename T>
+            void give(std::optional<T>& buffer)
+            {
+                if (buffer.has_value())
+                {
+                    give(buffer.value());
+                }
+                buffer.reset();
+            }
+
+            /**
+            * Unsets a calibrationHistory, keeping its instance for take() unless it's shared with a static block or a
+            * copy of the sample. The instance is default allocated, as every copy-on-write value is, so it's kept
+            * whole rather than pooled with the buffers from the memory resource. */
+            void give(opentrackiotypes::CopyOnWrite<opentrackiotypes::Vector<opentrackiotypes::String>>& buffer)
+            {
+                const bool keep = buffer.has_value() && !buffer.isShared();
+                buffer.reset();
+                if (keep)
+                {
+                    m_calibrationHistory = std::move(buffer);
+                }
+            }
+
+            void take(opentrackiotypes::CopyOnWrite<opentrackiotypes::Vector<opentrackiotypes::String>>& out)
+            {
+                out = std::move(m_calibrationHistory);
+            }
+
+            /**
+            * Empties a vector of structs, returning the buffers of its elements, while keeping its own storage. */
+            void clear(opentrackiotypes::Vector<opentrackioproperties::Lens::Distortion>& distortions)
+            {
+                for (auto& distortion : distortions)
+                {
+                    give(distortion.radial);
+                    give(distortion.tangential);
+                    give(distortion.model);
+                }
+                distortions.clear();
+            }
+
+            void clear(opentrackioproperties::Transforms::Chain& transforms)
+            {
+                for (auto& transform : transforms)
+                {
+                    give(transform.id);
+                }
+                transforms.clear();
+            }
+
+            void clear(opentrackiotypes::Vector<opentrackiotypes::Uuid>& uuids)
+            {
+                uuids.clear();
+            }
+
+            void clear(opentrackiotypes::Vector<uint16_t>& values)
+            {
+                values.clear();
+            }
+
+            template<typename T>
+            void clear(T&)
+            {
+            }
+
+        private:
+            /**
+            * Bounds the spares of each type should buffers be given back without being taken again. */
+            static constexpr std::size_t MAX_SPARES = 64;
+
+            template<typename T>
+            static constexpr bool IS_SMALL_VECTOR = std::is_same_v<T, opentrackioproperties::Lens::Coefficients> ||
+                                                    std::is_same_v<T, opentrackioproperties::Transforms::Chain>;
+
+            template<typename T>
+            static constexpr bool IS_POOLED =
+                std::is_same_v<T, opentrackiotypes::String> ||
+                std::is_same_v<T, opentrackioproperties::Lens::Coefficients> ||
+                std::is_same_v<T, opentrackiotypes::Vector<opentrackiotypes::String>> ||
+                std::is_same_v<T, opentrackiotypes::Vector<uint16_t>> ||
+                std::is_same_v<T, opentrackiotypes::Vector<opentrackiotypes::Uuid>> ||
+                std::is_same_v<T, opentrackiotypes::Vector<opentrackioproperties::Lens::Distortion>> ||
+                std::is_same_v<T, opentrackioproperties::Transforms::Chain>;
+
+            static bool hasHeapStorage(const opentrackiotypes::String& buffer)
+            {
+                return buffer.capacity() > opentrackiotypes::String{}.capacity();
+            }
+
+            template<typename T>
+            static bool hasHeapStorage(const opentrackiotypes::Vector<T>& buffer)
+            {
+                return buffer.capacity() > 0;
+            }
+
+            template<typename T, std::size_t N>
+            static bool hasHeapStorage(const opentrackiotypes::SmallVector<T, N>& buffer)
+            {
+                return buffer.isSpilled();
+            }
+
+#ifdef OPENTRACKIO_PMR
+            std::pmr::memory_resource* m_resource = std::pmr::get_default_resource();
+#endif
+
+            std::tuple<std::vector<opentrackiotypes::String>,
+                       std::vector<opentrackioproperties::Lens::Coefficients>,
+                       std::vector<opentrackiotypes::Vector<opentrackiotypes::String>>,
+                       std::vector<opentrackiotypes::Vector<uint16_t>>,
+                       std::vector<opentrackiotypes::Vector<opentrackiotypes::Uuid>>,
+                       std::vector<opentrackiotypes::Vector<opentrackioproperties::Lens::Distortion>>,
+                       std::vector<opentrackioproperties::Transforms::Chain>> m_spares{};
+            opentrackiotypes::CopyOnWrite<opentrackiotypes::Vector<opentrackiotypes::String>> m_calibrationHistory{};
+        };
+
+        /**
+        * nlohmann SAX handler. Each token is written into the slot of the field it belongs to, found by walking the
+        * key path through FIELDS; keys that aren't part of the schema are only remembered for the leftover-field
+        * warnings. Once the whole document has been seen the slots are validated property by property, mirroring the
+        * DOM based parse() functions so that both paths produce the same structs, errors and warnings.
+        * Values of fields outside the requested SampleFields are dropped as they arrive, along with everything
+        * nested in them. A handler is kept for the lifetime of a sample so that its buffers are reused by every
+        * parse. */
+        class SampleSaxHandler
+        {
+        public:
+            SampleSaxHandler()
+            {
+                m_frames.reserve(16);
+            }
+
+#ifdef OPENTRACKIO_PMR
+            /**
+            * The properties assigned to samples are allocated from resource. */
+            explicit SampleSaxHandler(std::pmr::memory_resource* resource) : m_distortions{resource},
+                                                                             m_transforms{resource},
+                                                                             m_buffers{resource}
+            {
+                m_frames.reserve(16);
+            }
+#endif
+
+            /**
+            * Prepares for a new document, whose values are kept only for the given fields. */
+            void begin(SampleFields fields)
+            {
+                m_wanted = wantedFields(fields);
+                m_frames.clear();
+                m_pendingField = std::nullopt;
+                m_skipPending = false;
+                m_skipDepth = 0;
+                m_unknownPath.clear();
+                m_pendingUnknownKey.clear();
+                m_staticBytes = {};
+                m_staticBlock = nullptr;
+                m_dropStatic = false;
+                resetField(Field::Root);
+            }
+
+            /**
+            * Unsets every property of sample, keeping their strings and vectors for the next parse to fill. */
+            void recycle(OpenTrackIOSample& sample)
+            {
+                // A camera shared with a static block or a copy of the sample is left to them.
+                if (sample.camera.has_value() && !sample.camera.isShared())
+                {
+                    m_buffers.give(sample.camera.mutate().fdlLink);
+                }
+
+                if (sample.lens.has_value())
+                {
+                    m_buffers.give(sample.lens->custom);
+                    m_buffers.give(sample.lens->distortion);
+                    m_buffers.give(sample.lens->firmwareVersion);
+                    m_buffers.give(sample.lens->make);
+                    m_buffers.give(sample.lens->model);
+                    m_buffers.give(sample.lens->calibrationHistory);
+                    m_buffers.give(sample.lens->serialNumber);
+                }
+
+                if (sample.protocol.has_value())
+                {
+                    m_buffers.give(sample.protocol->name);
+                    m_buffers.give(sample.protocol->version);
+                }
+
+                if (sample.relatedSampleIds.has_value())
+                {
+                    m_buffers.give(sample.relatedSampleIds->samples);
+                }
+
+                if (sample.timing.has_value() && sample.timing->synchronization.has_value() &&
+                    sample.timing->synchronization->ptp.has_value())
+                {
+                    m_buffers.give(sample.timing->synchronization->ptp->leaderIdentity);
+                }
+
+                if (sample.tracker.has_value())
+                {
+                    m_buffers.give(sample.tracker->firmwareVersion);
+                    m_buffers.give(sample.tracker->make);
+                    m_buffers.give(sample.tracker->model);
+                    m_buffers.give(sample.tracker->notes);
+                    m_buffers.give(sample.tracker->serialNumber);
+                    m_buffers.give(sample.tracker->slate);
+                    m_buffers.give(sample.tracker->status);
+                }
+
+                if (sample.transforms.has_value())
+                {
+                    m_buffers.give(sample.transforms->transforms);
+                }
+
+                sample.camera = std::nullopt;
+                sample.duration = std::nullopt;
+                sample.globalStage = std::nullopt;
+                sample.lens = std::nullopt;
+                sample.protocol = std::nullopt;
+                sample.relatedSampleIds = std::nullopt;
+                sample.sampleId = std::nullopt;
+                sample.sourceId = std::nullopt;
+                sample.sourceNumber = std::nullopt;
+                sample.timing = std::nullopt;
+                sample.tracker = std::nullopt;
+                sample.transforms = std::nullopt;
+            }
+
+            /**
+            * True, once, when the value following the last key belongs to a field outside the requested SampleFields.
+            * Lets a reader that can step over a value without tokenising it do so instead of reporting it. */
+            bool skipNextValue()
+            {
+                return std::exchange(m_skipPending, false);
+            }
+
+            // ------- Static cache
+            /**
+            * True when the value following the last key is the top-level static object. */
+            [[nodiscard]] bool staticValueNext() const
+            {
+                return m_frames.size() == 1 && m_pendingField == Field::Static;
+            }
+
+            /**
+            * Looks up the raw bytes of the static object, under sourceUrn or, if that's empty, the sourceId read so
+            * far. On a hit anything already read into the static object is dropped and the cached block is assigned
+            * in its place, so the caller doesn't need to report the value. The bytes have to stay valid until the
+            * end of the parse. */
+            bool matchStatic(std::span<const uint8_t> bytes, std::string_view sourceUrn = {})
+            {
+                if (!m_wanted[index(Field::Static)])
+                {
+                    return false;
+                }
+
+                m_staticBytes = bytes;
+                m_staticBlock = nullptr;
+
+                if (sourceUrn.empty() && slot(Field::SourceId).isString())
+                {
+                    sourceUrn = slot(Field::SourceId).string;
+                }
+
+                const std::optional<opentrackiotypes::Uuid> source = opentrackiotypes::Uuid::fromUrn(sourceUrn);
+                if (!source.has_value())
+                {
+                    return false;
+                }
+
+                const auto entry = m_staticCache.find(source.value());
+                if (entry == m_staticCache.end() || !std::ranges::equal(entry->second.bytes, bytes))
+                {
+                    return false;
+                }
+
+                m_staticBlock = entry->second.block;
+                resetField(Field::Static);
+                if (m_pendingField == Field::Static)
+                {
+                    m_pendingField = std::nullopt;
+                }
+                return true;
+            }
+
+            /**
+            * Drops every static object as it's tokenised, for a static object matched before the document. */
+            void dropStatic()
+            {
+                m_dropStatic = true;
+            }
+
+            /**
+            * Caches the static object of the last parse, unless it was a hit or can't be rebuilt from the sample.
+            * A new source replaces a pseudo-randomly chosen one once the cache holds m_staticCacheCapacity. */
+            void updateStaticCache(const OpenTrackIOSample& sample, const ParseErrors& errors)
+            {
+                const std::size_t staticBegin = index(Field::Static);
+                const std::size_t staticEnd = SUBTREE_ENDS[staticBegin];
+
+                if (m_staticCacheCapacity == 0 || m_staticBlock != nullptr || m_staticBytes.empty() || !errors.empty() ||
+                    !slot(Field::Static).isObject() || !slot(Field::SourceId).isString() ||
+                    !std::all_of(m_wanted.begin() + staticBegin, m_wanted.begin() + staticEnd, std::identity{}))
+                {
+                    return;
+                }
+
+                for (std::size_t i = staticBegin + 1; i < staticEnd; ++i)
+                {
+                    if (m_values[i].isPresent() && !isCovered(static_cast<Field>(i)))
+                    {
+                        return;
+                    }
+                }
+
+                for (const auto& unknown : m_unknownFields)
+                {
+                    if (index(unknown.parent) >= staticBegin && index(unknown.parent) < staticEnd &&
+                        !isCovered(unknown.parent))
+                    {
+                        return;
+                    }
+                }
+
+                const std::optional<opentrackiotypes::Uuid> source =
+                        opentrackiotypes::Uuid::fromUrn(slot(Field::SourceId).string);
+                if (!source.has_value())
+                {
+                    return;
+                }
+
+                // The block gets a camera of its own rather than sharing the one made from the parse's buffers.
+                auto block = std::make_shared<opentrackioproperties::StaticBlock>();
+                if (sample.camera.has_value())
+                {
+                    block->camera = sample.camera.value();
+                }
+                block->duration = sample.duration;
+
+                if (isPresent(Field::StaticLens))
+                {
+                    // The static fields of a lens don't appear in the dynamic one, except for calibrationHistory.
+                    const opentrackioproperties::Lens& lens = sample.lens.value();
+                    auto& staticLens = block->lens.emplace();
+                    staticLens.firmwareVersion = lens.firmwareVersion;
+                    staticLens.make = lens.make;
+                    staticLens.model = lens.model;
+                    staticLens.nominalFocalLength = lens.nominalFocalLength;
+                    staticLens.serialNumber = lens.serialNumber;
+                    staticLens.distortionOverscanMax = lens.distortionOverscanMax;
+                    staticLens.undistortionOverscanMax = lens.undistortionOverscanMax;
+
+                    if (slot(Field::StaticLensCalibrationHistory).isArray())
+                    {
+                        slot(Field::StaticLensCalibrationHistory).get(staticLens.calibrationHistory.emplace());
+                    }
+                }
+
+                if (isPresent(Field::StaticTracker))
+                {
+                    const opentrackioproperties::Tracker& tracker = sample.tracker.value();
+                    auto& staticTracker = block->tracker.emplace();
+                    staticTracker.firmwareVersion = tracker.firmwareVersion;
+                    staticTracker.make = tracker.make;
+                    staticTracker.model = tracker.model;
+                    staticTracker.serialNumber = tracker.serialNumber;
+                }
+
+                auto entry = m_staticCache.find(source.value());
+                if (entry == m_staticCache.end() && m_staticCache.size() >= m_staticCacheCapacity)
+                {
+                    // The evicted node is reused, keeping the capacity of its bytes.
+                    auto node = m_staticCache.extract(evictionCandidate());
+                    node.key() = source.value();
+                    entry = m_staticCache.insert(std::move(node)).position;
+                }
+                else if (entry == m_staticCache.end())
+                {
+                    entry = m_staticCache.try_emplace(source.value()).first;
+                }
+
+                entry->second.bytes.assign(m_staticBytes.begin(), m_staticBytes.end());
+                entry->second.block = std::move(block);
+                m_staticBlock = entry->second.block;
+            }
+
+            /**
+            * Evicts cached sources until at most sources are left, 0 disables the cache. */
+            void setStaticCacheCapacity(std::size_t sources)
+            {
+                m_staticCacheCapacity = sources;
+                while (m_staticCache.size() > m_staticCacheCapacity)
+                {
+                    m_staticCache.erase(evictionCandidate());
+                }
+            }
+
+            [[nodiscard]] const std::shared_ptr<const opentrackioproperties::StaticBlock>& staticBlock() const
+            {
+                return m_staticBlock;
+            }
+
+            [[nodiscard]] OpenTrackIOSaxParser::StaticCacheStats staticCacheStats() const
+            {
+                return m_staticCacheStats;
+            }
+
+            // ------- nlohmann SAX interface
+            bool null()
+            {
+                if (Value* value = nextValue().value)
+                {
+                    value->type = Value::Type::NUL;
+                }
+                return true;
+            }
+
+            bool boolean(bool val)
+            {
+                if (Value* value = nextValue().value)
+                {
+                    value->type = Value::Type::BOOLEAN;
+                    value->boolean = val;
+                }
+                return true;
+            }
+
+            bool number_integer(nlohmann::json::number_integer_t val)
+            {
+                if (Value* value = nextValue().value)
+                {
+                    value->type = Value::Type::INTEGER;
+                    value->integer = val;
+                }
+                return true;
+            }
+
+            bool number_unsigned(nlohmann::json::number_unsigned_t val)
+            {
+                if (Value* value = nextValue().value)
+                {
+                    value->type = Value::Type::UNSIGNED;
+                    value->unsignedInteger = val;
+                }
+                return true;
+            }
+
+            bool number_float(nlohmann::json::number_float_t val, const nlohmann::json::string_t&)
+            {
+                if (Value* value = nextValue().value)
+                {
+                    value->type = Value::Type::FLOAT;
+                    value->floating = val;
+                }
+                return true;
+            }
+
+            bool string(nlohmann::json::string_t& val)
+            {
+                if (Value* value = nextValue().value)
+                {
+                    value->type = Value::Type::STRING;
+                    value->string.assign(val);
+                }
+                return true;
+            }
+
+            bool binary(nlohmann::json::binary_t&)
+            {
+                if (Value* value = nextValue().value)
+                {
+                    value->type = Value::Type::BINARY;
+                }
+                return true;
+            }
+
+            bool start_object(std::size_t)
+            {
+                return startContainer(Value::Type::OBJECT);
+            }
+
+            bool key(nlohmann::json::string_t& key)
+            {
+                if (m_skipDepth > 0)
+                {
+                    return true;
+                }
+
+                const Frame& frame = m_frames.back();
+                m_pendingField = std::nullopt;
+
+                if (frame.known)
+                {
+                    m_pendingField = findChild(frame.field, key);
+                    if (m_pendingField.has_value())
+                    {
+                        if (!m_wanted[index(m_pendingField.value())] ||
+                            (m_dropStatic && m_pendingField == Field::Static))
+                        {
+                            m_pendingField = std::nullopt;
+                            m_skipPending = true;
+                        }
+                        return true;
+                    }
+                    slot(frame.field).hasUnknownFields = true;
+                }
+
+                if (frame.recordKeys)
+                {
+                    std::string path = pathOf(frame.field);
+                    path.append(m_unknownPath);
+                    path.push_back('\0');
+                    path.append(key);
+                    m_unknownFields.push_back(UnknownField{frame.field, std::move(path)});
+                    m_pendingUnknownKey.assign(key);
+                }
+                return true;
+            }
+
+            bool end_object()
+            {
+                if (m_skipDepth > 0)
+                {
+                    --m_skipDepth;
+                    return true;
+                }
+
+                const Frame frame = m_frames.back();
+                m_frames.pop_back();
+                m_unknownPath.resize(frame.unknownPathLength);
+
+                if (frame.known && frame.field == Field::LensDistortionItem)
+                {
+                    finishDistortion();
+                }
+                else if (frame.known && frame.field == Field::TransformsItem)
+                {
+                    finishTransform();
+                }
+                return true;
+            }
+
+            bool start_array(std::size_t)
+            {
+                return startContainer(Value::Type::ARRAY);
+            }
+
+            bool end_array()
+            {
+                if (m_skipDepth > 0)
+                {
+                    --m_skipDepth;
+                    return true;
+                }
+
+                m_unknownPath.resize(m_frames.back().unknownPathLength);
+                m_frames.pop_back();
+                return true;
+            }
+
+            bool parse_error(std::size_t, const std::string&, const nlohmann::detail::exception&)
+            {
+                return false;
+            }
+
+            // ------- Validation
+            void assignProperties(OpenTrackIOSample& sample, ParseErrors& errors)
+            {
+                // A static object read before the sourceId it belongs to can only be looked up now.
+                if (!m_staticBytes.empty())
+                {
+                    if (m_staticBlock == nullptr)
+                    {
+                        matchStatic(m_staticBytes);
+                    }
+
+                    if (m_staticBlock != nullptr)
+                    {
+                        ++m_staticCacheStats.hits;
+                    }
+                    else
+                    {
+                        ++m_staticCacheStats.misses;
+                    }
+                }
+
+                sample.camera = parseCamera(errors);
+                sample.duration = parseDuration(errors);
+                sample.globalStage = parseGlobalStage(errors);
+                sample.lens = parseLens(errors);
+                sample.protocol = parseProtocol(errors);
+                sample.relatedSampleIds = parseRelatedSampleIds(errors);
+                sample.sampleId = parseSampleId(errors);
+                sample.sourceId = parseSourceId(errors);
+                sample.sourceNumber = parseSourceNumber(errors);
+                sample.timing = parseTiming(errors);
+                sample.tracker = parseTracker(errors);
+                sample.transforms = parseTransforms(errors);
+
+                if (m_staticBlock != nullptr)
+                {
+                    assignStatic(sample, *m_staticBlock);
+                }
+            }
+
+            void warnForRemainingFields(std::vector<std::string>& warnings) const
+            {
+                std::vector<std::string> remaining{};
+
+                // The static object itself is never reported, skipping it here saves building its path every parse.
+                for (std::size_t i = index(Field::Static) + 1; i < FIELD_COUNT; ++i)
+                {
+                    const auto field = static_cast<Field>(i);
+                    if (!IN_ARRAY_ITEM[i] && slot(field).isPresent() && !isCovered(field))
+                    {
+                        remaining.emplace_back(pathOf(field));
+                    }
+                }
+
+                for (const auto& unknown : m_unknownFields)
+                {
+                    if (!isCovered(unknown.parent))
+                    {
+                        remaining.emplace_back(unknown.path);
+                    }
+                }
+
+                std::sort(remaining.begin(), remaining.end());
+                remaining.erase(std::unique(remaining.begin(), remaining.end()), remaining.end());
+
+                for (const auto& path : remaining)
+                {
+                    const std::string_view key = std::string_view{path}.substr(path.rfind('\0') + 1);
+                    if (key != "static")
+                    {
+                        warnings.push_back(std::format("Key: {} was still remaining after parsing.", key));
+                    }
+                }
+            }
+
+        private:
+            struct Frame
+            {
+                /**
+                * The field of this container, or for containers that aren't in FIELDS the closest one that is. */
+                Field field;
+                bool known;
+                bool array;
+
+                /**
+                * Keys in this object are reported as leftovers if nothing consumes them. The DOM path never looks
+                * inside arrays, so this is false anywhere below one. */
+                bool recordKeys;
+                std::size_t unknownPathLength;
+            };
+
+            struct Target
+            {
+                Value* value;
+                Field field;
+                bool known;
+            };
+
+            struct UnknownField
+            {
+                Field parent;
+                std::string path;
+            };
+
+            Value& slot(Field field)
+            {
+                return m_values[index(field)];
+            }
+
+            [[nodiscard]] const Value& slot(Field field) const
+            {
+                return m_values[index(field)];
+            }
+
+            /**
+            * Resets a field and everything below it, a repeated key replaces the earlier value as it does in a DOM. */
+            void resetField(Field field)
+            {
+                const std::size_t begin = index(field);
+                const std::size_t end = SUBTREE_ENDS[begin];
+                for (std::size_t i = begin; i < end; ++i)
+                {
+                    m_values[i].reset();
+                }
+
+                if (!m_unknownFields.empty())
+                {
+                    std::erase_if(m_unknownFields, [&](const UnknownField& unknown)
+                    {
+                        return index(unknown.parent) >= begin && index(unknown.parent) < end;
+                    });
+                }
+
+                if (field == Field::LensDistortion || isAncestor(field, Field::LensDistortion))
+                {
+                    m_buffers.clear(m_distortions);
+                    m_distortionErrors.clear();
+                }
+
+                if (field == Field::Transforms || isAncestor(field, Field::Transforms))
+                {
+                    m_buffers.clear(m_transforms);
+                    m_transformErrors.clear();
+                }
+            }
+
+            /**
+            * Works out where the next value in the stream belongs. */
+            Target nextValue()
+            {
+                if (m_skipDepth > 0 || m_skipPending)
+                {
+                    m_skipPending = false;
+                    return {nullptr, Field::Root, false};
+                }
+
+                if (m_frames.empty())
+                {
+                    resetField(Field::Root);
+                    return {&slot(Field::Root), Field::Root, true};
+                }
+
+                const Frame& frame = m_frames.back();
+                if (!frame.array)
+                {
+                    if (!m_pendingField.has_value())
+                    {
+                        return {nullptr, frame.field, false};
+                    }
+
+                    const Field field = m_pendingField.value();
+                    resetField(field);
+                    return {&slot(field), field, true};
+                }
+
+                if (!frame.known)
+                {
+                    return {nullptr, frame.field, false};
+                }
+
+                if (const auto item = itemOf(frame.field); item.has_value())
+                {
+                    resetField(item.value());
+                    return {&slot(item.value()), item.value(), true};
+                }
+
+                return {&slot(frame.field).addItem(), frame.field, false};
+            }
+
+            bool startContainer(Value::Type type)
+            {
+                if (m_skipDepth > 0 || m_skipPending)
+                {
+                    m_skipPending = false;
+                    ++m_skipDepth;
+                    return true;
+                }
+
+                const Target target = nextValue();
+                if (target.value != nullptr)
+                {
+                    target.value->type = type;
+                }
+
+                const bool recordKeys = m_frames.empty() || (m_frames.back().recordKeys && !m_frames.back().array);
+                const std::size_t unknownPathLength = m_unknownPath.size();
+                if (!target.known && recordKeys)
+                {
+                    m_unknownPath.push_back('\0');
+                    m_unknownPath.append(m_pendingUnknownKey);
+                }
+
+                m_frames.push_back(Frame{target.field, target.known, type == Value::Type::ARRAY, recordKeys, unknownPathLength});
+                return true;
+            }
+
+            /**
+            * A field is covered if it, or any object it sits in, has been consumed. */
+            [[nodiscard]] bool isCovered(Field field) const
+            {
+                while (true)
+                {
+                    if (slot(field).consumed)
+                    {
+                        return true;
+                    }
+
+                    if (field == Field::Root)
+                    {
+                        return false;
+                    }
+                    field = parentOf(field);
+                }
+            }
+
+            /**
+            * Equivalent of OpenTrackIOHelpers::clearFieldIfEmpty. */
+            void consumeIfEmpty(Field field)
+            {
+                Value& value = slot(field);
+                if (!value.isObject() || value.hasUnknownFields)
+                {
+                    return;
+                }
+
+                for (std::size_t i = index(field) + 1; i < SUBTREE_ENDS[index(field)]; i = SUBTREE_ENDS[i])
+                {
+                    if (m_values[i].isPresent() && !m_values[i].consumed)
+                    {
+                        return;
+                    }
+                }
+                value.consumed = true;
+            }
+
+            void consume(Field field)
+            {
+                slot(field).consumed = true;
+            }
+
+            [[nodiscard]] bool isPresent(Field field) const
+            {
+                return slot(field).isPresent();
+            }
+
+            /**
+            * Equivalent of OpenTrackIOHelpers::assignField. Where get<T>() would have thrown on the DOM path the
+            * mismatch is reported as an error instead. */
+            template<typename T>
+            void assignField(Field field, std::optional<T>& out, std::string_view typeStr, ParseErrors& errors)
+            {                Value& value = slot(field);
+                if (!value.isPresent())
+                {
+                    return;
+                }
+
+                T val = m_buffers.takeFor<T>(value);
+                if (!value.get(val))
+                {
+                    m_buffers.give(val);
+                    errors.add(ErrorCode::NOT_OF_TYPE, keyOf(field), typeStr);
+                    return;
+                }
+
+                out = std::move(val);
+                value.consumed = true;
+            }
+
+            /**
+            * As above for a value held copy-on-write, refilled in place in the instance kept from the last sample. */
+            void assignField(Field field, opentrackiotypes::CopyOnWrite<opentrackiotypes::Vector<opentrackiotypes::String>>& out,
+                             std::string_view typeStr, ParseErrors& errors)
+            {
+                Value& value = slot(field);
+                if (!value.isPresent())
+                {
+                    return;
+                }
+
+                if (!out.has_value())
+                {
+                    m_buffers.take(out);
+                }
+                if (!value.get(out.reuse()))
+                {
+                    out.reset();
+                    errors.add(ErrorCode::NOT_OF_TYPE, keyOf(field), typeStr);
+                    return;
+                }
+
+                value.consumed = true;
+            }
+
+            /**
+            * As assignField for a string that is only compared, returning a view of the value instead of a copy. */
+            std::optional<std::string_view> viewStringField(Field field, ParseErrors& errors)
+            {
+                Value& value = slot(field);
+                if (!value.isPresent())
+                {
+                    return std::nullopt;
+                }
+
+                if (!value.isString())
+                {
+                    errors.add(ErrorCode::NOT_OF_TYPE, keyOf(field), "string");
+                    return std::nullopt;
+                }
+
+                value.consumed = true;
+                return value.string;
+            }
+
+            /**
+            * Equivalent of OpenTrackIOHelpers::assignPatternField. */
+            void assignPatternField(Field field, std::optional<opentrackiotypes::String>& out, bool (*matchesPattern)(std::string_view),
+                                    ParseErrors& errors)
+            {
+                Value& value = slot(field);
+                if (!value.isPresent())
+                {
+                    return;
+                }
+
+                if (!value.isString())
+                {
+                    errors.add(ErrorCode::NOT_OF_TYPE, keyOf(field), "string");
+                    out = std::nullopt;
+                    return;
+                }
+
+                if (!matchesPattern(value.string))
+                {
+                    errors.add(ErrorCode::PATTERN_MISMATCH, keyOf(field));
+                    out = std::nullopt;
+                    return;
+                }
+
+                out = m_buffers.takeFor<opentrackiotypes::String>(value);
+                out->assign(value.string);
+                value.consumed = true;
+            }
+
+            /**
+            * As assignPatternField for a URN, which is converted to its Uuid without copying the string. */
+            void assignUuidField(Field field, std::optional<opentrackiotypes::Uuid>& out, ParseErrors& errors)
+            {
+                Value& value = slot(field);
+                if (!value.isPresent())
+                {
+                    return;
+                }
+
+                if (!value.isString())
+                {
+                    errors.add(ErrorCode::NOT_OF_TYPE, keyOf(field), "string");
+                    out = std::nullopt;
+                    return;
+                }
+
+                out = opentrackiotypes::Uuid::fromUrn(value.string);
+                if (!out.has_value())
+                {
+                    errors.add(ErrorCode::PATTERN_MISMATCH, keyOf(field));
+                    return;
+                }
+
+                value.consumed = true;
+            }
+
+            // ------- Types
+            std::optional<opentrackiotypes::Rational> parseRational(Field field, ParseErrors& errors) const
+            {
+                const Value& num = slot(findChild(field, "num").value());
+                const Value& denom = slot(findChild(field, "denom").value());
+
+                if (!slot(field).isObject() || !num.isPresent() || !denom.isPresent())
+                {
+                    errors.add(ErrorCode::KEY_MISSING_RATIONAL_FIELDS, keyOf(field));
+                    return std::nullopt;
+                }
+
+                if (!num.isNumberUnsigned() || !denom.isNumberUnsigned())
+                {
+                    errors.add(ErrorCode::KEY_RATIONAL_NOT_UNSIGNED, keyOf(field));
+                    return std::nullopt;
+                }
+
+                return opentrackiotypes::Rational(static_cast<uint32_t>(num.unsignedInteger),
+                                                  static_cast<uint32_t>(denom.unsignedInteger));
+            }
+
+            /**
+            * Shared by Vector3 and Rotation, which only differ in their field names and error text. */
+            bool parseTriple(Field field, std::array<std::string_view, 3> keys, std::string_view typeName,
+                             std::array<double, 3>& out, ParseErrors& errors) const
+            {
+                std::array<const Value*, 3> values{};
+                for (std::size_t i = 0; i < keys.size(); ++i)
+                {
+                    values[i] = &slot(findChild(field, keys[i]).value());
+                }
+
+                if (!slot(field).isObject() || !values[0]->isPresent() || !values[1]->isPresent() || !values[2]->isPresent())
+                {
+                    errors.add(ErrorCode::KEY_MISSING_FIELDS, keyOf(field), typeName);
+                    return false;
+                }
+
+                if (!values[0]->isNumber() || !values[1]->isNumber() || !values[2]->isNumber())
+                {
+                    errors.add(ErrorCode::KEY_FIELDS_NOT_DOUBLE, keyOf(field), typeName);
+                    return false;
+                }
+
+                for (std::size_t i = 0; i < keys.size(); ++i)
+                {
+                    values[i]->get(out[i]);
+                }
+                return true;
+            }
+
+            std::optional<opentrackiotypes::Vector3> parseVector3(Field field, ParseErrors& errors) const
+            {
+                std::array<double, 3> xyz{};
+                if (!parseTriple(field, {"x", "y", "z"}, "Vector3", xyz, errors))
+                {
+                    return std::nullopt;
+                }
+                return opentrackiotypes::Vector3(xyz[0], xyz[1], xyz[2]);
+            }
+
+            std::optional<opentrackiotypes::Rotation> parseRotation(Field field, ParseErrors& errors) const
+            {
+                std::array<double, 3> ptr{};
+                if (!parseTriple(field, {"pan", "tilt", "roll"}, "Rotation", ptr, errors))
+                {
+                    return std::nullopt;
+                }
+                return opentrackiotypes::Rotation(ptr[0], ptr[1], ptr[2]);
+            }
+
+            std::optional<opentrackiotypes::Timestamp> parseTimestamp(Field field, ParseErrors& errors)
+            {
+                std::optional<uint64_t> seconds = std::nullopt;
+                std::optional<uint32_t> nanoseconds = std::nullopt;
+
+                assignField(findChild(field, "seconds").value(), seconds, "uint64", errors);
+                assignField(findChild(field, "nanoseconds").value(), nanoseconds, "uint32", errors);
+
+                if (!seconds.has_value() || !nanoseconds.has_value())
+                {
+                    errors.add(ErrorCode::MISSING_FIELDS, "timestamp");
+                    return std::nullopt;
+                }
+
+                return opentrackiotypes::Timestamp(seconds.value(), nanoseconds.value());
+            }
+
+            template<typename T>
+            std::optional<opentrackiotypes::Dimensions<T>> parseDimensions(Field field, ParseErrors& errors)
+            {
+                std::optional<T> width = std::nullopt;
+                std::optional<T> height = std::nullopt;
+
+                assignField(findChild(field, "width").value(), width, "double", errors);
+                assignField(findChild(field, "height").value(), height, "double", errors);
+
+                if (!width.has_value() || !height.has_value())
+                {
+                    errors.add(ErrorCode::KEY_MISSING_FIELDS, keyOf(field), "dimensions");
+                    return std::nullopt;
+                }
+
+                return opentrackiotypes::Dimensions<T>(width.value(), height.value());
+            }
+
+            std::optional<opentrackiotypes::Timecode> parseTimecode(ParseErrors& errors)
+            {
+                std::optional<uint8_t> hours = std::nullopt;
+                std::optional<uint8_t> minutes = std::nullopt;
+                std::optional<uint8_t> seconds = std::nullopt;
+                std::optional<uint8_t> frames = std::nullopt;
+                const std::optional<opentrackiotypes::Rational> frameRate = parseRational(Field::TimecodeFrameRate, errors);
+
+                assignField(Field::TimecodeHours, hours, "uint8", errors);
+                assignField(Field::TimecodeMinutes, minutes, "uint8", errors);
+                assignField(Field::TimecodeSeconds, seconds, "uint8", errors);
+                assignField(Field::TimecodeFrames, frames, "uint8", errors);
+
+                if (!hours.has_value() || !minutes.has_value() || !seconds.has_value() || !frames.has_value() ||
+                    !frameRate.has_value())
+                {
+                    errors.add(ErrorCode::MISSING_FIELDS, "timing/timecode");
+                    return std::nullopt;
+                }
+
+                std::optional<uint32_t> subFrame;
+                assignField(Field::TimecodeSubFrame, subFrame, "uint32_t", errors);
+
+                std::optional<bool> dropFrame;
+                assignField(Field::TimecodeDropFrame, dropFrame, "boolean", errors);
+
+                return opentrackiotypes::Timecode{
+                    hours.value(),
+                    minutes.value(),
+                    seconds.value(),
+                    frames.value(),
+                    frameRate.value(),
+                    subFrame,
+                    dropFrame
+                };
+            }
+
+            // ------- Array items, validated as soon as each element is complete
+            void finishDistortion()
+            {
+                std::optional<opentrackioproperties::Lens::Coefficients> radial = std::nullopt;
+                std::optional<opentrackioproperties::Lens::Coefficients> tangential = std::nullopt;
+                std::optional<double> overscan = std::nullopt;
+                std::optional<opentrackiotypes::String> model = std::nullopt;
+
+                assignField(Field::LensDistortionRadial, radial, "double", m_distortionErrors);
+                assignField(Field::LensDistortionTangential, tangential, "double", m_distortionErrors);
+                assignField(Field::LensDistortionModel, model, "string", m_distortionErrors);
+                assignField(Field::LensDistortionOverscan, overscan, "double", m_distortionErrors);
+
+                if (radial.has_value())
+                {
+                    // Moved in by construction, assigning would copy between unequal pmr allocators.
+                    m_distortions.push_back({std::move(radial.value()), std::move(tangential), std::move(model), overscan});
+                }
+            }
+
+            void finishTransform()
+            {
+                if (!isPresent(Field::TransformTranslation) || !isPresent(Field::TransformRotation))
+                {
+                    return;
+                }
+
+                const auto translation = parseVector3(Field::TransformTranslation, m_transformErrors);
+                const auto rotation = parseRotation(Field::TransformRotation, m_transformErrors);
+                if (!translation.has_value() || !rotation.has_value())
+                {
+                    return;
+                }
+
+                opentrackiotypes::Transform tf{translation.value(), rotation.value()};
+                if (isPresent(Field::TransformScale))
+                {
+                    tf.scale = parseVector3(Field::TransformScale, m_transformErrors);
+                }
+
+                assignField(Field::TransformId, tf.id, "string", m_transformErrors);
+                m_transforms.emplace_back(std::move(tf));
+            }
+
+            // ------- Properties
+            std::optional<opentrackioproperties::Camera> parseCamera(ParseErrors& errors)
+            {
+                if (!isPresent(Field::Camera))
+                {
+                    return std::nullopt;
+                }
+
+                if (!slot(Field::Camera).isObject())
+                {
+                    errors.add(ErrorCode::NOT_OF_TYPE, "camera", "object");
+                    return std::nullopt;
+                }
+
+                opentrackioproperties::Camera cam{};
+
+                if (isPresent(Field::CameraSensorDimensions))
+                {
+                    cam.activeSensorPhysicalDimensions = parseDimensions<double>(Field::CameraSensorDimensions, errors);
+                    consume(Field::CameraSensorDimensions);
+                }
+
+                if (isPresent(Field::CameraSensorResolution))
+                {
+                    cam.activeSensorResolution = parseDimensions<uint32_t>(Field::CameraSensorResolution, errors);
+                    consume(Field::CameraSensorResolution);
+                }
+
+                if (isPresent(Field::CameraAnamorphicSqueeze))
+                {
+                    cam.anamorphicSqueeze = parseRational(Field::CameraAnamorphicSqueeze, errors);
+                    consume(Field::CameraAnamorphicSqueeze);
+                }
+
+                assignField(Field::CameraFirmwareVersion, cam.firmwareVersion, "string", errors);
+                assignField(Field::CameraLabel, cam.label, "string", errors);
+                assignField(Field::CameraMake, cam.make, "string", errors);
+                assignField(Field::CameraModel, cam.model, "string", errors);
+                assignField(Field::CameraSerialNumber, cam.serialNumber, "string", errors);
+
+                if (isPresent(Field::CameraCaptureFrameRate))
+                {
+                    cam.captureFrameRate = parseRational(Field::CameraCaptureFrameRate, errors);
+                    consume(Field::CameraCaptureFrameRate);
+                }
+
+                assignPatternField(Field::CameraFdlLink, cam.fdlLink, opentrackiovalidation::isUrnUuid, errors);
+
+                assignField(Field::CameraIsoSpeed, cam.isoSpeed, "uint32", errors);
+                assignField(Field::CameraShutterAngle, cam.shutterAngle, "double", errors);
+
+                if (cam.shutterAngle.has_value() && cam.shutterAngle.value() > 360)
+                {
+                    errors.add(ErrorCode::OUT_OF_RANGE, "shutterAngle", "1 - 360");
+                    cam.shutterAngle = std::nullopt;
+                }
+
+                consumeIfEmpty(Field::Camera);
+                return cam;
+            }
+
+            std::optional<opentrackioproperties::Duration> parseDuration(ParseErrors& errors)
+            {
+                if (!isPresent(Field::Duration))
+                {
+                    return std::nullopt;
+                }
+
+                if (!slot(Field::Duration).isObject())
+                {
+                    errors.add(ErrorCode::NOT_OF_TYPE, "duration", "object");
+                    return std::nullopt;
+                }
+
+                std::optional<uint32_t> numerator = std::nullopt;
+                std::optional<uint32_t> denominator = std::nullopt;
+
+                assignField(Field::DurationNum, numerator, "uint64", errors);
+                assignField(Field::DurationDenom, denominator, "uint64", errors);
+
+                if (!numerator.has_value() || !denominator.has_value())
+                {
+                    errors.add(ErrorCode::MISSING_FIELDS, "duration");
+                    return std::nullopt;
+                }
+
+                consumeIfEmpty(Field::Duration);
+                return opentrackioproperties::Duration{{numerator.value(), denominator.value()}};
+            }
+
+            std::optional<opentrackioproperties::GlobalStage> parseGlobalStage(ParseErrors& errors)
+            {
+                if (!isPresent(Field::GlobalStage))
+                {
+                    return std::nullopt;
+                }
+
+                if (!slot(Field::GlobalStage).isObject())
+                {
+                    errors.add(ErrorCode::NOT_OF_TYPE, "globalStage", "object");
+                    return std::nullopt;
+                }
+
+                opentrackioproperties::GlobalStage gs{};
+
+                const auto fieldCheckAndAssign = [&](Field field, double& out)
+                {
+                    const Value& value = slot(field);
+                    if (!value.isPresent())
+                    {
+                        errors.add(ErrorCode::MISSING_FIELD, "globalStage", keyOf(field));
+                        return false;
+                    }
+
+                    if (!value.isNumber())
+                    {
+                        errors.add(ErrorCode::NOT_A_NUMBER, "globalStage", keyOf(field));
+                        return false;
+                    }
+
+                    return value.get(out);
+                };
+
+                const auto fieldsSet =
+                        fieldCheckAndAssign(Field::GlobalStageE, gs.e) && fieldCheckAndAssign(Field::GlobalStageN, gs.n) &&
+                        fieldCheckAndAssign(Field::GlobalStageU, gs.u) && fieldCheckAndAssign(Field::GlobalStageLat0, gs.lat0) &&
+                        fieldCheckAndAssign(Field::GlobalStageLon0, gs.lon0) && fieldCheckAndAssign(Field::GlobalStageH0, gs.h0);
+
+                if (!fieldsSet)
+                {
+                    return std::nullopt;
+                }
+
+                consume(Field::GlobalStage);
+                return gs;
+            }
+
+            /**
+            * Equivalent of the offset structs in Lens::parse, which are set only if both x and y are present. */
+            template<typename T>
+            std::optional<T> parseOffset(Field field, ParseErrors& errors)
+            {
+                std::optional<double> x = std::nullopt;
+                std::optional<double> y = std::nullopt;
+
+                assignField(findChild(field, "x").value(), x, "double", errors);
+                assignField(findChild(field, "y").value(), y, "double", errors);
+                consume(field);
+
+                if (x.has_value() && y.has_value())
+                {
+                    return T{x.value(), y.value()};
+                }
+                return std::nullopt;
+            }
+
+            std::optional<opentrackioproperties::Lens> parseLens(ParseErrors& errors)
+            {
+                using Lens = opentrackioproperties::Lens;
+
+                if (!isPresent(Field::Lens) && !isPresent(Field::StaticLens))
+                {
+                    return std::nullopt;
+                }
+
+                Lens lens{};
+
+                // ------- Static Fields
+                if (isPresent(Field::StaticLens))
+                {
+                    assignField(Field::StaticLensFirmwareVersion, lens.firmwareVersion, "string", errors);
+                    assignField(Field::StaticLensMake, lens.make, "string", errors);
+                    assignField(Field::StaticLensModel, lens.model, "string", errors);
+                    assignField(Field::StaticLensNominalFocalLength, lens.nominalFocalLength, "double", errors);
+                    assignField(Field::StaticLensSerialNumber, lens.serialNumber, "string", errors);
+                    assignField(Field::StaticLensDistortionOverscanMax, lens.distortionOverscanMax, "double", errors);
+                    assignField(Field::StaticLensUndistortionOverscanMax, lens.undistortionOverscanMax, "double", errors);
+
+                    // Only consumed when it's an array, as with the std::vector<std::string> specialisation of assignField.
+                    if (slot(Field::StaticLensCalibrationHistory).isArray())
+                    {
+                        assignField(Field::StaticLensCalibrationHistory, lens.calibrationHistory, "string", errors);
+                    }
+
+                    consumeIfEmpty(Field::StaticLens);
+                }
+
+                // ------- Standard Fields
+                if (isPresent(Field::Lens))
+                {
+                    if (slot(Field::LensCustom).isArray())
+                    {
+                        assignField(Field::LensCustom, lens.custom, "double", errors);
+                    }
+
+                    if (slot(Field::LensDistortion).isArray())
+                    {
+                        errors.append(m_distortionErrors);
+                        lens.distortion = std::move(m_distortions);
+                        m_distortions = m_buffers.take<opentrackiotypes::Vector<opentrackioproperties::Lens::Distortion>>();
+                        consume(Field::LensDistortion);
+                    }
+
+                    if (isPresent(Field::LensDistortionOffset))
+                    {
+                        lens.distortionOffset = parseOffset<Lens::DistortionOffset>(Field::LensDistortionOffset, errors);
+                    }
+
+                    if (isPresent(Field::LensEncoders))
+                    {
+                        Lens::Encoders encoders{};
+                        assignField(Field::LensEncodersFocus, encoders.focus, "double", errors);
+                        assignField(Field::LensEncodersIris, encoders.iris, "double", errors);
+                        assignField(Field::LensEncodersZoom, encoders.zoom, "double", errors);
+
+                        if (encoders.focus.has_value() && encoders.iris.has_value() && encoders.zoom.has_value())
+                        {
+                            lens.encoders = encoders;
+                            consume(Field::LensEncoders);
+                        }
+                    }
+
+                    assignField(Field::LensEntrancePupilOffset, lens.entrancePupilOffset, "double", errors);
+
+                    if (isPresent(Field::LensExposureFalloff))
+                    {
+                        std::optional<double> a1 = std::nullopt;
+                        std::optional<double> a2 = std::nullopt;
+                        std::optional<double> a3 = std::nullopt;
+
+                        assignField(Field::LensExposureFalloffA1, a1, "double", errors);
+                        assignField(Field::LensExposureFalloffA2, a2, "double", errors);
+                        assignField(Field::LensExposureFalloffA3, a3, "double", errors);
+
+                        if (a1.has_value())
+                        {
+                            lens.exposureFalloff = Lens::ExposureFalloff{a1.value(), a2, a3};
+                        }
+                        consume(Field::LensExposureFalloff);
+                    }
+
+                    assignField(Field::LensFStop, lens.fStop, "double", errors);
+                    assignField(Field::LensPinholeFocalLength, lens.pinholeFocalLength, "double", errors);
+                    assignField(Field::LensFocusDistance, lens.focusDistance, "double", errors);
+
+                    if (slot(Field::LensCalibrationHistory).isArray())
+                    {
+                        assignField(Field::LensCalibrationHistory, lens.calibrationHistory, "string", errors);
+                    }
+
+                    if (isPresent(Field::LensProjectionOffset))
+                    {
+                        lens.projectionOffset = parseOffset<Lens::ProjectionOffset>(Field::LensProjectionOffset, errors);
+                    }
+
+                    if (isPresent(Field::LensRawEncoders))
+                    {
+                        lens.rawEncoders = Lens::RawEncoders{};
+                        assignField(Field::LensRawEncodersFocus, lens.rawEncoders->focus, "unit32", errors);
+                        assignField(Field::LensRawEncodersIris, lens.rawEncoders->iris, "uint32", errors);
+                        assignField(Field::LensRawEncodersZoom, lens.rawEncoders->zoom, "uint32", errors);
+                        consume(Field::LensRawEncoders);
+                    }
+
+                    assignField(Field::LensTStop, lens.tStop, "double", errors);
+
+                    consumeIfEmpty(Field::Lens);
+                }
+
+                return lens;
+            }
+
+            std::optional<opentrackioproperties::Protocol> parseProtocol(ParseErrors& errors)
+            {
+                if (!isPresent(Field::Protocol))
+                {
+                    return std::nullopt;
+                }
+
+                opentrackioproperties::Protocol pro{m_buffers.make<opentrackiotypes::String>(),
+                                                    m_buffers.make<opentrackiotypes::Vector<uint16_t>>()};
+                const Value& name = slot(Field::ProtocolName);
+
+                if (!name.isPresent())
+                {
+                    errors.add(ErrorCode::MISSING_NAMED_FIELD, "protocol", "name");
+                    return std::nullopt;
+                }
+
+                if (!name.isString())
+                {
+                    errors.add(ErrorCode::NOT_OF_TYPE, "protocol name", "string");
+                    return std::nullopt;
+                }
+
+                pro.name = m_buffers.takeFor<opentrackiotypes::String>(name);
+                pro.name.assign(name.string);
+
+                const Value& version = slot(Field::ProtocolVersion);
+                if (!version.isArray())
+                {
+                    errors.add(ErrorCode::NOT_OF_TYPE, "protocol version", "[int, int, int]");
+                    return std::nullopt;
+                }
+
+                if (version.elementCount != 3)
+                {
+                    errors.add(ErrorCode::WRONG_SIZE, "protocol version", "[int, int, int]", 3);
+                    return std::nullopt;
+                }
+
+                if (!version.items()[0].equals(OPEN_TRACK_IO_PROTOCOL_MAJOR_VERSION) ||
+                    !version.items()[1].equals(OPEN_TRACK_IO_PROTOCOL_MINOR_VERSION) ||
+                    !version.items()[2].equals(OPEN_TRACK_IO_PROTOCOL_PATCH))
+                {
+                    errors.add(ErrorCode::VERSION_MISMATCH, "protocol");
+                    return std::nullopt;
+                }
+
+                pro.version = m_buffers.take<opentrackiotypes::Vector<uint16_t>>();
+                pro.version.assign({
+                    OPEN_TRACK_IO_PROTOCOL_MAJOR_VERSION,
+                    OPEN_TRACK_IO_PROTOCOL_MINOR_VERSION,
+                    OPEN_TRACK_IO_PROTOCOL_PATCH
+                });
+
+                consume(Field::Protocol);
+                return pro;
+            }
+
+            std::optional<opentrackioproperties::RelatedSampleIds> parseRelatedSampleIds(ParseErrors& errors)
+            {
+                const Value& rsValue = slot(Field::RelatedSampleIds);
+                if (!rsValue.isPresent())
+                {
+                    return std::nullopt;
+                }
+
+                if (!rsValue.isArray())
+                {
+                    errors.add(ErrorCode::NOT_OF_TYPE, "relatedSampleIds", "array");
+                    return std::nullopt;
+                }
+
+                opentrackioproperties::RelatedSampleIds rs{m_buffers.take<opentrackiotypes::Vector<opentrackiotypes::Uuid>>()};
+                for (const auto& item : rsValue.items())
+                {
+                    if (!item.isString())
+                    {
+                        errors.add(ErrorCode::NOT_OF_TYPE, "relatedSampleIds/element", "string");
+                        continue;
+                    }
+
+                    // Check the string received to ensure that it matches the pattern described by the spec.
+                    const std::optional<opentrackiotypes::Uuid> uuid = opentrackiotypes::Uuid::fromUrn(item.string);
+                    if (!uuid.has_value())
+                    {
+                        errors.add(ErrorCode::ELEMENT_PATTERN_MISMATCH, "relatedSampleIds");
+                        continue;
+                    }
+
+                    rs.samples.push_back(uuid.value());
+                }
+
+                consume(Field::RelatedSampleIds);
+                return rs;
+            }
+
+            std::optional<opentrackioproperties::SampleId> parseSampleId(ParseErrors& errors)
+            {
+                std::optional<opentrackiotypes::Uuid> id;
+                assignUuidField(Field::SampleId, id, errors);
+
+                if (!id.has_value())
+                {
+                    return std::nullopt;
+                }
+
+                return opentrackioproperties::SampleId{id.value()};
+            }
+
+            std::optional<opentrackioproperties::SourceId> parseSourceId(ParseErrors& errors)
+            {
+                std::optional<opentrackiotypes::Uuid> id;
+                assignUuidField(Field::SourceId, id, errors);
+
+                if (!id.has_value())
+                {
+                    return std::nullopt;
+                }
+
+                return opentrackioproperties::SourceId{id.value()};
+            }
+
+            std::optional<opentrackioproperties::SourceNumber> parseSourceNumber(ParseErrors& errors)
+            {
+                std::optional<uint32_t> val;
+                assignField(Field::SourceNumber, val, "uint32", errors);
+
+                if (!val.has_value())
+                {
+                    return std::nullopt;
+                }
+
+                return opentrackioproperties::SourceNumber{val.value()};
+            }
+
+            std::optional<opentrackioproperties::Timing> parseTiming(ParseErrors& errors)
+            {
+                using Timing = opentrackioproperties::Timing;
+
+                if (!isPresent(Field::Timing))
+                {
+                    return std::nullopt;
+                }
+
+                if (!slot(Field::Timing).isObject())
+                {
+                    errors.add(ErrorCode::NOT_OF_TYPE, "timing", "object");
+                    return std::nullopt;
+                }
+
+                Timing timing{};
+
+                if (isPresent(Field::TimingSampleRate))
+                {
+                    timing.sampleRate = parseRational(Field::TimingSampleRate, errors);
+                    consume(Field::TimingSampleRate);
+                }
+
+                const std::optional<std::string_view> str = viewStringField(Field::TimingMode, errors);
+                if (str.has_value() && (str == "external" || str == "internal"))
+                {
+                    timing.mode = str == "external" ? Timing::Mode::EXTERNAL : Timing::Mode::INTERNAL;
+                }
+                else if (str.has_value())
+                {
+                    errors.add(ErrorCode::INVALID_STRING, "timing/mode");
+                    timing.mode = std::nullopt;
+                }
+
+                if (isPresent(Field::TimingRecordedTimestamp))
+                {
+                    timing.recordedTimestamp = parseTimestamp(Field::TimingRecordedTimestamp, errors);
+                    consume(Field::TimingRecordedTimestamp);
+                }
+
+                if (isPresent(Field::TimingSampleTimestamp))
+                {
+                    timing.sampleTimestamp = parseTimestamp(Field::TimingSampleTimestamp, errors);
+                    consume(Field::TimingSampleTimestamp);
+                }
+
+                assignField(Field::TimingSequenceNumber, timing.sequenceNumber, "uint16", errors);
+
+                if (isPresent(Field::Synchronization))
+                {
+                    timing.synchronization = parseSynchronization(errors);
+                    consumeIfEmpty(Field::Synchronization);
+                }
+
+                if (isPresent(Field::Timecode))
+                {
+                    timing.timecode = parseTimecode(errors);
+                    consume(Field::Timecode);
+                }
+
+                consumeIfEmpty(Field::Timing);
+                return timing;
+            }
+
+            std::optional<opentrackioproperties::Timing::Synchronization> parseSynchronization(ParseErrors& errors)
+            {
+                using Synchronization = opentrackioproperties::Timing::Synchronization;
+
+                Synchronization outSync{};
+
+                // Required Fields -------
+                const Value& locked = slot(Field::SynchronizationLocked);
+                const Value& source = slot(Field::SynchronizationSource);
+                if (!locked.isPresent() || !source.isPresent())
+                {
+                    errors.add(ErrorCode::MISSING_FIELDS, "timing/synchronization");
+                    return std::nullopt;
+                }
+
+                if (isPresent(Field::SynchronizationFrequency))
+                {
+                    const auto freq = parseRational(Field::SynchronizationFrequency, errors);
+                    if (!freq.has_value())
+                    {
+                        errors.add(ErrorCode::MISSING_FIELDS, "timing/synchronization/frequency");
+                        return std::nullopt;
+                    }
+                    outSync.frequency = freq.value();
+                    consume(Field::SynchronizationFrequency);
+                }
+
+                if (!locked.isBoolean())
+                {
+                    errors.add(ErrorCode::NOT_OF_TYPE, "timing/synchronization/locked", "bool");
+                    return std::nullopt;
+                }
+
+                outSync.locked = locked.boolean;
+                consume(Field::SynchronizationLocked);
+
+                if (!source.isString())
+                {
+                    errors.add(ErrorCode::NOT_OF_TYPE, "timing/synchronization/source", "string");
+                    return std::nullopt;
+                }
+
+                if (source.string == "genlock")
+                {
+                    outSync.source = Synchronization::SourceType::GEN_LOCK;
+                }
+                else if (source.string == "videoIn")
+                {
+                    outSync.source = Synchronization::SourceType::VIDEO_IN;
+                }
+                else if (source.string == "ptp")
+                {
+                    outSync.source = Synchronization::SourceType::PTP;
+                }
+                else if (source.string == "ntp")
+                {
+                    outSync.source = Synchronization::SourceType::NTP;
+                }
+                else
+                {
+                    errors.add(ErrorCode::INVALID_ENUMERATION, "timing/synchronization/source");
+                    return std::nullopt;
+                }
+                consume(Field::SynchronizationSource);
+
+                // Non-Required Fields --------
+                if (isPresent(Field::SynchronizationOffsets))
+                {
+                    outSync.offsets = Synchronization::Offsets{};
+                    assignField(Field::SynchronizationOffsetsTranslation, outSync.offsets->translation, "double", errors);
+                    assignField(Field::SynchronizationOffsetsRotation, outSync.offsets->rotation, "double", errors);
+                    assignField(Field::SynchronizationOffsetsLensEncoders, outSync.offsets->lensEncoders, "double", errors);
+
+                    if (!outSync.offsets->translation.has_value() && !outSync.offsets->rotation.has_value() &&
+                        !outSync.offsets->lensEncoders.has_value())
+                    {
+                        outSync.offsets = std::nullopt;
+                    }
+                    consume(Field::SynchronizationOffsets);
+                }
+
+                assignField(Field::SynchronizationPresent, outSync.present, "bool", errors);
+
+                if (isPresent(Field::Ptp))
+                {
+                    if (outSync.source == Synchronization::SourceType::PTP)
+                    {
+                        outSync.ptp = parsePtp(errors);
+                    }
+                    consumeIfEmpty(Field::Ptp);
+                }
+
+                return outSync;
+            }
+
+            std::optional<opentrackioproperties::Timing::Synchronization::Ptp> parsePtp(ParseErrors& errors)
+            {
+                using Ptp = opentrackioproperties::Timing::Synchronization::Ptp;
+
+                Ptp outPtp{
+                    .leaderIdentity = m_buffers.make<opentrackiotypes::String>(),
+                    .leaderPriorities = {},
+                    .leaderAccuracy = 0.0,
+                    .meanPathDelay = 0.0,
+                    .vlan = std::nullopt,
+                    .leaderTimeSource = std::nullopt
+                };
+
+                const std::optional<std::string_view> profileStr = viewStringField(Field::PtpProfile, errors);
+                bool successfullyAssignedProfileField = false;
+                if (profileStr.has_value())
+                {
+                    successfullyAssignedProfileField = true;
+                    if (profileStr == "IEEE Std 1588-2019")
+                    {
+                        outPtp.profile = Ptp::ProfileType::IEEE_Std_1588_2019;
+                    }
+                    else if (profileStr == "IEEE Std 802.1AS-2020")
+                    {
+                        outPtp.profile = Ptp::ProfileType::IEEE_Std_802_1AS_2020;
+                    }
+                    else if (profileStr == "SMPTE ST2059-2:2021")
+                    {
+                        outPtp.profile = Ptp::ProfileType::SMPTE_ST2059_2_2021;
+                    }
+                    else
+                    {
+                        successfullyAssignedProfileField = false;
+                    }
+                }
+                else
+                {
+                    errors.add(ErrorCode::REQUIRED_FIELD_MISSING, "timing/synchronization/ptp/profile");
+                    return std::nullopt;
+                }
+
+                if (!successfullyAssignedProfileField)
+                {
+                    errors.add(ErrorCode::INVALID_STRING, "profile");
+                    return std::nullopt;
+                }
+
+                std::optional<uint16_t> domain;
+                assignField(Field::PtpDomain, domain, "uint16", errors);
+                if (!domain.has_value())
+                {
+                    errors.add(ErrorCode::REQUIRED_FIELD_MISSING, "timing/synchronization/ptp/domain");
+                    return std::nullopt;
+                }
+                outPtp.domain = domain.value();
+
+                std::optional<opentrackiotypes::String> leaderIdentity;
+                assignPatternField(Field::PtpLeaderIdentity, leaderIdentity, opentrackiovalidation::isMacAddress, errors);
+
+                if (!leaderIdentity.has_value())
+                {
+                    errors.add(ErrorCode::REQUIRED_FIELD_MISSING, "timing/synchronization/ptp/leaderIdentity");
+                    return std::nullopt;
+                }
+                outPtp.leaderIdentity = std::move(leaderIdentity.value());
+
+                std::optional<uint8_t> priority1;
+                std::optional<uint8_t> priority2;
+                assignField(Field::PtpLeaderPrioritiesPriority1, priority1, "uint8", errors);
+                assignField(Field::PtpLeaderPrioritiesPriority2, priority2, "uint8", errors);
+
+                if (!priority1.has_value() || !priority2.has_value())
+                {
+                    errors.add(ErrorCode::REQUIRED_SUBFIELD_MISSING, "timing/synchronization/ptp/leaderPriorities");
+                    return std::nullopt;
+                }
+                consumeIfEmpty(Field::PtpLeaderPriorities);
+
+                outPtp.leaderPriorities = Ptp::LeaderPriorities{
+                    priority1.value(),
+                    priority2.value()
+                };
+
+                std::optional<double> leaderAccuracy;
+                assignField(Field::PtpLeaderAccuracy, leaderAccuracy, "double", errors);
+                if (!leaderAccuracy.has_value())
+                {
+                    errors.add(ErrorCode::REQUIRED_FIELD_MISSING, "timing/synchronization/ptp/leaderAccuracy");
+                    return std::nullopt;
+                }
+                outPtp.leaderAccuracy = leaderAccuracy.value();
+
+                std::optional<double> meanPathDelay;
+                assignField(Field::PtpMeanPathDelay, meanPathDelay, "double", errors);
+                if (!meanPathDelay.has_value())
+                {
+                    errors.add(ErrorCode::REQUIRED_FIELD_MISSING, "timing/synchronization/ptp/meanPathDelay");
+                    return std::nullopt;
+                }
+                outPtp.meanPathDelay = meanPathDelay.value();
+
+                assignField(Field::PtpVlan, outPtp.vlan, "uint32", errors);
+
+                const std::optional<std::string_view> leaderTimeSourceStr = viewStringField(Field::PtpLeaderTimeSource, errors);
+                if (leaderTimeSourceStr.has_value())
+                {
+                    if (leaderTimeSourceStr == "GNSS")
+                    {
+                        outPtp.leaderTimeSource = Ptp::LeaderTimeSourceType::GNSS;
+                    }
+                    else if (leaderTimeSourceStr == "Atomic clock")
+                    {
+                        outPtp.leaderTimeSource = Ptp::LeaderTimeSourceType::Atomic_clock;
+                    }
+                    else if (leaderTimeSourceStr == "NTP")
+                    {
+                        outPtp.leaderTimeSource = Ptp::LeaderTimeSourceType::NTP;
+                    }
+                }
+
+                return outPtp;
+            }
+
+            std::optional<opentrackioproperties::Tracker> parseTracker(ParseErrors& errors)
+            {
+                if (!isPresent(Field::Tracker) && !isPresent(Field::StaticTracker))
+                {
+                    return std::nullopt;
+                }
+
+                opentrackioproperties::Tracker tkr{};
+
+                // ------- Static Fields
+                if (isPresent(Field::StaticTracker))
+                {
+                    assignField(Field::StaticTrackerFirmwareVersion, tkr.firmwareVersion, "string", errors);
+                    assignField(Field::StaticTrackerMake, tkr.make, "string", errors);
+                    assignField(Field::StaticTrackerModel, tkr.model, "string", errors);
+                    assignField(Field::StaticTrackerSerialNumber, tkr.serialNumber, "string", errors);
+
+                    consumeIfEmpty(Field::StaticTracker);
+                }
+
+                // ------- Standard Fields
+                if (isPresent(Field::Tracker))
+                {
+                    assignField(Field::TrackerNotes, tkr.notes, "string", errors);
+                    assignField(Field::TrackerRecording, tkr.recording, "boolean", errors);
+                    assignField(Field::TrackerSlate, tkr.slate, "string", errors);
+                    assignField(Field::TrackerStatus, tkr.status, "string", errors);
+
+                    consumeIfEmpty(Field::Tracker);
+                }
+
+                return tkr;
+            }
+
+            std::optional<opentrackioproperties::Transforms> parseTransforms(ParseErrors& errors)
+            {
+                if (!isPresent(Field::Transforms))
+                {
+                    return std::nullopt;
+                }
+
+                if (!slot(Field::Transforms).isArray())
+                {
+                    errors.add(ErrorCode::NOT_AN_ARRAY, "Transforms");
+                    return std::nullopt;
+                }
+
+                errors.append(m_transformErrors);
+                consume(Field::Transforms);
+                opentrackioproperties::Transforms transforms{std::move(m_transforms)};
+                m_transforms = m_buffers.take<opentrackioproperties::Transforms::Chain>();
+                return transforms;
+            }
+
+            /**
+            * Assigns the properties of a cached static object, as far as they're in the requested fields. The camera
+            * and calibrationHistory are shared with the block and the other strings of lens and tracker are copied into
+            * spare buffers, so that a hit doesn't allocate once the buffers have grown to fit. */
+            void assignStatic(OpenTrackIOSample& sample, const opentrackioproperties::StaticBlock& block)
+            {
+                if (m_wanted[index(Field::Camera)])
+                {
+                    sample.camera = block.camera;
+                }
+
+                if (m_wanted[index(Field::Duration)])
+                {
+                    sample.duration = block.duration;
+                }
+
+                if (m_wanted[index(Field::StaticLens)] && block.lens.has_value())
+                {
+                    const opentrackioproperties::Lens& from = block.lens.value();
+                    opentrackioproperties::Lens& lens = sample.lens.has_value() ? sample.lens.value() : sample.lens.emplace();
+                    m_buffers.copy(lens.firmwareVersion, from.firmwareVersion);
+                    m_buffers.copy(lens.make, from.make);
+                    m_buffers.copy(lens.model, from.model);
+                    lens.nominalFocalLength = from.nominalFocalLength;
+                    m_buffers.copy(lens.serialNumber, from.serialNumber);
+                    lens.distortionOverscanMax = from.distortionOverscanMax;
+                    lens.undistortionOverscanMax = from.undistortionOverscanMax;
+
+                    // As in parseLens, a calibrationHistory in the dynamic lens replaces the static one.
+                    if (!lens.calibrationHistory.has_value())
+                    {
+                        lens.calibrationHistory = from.calibrationHistory;
+                    }
+                }
+
+                if (m_wanted[index(Field::StaticTracker)] && block.tracker.has_value())
+                {
+                    const opentrackioproperties::Tracker& from = block.tracker.value();
+                    opentrackioproperties::Tracker& tkr = sample.tracker.has_value() ? sample.tracker.value() : sample.tracker.emplace();
+                    m_buffers.copy(tkr.firmwareVersion, from.firmwareVersion);
+                    m_buffers.copy(tkr.make, from.make);
+                    m_buffers.copy(tkr.model, from.model);
+                    m_buffers.copy(tkr.serialNumber, from.serialNumber);
+                }
+            }
+
+            std::array<Value, FIELD_COUNT> m_values{};
+            std::array<bool, FIELD_COUNT> m_wanted{};
+            std::vector<Frame> m_frames{};
+            std::optional<Field> m_pendingField = std::nullopt;
+
+            /**
+            * The next value is outside the requested fields, and the depth of the containers being dropped. */
+            bool m_skipPending = false;
+            std::size_t m_skipDepth = 0;
+
+            /**
+            * Keys of the enclosing objects that aren't in FIELDS, below the closest field that is. */
+            std::string m_unknownPath{};
+            std::string m_pendingUnknownKey{};
+            std::vector<UnknownField> m_unknownFields{};
+
+            opentrackiotypes::Vector<opentrackioproperties::Lens::Distortion> m_distortions{};
+            ParseErrors m_distortionErrors{};
+            opentrackioproperties::Transforms::Chain m_transforms{};
+            ParseErrors m_transformErrors{};
+
+            Buffers m_buffers{};
+
+            struct StaticEntry
+            {
+                /**
+                * Compared in full rather than by hash so that a collision can never assign the wrong block. JSON and
+                * CBOR encodings of an object can't be equal as they start with different bytes. */
+                std::vector<uint8_t> bytes;
+                std::shared_ptr<const opentrackioproperties::StaticBlock> block;
+            };
+
+            using StaticCache = std::unordered_map<opentrackiotypes::Uuid, StaticEntry>;
+
+            /**
+            * A pseudo-random entry to make room in a full cache. Unlike least recently used, which misses every time
+            * when one more source than fits is sent in rotation, random replacement keeps most of them cached. */
+            StaticCache::iterator evictionCandidate()
+            {
+                std::uniform_int_distribution<std::size_t> pick{0, m_staticCache.size() - 1};
+                return std::next(m_staticCache.begin(), static_cast<std::ptrdiff_t>(pick(m_evictionRandom)));
+            }
+
+            /**
+            * Bounds the cache should sourceIds keep changing. */
+            std::size_t m_staticCacheCapacity = OpenTrackIOSaxParser::DEFAULT_STATIC_CACHE_CAPACITY;
+            std::minstd_rand m_evictionRandom{};
+
+            StaticCache m_staticCache{};
+            OpenTrackIOSaxParser::StaticCacheStats m_staticCacheStats{};
+
+            /**
+            * The raw static object of the current parse and the block assigned for it, if any. */
+            std::span<const uint8_t> m_staticBytes{};
+            std::shared_ptr<const opentrackioproperties::StaticBlock> m_staticBlock{};
+            bool m_dropStatic = false;
+        };
+
+        /**
+        * Raw text of the top-level static and sourceId members of a JSON document, the last of each as in a DOM. */
+        struct TopLevelMembers
+        {
+            std::string_view staticValue{};
+            std::string_view sourceId{};
+        };
+
+        /**
+        * Finds the top-level members that the static cache needs without tokenising the document, so that an
+        * unchanged static object can be matched before it's parsed. It's only as strict as it needs to be to find
+        * them, the document is still validated by the parse that follows. Returns std::nullopt if the document isn't
+        * an object or has a top-level key with escapes, which could spell out either name. */
+        class TopLevelScanner
+        {
+        public:
+            explicit TopLevelScanner(std::string_view json)
+                : m_json{json}
+            {
+            }
+
+            std::optional<TopLevelMembers> scan()
+            {
+                TopLevelMembers members{};
+                if (!consume('{'))
+                {
+                    return std::nullopt;
+                }
+
+                if (consume('}'))
+                {
+                    return members;
+                }
+
+                do
+                {
+                    skipWhitespace();
+                    std::string_view key{};
+                    bool escaped = false;
+                    if (!readString(key, escaped) || escaped || !consume(':'))
+                    {
+                        return std::nullopt;
+                    }
+
+                    skipWhitespace();
+                    const std::size_t start = m_position;
+                    if (!skipValue())
+                    {
+                        return std::nullopt;
+                    }
+
+                    const std::string_view value = m_json.substr(start, m_position - start);
+                    if (key == "static")
+                    {
+                        members.staticValue = value;
+                    }
+                    else if (key == "sourceId")
+                    {
+                        // A URN never needs escapes, leaving anything else for the parse to reject.
+                        const bool isPlainString = value.size() >= 2 && value.front() == '"' &&
+                                                   value.find('\\') == std::string_view::npos;
+                        members.sourceId = isPlainString ? value.substr(1, value.size() - 2) : std::string_view{};
+                    }
+                } while (consume(','));
+
+                if (!consume('}'))
+                {
+                    return std::nullopt;
+                }
+                return members;
+            }
+
+        private:
+            void skipWhitespace()
+            {
+                while (m_position < m_json.size() &&
+                       (m_json[m_position] == ' ' || m_json[m_position] == '\t' ||
+                        m_json[m_position] == '\n' || m_json[m_position] == '\r'))
+                {
+                    ++m_position;
+                }
+            }
+
+            bool consume(char c)
+            {
+                skipWhitespace();
+                if (m_position < m_json.size() && m_json[m_position] == c)
+                {
+                    ++m_position;
+                    return true;
+                }
+                return false;
+            }
+
+            /**
+            * Reads the string at the current position, returning its contents between the quotes as they appear. */
+            bool readString(std::string_view& contents, bool& escaped)
+            {
+                if (m_position >= m_json.size() || m_json[m_position] != '"')
+                {
+                    return false;
+                }
+
+                const std::size_t start = ++m_position;
+                while (m_position < m_json.size())
+                {
+                    const char c = m_json[m_position];
+                    if (c == '"')
+                    {
+                        contents = m_json.substr(start, m_position - start);
+                        ++m_position;
+                        return true;
+                    }
+
+                    if (c == '\\')
+                    {
+                        escaped = true;
+                        ++m_position;
+                    }
+                    ++m_position;
+                }
+                return false;
+            }
+
+            /**
+            * Steps over one value, matching brackets outside of strings. */
+            bool skipValue()
+            {
+                std::string_view contents{};
+                bool escaped = false;
+                std::size_t depth = 0;
+
+                while (m_position < m_json.size())
+                {
+                    const char c = m_json[m_position];
+                    if (c == '"')
+                    {
+                        if (!readString(contents, escaped))
+                        {
+                            return false;
+                        }
+                    }
+                    else if (c == '{' || c == '[')
+                    {
+                        ++depth;
+                        ++m_position;
+                    }
+                    else if (c == '}' || c == ']')
+                    {
+                        if (depth == 0)
+                        {
+                            return true;
+                        }
+                        --depth;
+                        ++m_position;
+                    }
+                    else if (depth == 0 && (c == ',' || c == ' ' || c == '\t' || c == '\n' || c == '\r'))
+                    {
+                        return true;
+                    }
+                    else
+                    {
+                        ++m_position;
+                    }
+
+                    if (depth == 0 && (c == '"' || c == '}' || c == ']'))
+                    {
+                        return true;
+                    }
+                }
+                return depth == 0;
+            }
+
+            std::string_view m_json;
+            std::size_t m_position = 0;
+        };
+
+        /**
+        * Decodes an RFC 8949 CBOR item from a byte span and reports it to a SAX handler, accepting the same subset of
+        * CBOR as nlohmann::json::from_cbor: integers, byte and text strings (definite or indefinite length), arrays,
+        * maps with text string keys, booleans, null and half, single and double precision floats. Tags and other simple
+        * values are rejected. Failures are returned rather than thrown.
+        * Values the handler asks to skip are stepped over without being reported or copied, but are still checked to
+        * be well formed. */
+        template<typename Handler>
+        class CborReader
+        {
+        public:
+            /**
+            * Text strings are decoded into string, which is kept by the caller so that its storage is reused. */
+            CborReader(std::span<const uint8_t> cbor, Handler& handler, std::string& string)
+                : m_cbor{cbor}, m_handler{handler}, m_string{string}
+            {
+            }
+
+            /**
+            * Reads exactly one item spanning the whole input. */
+            bool read(OpenTrackIOSaxParser::CborError& error)
+            {
+                if (!readItem<false>(0))
+                {
+                    error = m_error;
+                    return false;
+                }
+
+                if (m_position != m_cbor.size())
+                {
+                    error = {"expected end of input", m_position + 1};
+                    return false;
+                }
+                return true;
+            }
+
+        private:
+            /**
+            * Bounds the recursion of nested arrays, maps and indefinite length string chunks. */
+            static constexpr std::size_t MAX_DEPTH = 512;
+            static constexpr uint8_t INDEFINITE_LENGTH = 31;
+            static constexpr uint8_t BREAK = 0xFF;
+
+            bool fail(std::string_view description, std::size_t byte)
+            {
+                m_error = {description, byte};
+                return false;
+            }
+
+            bool failEndOfInput()
+            {
+                return fail("unexpected end of input", m_cbor.size() + 1);
+            }
+
+            [[nodiscard]] std::size_t remaining() const
+            {
+                return m_cbor.size() - m_position;
+            }
+
+            template<typename T>
+            bool readBigEndian(T& value)
+            {
+                if (remaining() < sizeof(T))
+                {
+                    return failEndOfInput();
+                }
+
+                value = 0;
+                for (std::size_t i = 0; i < sizeof(T); ++i)
+                {
+                    value = static_cast<T>((value << 8) | m_cbor[m_position++]);
+                }
+                return true;
+            }
+
+            /**
+            * Reads the argument that follows an initial byte with the given additional information. */
+            bool readArgument(uint8_t info, uint64_t& argument)
+            {
+                switch (info)
+                {
+                    case 24:
+                    {
+                        uint8_t value = 0;
+                        if (!readBigEndian(value)) return false;
+                        argument = value;
+                        return true;
+                    }
+                    case 25:
+                    {
+                        uint16_t value = 0;
+                        if (!readBigEndian(value)) return false;
+                        argument = value;
+                        return true;
+                    }
+                    case 26:
+                    {
+                        uint32_t value = 0;
+                        if (!readBigEndian(value)) return false;
+                        argument = value;
+                        return true;
+                    }
+                    case 27:
+                        return readBigEndian(argument);
+                    default:
+                        if (info < 24)
+                        {
+                            argument = info;
+                            return true;
+                        }
+                        return fail("invalid byte", m_position);
+                }
+            }
+
+            bool skipBytes(std::size_t count)
+            {
+                if (remaining() < count)
+                {
+                    return failEndOfInput();
+                }
+
+                m_position += count;
+                return true;
+            }
+
+            /**
+            * Reads a string of the given major type, appending it to m_string if keep is set. Indefinite length
+            * strings are a sequence of chunks of the same major type terminated by a break. */
+            bool readString(uint8_t majorType, uint8_t info, std::size_t depth, bool keep)
+            {
+                if (info == INDEFINITE_LENGTH)
+                {
+                    if (depth >= MAX_DEPTH)
+                    {
+                        return fail("nesting too deep", m_position);
+                    }
+
+                    while (true)
+                    {
+                        if (remaining() == 0)
+                        {
+                            return failEndOfInput();
+                        }
+
+                        const uint8_t chunk = m_cbor[m_position++];
+                        if (chunk == BREAK)
+                        {
+                            return true;
+                        }
+
+                        if ((chunk >> 5) != majorType)
+                        {
+                            return fail("invalid byte", m_position);
+                        }
+
+                        if (!readString(majorType, chunk & 0x1F, depth + 1, keep))
+                        {
+                            return false;
+                        }
+                    }
+                }
+
+                uint64_t length = 0;
+                if (!readArgument(info, length))
+                {
+                    return false;
+                }
+
+                if (length > remaining())
+                {
+                    return failEndOfInput();
+                }
+
+                if (keep)
+                {
+                    m_string.append(reinterpret_cast<const char*>(m_cbor.data() + m_position), length);
+                }
+                m_position += length;
+                return true;
+            }
+
+            template<bool Skip>
+            bool readKey(std::size_t depth)
+            {
+                if (remaining() == 0)
+                {
+                    return failEndOfInput();
+                }
+
+                const uint8_t initial = m_cbor[m_position++];
+                if ((initial >> 5) != 3)
+                {
+                    return fail("map key must be a text string", m_position);
+                }
+
+                m_string.clear();
+                return readString(3, initial & 0x1F, depth, !Skip) && (Skip || m_handler.key(m_string));
+            }
+
+            bool readFloat(uint8_t initial)
+            {
+                double value = 0.0;
+                switch (initial)
+                {
+                    case 0xF9:
+                    {
+                        uint16_t half = 0;
+                        if (!readBigEndian(half)) return false;
+
+                        const int exponent = (half >> 10) & 0x1F;
+                        const unsigned mantissa = half & 0x3FF;
+                        if (exponent == 0)
+                        {
+                            value = std::ldexp(mantissa, -24);
+                        }
+                        else if (exponent == 31)
+                        {
+                            value = mantissa == 0
+                                ? std::numeric_limits<double>::infinity()
+                                : std::numeric_limits<double>::quiet_NaN();
+                        }
+                        else
+                        {
+                            value = std::ldexp(mantissa + 1024, exponent - 25);
+                        }
+
+                        if ((half & 0x8000) != 0)
+                        {
+                            value = -value;
+                        }
+                        break;
+                    }
+                    case 0xFA:
+                    {
+                        uint32_t bits = 0;
+                        if (!readBigEndian(bits)) return false;
+                        value = std::bit_cast<float>(bits);
+                        break;
+                    }
+                    default:
+                    {
+                        uint64_t bits = 0;
+                        if (!readBigEndian(bits)) return false;
+                        value = std::bit_cast<double>(bits);
+                        break;
+                    }
+                }
+                return m_handler.number_float(value, m_string);
+            }
+
+            /**
+            * Reads one item and reports it to the handler, or only steps over it when Skip is set. */
+            template<bool Skip>
+            bool readItem(std::size_t depth)
+            {
+                if (remaining() == 0)
+                {
+                    return failEndOfInput();
+                }
+
+                const uint8_t initial = m_cbor[m_position++];
+                const uint8_t majorType = initial >> 5;
+                const uint8_t info = initial & 0x1F;
+                uint64_t argument = 0;
+
+                switch (majorType)
+                {
+                    case 0:
+                        return readArgument(info, argument) && (Skip || m_handler.number_unsigned(argument));
+                    case 1:
+                        return readArgument(info, argument) &&
+                               (Skip || m_handler.number_integer(static_cast<int64_t>(-1) - static_cast<int64_t>(argument)));
+                    case 2:
+                    {
+                        nlohmann::json::binary_t binary{};
+                        return readString(majorType, info, depth, false) && (Skip || m_handler.binary(binary));
+                    }
+                    case 3:
+                        m_string.clear();
+                        return readString(majorType, info, depth, !Skip) && (Skip || m_handler.string(m_string));
+                    case 4:
+                    case 5:
+                        return readContainer<Skip>(majorType, info, depth);
+                    case 7:
+                        switch (initial)
+                        {
+                            case 0xF4: return Skip || m_handler.boolean(false);
+                            case 0xF5: return Skip || m_handler.boolean(true);
+                            case 0xF6: return Skip || m_handler.null();
+                            case 0xF9:
+                            case 0xFA:
+                            case 0xFB:
+                                if constexpr (Skip)
+                                {
+                                    // Half, single and double precision floats follow in 2, 4 and 8 bytes.
+                                    return skipBytes(std::size_t(1) << (initial - 0xF8));
+                                }
+                                m_string.clear();
+                                return readFloat(initial);
+                            default:
+                                return fail("invalid byte", m_position);
+                        }
+                    default:
+                        // Tags aren't supported, as with nlohmann's default tag handler.
+                        return fail("invalid byte", m_position);
+                }
+            }
+
+            /**
+            * Steps over the static object to find its bytes, which are only read again if the handler has no cached
+            * block for them. */
+            bool readStatic(std::size_t depth)
+            {
+                const std::size_t start = m_position;
+                if (!readItem<true>(depth))
+                {
+                    return false;
+                }
+
+                if (m_handler.matchStatic(m_cbor.subspan(start, m_position - start)))
+                {
+                    return true;
+                }
+
+                m_position = start;
+                return readItem<false>(depth);
+            }
+
+            template<bool Skip>
+            bool readContainer(uint8_t majorType, uint8_t info, std::size_t depth)
+            {
+                if (depth >= MAX_DEPTH)
+                {
+                    return fail("nesting too deep", m_position);
+                }
+
+                const bool isMap = majorType == 5;
+                const auto readEntry = [&]()
+                {
+                    if (!isMap)
+                    {
+                        return readItem<Skip>(depth + 1);
+                    }
+
+                    if (!readKey<Skip>(depth + 1))
+                    {
+                        return false;
+                    }
+                    if (Skip || m_handler.skipNextValue())
+                    {
+                        return readItem<true>(depth + 1);
+                    }
+                    return m_handler.staticValueNext() ? readStatic(depth + 1) : readItem<false>(depth + 1);
+                };
+
+                if (info == INDEFINITE_LENGTH)
+                {
+                    if (!Skip && !(isMap ? m_handler.start_object(std::size_t(-1)) : m_handler.start_array(std::size_t(-1))))
+                    {
+                        return false;
+                    }
+
+                    while (true)
+                    {
+                        if (remaining() == 0)
+                        {
+                            return failEndOfInput();
+                        }
+
+                        if (m_cbor[m_position] == BREAK)
+                        {
+                            ++m_position;
+                            break;
+                        }
+
+                        if (!readEntry())
+                        {
+                            return false;
+                        }
+                    }
+                }
+                else
+                {
+                    uint64_t length = 0;
+                    if (!readArgument(info, length))
+                    {
+                        return false;
+                    }
+
+                    // Every entry takes at least one byte so a length beyond the input is truncated regardless.
+                    if (length > remaining())
+                    {
+                        return failEndOfInput();
+                    }
+
+                    if (!Skip && !(isMap ? m_handler.start_object(length) : m_handler.start_array(length)))
+                    {
+                        return false;
+                    }
+
+                    for (uint64_t i = 0; i < length; ++i)
+                    {
+                        if (!readEntry())
+                        {
+                            return false;
+                        }
+                    }
+                }
+
+                return Skip || (isMap ? m_handler.end_object() : m_handler.end_array());
+            }
+
+            std::span<const uint8_t> m_cbor;
+            Handler& m_handler;
+            std::size_t m_position = 0;
+            std::string& m_string;
+            OpenTrackIOSaxParser::CborError m_error{};
+        };
+    } // namespace
+
+    /**
+    * Everything that's kept between parses. */
+    struct OpenTrackIOSaxParser::State
+    {
+        SampleSaxHandler handler{};
+        std::string cborString{};
+    };
+
+    OpenTrackIOSaxParser::OpenTrackIOSaxParser() = default;
+    OpenTrackIOSaxParser::~OpenTrackIOSaxParser() = default;
+
+#ifdef OPENTRACKIO_PMR
+    OpenTrackIOSaxParser::OpenTrackIOSaxParser(std::pmr::memory_resource* resource) : m_resource{resource}
+    {
+    }
+#endif
+
+    OpenTrackIOSaxParser::OpenTrackIOSaxParser(const OpenTrackIOSaxParser& other)
+        : m_staticCacheCapacity{other.m_staticCacheCapacity}
+    {
+    }
+
+    OpenTrackIOSaxParser& OpenTrackIOSaxParser::operator=(const OpenTrackIOSaxParser& other)
+    {
+        setStaticCacheCapacity(other.m_staticCacheCapacity);
+        return *this;
+    }
+
+    OpenTrackIOSaxParser::OpenTrackIOSaxParser(OpenTrackIOSaxParser&&) noexcept = default;
+    OpenTrackIOSaxParser& OpenTrackIOSaxParser::operator=(OpenTrackIOSaxParser&&) noexcept = default;
+
+    OpenTrackIOSaxParser::State& OpenTrackIOSaxParser::state()
+    {
+        if (m_state == nullptr)
+        {
+#ifdef OPENTRACKIO_PMR
+            m_state = std::make_unique<State>(SampleSaxHandler{m_resource});
+#else
+            m_state = std::make_unique<State>();
+#endif
+            m_state->handler.setStaticCacheCapacity(m_staticCacheCapacity);
+        }
+        return *m_state;
+    }
+
+    void OpenTrackIOSaxParser::setStaticCacheCapacity(std::size_t sources)
+    {
+        m_staticCacheCapacity = sources;
+        if (m_state != nullptr)
+        {
+            m_state->handler.setStaticCacheCapacity(sources);
+        }
+    }
+
+    void OpenTrackIOSaxParser::recycle(OpenTrackIOSample& sample)
+    {
+        state().handler.recycle(sample);
+    }
+
+    std::shared_ptr<const opentrackioproperties::StaticBlock> OpenTrackIOSaxParser::staticBlock() const
+    {
+        return m_state != nullptr ? m_state->handler.staticBlock() : nullptr;
+    }
+
+    OpenTrackIOSaxParser::StaticCacheStats OpenTrackIOSaxParser::staticCacheStats() const
+    {
+        return m_state != nullptr ? m_state->handler.staticCacheStats() : StaticCacheStats{};
+    }
+
+    bool OpenTrackIOSaxParser::parse(std::string_view jsonString,
+                                     SampleFields fields,
+                                     OpenTrackIOSample& sample,
+                                     ParseErrors& errors,
+                                     std::vector<std::string>& warnings)
+    {
+        SampleSaxHandler& handler = state().handler;
+        handler.begin(fields);
+
+        const std::optional<TopLevelMembers> members = TopLevelScanner{jsonString}.scan();
+        if (members.has_value() && !members->staticValue.empty())
+        {
+            const std::span<const uint8_t> staticBytes{
+                reinterpret_cast<const uint8_t*>(members->staticValue.data()), members->staticValue.size()};
+            if (handler.matchStatic(staticBytes, members->sourceId))
+            {
+                handler.dropStatic();
+            }
+        }
+
+        if (!nlohmann::json::sax_parse(jsonString, &handler))
+        {
+            return false;
+        }
+
+        handler.assignProperties(sample, errors);
+        handler.updateStaticCache(sample, errors);
+        if (errors.empty())
+        {
+            handler.warnForRemainingFields(warnings);
+        }
+        return true;
+    }
+
+    bool OpenTrackIOSaxParser::parse(std::span<const uint8_t> cbor,
+                                     SampleFields fields,
+                                     OpenTrackIOSample& sample,
+                                     ParseErrors& errors,
+                                     std::vector<std::string>& warnings,
+                                     CborError& cborError)
+    {
+        State& current = state();
+        current.handler.begin(fields);
+        CborReader reader{cbor, current.handler, current.cborString};
+        if (!reader.read(cborError))
+        {
+            return false;
+        }
+
+        current.handler.assignProperties(sample, errors);
+        current.handler.updateStaticCache(sample, errors);
+        if (errors.empty())
+        {
+            current.handler.warnForRemainingFields(warnings);
+        }
+        return true;
+    }
+} // namespace opentrackio
@@ -0,0 +1,348 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "opentrackio-cpp/OpenTrackIOSender.h"
+#include <algorithm>
+#include <cerrno>
+#include <thread>
+#ifdef OPENTRACKIO_IO_URING
+#include "opentrackio-cpp/OpenTrackIOUring.h"
+#endif
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+namespace opentrackio
+{
+    struct OpenTrackIOSender::Queue
+    {
+        Queue(std::size_t capacity, std::size_t maxDatagramSize)
+            : buffers(capacity * maxDatagramSize),
+              iovecs(capacity),
+              destinations(capacity),
+              messages(capacity)
+        {
+            for (std::size_t i = 0; i < capacity; ++i)
+            {
+                iovecs[i].iov_base = buffers.data() + i * maxDatagramSize;
+                messages[i].msg_hdr.msg_iov = &iovecs[i];
+                messages[i].msg_hdr.msg_iovlen = 1;
+                messages[i].msg_hdr.msg_name = &destinations[i];
+                messages[i].msg_hdr.msg_namelen = sizeof(sockaddr_in);
+            }
+        }
+
+        // A datagram buffer per entry, and the headers sendmmsg() takes that point at them.
+        std::vector<uint8_t> buffers;
+        std::vector<iovec> iovecs;
+        std::vector<sockaddr_in> destinations;
+        std::vector<mmsghdr> messages;
+
+#ifdef OPENTRACKIO_IO_URING
+        // With IO_URING, the queue's datagrams are submitted to it as they are to sendmmsg().
+        IoUring ring{};
+#endif
+    };
+
+    OpenTrackIOSender::OpenTrackIOSender(Settings settings) : m_settings{std::move(settings)}
+    {
+        m_settings.queueCapacity = std::max<std::size_t>(m_settings.queueCapacity, 1);
+        m_settings.burstSize = std::max<std::size_t>(m_settings.burstSize, 1);
+        m_settings.maxDatagramSize = std::max(m_settings.maxDatagramSize, PacketHeader::SIZE + 1);
+        m_queue = std::make_unique<Queue>(m_settings.queueCapacity, m_settings.maxDatagramSize);
+    }
+
+    OpenTrackIOSender::~OpenTrackIOSender()
+    {
+        if (m_socket >= 0)
+        {
+            ::close(m_socket);
+        }
+    }
+
+    bool OpenTrackIOSender::open()
+    {
+        if (m_socket >= 0)
+        {
+            return true;
+        }
+
+        const auto fail = [this]()
+        {
+            m_error = std::error_code{errno, std::system_category()};
+            if (m_socket >= 0)
+            {
+                ::close(m_socket);
+                m_socket = -1;
+            }
+            return false;
+        };
+
+        m_socket = ::socket(AF_INET, SOCK_DGRAM | SOCK_CLOEXEC, 0);
+        if (m_socket < 0)
+        {
+            return fail();
+        }
+
+        const unsigned char ttl = m_settings.multicastTtl;
+        const unsigned char loop = m_settings.multicastLoop ? 1 : 0;
+        if (::setsockopt(m_socket, IPPROTO_IP, IP_MULTICAST_TTL, &ttl, sizeof(ttl)) != 0 ||
+            ::setsockopt(m_socket, IPPROTO_IP, IP_MULTICAST_LOOP, &loop, sizeof(loop)) != 0)
+        {
+            return fail();
+        }
+
+        if (m_settings.interfaceAddress != 0)
+        {
+            in_addr interface{};
+            interface.s_addr = htonl(m_settings.interfaceAddress);
+            if (::setsockopt(m_socket, IPPROTO_IP, IP_MULTICAST_IF, &interface, sizeof(interface)) != 0)
+            {
+                return fail();
+            }
+        }
+
+        if (m_settings.sendBufferSize > 0 &&
+            ::setsockopt(m_socket, SOL_SOCKET, SO_SNDBUF, &m_settings.sendBufferSize,
+                         sizeof(m_settings.sendBufferSize)) != 0)
+        {
+            return fail();
+        }
+
+        // A send per queued datagram, as sendmmsg() would be given.
+        m_error = {};
+#ifdef OPENTRACKIO_IO_URING
+        m_backend = m_settings.backend == TransportBackend::IO_URING &&
+                    m_queue->ring.open(static_cast<unsigned int>(std::min<std::size_t>(m_settings.queueCapacity, 4096)),
+                                       0)
+                        ? TransportBackend::IO_URING
+                        : TransportBackend::SOCKETS;
+#else
+        m_backend = TransportBackend::SOCKETS;
+#endif
+        return true;
+    }
+
+    bool OpenTrackIOSender::queue(const OpenTrackIOSample& sample, uint8_t sourceNumber)
+    {
+        if (m_settings.encoding == PayloadEncoding::JSON)
+        {
+            m_json.clear();
+            sample.serializeJson(m_json);
+            return queue(PayloadEncoding::JSON,
+                         {reinterpret_cast<const uint8_t*>(m_json.data()), m_json.size()}, sourceNumber);
+        }
+
+        // Only measure the sample when it has outgrown the buffer, which is then kept at that size.
+        std::optional<std::size_t> size = sample.serializeCbor(m_cbor);
+        if (!size)
+        {
+            m_cbor.resize(sample.serializedCborSize());
+            size = sample.serializeCbor(m_cbor);
+            if (!size)
+            {
+                return false;
+            }
+        }
+        return queue(PayloadEncoding::CBOR, std::span<const uint8_t>(m_cbor).first(*size), sourceNumber);
+    }
+
+    bool OpenTrackIOSender::queue(PayloadEncoding encoding, std::span<const uint8_t> payload, uint8_t sourceNumber)
+    {
+        PacketSegmenter segmenter{encoding, m_sequenceNumber, payload, m_settings.maxDatagramSize};
+        const std::size_t segments = segmenter.segmentCount();
+        if (segments > m_settings.queueCapacity)
+        {
+            return false;
+        }
+        if (m_queued + segments > m_settings.queueCapacity)
+        {
+            ++m_stats.overflowFlushes;
+            flush();
+        }
+
+        sockaddr_in destination{};
+        destination.sin_family = AF_INET;
+        destination.sin_port = htons(m_settings.port);
+        destination.sin_addr.s_addr = htonl(multicastGroup(sourceNumber));
+
+        Queue& queue = *m_queue;
+        while (!segmenter.done())
+        {
+            iovec& iov = queue.iovecs[m_queued];
+            const std::optional<std::size_t> size =
+                segmenter.next({static_cast<uint8_t*>(iov.iov_base), m_settings.maxDatagramSize});
+            if (!size)
+            {
+                return false;
+            }
+            iov.iov_len = *size;
+            queue.destinations[m_queued] = destination;
+            ++m_queued;
+        }
+
+        ++m_sequenceNumber;
+        ++m_stats.samples;
+        return true;
+    }
+
+    std::size_t OpenTrackIOSender::flush()
+    {
+        const std::size_t sent = send(0, m_queued);
+        m_queued = 0;
+        return sent;
+    }
+
+    std::size_t OpenTrackIOSender::flushPaced(Clock::duration interval)
+    {
+        const std::size_t bursts = (m_queued + m_settings.burstSize - 1) / m_settings.burstSize;
+        if (bursts <= 1)
+        {
+            return flush();
+        }
+
+        const Clock::time_point start = Clock::now();
+        const Clock::duration step = interval / static_cast<Clock::rep>(bursts);
+        std::size_t sent = 0;
+        for (std::size_t burst = 0; burst < bursts; ++burst)
+        {
+            if (burst > 0)
+            {
+                std::this_thread::sleep_until(start + step * static_cast<Clock::rep>(burst));
+            }
+            const std::size_t first = burst * m_settings.burstSize;
+            sent += send(first, std::min(m_settings.burstSize, m_queued - first));
+        }
+        m_queued = 0;
+        return sent;
+    }
+
+    std::optional<OpenTrackIOSender::Clock::duration> OpenTrackIOSender::frameInterval(const OpenTrackIOSample& sample)
+    {
+        if (!sample.timing || !sample.timing->sampleRate || sample.timing->sampleRate->numerator == 0)
+        {
+            return std::nullopt;
+        }
+
+        const opentrackiotypes::Rational& rate = *sample.timing->sampleRate;
+        const std::chrono::nanoseconds interval{static_cast<int64_t>(rate.denominator) * 1'000'000'000 /
+                                                rate.numerator};
+        return std::chrono::duration_cast<Clock::duration>(interval);
+    }
+
+    std::size_t OpenTrackIOSender::send(std::size_t first, std::size_t count)
+    {
+#ifdef OPENTRACKIO_IO_URING
+        if (m_backend == TransportBackend::IO_URING)
+        {
+            return sendRing(first, count);
+        }
+#endif
+
+        Queue& queue = *m_queue;
+        std::size_t sent = 0;
+        while (sent < count)
+        {
+            const auto batch = static_cast<unsigned int>(std::min<std::size_t>(count - sent, UIO_MAXIOV));
+            const int result = ::sendmmsg(m_socket, queue.messages.data() + first + sent, batch, 0);
+            ++m_stats.sendCalls;
+            if (result < 0)
+            {
+                if (errno == EINTR)
+                {
+                    continue;
+                }
+                m_error = std::error_code{errno, std::system_category()};
+                m_stats.failed += count - sent;
+                break;
+            }
+
+            for (int i = 0; i < result; ++i)
+            {
+                m_stats.bytes += queue.messages[first + sent + i].msg_len;
+            }
+            sent += static_cast<std::size_t>(result);
+        }
+
+        m_stats.datagrams += sent;
+        return sent;
+    }
+
+#ifdef OPENTRACKIO_IO_URING
+    std::size_t OpenTrackIOSender::sendRing(std::size_t first, std::size_t count)
+    {
+        Queue& queue = *m_queue;
+        IoUring& ring = queue.ring;
+        std::size_t sent = 0;
+        std::size_t done = 0;
+        while (done < count)
+        {
+            unsigned int submitted = 0;
+            for (; done + submitted < count; ++submitted)
+            {
+                io_uring_sqe* const sqe = ring.getSqe();
+                if (sqe == nullptr)
+                {
+                    break;
+                }
+                sqe->opcode = IORING_OP_SENDMSG;
+                sqe->fd = m_socket;
+                sqe->addr = reinterpret_cast<uint64_t>(&queue.messages[first + done + submitted].msg_hdr);
+                sqe->len = 1;
+            }
+
+            // Wait for every send submitted, so that none of them is still reading the queue when it is refilled.
+            unsigned int completed = 0;
+            while (completed < submitted)
+            {
+                const int result = ring.submit(submitted - completed);
+                ++m_stats.sendCalls;
+                if (result < 0 && result != -EINTR && result != -EAGAIN && result != -EBUSY)
+                {
+                    // The ring itself has failed: drop what is left and send with sendmmsg() from now on.
+                    m_error = std::error_code{-result, std::system_category()};
+                    m_stats.failed += count - done - completed;
+                    ring.close();
+                    m_backend = TransportBackend::SOCKETS;
+                    m_stats.datagrams += sent;
+                    return sent;
+                }
+
+                const unsigned int ready = ring.ready();
+                for (unsigned int i = 0; i < ready; ++i)
+                {
+                    const io_uring_cqe& cqe = ring.completion(i);
+                    if (cqe.res < 0)
+                    {
+                        m_error = std::error_code{-cqe.res, std::system_category()};
+                        ++m_stats.failed;
+                    }
+                    else
+                    {
+                        m_stats.bytes += static_cast<uint64_t>(cqe.res);
+                        ++sent;
+                    }
+                }
+                ring.consume(ready);
+                completed += ready;
+            }
+            done += submitted;
+        }
+
+        m_stats.datagrams += sent;
+        return sent;
+    }
+#endif
+} // namespace opentrackio
@@ -0,0 +1,989 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "opentrackio-cpp/OpenTrackIOSerializer.h"
+#include "opentrackio-cpp/OpenTrackIOSample.h"
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <concepts>
+#include <initializer_list>
+#include <limits>
+#include <span>
+
+namespace opentrackio
+{
+    namespace
+    {
+        class StringSink
+        {
+        public:
+            explicit StringSink(std::string& out) : m_out{out} {}
+
+            void put(char c) { m_out.push_back(c); }
+            void write(const char* data, std::size_t size) { m_out.append(data, size); }
+
+        private:
+            std::string& m_out;
+        };
+
+        /**
+        * Writes into a fixed buffer, dropping everything after the first write that doesn't fit. */
+        template<typename Char>
+        class SpanSink
+        {
+        public:
+            explicit SpanSink(std::span<Char> buffer) : m_buffer{buffer} {}
+
+            void put(Char c) { write(&c, 1); }
+
+            void write(const Char* data, std::size_t size)
+            {
+                if (m_overflowed || size > m_buffer.size() - m_size)
+                {
+                    m_overflowed = true;
+                    return;
+                }
+
+                std::copy(data, data + size, m_buffer.begin() + static_cast<std::ptrdiff_t>(m_size));
+                m_size += size;
+            }
+
+            [[nodiscard]] std::size_t position() const { return m_size; }
+
+            void patch(std::size_t position, Char c)
+            {
+                if (!m_overflowed)
+                {
+                    m_buffer[position] = c;
+                }
+            }
+
+            [[nodiscard]] std::optional<std::size_t> size() const
+            {
+                return m_overflowed ? std::nullopt : std::optional{m_size};
+            }
+
+        private:
+            std::span<Char> m_buffer;
+            std::size_t m_size = 0;
+            bool m_overflowed = false;
+        };
+
+        /**
+        * Counts the bytes that would be written without storing them. */
+        class CountingSink
+        {
+        public:
+            void put(uint8_t) { ++m_size; }
+            void write(const uint8_t*, std::size_t size) { m_size += size; }
+            [[nodiscard]] std::size_t position() const { return m_size; }
+            void patch(std::size_t, uint8_t) {}
+            [[nodiscard]] std::size_t size() const { return m_size; }
+
+        private:
+            std::size_t m_size = 0;
+        };
+
+        /**
+        * Compact JSON text, as nlohmann::json::dump() writes it. */
+        template<typename Sink>
+        class JsonEncoder
+        {
+        public:
+            explicit JsonEncoder(Sink& sink) : m_sink{sink} {}
+
+            std::size_t beginObject()
+            {
+                m_sink.put('{');
+                return 0;
+            }
+
+            void endObject(std::size_t, std::size_t)
+            {
+                m_sink.put('}');
+            }
+
+            void beginArray(std::size_t)
+            {
+                m_sink.put('[');
+            }
+
+            void endArray()
+            {
+                m_sink.put(']');
+            }
+
+            void emptyObject() { write("{}"); }
+
+            void separator(bool first)
+            {
+                if (!first)
+                {
+                    m_sink.put(',');
+                }
+            }
+
+            void key(std::string_view key)
+            {
+                string(key);
+                m_sink.put(':');
+            }
+
+            void null() { write("null"); }
+
+            void boolean(bool value) { write(value ? "true" : "false"); }
+
+            void number(double value)
+            {
+                if (!std::isfinite(value))
+                {
+                    null();
+                    return;
+                }
+
+                // dump()'s own formatting, shortest round-trip digits from Grisu2 that std::to_chars doesn't always
+                // match. It is internal to nlohmann, hence the pinned version.
+                static_assert(NLOHMANN_JSON_VERSION_MAJOR == 3 && NLOHMANN_JSON_VERSION_MINOR >= 11,
+                              "Check that nlohmann::detail::to_chars still formats doubles as dump() does");
+                std::array<char, 64> buffer{};
+                const char* end = nlohmann::detail::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+                m_sink.write(buffer.data(), static_cast<std::size_t>(end - buffer.data()));
+            }
+
+            template<std::integral T>
+            void number(T value)
+            {
+                std::array<char, 24> buffer{};
+                const auto [end, error] = std::to_chars(buffer.data(), buffer.data() + buffer.size(), value);
+                m_sink.write(buffer.data(), static_cast<std::size_t>(end - buffer.data()));
+            }
+
+            /**
+            * Escapes as nlohmann::json::dump() does without ensure_ascii: quotes, backslashes and control characters. */
+            void string(std::string_view str)
+            {
+                static constexpr std::string_view HEX_DIGITS = "0123456789abcdef";
+
+                m_sink.put('"');
+                std::size_t unescaped = 0;
+                for (std::size_t i = 0; i < str.size(); ++i)
+                {
+                    const auto c = static_cast<uint8_t>(str[i]);
+                    if (c >= 0x20 && c != '"' && c != '\\')
+                    {
+                        continue;
+                    }
+
+                    write(str.substr(unescaped, i - unescaped));
+                    unescaped = i + 1;
+                    switch (c)
+                    {
+                        case '"': write("\\\""); break;
+                        case '\\': write("\\\\"); break;
+                        case '\b': write("\\b"); break;
+                        case '\f': write("\\f"); break;
+                        case '\n': write("\\n"); break;
+                        case '\r': write("\\r"); break;
+                        case '\t': write("\\t"); break;
+                        default:
+                        {
+                            const std::array<char, 6> escaped = {'\\', 'u', '0', '0', HEX_DIGITS[c >> 4], HEX_DIGITS[c & 0xF]};
+                            m_sink.write(escaped.data(), escaped.size());
+                        }
+                    }
+                }
+                write(str.substr(unescaped));
+                m_sink.put('"');
+            }
+
+        private:
+            void write(std::string_view str) { m_sink.write(str.data(), str.size()); }
+
+            Sink& m_sink;
+        };
+
+        /**
+        * CBOR with the shortest argument encodings and definite lengths, as nlohmann::json::to_cbor() writes it. */
+        template<typename Sink>
+        class CborEncoder
+        {
+        public:
+            explicit CborEncoder(Sink& sink) : m_sink{sink} {}
+
+            /**
+            * Maps are written before their size is known, so the header is patched by endObject(). Every object in
+            * the schema has fewer than 24 members so the header is always the single byte that holds the size. */
+            std::size_t beginObject()
+            {
+                const std::size_t position = m_sink.position();
+                m_sink.put(MAP);
+                return position;
+            }
+
+            void endObject(std::size_t header, std::size_t memberCount)
+            {
+                m_sink.patch(header, static_cast<uint8_t>(MAP | memberCount));
+            }
+
+            void beginArray(std::size_t size) { head(ARRAY, size); }
+            void endArray() {}
+            void emptyObject() { m_sink.put(MAP); }
+            void separator(bool) {}
+            void key(std::string_view key) { string(key); }
+            void null() { m_sink.put(0xF6); }
+            void boolean(bool value) { m_sink.put(value ? 0xF5 : 0xF4); }
+
+            void number(double value)
+            {
+                if (std::isnan(value))
+                {
+                    write({0xF9, 0x7E, 0x00});
+                }
+                else if (std::isinf(value))
+                {
+                    write({0xF9, static_cast<uint8_t>(value > 0 ? 0x7C : 0xFC), 0x00});
+                }
+                else if (value >= std::numeric_limits<float>::lowest() &&
+                         value <= std::numeric_limits<float>::max() &&
+                         static_cast<double>(static_cast<float>(value)) == value)
+                {
+                    m_sink.put(0xFA);
+                    bigEndian(std::bit_cast<uint32_t>(static_cast<float>(value)));
+                }
+                else
+                {
+                    m_sink.put(0xFB);
+                    bigEndian(std::bit_cast<uint64_t>(value));
+                }
+            }
+
+            template<std::integral T>
+            void number(T value)
+            {
+                if constexpr (std::is_signed_v<T>)
+                {
+                    if (value < 0)
+                    {
+                        head(NEGATIVE_INTEGER, static_cast<uint64_t>(-1 - static_cast<int64_t>(value)));
+                        return;
+                    }
+                }
+                head(UNSIGNED_INTEGER, static_cast<uint64_t>(value));
+            }
+
+            void string(std::string_view str)
+            {
+                head(TEXT_STRING, str.size());
+                m_sink.write(reinterpret_cast<const uint8_t*>(str.data()), str.size());
+            }
+
+        private:
+            static constexpr uint8_t UNSIGNED_INTEGER = 0x00;
+            static constexpr uint8_t NEGATIVE_INTEGER = 0x20;
+            static constexpr uint8_t TEXT_STRING = 0x60;
+            static constexpr uint8_t ARRAY = 0x80;
+            static constexpr uint8_t MAP = 0xA0;
+
+            void write(std::initializer_list<uint8_t> bytes) { m_sink.write(bytes.begin(), bytes.size()); }
+
+            template<std::unsigned_integral T>
+            void bigEndian(T value)
+            {
+                for (std::size_t shift = sizeof(T) * 8; shift > 0; shift -= 8)
+                {
+                    m_sink.put(static_cast<uint8_t>(value >> (shift - 8)));
+                }
+            }
+
+            /**
+            * Initial byte of the major type and its argument, using the smallest encoding that holds the argument. */
+            void head(uint8_t majorType, uint64_t argument)
+            {
+                if (argument < 24)
+                {
+                    m_sink.put(static_cast<uint8_t>(majorType | argument));
+                }
+                else if (argument <= std::numeric_limits<uint8_t>::max())
+                {
+                    m_sink.put(majorType | 24);
+                    bigEndian(static_cast<uint8_t>(argument));
+                }
+                else if (argument <= std::numeric_limits<uint16_t>::max())
+                {
+                    m_sink.put(majorType | 25);
+                    bigEndian(static_cast<uint16_t>(argument));
+                }
+                else if (argument <= std::numeric_limits<uint32_t>::max())
+                {
+                    m_sink.put(majorType | 26);
+                    bigEndian(static_cast<uint32_t>(argument));
+                }
+                else
+                {
+                    m_sink.put(majorType | 27);
+                    bigEndian(argument);
+                }
+            }
+
+            Sink& m_sink;
+        };
+
+        /**
+        * What the DOM ends up holding for an object that no member was assigned to. */
+        enum class WhenEmpty
+        {
+            Omit,
+            WriteObject,
+            WriteNull
+        };
+
+        /**
+        * Writes nested objects and arrays through an encoder. Objects are opened lazily on their first member so that
+        * empty objects can be omitted, or written as {} or null, the way the nlohmann::json DOM built by
+        * OpenTrackIOSample::generateJson() does. Members must be written in the DOM's key order, which is sorted
+        * byte-wise. */
+        template<typename Encoder>
+        class StructuredWriter
+        {
+        public:
+            explicit StructuredWriter(Encoder& encoder) : m_encoder{encoder} {}
+
+            void beginObject(std::string_view key, WhenEmpty whenEmpty)
+            {
+                m_levels[m_depth++] = Level{key, whenEmpty};
+            }
+
+            void endObject()
+            {
+                const Level level = m_levels[--m_depth];
+                if (level.opened)
+                {
+                    m_encoder.endObject(level.header, level.memberCount);
+                    return;
+                }
+
+                if (level.whenEmpty == WhenEmpty::Omit)
+                {
+                    return;
+                }
+
+                if (m_depth > 0)
+                {
+                    beginMember(m_depth - 1, level.key);
+                }
+
+                if (level.whenEmpty == WhenEmpty::WriteObject)
+                {
+                    m_encoder.emptyObject();
+                }
+                else
+                {
+                    m_encoder.null();
+                }
+            }
+
+            void beginArray(std::string_view key, std::size_t size)
+            {
+                m_levels[m_depth++] = Level{key, WhenEmpty::WriteObject, true, size};
+                open(m_depth - 1);
+            }
+
+            void endArray()
+            {
+                --m_depth;
+                m_encoder.endArray();
+            }
+
+            /**
+            * Elements of arrays are written through member() too, their key is ignored. */
+            void member(std::string_view key, bool value)
+            {
+                beginMember(m_depth - 1, key);
+                m_encoder.boolean(value);
+            }
+
+            void member(std::string_view key, double value)
+            {
+                beginMember(m_depth - 1, key);
+                m_encoder.number(value);
+            }
+
+            template<std::integral T>
+            void member(std::string_view key, T value)
+            {
+                beginMember(m_depth - 1, key);
+                m_encoder.number(value);
+            }
+
+            void member(std::string_view key, std::string_view value)
+            {
+                beginMember(m_depth - 1, key);
+                m_encoder.string(value);
+            }
+
+            void member(std::string_view key, const char* value)
+            {
+                member(key, std::string_view{value});
+            }
+
+            template<typename T>
+            void member(std::string_view key, const std::optional<T>& value)
+            {
+                if (value.has_value())
+                {
+                    member(key, value.value());
+                }
+            }
+
+            template<typename T>
+            void member(std::string_view key, const opentrackiotypes::CopyOnWrite<T>& value)
+            {
+                if (value.has_value())
+                {
+                    member(key, value.value());
+                }
+            }
+
+            template<typename T>
+            void member(std::string_view key, const opentrackiotypes::Vector<T>& values)
+            {
+                elements(key, std::span<const T>{values});
+            }
+
+            template<typename T, std::size_t N>
+            void member(std::string_view key, const opentrackiotypes::SmallVector<T, N>& values)
+            {
+                elements(key, std::span<const T>{values.data(), values.size()});
+            }
+
+            void member(std::string_view key, const opentrackiotypes::Uuid& value)
+            {
+                std::array<char, opentrackiotypes::Uuid::URN_LENGTH> urn{};
+                value.toUrn(urn);
+                member(key, std::string_view{urn.data(), urn.size()});
+            }
+
+            void member(std::string_view key, const opentrackiotypes::Rational& value)
+            {
+                beginObject(key, WhenEmpty::WriteObject);
+                member("denom", value.denominator);
+                member("num", value.numerator);
+                endObject();
+            }
+
+            void member(std::string_view key, const opentrackiotypes::Timestamp& value)
+            {
+                beginObject(key, WhenEmpty::WriteObject);
+                member("nanoseconds", value.nanoseconds);
+                member("seconds", value.seconds);
+                endObject();
+            }
+
+            template<typename T>
+            void member(std::string_view key, const opentrackiotypes::Dimensions<T>& value)
+            {
+                beginObject(key, WhenEmpty::WriteObject);
+                member("height", value.height);
+                member("width", value.width);
+                endObject();
+            }
+
+            void member(std::string_view key, const opentrackiotypes::Vector3& value)
+            {
+                beginObject(key, WhenEmpty::WriteObject);
+                member("x", value.x);
+                member("y", value.y);
+                member("z", value.z);
+                endObject();
+            }
+
+            void member(std::string_view key, const opentrackiotypes::Rotation& value)
+            {
+                beginObject(key, WhenEmpty::WriteObject);
+                member("pan", value.pan);
+                member("roll", value.roll);
+                member("tilt", value.tilt);
+                endObject();
+            }
+
+        private:
+            /**
+            * Deep enough for ptp.leaderPriorities and the radial array of a distortion. */
+            static constexpr std::size_t MAX_DEPTH = 8;
+
+            struct Level
+            {
+                std::string_view key{};
+                WhenEmpty whenEmpty = WhenEmpty::Omit;
+                bool isArray = false;
+                std::size_t arraySize = 0;
+                bool opened = false;
+                std::size_t header = 0;
+                std::size_t memberCount = 0;
+            };
+
+            template<typename T>
+            void elements(std::string_view key, std::span<const T> values)
+            {
+                beginArray(key, values.size());
+                for (const T& value : values)
+                {
+                    member({}, value);
+                }
+                endArray();
+            }
+
+            /**
+            * Begins the level at index, and any unopened levels enclosing it. */
+            void open(std::size_t index)
+            {
+                Level& level = m_levels[index];
+                if (level.opened)
+                {
+                    return;
+                }
+
+                level.opened = true;
+                if (index > 0)
+                {
+                    beginMember(index - 1, level.key);
+                }
+
+                if (level.isArray)
+                {
+                    m_encoder.beginArray(level.arraySize);
+                }
+                else
+                {
+                    level.header = m_encoder.beginObject();
+                }
+            }
+
+            /**
+            * Writes what comes before a member of the level at index: a separator and, for objects, the key. */
+            void beginMember(std::size_t index, std::string_view key)
+            {
+                open(index);
+
+                Level& level = m_levels[index];
+                m_encoder.separator(level.memberCount++ == 0);
+                if (!level.isArray)
+                {
+                    m_encoder.key(key);
+                }
+            }
+
+            Encoder& m_encoder;
+            std::array<Level, MAX_DEPTH> m_levels{};
+            std::size_t m_depth = 0;
+        };
+
+        template<typename Writer>
+        void writeCamera(Writer& writer, const opentrackioproperties::Camera& camera)
+        {
+            writer.beginObject("camera", WhenEmpty::WriteObject);
+            writer.member("activeSensorPhysicalDimensions", camera.activeSensorPhysicalDimensions);
+            writer.member("activeSensorResolution", camera.activeSensorResolution);
+            writer.member("anamorphicSqueeze", camera.anamorphicSqueeze);
+            writer.member("captureFrameRate", camera.captureFrameRate);
+            writer.member("fdlLink", camera.fdlLink);
+            writer.member("firmwareVersion", camera.firmwareVersion);
+            writer.member("isoSpeed", camera.isoSpeed);
+            writer.member("label", camera.label);
+            writer.member("make", camera.make);
+            writer.member("model", camera.model);
+            writer.member("serialNumber", camera.serialNumber);
+            writer.member("shutterAngle", camera.shutterAngle);
+            writer.endObject();
+        }
+
+        template<typename Writer>
+        void writeGlobalStage(Writer& writer, const opentrackioproperties::GlobalStage& globalStage)
+        {
+            writer.beginObject("globalStage", WhenEmpty::WriteObject);
+            writer.member("E", globalStage.e);
+            writer.member("N", globalStage.n);
+            writer.member("U", globalStage.u);
+            writer.member("h0", globalStage.h0);
+            writer.member("lat0", globalStage.lat0);
+            writer.member("lon0", globalStage.lon0);
+            writer.endObject();
+        }
+
+        template<typename Writer>
+        void writeStaticLens(Writer& writer, const opentrackioproperties::Lens& lens)
+        {
+            writer.beginObject("lens", WhenEmpty::Omit);
+            writer.member("calibrationHistory", lens.calibrationHistory);
+            writer.member("distortionOverscanMax", lens.distortionOverscanMax);
+            writer.member("firmwareVersion", lens.firmwareVersion);
+            writer.member("make", lens.make);
+            writer.member("model", lens.model);
+            writer.member("nominalFocalLength", lens.nominalFocalLength);
+            writer.member("serialNumber", lens.serialNumber);
+            writer.member("undistortionOverscanMax", lens.undistortionOverscanMax);
+            writer.endObject();
+        }
+
+        template<typename Writer>
+        void writeLens(Writer& writer, const opentrackioproperties::Lens& lens)
+        {
+            writer.beginObject("lens", WhenEmpty::Omit);
+            writer.member("custom", lens.custom);
+
+            if (lens.distortion.has_value())
+            {
+                writer.beginArray("distortion", lens.distortion->size());
+                for (const auto& distortion : lens.distortion.value())
+                {
+                    writer.beginObject({}, WhenEmpty::WriteObject);
+                    writer.member("model", distortion.model);
+                    writer.member("overscan", distortion.overscan);
+                    writer.member("radial", distortion.radial);
+                    writer.member("tangential", distortion.tangential);
+                    writer.endObject();
+                }
+                writer.endArray();
+            }
+
+            if (lens.distortionOffset.has_value())
+            {
+                writer.beginObject("distortionOffset", WhenEmpty::WriteObject);
+                writer.member("x", lens.distortionOffset->x);
+                writer.member("y", lens.distortionOffset->y);
+                writer.endObject();
+            }
+
+            if (lens.encoders.has_value())
+            {
+                writer.beginObject("encoders", WhenEmpty::WriteNull);
+                writer.member("focus", lens.encoders->focus);
+                writer.member("iris", lens.encoders->iris);
+                writer.member("zoom", lens.encoders->zoom);
+                writer.endObject();
+            }
+
+            writer.member("entrancePupilOffset", lens.entrancePupilOffset);
+
+            if (lens.exposureFalloff.has_value())
+            {
+                writer.beginObject("exposureFalloff", WhenEmpty::WriteObject);
+                writer.member("a1", lens.exposureFalloff->a1);
+                writer.member("a2", lens.exposureFalloff->a2);
+                writer.member("a3", lens.exposureFalloff->a3);
+                writer.endObject();
+            }
+
+            writer.member("fStop", lens.fStop);
+            writer.member("focusDistance", lens.focusDistance);
+            writer.member("pinholeFocalLength", lens.pinholeFocalLength);
+
+            if (lens.projectionOffset.has_value())
+            {
+                writer.beginObject("projectionOffset", WhenEmpty::WriteObject);
+                writer.member("x", lens.projectionOffset->x);
+                writer.member("y", lens.projectionOffset->y);
+                writer.endObject();
+            }
+
+            if (lens.rawEncoders.has_value())
+            {
+                writer.beginObject("rawEncoders", WhenEmpty::WriteNull);
+                writer.member("focus", lens.rawEncoders->focus);
+                writer.member("iris", lens.rawEncoders->iris);
+                writer.member("zoom", lens.rawEncoders->zoom);
+                writer.endObject();
+            }
+
+            writer.member("tStop", lens.tStop);
+            writer.endObject();
+        }
+
+        template<typename Writer>
+        void writePtp(Writer& writer, const opentrackioproperties::Timing::Synchronization::Ptp& ptp)
+        {
+            using Ptp = opentrackioproperties::Timing::Synchronization::Ptp;
+
+            writer.beginObject("ptp", WhenEmpty::WriteObject);
+            writer.member("domain", ptp.domain);
+            writer.member("leaderAccuracy", ptp.leaderAccuracy);
+            writer.member("leaderIdentity", ptp.leaderIdentity);
+
+            writer.beginObject("leaderPriorities", WhenEmpty::WriteObject);
+            writer.member("priority1", ptp.leaderPriorities.priority1);
+            writer.member("priority2", ptp.leaderPriorities.priority2);
+            writer.endObject();
+
+            if (ptp.leaderTimeSource.has_value())
+            {
+                switch (ptp.leaderTimeSource.value())
+                {
+                    case Ptp::LeaderTimeSourceType::GNSS:
+                        writer.member("leaderTimeSource", "GNSS");
+                        break;
+                    case Ptp::LeaderTimeSourceType::Atomic_clock:
+                        writer.member("leaderTimeSource", "Atomic clock");
+                        break;
+                    case Ptp::LeaderTimeSourceType::NTP:
+                        writer.member("leaderTimeSource", "NTP");
+                }
+            }
+
+            writer.member("meanPathDelay", ptp.meanPathDelay);
+
+            switch (ptp.profile)
+            {
+                case Ptp::ProfileType::IEEE_Std_1588_2019:
+                    writer.member("profile", "IEEE Std 1588-2019");
+                    break;
+                case Ptp::ProfileType::IEEE_Std_802_1AS_2020:
+                    writer.member("profile", "IEEE Std 802.1AS-2020");
+                    break;
+                case Ptp::ProfileType::SMPTE_ST2059_2_2021:
+                    writer.member("profile", "SMPTE ST2059-2:2021");
+            }
+
+            writer.member("vlan", ptp.vlan);
+            writer.endObject();
+        }
+
+        template<typename Writer>
+        void writeSynchronization(Writer& writer,
+                                  const opentrackioproperties::Timing::Synchronization& synchronization)
+        {
+            using SourceType = opentrackioproperties::Timing::Synchronization::SourceType;
+
+            writer.beginObject("synchronization", WhenEmpty::WriteObject);
+            writer.member("frequency", synchronization.frequency);
+            writer.member("locked", synchronization.locked);
+
+            if (synchronization.offsets.has_value())
+            {
+                writer.beginObject("offsets", WhenEmpty::WriteNull);
+                writer.member("lensEncoders", synchronization.offsets->lensEncoders);
+                writer.member("rotation", synchronization.offsets->rotation);
+                writer.member("translation", synchronization.offsets->translation);
+                writer.endObject();
+            }
+
+            writer.member("present", synchronization.present);
+
+            if (synchronization.ptp.has_value())
+            {
+                writePtp(writer, synchronization.ptp.value());
+            }
+
+            switch (synchronization.source)
+            {
+                case SourceType::GEN_LOCK:
+                    writer.member("source", "genlock");
+                    break;
+                case SourceType::VIDEO_IN:
+                    writer.member("source", "videoIn");
+                    break;
+                case SourceType::PTP:
+                    writer.member("source", "ptp");
+                    break;
+                case SourceType::NTP:
+                    writer.member("source", "ntp");
+                    break;
+            }
+            writer.endObject();
+        }
+
+        template<typename Writer>
+        void writeTiming(Writer& writer, const opentrackioproperties::Timing& timing)
+        {
+            writer.beginObject("timing", WhenEmpty::WriteObject);
+            if (timing.mode.has_value())
+            {
+                writer.member("mode", timing.mode.value() == opentrackioproperties::Timing::Mode::INTERNAL ?
+                                      "internal" : "external");
+            }
+            writer.member("recordedTimestamp", timing.recordedTimestamp);
+            writer.member("sampleRate", timing.sampleRate);
+            writer.member("sampleTimestamp", timing.sampleTimestamp);
+            writer.member("sequenceNumber", timing.sequenceNumber);
+
+            if (timing.synchronization.has_value())
+            {
+                writeSynchronization(writer, timing.synchronization.value());
+            }
+
+            if (timing.timecode.has_value())
+            {
+                const auto& timecode = timing.timecode.value();
+                writer.beginObject("timecode", WhenEmpty::WriteObject);
+                writer.member("dropFrame", timecode.dropFrame);
+                writer.member("frameRate", timecode.frameRate);
+                writer.member("frames", timecode.frames);
+                writer.member("hours", timecode.hours);
+                writer.member("minutes", timecode.minutes);
+                writer.member("seconds", timecode.seconds);
+                writer.member("subFrame", timecode.subFrame);
+                writer.endObject();
+            }
+            writer.endObject();
+        }
+
+        template<typename Writer>
+        void writeTransforms(Writer& writer, const opentrackioproperties::Transforms& transforms)
+        {
+            writer.beginArray("transforms", transforms.transforms.size());
+            for (const auto& transform : transforms.transforms)
+            {
+                writer.beginObject({}, WhenEmpty::WriteObject);
+                writer.member("id", transform.id);
+                writer.member("rotation", transform.rotation);
+                writer.member("scale", transform.scale);
+                writer.member("translation", transform.translation);
+                writer.endObject();
+            }
+            writer.endArray();
+        }
+
+        /**
+        * Writes each property in the key order of the DOM, in which the static block sorts between sourceNumber and
+        * timing. */
+        template<typename Writer>
+        void writeSample(Writer& writer, const OpenTrackIOSample& sample)
+        {
+            writer.beginObject({}, WhenEmpty::WriteNull);
+
+            if (sample.globalStage.has_value())
+            {
+                writeGlobalStage(writer, sample.globalStage.value());
+            }
+
+            if (sample.lens.has_value())
+            {
+                writeLens(writer, sample.lens.value());
+            }
+
+            if (sample.protocol.has_value())
+            {
+                writer.beginObject("protocol", WhenEmpty::WriteObject);
+                writer.member("name", sample.protocol->name);
+                writer.member("version", sample.protocol->version);
+                writer.endObject();
+            }
+
+            if (sample.relatedSampleIds.has_value())
+            {
+                writer.member("relatedSampleIds", sample.relatedSampleIds->samples);
+            }
+
+            if (sample.sampleId.has_value())
+            {
+                writer.member("sampleId", sample.sampleId->id);
+            }
+
+            if (sample.sourceId.has_value())
+            {
+                writer.member("sourceId", sample.sourceId->id);
+            }
+
+            if (sample.sourceNumber.has_value())
+            {
+                writer.member("sourceNumber", sample.sourceNumber->value);
+            }
+
+            // ------- Static Fields
+            writer.beginObject("static", WhenEmpty::Omit);
+            if (sample.camera.has_value())
+            {
+                writeCamera(writer, sample.camera.value());
+            }
+
+            if (sample.duration.has_value())
+            {
+                writer.member("duration", sample.duration->rational);
+            }
+
+            if (sample.lens.has_value())
+            {
+                writeStaticLens(writer, sample.lens.value());
+            }
+
+            if (sample.tracker.has_value())
+            {
+                writer.beginObject("tracker", WhenEmpty::Omit);
+                writer.member("firmwareVersion", sample.tracker->firmwareVersion);
+                writer.member("make", sample.tracker->make);
+                writer.member("model", sample.tracker->model);
+                writer.member("serialNumber", sample.tracker->serialNumber);
+                writer.endObject();
+            }
+            writer.endObject();
+
+            if (sample.timing.has_value())
+            {
+                writeTiming(writer, sample.timing.value());
+            }
+
+            if (sample.tracker.has_value())
+            {
+                writer.beginObject("tracker", WhenEmpty::Omit);
+                writer.member("notes", sample.tracker->notes);
+                writer.member("recording", sample.tracker->recording);
+                writer.member("slate", sample.tracker->slate);
+                writer.member("status", sample.tracker->status);
+                writer.endObject();
+            }
+
+            if (sample.transforms.has_value())
+            {
+                writeTransforms(writer, sample.transforms.value());
+            }
+
+            writer.endObject();
+        }
+    } // namespace
+
+    void OpenTrackIOSerializer::writeJson(const OpenTrackIOSample& sample, std::string& out)
+    {
+        StringSink sink{out};
+        JsonEncoder encoder{sink};
+        StructuredWriter writer{encoder};
+        writeSample(writer, sample);
+    }
+
+    std::optional<std::size_t> OpenTrackIOSerializer::writeJson(const OpenTrackIOSample& sample, std::span<char> buffer)
+    {
+        SpanSink sink{buffer};
+        JsonEncoder encoder{sink};
+        StructuredWriter writer{encoder};
+        writeSample(writer, sample);
+        return sink.size();
+    }
+
+    std::optional<std::size_t> OpenTrackIOSerializer::writeCbor(const OpenTrackIOSample& sample, std::span<uint8_t> buffer)
+    {
+        SpanSink sink{buffer};
+        CborEncoder encoder{sink};
+        StructuredWriter writer{encoder};
+        writeSample(writer, sample);
+        return sink.size();
+    }
+
+    std::size_t OpenTrackIOSerializer::cborSize(const OpenTrackIOSample& sample)
+    {
+        CountingSink sink{};
+        CborEncoder encoder{sink};
+        StructuredWriter writer{encoder};
+        writeSample(writer, sample);
+        return sink.size();
+    }
+} // namespace opentrackio
@@ -0,0 +1,97 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "opentrackio-cpp/OpenTrackIOStringPool.h"
+#include <functional>
+#include <utility>
+
+namespace opentrackio::opentrackiotypes
+{
+    const std::string InternedString::EMPTY{};
+
+    InternedString InternedString::intern(std::string_view value)
+    {
+        return StringPool::global().intern(value);
+    }
+
+    StringPool::~StringPool()
+    {
+        for (auto& bucket : m_buckets)
+        {
+            const Entry* entry = bucket.load(std::memory_order_relaxed);
+            while (entry != nullptr)
+            {
+                delete std::exchange(entry, entry->next);
+            }
+        }
+    }
+
+    StringPool& StringPool::global()
+    {
+        // Never destroyed, so that handles held by other statics stay valid while they're destroyed.
+        static StringPool* pool = new StringPool();
+        return *pool;
+    }
+
+    InternedString StringPool::intern(std::string_view value)
+    {
+        if (value.empty())
+        {
+            return {};
+        }
+
+        const std::size_t hash = std::hash<std::string_view>{}(value);
+        std::atomic<const Entry*>& bucket = m_buckets[hash % BUCKET_COUNT];
+
+        if (const Entry* entry = find(bucket.load(std::memory_order_acquire), value, hash))
+        {
+            return InternedString{&entry->value};
+        }
+
+        {
+            std::scoped_lock lock{m_mutex};
+
+            // Another thread may have added it since the lookup above.
+            const Entry* head = bucket.load(std::memory_order_relaxed);
+            if (const Entry* entry = find(head, value, hash))
+            {
+                return InternedString{&entry->value};
+            }
+
+            const std::size_t bytes = m_bytes.load(std::memory_order_relaxed) + value.size();
+            if (bytes <= capacity())
+            {
+                const Entry* entry = new Entry{std::string{value}, hash, head};
+                bucket.store(entry, std::memory_order_release);
+                m_size.fetch_add(1, std::memory_order_relaxed);
+                m_bytes.store(bytes, std::memory_order_relaxed);
+                return InternedString{&entry->value};
+            }
+        }
+
+        // The pool is full, the string is left to the handles to it.
+        return InternedString{std::make_shared<const std::string>(value)};
+    }
+
+    const StringPool::Entry* StringPool::find(const Entry* head, std::string_view value, std::size_t hash)
+    {
+        for (const Entry* entry = head; entry != nullptr; entry = entry->next)
+        {
+            if (entry->hash == hash && entry->value == value)
+            {
+                return entry;
+            }
+        }
+        return nullptr;
+    }
+} // namespace opentrackio::opentrackiotypes
@@ -0,0 +1,252 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "opentrackio-cpp/OpenTrackIOUring.h"
+#include <algorithm>
+#include <atomic>
+#include <cerrno>
+#include <csignal>
+#include <cstring>
+#include <linux/time_types.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace opentrackio
+{
+    namespace
+    {
+        // The queue heads and tails are shared with the kernel, which reads and writes them concurrently.
+        unsigned int loadAcquire(unsigned int* value)
+        {
+            return std::atomic_ref<unsigned int>(*value).load(std::memory_order_acquire);
+        }
+
+        void storeRelease(unsigned int* value, unsigned int newValue)
+        {
+            std::atomic_ref<unsigned int>(*value).store(newValue, std::memory_order_release);
+        }
+    } // namespace
+
+    IoUring::~IoUring()
+    {
+        close();
+    }
+
+    bool IoUring::fail(int error)
+    {
+        m_error = std::error_code{error, std::system_category()};
+        close();
+        return false;
+    }
+
+    bool IoUring::open(unsigned int entries, unsigned int completionEntries)
+    {
+        close();
+
+        io_uring_params params{};
+        params.flags = IORING_SETUP_CQSIZE;
+        params.cq_entries = std::max(completionEntries, entries);
+        m_fd = static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+        if (m_fd < 0)
+        {
+            m_fd = -1;
+            return fail(errno);
+        }
+
+        // Both queues in one mapping, and waiting with a timeout, came in Linux 5.4 and 5.11.
+        if ((params.features & IORING_FEAT_SINGLE_MMAP) == 0 || (params.features & IORING_FEAT_EXT_ARG) == 0)
+        {
+            return fail(ENOSYS);
+        }
+
+        m_ringsSize = std::max(params.sq_off.array + params.sq_entries * sizeof(unsigned int),
+                               params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe));
+        m_rings = ::mmap(nullptr, m_ringsSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd,
+                         IORING_OFF_SQ_RING);
+        if (m_rings == MAP_FAILED)
+        {
+            m_rings = nullptr;
+            return fail(errno);
+        }
+
+        m_sqesSize = params.sq_entries * sizeof(io_uring_sqe);
+        void* const sqes = ::mmap(nullptr, m_sqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_fd,
+                                  IORING_OFF_SQES);
+        if (sqes == MAP_FAILED)
+        {
+            return fail(errno);
+        }
+        m_sqes = static_cast<io_uring_sqe*>(sqes);
+
+        auto* const rings = static_cast<uint8_t*>(m_rings);
+        m_sqHead = reinterpret_cast<unsigned int*>(rings + params.sq_off.head);
+        m_sqTail = reinterpret_cast<unsigned int*>(rings + params.sq_off.tail);
+        m_sqMask = *reinterpret_cast<unsigned int*>(rings + params.sq_off.ring_mask);
+        m_sqEntries = params.sq_entries;
+        m_sqPending = *m_sqTail;
+        m_cqHead = reinterpret_cast<unsigned int*>(rings + params.cq_off.head);
+        m_cqTail = reinterpret_cast<unsigned int*>(rings + params.cq_off.tail);
+        m_cqMask = *reinterpret_cast<unsigned int*>(rings + params.cq_off.ring_mask);
+        m_cqes = reinterpret_cast<io_uring_cqe*>(rings + params.cq_off.cqes);
+
+        // Submission queue entries are always used in order, so the indirection array maps each slot to itself.
+        auto* const array = reinterpret_cast<unsigned int*>(rings + params.sq_off.array);
+        for (unsigned int i = 0; i < m_sqEntries; ++i)
+        {
+            array[i] = i;
+        }
+
+        m_error = {};
+        return true;
+    }
+
+    void IoUring::close()
+    {
+        // Closing the ring cancels its requests before the buffers they would write to are unmapped.
+        if (m_fd >= 0)
+        {
+            ::close(m_fd);
+            m_fd = -1;
+        }
+        if (m_sqes != nullptr)
+        {
+            ::munmap(m_sqes, m_sqesSize);
+            m_sqes = nullptr;
+        }
+        if (m_rings != nullptr)
+        {
+            ::munmap(m_rings, m_ringsSize);
+            m_rings = nullptr;
+        }
+        if (m_bufferRing != nullptr)
+        {
+            ::munmap(m_bufferRing, m_bufferRingSize);
+            m_bufferRing = nullptr;
+        }
+        m_buffers = nullptr;
+    }
+
+    io_uring_sqe* IoUring::getSqe()
+    {
+        if (m_sqPending - loadAcquire(m_sqHead) >= m_sqEntries)
+        {
+            return nullptr;
+        }
+
+        io_uring_sqe* const sqe = &m_sqes[m_sqPending & m_sqMask];
+        ++m_sqPending;
+        std::memset(sqe, 0, sizeof(*sqe));
+        return sqe;
+    }
+
+    int IoUring::submit(unsigned int waitFor, std::chrono::milliseconds timeout)
+    {
+        // Entries an earlier call published but the kernel didn't consume yet are submitted again.
+        const unsigned int toSubmit = m_sqPending - loadAcquire(m_sqHead);
+        if (toSubmit == 0 && waitFor == 0)
+        {
+            return 0;
+        }
+        storeRelease(m_sqTail, m_sqPending);
+
+        unsigned int flags = waitFor > 0 ? IORING_ENTER_GETEVENTS : 0;
+        __kernel_timespec time{};
+        io_uring_getevents_arg arg{};
+        void* argument = nullptr;
+        std::size_t argumentSize = 0;
+        if (waitFor > 0 && timeout.count() > 0)
+        {
+            time.tv_sec = timeout.count() / 1000;
+            time.tv_nsec = (timeout.count() % 1000) * 1'000'000;
+            arg.sigmask_sz = _NSIG / 8;
+            arg.ts = reinterpret_cast<uint64_t>(&time);
+            flags |= IORING_ENTER_EXT_ARG;
+            argument = &arg;
+            argumentSize = sizeof(arg);
+        }
+
+        ++m_enterCalls;
+        const auto result = static_cast<int>(::syscall(__NR_io_uring_enter, m_fd, toSubmit, waitFor, flags,
+                                                       argument, argumentSize));
+        return result < 0 ? -errno : result;
+    }
+
+    unsigned int IoUring::ready() const
+    {
+        return loadAcquire(m_cqTail) - *m_cqHead;
+    }
+
+    const io_uring_cqe& IoUring::completion(unsigned int index) const
+    {
+        return m_cqes[(*m_cqHead + index) & m_cqMask];
+    }
+
+    void IoUring::consume(unsigned int count)
+    {
+        storeRelease(m_cqHead, *m_cqHead + count);
+    }
+
+    bool IoUring::registerBufferRing(uint16_t group, std::span<uint8_t> storage, std::size_t size, uint16_t count)
+    {
+        if (count == 0 || (count & (count - 1)) != 0 || count > 32768 || storage.size() < size * count)
+        {
+            return fail(EINVAL);
+        }
+
+        // The ring has to start on a page of its own.
+        m_bufferRingSize = count * sizeof(io_uring_buf);
+        void* const ring = ::mmap(nullptr, m_bufferRingSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS,
+                                  -1, 0);
+        if (ring == MAP_FAILED)
+        {
+            return fail(errno);
+        }
+        m_bufferRing = static_cast<io_uring_buf*>(ring);
+
+        io_uring_buf_reg registration{};
+        registration.ring_addr = reinterpret_cast<uint64_t>(m_bufferRing);
+        registration.ring_entries = count;
+        registration.bgid = group;
+        if (::syscall(__NR_io_uring_register, m_fd, IORING_REGISTER_PBUF_RING, &registration, 1) != 0)
+        {
+            return fail(errno);
+        }
+
+        m_buffers = storage.data();
+        m_bufferSize = size;
+        m_bufferMask = static_cast<uint16_t>(count - 1);
+        m_bufferTail = 0;
+        for (uint32_t id = 0; id < count; ++id)
+        {
+            recycleBuffer(static_cast<uint16_t>(id));
+        }
+        commitBuffers();
+        return true;
+    }
+
+    void IoUring::recycleBuffer(uint16_t id)
+    {
+        io_uring_buf& entry = m_bufferRing[m_bufferTail & m_bufferMask];
+        entry.addr = reinterpret_cast<uint64_t>(buffer(id));
+        entry.len = static_cast<uint32_t>(m_bufferSize);
+        entry.bid = id;
+        ++m_bufferTail;
+    }
+
+    void IoUring::commitBuffers()
+    {
+        // The tail overlays the reserved field of the first entry.
+        std::atomic_ref<uint16_t>(m_bufferRing[0].resv).store(m_bufferTail, std::memory_order_release);
+    }
+} // namespace opentrackio
@@ -0,0 +1,130 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include "opentrackio-cpp/OpenTrackIOValidation.h"
+#include <cstddef>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define OPENTRACKIO_VALIDATION_SSE2
+#include <emmintrin.h>
+#endif
+
+namespace opentrackio::opentrackiovalidation
+{
+    namespace
+    {
+        constexpr std::string_view URN_PREFIX = "urn:uuid:";
+        constexpr std::size_t UUID_LENGTH = 36;
+
+        constexpr bool isLowerHex(char c)
+        {
+            return (c >= '0' && c <= '9') || (c >= 'a' && c <= 'f');
+        }
+
+        constexpr bool isUuidHyphenPosition(std::size_t i)
+        {
+            return i == 8 || i == 13 || i == 18 || i == 23;
+        }
+
+        /**
+        * 8-4-4-4-12 lowercase hex digits separated by hyphens. */
+        constexpr bool isUuidScalar(std::string_view uuid)
+        {
+            for (std::size_t i = 0; i < UUID_LENGTH; ++i)
+            {
+                if (isUuidHyphenPosition(i) ? uuid[i] != '-' : !isLowerHex(uuid[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        static_assert(isUuidScalar("5ca5f233-11b5-4f43-8815-948d73e48a33"));
+        static_assert(!isUuidScalar("5CA5F233-11B5-4F43-8815-948D73E48A33"));
+        static_assert(!isUuidScalar("5ca5f233-11b5-4f43-8815+948d73e48a33"));
+
+#ifdef OPENTRACKIO_VALIDATION_SSE2
+        /**
+        * Checks 16 bytes, where hyphens lists the lanes that must be '-' and every other lane must be a lowercase hex
+        * digit. Bytes at or above 0x80 compare as negative so fall outside both ranges. */
+        bool isUuidBlock(__m128i block, __m128i hyphens)
+        {
+            const auto inRange = [block](char low, char high)
+            {
+                return _mm_and_si128(_mm_cmpgt_epi8(block, _mm_set1_epi8(static_cast<char>(low - 1))),
+                                     _mm_cmplt_epi8(block, _mm_set1_epi8(static_cast<char>(high + 1))));
+            };
+
+            const __m128i hex = _mm_or_si128(inRange('0', '9'), inRange('a', 'f'));
+            const __m128i hyphen = _mm_cmpeq_epi8(block, _mm_set1_epi8('-'));
+            const __m128i valid = _mm_or_si128(_mm_andnot_si128(hyphens, hex), _mm_and_si128(hyphens, hyphen));
+            return _mm_movemask_epi8(valid) == 0xFFFF;
+        }
+
+        bool isUuid(std::string_view uuid)
+        {
+            // Hyphens sit at offsets 8 and 13 of the first block and 2 and 7 of the second, which starts at 16.
+            const __m128i firstHyphens = _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, -1, 0, 0, 0, 0, -1, 0, 0);
+            const __m128i secondHyphens = _mm_setr_epi8(0, 0, -1, 0, 0, 0, 0, -1, 0, 0, 0, 0, 0, 0, 0, 0);
+
+            const auto* data = reinterpret_cast<const __m128i*>(uuid.data());
+            if (!isUuidBlock(_mm_loadu_si128(data), firstHyphens) ||
+                !isUuidBlock(_mm_loadu_si128(data + 1), secondHyphens))
+            {
+                return false;
+            }
+
+            for (std::size_t i = 32; i < UUID_LENGTH; ++i)
+            {
+                if (!isLowerHex(uuid[i]))
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+#else
+        bool isUuid(std::string_view uuid)
+        {
+            return isUuidScalar(uuid);
+        }
+#endif
+    } // namespace
+
+    bool isUrnUuid(std::string_view str)
+    {
+        return str.size() == URN_PREFIX.size() + UUID_LENGTH &&
+               str.starts_with(URN_PREFIX) &&
+               isUuid(str.substr(URN_PREFIX.size()));
+    }
+
+    bool isMacAddress(std::string_view str)
+    {
+        constexpr std::size_t length = 17;
+        if (str.size() != length || (str[2] != ':' && str[2] != '-'))
+        {
+            return false;
+        }
+
+        const char separator = str[2];
+        for (std::size_t i = 0; i < length; ++i)
+        {
+            if (i % 3 == 2 ? str[i] != separator : !isLowerHex(str[i]))
+            {
+                return false;
+            }
+        }
+        return true;
+    }
+} // namespace opentrackio::opentrackiovalidation
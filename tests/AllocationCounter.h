@@ -0,0 +1,36 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#pragma once
+#include <cstddef>
+
+namespace opentrackio::tests
+{
+    /**
+    * Total number of global operator new calls made by the test executable so far.
+    * Counted by the replacement operator new in AllocationCounter.cpp. */
+    std::size_t allocationCount();
+
+    /**
+    * Counts the allocations made between construction and a call to count(). */
+    class AllocationScope
+    {
+    public:
+        AllocationScope() : m_start{allocationCount()} {}
+
+        [[nodiscard]] std::size_t count() const { return allocationCount() - m_start; }
+
+    private:
+        std::size_t m_start;
+    };
+} // namespace opentrackio::tests
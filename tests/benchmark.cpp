@@ -0,0 +1,935 @@
+/**
+ * Copyright 2025 Mo-Sys Engineering Ltd
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of this software and associated documentation files (the “Software”),
+ * to deal in the Software without restriction, including without limitation the rights to use, copy, modify, merge, publish,
+ * distribute, sublicense, and/or sell copies of the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all copies or substantial portions of the Software.
+ * THE SOFTWARE IS PROVIDED “AS IS”, WITHOUT WARRANTY OF ANY KIND, EXPRESS OR IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM,
+ * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/benchmark/catch_benchmark.hpp>
+#include <nlohmann/json.hpp>
+#include <opentrackio-cpp/OpenTrackIODynamicFrame.h>
+#include <opentrackio-cpp/OpenTrackIOPacket.h>
+#include <opentrackio-cpp/OpenTrackIOReassembler.h>
+#ifdef __linux__
+#include <opentrackio-cpp/OpenTrackIOReceiver.h>
+#include <opentrackio-cpp/OpenTrackIOSender.h>
+#endif
+#include <opentrackio-cpp/OpenTrackIOSample.h>
+#include <opentrackio-cpp/OpenTrackIOValidation.h>
+#include <optional>
+#include <regex>
+#include <span>
+#include <thread>
+#include <vector>
+#include "AllocationCounter.h"
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+using nlohmann::json;
+
+/**
+ * Benchmarks are hidden from the default run, use the "[benchmark]" tag to run them e.g.
+ * ./build/tests/tests "[benchmark]"
+ */
+
+namespace
+{
+    // Equivalent of the published complete_static_example, kept inline so the benchmarks don't need the network.
+    constexpr std::string_view COMPLETE_SAMPLE = R"({
+        "static": {
+            "duration": {"num": 1, "denom": 25},
+            "camera": {
+                "captureFrameRate": {"num": 24000, "denom": 1001},
+                "activeSensorPhysicalDimensions": {"height": 24.0, "width": 36.0},
+                "activeSensorResolution": {"height": 2160, "width": 3840},
+                "make": "CameraMaker", "model": "Model20", "serialNumber": "1234567890A",
+                "firmwareVersion": "1.2.3", "label": "A",
+                "anamorphicSqueeze": {"num": 1, "denom": 1},
+                "isoSpeed": 4000, "fdlLink": "urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a33", "shutterAngle": 45.0
+            },
+            "lens": {
+                "distortionOverscanMax": 1.2, "undistortionOverscanMax": 1.3,
+                "make": "LensMaker", "model": "Model15", "serialNumber": "1234567890A",
+                "firmwareVersion": "1.2.3", "nominalFocalLength": 14.0,
+                "calibrationHistory": ["LensMaker 123", "TrackerMaker 123"]
+            },
+            "tracker": {"make": "TrackerMaker", "model": "Tracker", "serialNumber": "1234567890A", "firmwareVersion": "1.2.3"}
+        },
+        "tracker": {"notes": "Example generated sample.", "recording": false, "slate": "A101_A_4", "status": "Optical Good"},
+        "timing": {
+            "mode": "internal",
+            "recordedTimestamp": {"seconds": 1718806000, "nanoseconds": 500000000},
+            "sampleRate": {"num": 24, "denom": 1},
+            "sampleTimestamp": {"seconds": 1718806554, "nanoseconds": 500000000},
+            "sequenceNumber": 0,
+            "synchronization": {
+                "locked": true, "source": "ptp", "frequency": {"num": 24000, "denom": 1001},
+                "offsets": {"translation": 1.0, "rotation": 2.0, "lensEncoders": 3.0}, "present": true,
+                "ptp": {
+                    "profile": "SMPTE ST2059-2:2021", "domain": 1, "leaderIdentity": "00:11:22:33:44:55",
+                    "leaderPriorities": {"priority1": 128, "priority2": 128}, "leaderAccuracy": 5e-08,
+                    "leaderTimeSource": "GNSS", "meanPathDelay": 0.000123, "vlan": 100
+                }
+            },
+            "timecode": {"hours": 1, "minutes": 2, "seconds": 3, "frames": 4, "frameRate": {"num": 24000, "denom": 1001}, "subFrame": 1, "dropFrame": true}
+        },
+        "lens": {
+            "custom": [1.0, 2.0],
+            "distortion": [
+                {"model": "Brown-Conrady U-D", "radial": [1.0, 2.0, 3.0, 4.0, 5.0, 6.0], "tangential": [1.0, 2.0], "overscan": 3.0},
+                {"radial": [1.0, 2.0, 3.0, 4.0, 5.0, 6.0], "tangential": [1.0, 2.0], "overscan": 2.0}
+            ],
+            "distortionOffset": {"x": 1.0, "y": 2.0},
+            "encoders": {"focus": 0.1, "iris": 0.2, "zoom": 0.3},
+            "entrancePupilOffset": 0.123,
+            "exposureFalloff": {"a1": 1.0, "a2": 2.0, "a3": 3.0},
+            "fStop": 4.0, "pinholeFocalLength": 24.305, "focusDistance": 10.0,
+            "projectionOffset": {"x": 0.1, "y": 0.2},
+            "rawEncoders": {"focus": 1000, "iris": 2000, "zoom": 3000},
+            "tStop": 4.1
+        },
+        "protocol": {"name": "OpenTrackIO", "version": [1, 0, 1]},
+        "sampleId": "urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a33",
+        "sourceId": "urn:uuid:5ca5f233-11b5-dead-beef-948d73e48a33",
+        "sourceNumber": 1,
+        "relatedSampleIds": ["urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a34", "urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a35"],
+        "globalStage": {"E": 100.0, "N": 200.0, "U": 300.0, "lat0": 100.0, "lon0": 200.0, "h0": 300.0},
+        "transforms": [
+            {"translation": {"x": 1.0, "y": 2.0, "z": 3.0}, "rotation": {"pan": 180.0, "tilt": 90.0, "roll": 45.0}, "id": "Dolly"},
+            {"translation": {"x": 1.0, "y": 2.0, "z": 3.0}, "rotation": {"pan": 180.0, "tilt": 90.0, "roll": 45.0},
+             "scale": {"x": 1.0, "y": 2.0, "z": 3.0}, "id": "Crane Arm"},
+            {"translation": {"x": 1.0, "y": 2.0, "z": 3.0}, "rotation": {"pan": 180.0, "tilt": 90.0, "roll": 45.0},
+             "scale": {"x": 1.0, "y": 2.0, "z": 3.0}, "id": "Camera"}
+        ]
+    })";
+} // namespace
+
+TEST_CASE("Parsing from a JSON DOM", "[.][benchmark]")
+{
+    const json example = json::parse(COMPLETE_SAMPLE);
+
+    {
+        // Warm up first so one-off static initialisation isn't counted.
+        REQUIRE(opentrackio::OpenTrackIOSample{}.initialise(example));
+
+        const opentrackio::tests::AllocationScope allocations;
+        opentrackio::OpenTrackIOSample sample;
+        REQUIRE(sample.initialise(example));
+        WARN("Allocations per sample from a JSON DOM: " << allocations.count());
+    }
+
+    {
+        json document = example;
+        const opentrackio::tests::AllocationScope allocations;
+        opentrackio::OpenTrackIOSample sample;
+        REQUIRE(sample.initialise(std::move(document)));
+        WARN("Allocations per sample from a JSON DOM handed over: " << allocations.count());
+    }
+
+    BENCHMARK("initialise(const nlohmann::json&)")
+    {
+        opentrackio::OpenTrackIOSample sample;
+        return sample.initialise(example);
+    };
+
+    // Both build a DOM of their own to hand in, as a caller would, the second hands it over.
+    BENCHMARK("Copying the DOM + initialise(const nlohmann::json&)")
+    {
+        const json document = example;
+        opentrackio::OpenTrackIOSample sample;
+        return sample.initialise(document);
+    };
+
+    BENCHMARK("Copying the DOM + initialise(nlohmann::json&&)")
+    {
+        json document = example;
+        opentrackio::OpenTrackIOSample sample;
+        return sample.initialise(std::move(document));
+    };
+}
+
+TEST_CASE("Parsing from JSON text", "[.][benchmark]")
+{
+    {
+        // Warm up first so one-off static initialisation isn't counted.
+        REQUIRE(opentrackio::OpenTrackIOSample{}.initialise(COMPLETE_SAMPLE));
+
+        const opentrackio::tests::AllocationScope allocations;
+        opentrackio::OpenTrackIOSample sample;
+        REQUIRE(sample.initialise(COMPLETE_SAMPLE));
+        WARN("Allocations per sample from JSON text: " << allocations.count());
+    }
+
+    opentrackio::OpenTrackIOSample reused;
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            REQUIRE(reused.initialise(COMPLETE_SAMPLE));
+        }
+
+        const opentrackio::tests::AllocationScope allocations;
+        REQUIRE(reused.initialise(COMPLETE_SAMPLE));
+        WARN("Allocations per sample from JSON text into a reused sample: " << allocations.count());
+    }
+
+    BENCHMARK("initialise(std::string_view)")
+    {
+        opentrackio::OpenTrackIOSample sample;
+        return sample.initialise(COMPLETE_SAMPLE);
+    };
+
+    BENCHMARK("initialise(std::string_view) into a reused sample")
+    {
+        return reused.initialise(COMPLETE_SAMPLE);
+    };
+
+    BENCHMARK("nlohmann::json::parse + initialise(const nlohmann::json&)")
+    {
+        opentrackio::OpenTrackIOSample sample;
+        return sample.initialise(json::parse(COMPLETE_SAMPLE));
+    };
+}
+
+TEST_CASE("Parsing from CBOR", "[.][benchmark]")
+{
+    const std::vector<uint8_t> cbor = json::to_cbor(json::parse(COMPLETE_SAMPLE));
+    const std::span<const uint8_t> payload{cbor};
+
+    {
+        // Warm up first so one-off static initialisation isn't counted.
+        REQUIRE(opentrackio::OpenTrackIOSample{}.initialise(payload));
+
+        const opentrackio::tests::AllocationScope allocations;
+        opentrackio::OpenTrackIOSample sample;
+        REQUIRE(sample.initialise(payload));
+        WARN("Allocations per sample from " << cbor.size() << " bytes of CBOR: " << allocations.count());
+    }
+
+    opentrackio::OpenTrackIOSample reused;
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            REQUIRE(reused.initialise(payload));
+        }
+
+        const opentrackio::tests::AllocationScope allocations;
+        REQUIRE(reused.initialise(payload));
+        WARN("Allocations per sample from CBOR into a reused sample: " << allocations.count());
+    }
+
+    BENCHMARK("initialise(std::span<const uint8_t>)")
+    {
+        opentrackio::OpenTrackIOSample sample;
+        return sample.initialise(payload);
+    };
+
+    BENCHMARK("initialise(std::span<const uint8_t>) into a reused sample")
+    {
+        return reused.initialise(payload);
+    };
+
+    BENCHMARK("nlohmann::json::from_cbor + initialise(const nlohmann::json&)")
+    {
+        opentrackio::OpenTrackIOSample sample;
+        return sample.initialise(json::from_cbor(payload));
+    };
+}
+
+TEST_CASE("Parsing lens distortion and transforms", "[.][benchmark]")
+{
+    // The per-frame part of a tracked lens: the coefficient arrays and transform chain that change with every sample.
+    constexpr std::string_view DISTORTION_SAMPLE = R"({
+        "lens": {
+            "custom": [0.5, 0.25],
+            "distortion": [
+                {"model": "Brown-Conrady D-U", "radial": [-0.0512, 0.0112, -0.0009], "tangential": [0.0001, -0.0002]},
+                {"model": "Brown-Conrady U-D", "radial": [0.0498, -0.0101, 0.0008], "tangential": [-0.0001, 0.0002], "overscan": 1.05}
+            ],
+            "encoders": {"focus": 0.1, "iris": 0.2, "zoom": 0.3}
+        },
+        "transforms": [
+            {"translation": {"x": 1.0, "y": 2.0, "z": 3.0}, "rotation": {"pan": 180.0, "tilt": 90.0, "roll": 45.0}, "id": "Crane"},
+            {"translation": {"x": 0.1, "y": 0.2, "z": 0.3}, "rotation": {"pan": 10.0, "tilt": 5.0, "roll": 0.0}, "id": "Camera"}
+        ]
+    })";
+    const std::vector<uint8_t> cbor = json::to_cbor(json::parse(DISTORTION_SAMPLE));
+    const std::span<const uint8_t> payload{cbor};
+
+    opentrackio::OpenTrackIOSample sample;
+    REQUIRE(sample.initialise(payload));
+
+    {
+        const opentrackio::tests::AllocationScope allocations;
+        opentrackio::OpenTrackIOSample fresh;
+        REQUIRE(fresh.initialise(payload));
+        WARN("Allocations per sample from CBOR: " << allocations.count());
+    }
+
+    {
+        const opentrackio::tests::AllocationScope allocations;
+        const opentrackio::OpenTrackIOSample copy{sample};
+        WARN("Allocations copying the sample: " << allocations.count());
+    }
+
+    // A second of samples, as a consumer buffering a take would hold them.
+    std::vector<opentrackio::OpenTrackIOSample> samples(48, sample);
+
+    BENCHMARK("initialise(std::span<const uint8_t>)")
+    {
+        opentrackio::OpenTrackIOSample fresh;
+        return fresh.initialise(payload);
+    };
+
+    BENCHMARK("Copying the sample")
+    {
+        const opentrackio::OpenTrackIOSample copy{sample};
+        return copy.lens.has_value();
+    };
+
+    BENCHMARK("Reading the coefficients and transforms of 48 samples")
+    {
+        double sum = 0.0;
+        for (const auto& s : samples)
+        {
+            for (const auto& distortion : *s.lens->distortion)
+            {
+                for (const double k : distortion.radial)
+                {
+                    sum += k;
+                }
+                for (const double p : *distortion.tangential)
+                {
+                    sum += p;
+                }
+            }
+            for (const auto& transform : s.transforms->transforms)
+            {
+                sum += transform.translation.x + transform.rotation.pan;
+            }
+        }
+        return sum;
+    };
+}
+
+TEST_CASE("Decoding into DynamicFrames", "[.][benchmark]")
+{
+    const std::vector<uint8_t> cbor = json::to_cbor(json::parse(COMPLETE_SAMPLE));
+    const std::span<const uint8_t> payload{cbor};
+
+    opentrackio::OpenTrackIOSample sample;
+    REQUIRE(sample.initialise(payload));
+
+    opentrackio::DynamicFrameDecoder decoder;
+    opentrackio::DynamicFrame frame{};
+    REQUIRE(decoder.decode(payload, frame));
+    WARN("sizeof(DynamicFrame): " << sizeof(opentrackio::DynamicFrame));
+
+    // A second of frames, as a ring buffer would hold them.
+    std::vector<opentrackio::DynamicFrame> ring(48, frame);
+    std::size_t next = 0;
+
+    BENCHMARK("DynamicFrameDecoder::decode(std::span<const uint8_t>)")
+    {
+        return decoder.decode(payload, frame);
+    };
+
+    BENCHMARK("DynamicFrame::assign(const OpenTrackIOSample&)")
+    {
+        return frame.assign(sample);
+    };
+
+    BENCHMARK("Copying a DynamicFrame into a ring buffer")
+    {
+        ring[next++ % ring.size()] = frame;
+        return next;
+    };
+
+    BENCHMARK("Copying an OpenTrackIOSample")
+    {
+        const opentrackio::OpenTrackIOSample copy{sample};
+        return copy.lens.has_value();
+    };
+
+    opentrackio::OpenTrackIOSample applied{sample};
+    BENCHMARK("DynamicFrame::applyTo(OpenTrackIOSample&)")
+    {
+        frame.applyTo(applied);
+        return applied.lens.has_value();
+    };
+}
+
+TEST_CASE("Fanning a sample out to subscribers", "[.][benchmark]")
+{
+    opentrackio::OpenTrackIOSample sample;
+    REQUIRE(sample.initialise(COMPLETE_SAMPLE));
+
+    {
+        const opentrackio::tests::AllocationScope allocations;
+        const opentrackio::OpenTrackIOSample copy{sample};
+        WARN("Allocations per subscriber: " << allocations.count());
+    }
+
+    for (const int subscribers : {1, 4, 16, 64})
+    {
+        std::vector<std::vector<opentrackio::OpenTrackIOSample>> queues(subscribers);
+        for (auto& queue : queues)
+        {
+            queue.reserve(1);
+        }
+
+        BENCHMARK("Copying into " + std::to_string(subscribers) + " subscriber queues")
+        {
+            for (auto& queue : queues)
+            {
+                queue.clear();
+                queue.push_back(sample);
+            }
+            return queues.size();
+        };
+    }
+}
+
+TEST_CASE("Parsing pose and lens only", "[.][benchmark]")
+{
+    using opentrackio::SampleFields;
+
+    const SampleFields fields = SampleFields::TRANSFORMS | SampleFields::LENS_ENCODERS | SampleFields::LENS_DISTORTION |
+                                SampleFields::TIMING_SAMPLE_TIMESTAMP;
+    const std::vector<uint8_t> cbor = json::to_cbor(json::parse(COMPLETE_SAMPLE));
+    const std::span<const uint8_t> payload{cbor};
+
+    BENCHMARK("initialise(std::string_view, SampleFields)")
+    {
+        opentrackio::OpenTrackIOSample sample;
+        return sample.initialise(COMPLETE_SAMPLE, fields);
+    };
+
+    BENCHMARK("initialise(std::span<const uint8_t>, SampleFields)")
+    {
+        opentrackio::OpenTrackIOSample sample;
+        return sample.initialise(payload, fields);
+    };
+}
+
+TEST_CASE("Serialising to JSON text", "[.][benchmark]")
+{
+    opentrackio::OpenTrackIOSample sample;
+    REQUIRE(sample.initialise(COMPLETE_SAMPLE));
+
+    std::string text;
+    sample.serializeJson(text);
+    REQUIRE(text == opentrackio::OpenTrackIOSample{sample}.getJson().dump());
+
+    {
+        const opentrackio::tests::AllocationScope allocations;
+        text.clear();
+        sample.serializeJson(text);
+        WARN("Allocations per sample serialising to warm JSON text: " << allocations.count());
+    }
+
+    BENCHMARK("serializeJson(std::string&)")
+    {
+        text.clear();
+        sample.serializeJson(text);
+        return text.size();
+    };
+
+    BENCHMARK("getJson().dump()")
+    {
+        opentrackio::OpenTrackIOSample copy{sample};
+        return copy.getJson().dump().size();
+    };
+
+    BENCHMARK("markDirty(ALL) + getJson().dump()")
+    {
+        sample.markDirty(opentrackio::SampleFields::ALL);
+        return sample.getJson().dump().size();
+    };
+
+    BENCHMARK("markDirty(TRANSFORMS) + getJson().dump()")
+    {
+        sample.markDirty(opentrackio::SampleFields::TRANSFORMS);
+        return sample.getJson().dump().size();
+    };
+}
+
+TEST_CASE("Generating a JSON DOM into an arena", "[.][benchmark]")
+{
+    opentrackio::OpenTrackIOSample sample;
+    REQUIRE(sample.initialise(COMPLETE_SAMPLE));
+
+    opentrackio::JsonArena arena;
+    REQUIRE(std::string_view{sample.getJson(arena).dump()} == opentrackio::OpenTrackIOSample{sample}.getJson().dump());
+    arena.reset();
+
+    {
+        const opentrackio::tests::AllocationScope allocations;
+        opentrackio::OpenTrackIOSample copy{sample};
+        const auto before = allocations.count();
+        copy.getJson();
+        WARN("Heap allocations per sample generating a nlohmann::json DOM: " << allocations.count() - before);
+    }
+
+    {
+        const auto before = arena.stats();
+        std::optional<opentrackio::ArenaJson> dom;
+        {
+            const opentrackio::tests::AllocationScope allocations;
+            dom = sample.getJson(arena);
+            WARN("Heap allocations per sample generating into a warm arena: " << allocations.count());
+        }
+        {
+            const opentrackio::tests::AllocationScope allocations;
+            dom.reset();
+            WARN("Heap allocations destroying it: " << allocations.count());
+        }
+        arena.reset();
+        const auto& after = arena.stats();
+        WARN("Arena allocations per sample: " << after.allocations - before.allocations
+             << ", bytes: " << after.bytesAllocated - before.bytesAllocated
+             << ", blocks: " << after.blocks << " reserving " << after.bytesReserved << " bytes"
+             << ", peak bytes in use: " << after.peakBytesUsed);
+    }
+
+    BENCHMARK("getJson() into a fresh sample")
+    {
+        opentrackio::OpenTrackIOSample copy{sample};
+        return copy.getJson().size();
+    };
+
+    BENCHMARK("getJson(JsonArena&), reset per sample")
+    {
+        std::size_t size;
+        {
+            size = sample.getJson(arena).size();
+        }
+        arena.reset();
+        return size;
+    };
+
+    BENCHMARK("getJson(JsonArena&), reset per batch of 16")
+    {
+        std::size_t size = 0;
+        {
+            std::vector<opentrackio::ArenaJson> batch;
+            batch.reserve(16);
+            for (int i = 0; i < 16; ++i)
+            {
+                batch.push_back(sample.getJson(arena));
+            }
+            size = batch.back().size();
+        }
+        arena.reset();
+        return size;
+    };
+}
+
+TEST_CASE("Serialising to CBOR", "[.][benchmark]")
+{
+    opentrackio::OpenTrackIOSample sample;
+    REQUIRE(sample.initialise(COMPLETE_SAMPLE));
+
+    std::vector<uint8_t> cbor(sample.serializedCborSize());
+    REQUIRE(sample.serializeCbor(cbor) == cbor.size());
+    REQUIRE(cbor == json::to_cbor(opentrackio::OpenTrackIOSample{sample}.getJson()));
+
+    {
+        const opentrackio::tests::AllocationScope allocations;
+        sample.serializeCbor(cbor);
+        WARN("Allocations per sample serialising " << cbor.size() << " bytes of CBOR: " << allocations.count());
+    }
+
+    BENCHMARK("serializedCborSize()")
+    {
+        return sample.serializedCborSize();
+    };
+
+    BENCHMARK("serializeCbor(std::span<uint8_t>)")
+    {
+        return sample.serializeCbor(cbor);
+    };
+
+    BENCHMARK("nlohmann::json::to_cbor(getJson())")
+    {
+        opentrackio::OpenTrackIOSample copy{sample};
+        return json::to_cbor(copy.getJson()).size();
+    };
+}
+
+TEST_CASE("Validating URNs and MAC addresses", "[.][benchmark]")
+{
+    constexpr std::string_view urnRegex = R"(^urn:uuid:[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}$)";
+    constexpr std::string_view macRegex = R"((?:^[0-9a-f]{2}(?::[0-9a-f]{2}){5}$)|(?:^[0-9a-f]{2}(?:-[0-9a-f]{2}){5}$))";
+    const std::string urn = "urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a33";
+    const std::string mac = "00:11:22:33:44:55";
+
+    BENCHMARK("URN: std::regex constructed per call")
+    {
+        return std::regex_match(urn, std::regex{urnRegex.data()});
+    };
+
+    const std::regex urnPattern{urnRegex.data()};
+    BENCHMARK("URN: precompiled std::regex")
+    {
+        return std::regex_match(urn, urnPattern);
+    };
+
+    BENCHMARK("URN: isUrnUuid")
+    {
+        return opentrackio::opentrackiovalidation::isUrnUuid(urn);
+    };
+
+    BENCHMARK("MAC: std::regex constructed per call")
+    {
+        return std::regex_match(mac, std::regex{macRegex.data()});
+    };
+
+    const std::regex macPattern{macRegex.data()};
+    BENCHMARK("MAC: precompiled std::regex")
+    {
+        return std::regex_match(mac, macPattern);
+    };
+
+    BENCHMARK("MAC: isMacAddress")
+    {
+        return opentrackio::opentrackiovalidation::isMacAddress(mac);
+    };
+}
+
+TEST_CASE("Framing and decoding packets", "[.][benchmark]")
+{
+    const std::vector<uint8_t> cbor = json::to_cbor(json::parse(COMPLETE_SAMPLE));
+
+    opentrackio::PacketHeader header{};
+    header.encoding = opentrackio::PayloadEncoding::CBOR;
+    std::vector<uint8_t> datagram(opentrackio::PacketHeader::SIZE + cbor.size());
+    REQUIRE(opentrackio::encodePacket(header, cbor, datagram) == datagram.size());
+
+    opentrackio::OpenTrackIOSample reused;
+    opentrackio::Packet packet{};
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            REQUIRE(opentrackio::decodePacket(datagram, packet) == opentrackio::PacketError::NONE);
+            REQUIRE(opentrackio::initialiseFromPacket(reused, packet));
+        }
+
+        const opentrackio::tests::AllocationScope allocations;
+        REQUIRE(opentrackio::decodePacket(datagram, packet) == opentrackio::PacketError::NONE);
+        REQUIRE(opentrackio::initialiseFromPacket(reused, packet));
+        WARN("Allocations per " << datagram.size() << " byte packet decoded into a reused sample: " << allocations.count());
+    }
+
+    const std::vector<uint8_t> mtu(opentrackio::PacketSegmenter::DEFAULT_MAX_DATAGRAM_SIZE, 0xA5);
+
+    BENCHMARK("Fletcher-16 of 1472 bytes, byte at a time")
+    {
+        return opentrackio::fletcher16Scalar(mtu);
+    };
+
+    BENCHMARK("Fletcher-16 of 1472 bytes, Fletcher16::compute")
+    {
+        return opentrackio::Fletcher16::compute(mtu);
+    };
+
+    BENCHMARK("encodePacket(const PacketHeader&, ...)")
+    {
+        return opentrackio::encodePacket(header, cbor, datagram);
+    };
+
+    BENCHMARK("decodePacket(std::span<const uint8_t>, Packet&)")
+    {
+        return opentrackio::decodePacket(datagram, packet);
+    };
+
+    BENCHMARK("decodePacket + initialiseFromPacket into a reused sample")
+    {
+        return opentrackio::decodePacket(datagram, packet) == opentrackio::PacketError::NONE &&
+               opentrackio::initialiseFromPacket(reused, packet);
+    };
+}
+
+TEST_CASE("Reassembling segmented payloads", "[.][benchmark]")
+{
+    const std::span<const uint8_t> payload(reinterpret_cast<const uint8_t*>(COMPLETE_SAMPLE.data()), COMPLETE_SAMPLE.size());
+
+    std::vector<std::vector<uint8_t>> datagrams;
+    std::vector<opentrackio::Packet> packets;
+    opentrackio::PacketSegmenter segmenter(opentrackio::PayloadEncoding::JSON, 0, payload);
+    datagrams.reserve(segmenter.segmentCount());
+    while (!segmenter.done())
+    {
+        std::vector<uint8_t>& datagram = datagrams.emplace_back(opentrackio::PacketSegmenter::DEFAULT_MAX_DATAGRAM_SIZE);
+        datagram.resize(*segmenter.next(datagram));
+        REQUIRE(opentrackio::decodePacket(datagram, packets.emplace_back()) == opentrackio::PacketError::NONE);
+    }
+
+    opentrackio::PacketReassembler reassembler;
+    const opentrackio::PacketReassembler::Clock::time_point now{};
+    opentrackio::PacketReassembler::Payload complete{};
+    opentrackio::OpenTrackIOSample reused;
+    uint16_t sequenceNumber = 0;
+
+    // The reassembler only reads the sequence number from the header, so the same datagrams stand in for each payload.
+    const auto reassemble = [&]()
+    {
+        ++sequenceNumber;
+        opentrackio::SegmentResult result{};
+        for (opentrackio::Packet& packet : packets)
+        {
+            packet.header.sequenceNumber = sequenceNumber;
+            result = reassembler.add(1, packet, now, complete);
+        }
+        return result;
+    };
+
+    {
+        REQUIRE(reassemble() == opentrackio::SegmentResult::COMPLETE);
+        REQUIRE(opentrackio::initialiseFromPayload(reused, complete.encoding, complete.payload));
+
+        const opentrackio::tests::AllocationScope allocations;
+        REQUIRE(reassemble() == opentrackio::SegmentResult::COMPLETE);
+        WARN("Allocations reassembling " << packets.size() << " segments: " << allocations.count());
+    }
+
+    BENCHMARK("PacketReassembler::add, " + std::to_string(packets.size()) + " segments of " +
+              std::to_string(payload.size()) + " bytes")
+    {
+        return reassemble();
+    };
+
+    BENCHMARK("PacketReassembler::add + initialiseFromPayload into a reused sample")
+    {
+        reassemble();
+        return opentrackio::initialiseFromPayload(reused, complete.encoding, complete.payload);
+    };
+}
+
+#ifdef __linux__
+TEST_CASE("Receiving packets over loopback multicast", "[.][benchmark]")
+{
+    constexpr uint16_t port = 55601;
+    constexpr std::size_t datagramsToSend = 200000;
+
+    // The per-frame part of the complete example, and a sample with little more than the lens encoders, for which
+    // receiving rather than parsing dominates.
+    json dynamic = json::parse(COMPLETE_SAMPLE);
+    dynamic.erase("static");
+    const json encoders = json::parse(R"({"lens": {"encoders": {"focus": 0.1, "iris": 0.2, "zoom": 0.3}}, "timing": {"sequenceNumber": 1}})");
+
+    const auto threadCpuSeconds = []()
+    {
+        timespec time{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+        return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) * 1e-9;
+    };
+
+    for (const json& sample : {dynamic, encoders})
+    {
+        const std::vector<uint8_t> cbor = json::to_cbor(sample);
+        opentrackio::PacketHeader header{};
+        header.encoding = opentrackio::PayloadEncoding::CBOR;
+        std::vector<uint8_t> datagram(opentrackio::PacketHeader::SIZE + cbor.size());
+        REQUIRE(opentrackio::encodePacket(header, cbor, datagram) == datagram.size());
+
+        for (const std::size_t batchSize : {std::size_t{1}, std::size_t{8}, std::size_t{64}})
+        {
+            opentrackio::OpenTrackIOReceiver::Settings settings{};
+            settings.port = port;
+            settings.interfaceAddress = INADDR_LOOPBACK;
+            settings.batchSize = batchSize;
+            settings.receiveBufferSize = 8 * 1024 * 1024;
+
+            opentrackio::OpenTrackIOReceiver receiver{settings};
+            REQUIRE(receiver.open());
+
+            std::atomic<bool> sent = false;
+            std::jthread sender([&]()
+            {
+                const int socket = ::socket(AF_INET, SOCK_DGRAM, 0);
+                const in_addr loopback{htonl(INADDR_LOOPBACK)};
+                setsockopt(socket, IPPROTO_IP, IP_MULTICAST_IF, &loopback, sizeof(loopback));
+
+                sockaddr_in group{};
+                group.sin_family = AF_INET;
+                group.sin_port = htons(port);
+                group.sin_addr.s_addr = htonl(opentrackio::multicastGroup(1));
+                for (std::size_t i = 0; i < datagramsToSend; ++i)
+                {
+                    sendto(socket, datagram.data(), datagram.size(), 0, reinterpret_cast<const sockaddr*>(&group),
+                           sizeof(group));
+                }
+                close(socket);
+                sent = true;
+            });
+
+            // Received, decoded and parsed on this thread, so its CPU time is the receiver's.
+            const auto ignore = [](const opentrackio::OpenTrackIOSample&, uint64_t) {};
+            const double start = threadCpuSeconds();
+            while (receiver.receive(0, ignore, std::chrono::milliseconds(50)) > 0 || !sent)
+            {
+            }
+            const double seconds = threadCpuSeconds() - start;
+            sender.join();
+
+            const opentrackio::OpenTrackIOReceiver::Stats stats = receiver.stats();
+            REQUIRE(stats.parseFailures == 0);
+            WARN(datagram.size() << " byte datagrams in recvmmsg batches of " << batchSize << ": "
+                 << static_cast<uint64_t>(static_cast<double>(stats.samples) / seconds) << " packets/s per core, "
+                 << static_cast<double>(stats.datagrams) / static_cast<double>(stats.batches) << " per call, "
+                 << stats.datagrams << " of " << datagramsToSend << " received");
+        }
+    }
+}
+
+TEST_CASE("Sending packets in sendmmsg batches", "[.][benchmark]")
+{
+    constexpr std::size_t datagramsToSend = 200000;
+    const std::vector<uint8_t> cbor = json::to_cbor(
+        json::parse(R"({"lens": {"encoders": {"focus": 0.1, "iris": 0.2, "zoom": 0.3}}, "timing": {"sequenceNumber": 1}})"));
+
+    const auto threadCpuSeconds = []()
+    {
+        timespec time{};
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time);
+        return static_cast<double>(time.tv_sec) + static_cast<double>(time.tv_nsec) * 1e-9;
+    };
+
+    // Flushing after every sample is a system call per datagram, as sendto() would be.
+    for (const std::size_t samplesPerFlush : {std::size_t{1}, std::size_t{8}, std::size_t{64}})
+    {
+        opentrackio::OpenTrackIOSender::Settings settings{};
+        settings.port = 55603;
+        settings.interfaceAddress = INADDR_LOOPBACK;
+        settings.multicastLoop = false;
+        settings.queueCapacity = samplesPerFlush;
+        settings.sendBufferSize = 8 * 1024 * 1024;
+
+        opentrackio::OpenTrackIOSender sender{settings};
+        REQUIRE(sender.open());
+
+        const double start = threadCpuSeconds();
+        for (std::size_t i = 0; i < datagramsToSend; i += samplesPerFlush)
+        {
+            for (std::size_t j = 0; j < samplesPerFlush; ++j)
+            {
+                sender.queue(opentrackio::PayloadEncoding::CBOR, cbor, 1);
+            }
+            sender.flush();
+        }
+        const double seconds = threadCpuSeconds() - start;
+
+        const opentrackio::OpenTrackIOSender::Stats& stats = sender.stats();
+        REQUIRE(stats.failed == 0);
+        WARN(opentrackio::PacketHeader::SIZE + cbor.size() << " byte datagrams flushed " << samplesPerFlush
+             << " at a time: " << static_cast<uint64_t>(static_cast<double>(stats.datagrams) / seconds)
+             << " packets/s per core, " << static_cast<double>(stats.datagrams) / static_cast<double>(stats.sendCalls)
+             << " per call");
+    }
+}
+
+TEST_CASE("io_uring against sockets over loopback multicast", "[.][benchmark]")
+{
+    constexpr uint16_t port = 55605;
+    constexpr std::size_t samplesToSend = 100000;
+    constexpr std::size_t samplesPerFlush = 8;
+    using Clock = std::chrono::steady_clock;
+
+    // Each sample carries the time it was queued, for the receiving handler to measure its latency from.
+    opentrackio::OpenTrackIOSample sample{};
+    REQUIRE(sample.initialise(std::string_view(R"({"lens": {"encoders": {"focus": 0.1, "iris": 0.2, "zoom": 0.3}}, "timing": {"sampleTimestamp": {"seconds": 0, "nanoseconds": 0}}})")));
+    const auto sinceEpoch = []()
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+    };
+
+    for (const auto backend : {opentrackio::TransportBackend::SOCKETS, opentrackio::TransportBackend::IO_URING})
+    {
+        opentrackio::OpenTrackIOReceiver::Settings receiverSettings{};
+        receiverSettings.port = port;
+        receiverSettings.interfaceAddress = INADDR_LOOPBACK;
+        receiverSettings.receiveBufferSize = 8 * 1024 * 1024;
+        receiverSettings.backend = backend;
+        opentrackio::OpenTrackIOReceiver receiver{receiverSettings};
+        REQUIRE(receiver.open());
+
+        opentrackio::OpenTrackIOSender::Settings senderSettings{};
+        senderSettings.port = port;
+        senderSettings.interfaceAddress = INADDR_LOOPBACK;
+        senderSettings.queueCapacity = samplesPerFlush;
+        senderSettings.backend = backend;
+        opentrackio::OpenTrackIOSender sender{senderSettings};
+        REQUIRE(sender.open());
+
+        if (receiver.backend() != backend || sender.backend() != backend)
+        {
+            WARN("io_uring is unavailable, skipping it");
+            continue;
+        }
+
+        // Written by the worker thread only, and read once it has been stopped.
+        std::vector<int64_t> latencies;
+        latencies.reserve(samplesToSend);
+        REQUIRE(receiver.start([&](const opentrackio::OpenTrackIOSample& received, uint64_t)
+        {
+            const opentrackio::opentrackiotypes::Timestamp& sent = *received.timing->sampleTimestamp;
+            latencies.push_back(sinceEpoch() - static_cast<int64_t>(sent.seconds * 1'000'000'000 + sent.nanoseconds));
+        }));
+
+        // Sent in small flushes with a pause after each, a rate the receiver keeps up with, so that the latencies
+        // are of the path rather than of a backlog.
+        for (std::size_t i = 0; i < samplesToSend; i += samplesPerFlush)
+        {
+            for (std::size_t j = 0; j < samplesPerFlush; ++j)
+            {
+                const int64_t now = sinceEpoch();
+                sample.timing->sampleTimestamp = opentrackio::opentrackiotypes::Timestamp{
+                    static_cast<uint64_t>(now / 1'000'000'000), static_cast<uint32_t>(now % 1'000'000'000)};
+                sender.queue(sample, 1);
+            }
+            sender.flush();
+            std::this_thread::sleep_for(std::chrono::microseconds(20));
+        }
+
+        const auto deadline = Clock::now() + std::chrono::seconds(2);
+        while (receiver.stats().samples < sender.stats().samples && Clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        receiver.stop();
+
+        REQUIRE(!latencies.empty());
+        std::sort(latencies.begin(), latencies.end());
+        const auto percentile = [&latencies](double p)
+        {
+            const auto index = static_cast<std::size_t>(p * static_cast<double>(latencies.size() - 1));
+            return static_cast<double>(latencies[index]) / 1000.0;
+        };
+
+        const opentrackio::OpenTrackIOReceiver::Stats received = receiver.stats();
+        const opentrackio::OpenTrackIOSender::Stats& sent = sender.stats();
+        WARN((backend == opentrackio::TransportBackend::IO_URING ? "io_uring" : "sockets") << ": "
+             << static_cast<double>(received.systemCalls) / static_cast<double>(received.datagrams)
+             << " receiving and "
+             << static_cast<double>(sent.sendCalls) / static_cast<double>(sent.datagrams)
+             << " sending system calls per packet, latency p50 " << percentile(0.5) << " us, p99 "
+             << percentile(0.99) << " us, p99.9 " << percentile(0.999) << " us, " << received.samples << " of "
+             << sent.samples << " received");
+    }
+}
+#endif
@@ -11,13 +11,43 @@
  * DAMAGES OR OTHER LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
  */
 
+#include <algorithm>
+#include <atomic>
 #include <catch2/catch_test_macros.hpp>
+#include <cstring>
 #include <curl/curl.h>
+#include <format>
 #include <iostream>
+#include <limits>
+#include <map>
+#ifdef OPENTRACKIO_PMR
+#include <memory_resource>
+#endif
+#include <mutex>
 #include <nlohmann/json.hpp>
 #include <nlohmann/json-schema.hpp>
+#include <opentrackio-cpp/OpenTrackIODynamicFrame.h>
+#include <opentrackio-cpp/OpenTrackIOPacket.h>
+#include <opentrackio-cpp/OpenTrackIOReassembler.h>
+#ifdef __linux__
+#include <opentrackio-cpp/OpenTrackIOReceiver.h>
+#include <opentrackio-cpp/OpenTrackIOSender.h>
+#endif
 #include <opentrackio-cpp/OpenTrackIOSample.h>
+#include <opentrackio-cpp/OpenTrackIOValidation.h>
+#include <optional>
+#include <regex>
 #include <span>
+#include <thread>
+#include <unordered_map>
+#include "AllocationCounter.h"
+
+#ifdef __linux__
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
 
 using nlohmann::json;
 using nlohmann::json_schema::json_validator;
@@ -43,6 +73,30 @@ TEST_CASE("OpenTrackIOSample basic initialisation", "[init]")
         REQUIRE_FALSE(sample.initialise(cbor));
     }
 
+    SECTION("Initialising from malformed CBOR should be unsuccessful without throwing.")
+    {
+        const std::vector<uint8_t> valid = json::to_cbor(json::parse(R"({"sampleId": "a", "lens": {"fStop": 2.8}})"));
+        std::vector<std::vector<uint8_t>> malformed = {
+            std::vector<uint8_t>(valid.begin(), valid.end() - 1),
+            valid,
+            {0xC0, 0x60},
+            {0xA1, 0x01, 0x02},
+            {0xBF, 0x61, 0x61},
+            {0x9F, 0x9F, 0x9F},
+        };
+        malformed[1].push_back(0x00);
+
+        for (const std::vector<uint8_t>& cbor : malformed)
+        {
+            opentrackio::OpenTrackIOSample sample;
+            bool initialised = true;
+            REQUIRE_NOTHROW(initialised = sample.initialise(std::span<const uint8_t>(cbor)));
+            REQUIRE_FALSE(initialised);
+            REQUIRE(sample.getErrors().size() == 1);
+            REQUIRE(sample.getErrors().front().starts_with("Unable to initialise OpenTrackIO sample, CBOR parse error"));
+        }
+    }
+
     SECTION("Initialising from an empty JSON object should be unsuccessful.")
     {
         opentrackio::OpenTrackIOSample sample;
@@ -55,6 +109,1999 @@ TEST_CASE("OpenTrackIOSample basic initialisation", "[init]")
     }
 }
 
+TEST_CASE("OpenTrackIOSample reports unknown fields without modifying the input", "[init]")
+{
+    const json input = json::parse(R"({
+        "protocol": {"name": "OpenTrackIO", "version": [1, 0, 1]},
+        "sourceNumber": 1,
+        "unknownTopLevel": 1,
+        "lens": {"fStop": 4.0, "unknownLensField": true},
+        "static": {"camera": {"label": "A"}, "unknownStatic": {}}
+    })");
+    const json original = input;
+
+    opentrackio::OpenTrackIOSample sample;
+    REQUIRE(sample.initialise(input));
+    REQUIRE(input == original);
+    REQUIRE(sample.lens->fStop == 4.0);
+    REQUIRE(sample.camera->label == "A");
+
+    const auto& warnings = sample.getWarnings();
+    REQUIRE(warnings.size() == 4);
+    REQUIRE(std::find(warnings.begin(), warnings.end(), "Key: unknownTopLevel was still remaining after parsing.") != warnings.end());
+    REQUIRE(std::find(warnings.begin(), warnings.end(), "Key: lens was still remaining after parsing.") != warnings.end());
+    REQUIRE(std::find(warnings.begin(), warnings.end(), "Key: unknownLensField was still remaining after parsing.") != warnings.end());
+    REQUIRE(std::find(warnings.begin(), warnings.end(), "Key: unknownStatic was still remaining after parsing.") != warnings.end());
+}
+
+TEST_CASE("OpenTrackIOSample parses text, CBOR and DOMs identically", "[init]")
+{
+    for (const std::string_view text : {
+        R"({"protocol": {"name": "OpenTrackIO", "version": [1, 0, 1]}, "lens": {"fStop": 2.8, "custom": 1, "extra": {"a": 1}}})",
+        R"({"static": {"camera": {"label": "A", "shutterAngle": 400}}, "timing": {"sampleRate": {"num": 24}}})",
+        R"({"sampleId": "urn:uuid:not-a-uuid", "transforms": [{"translation": {"x": 1}, "rotation": {"pan": 1, "tilt": 2, "roll": 3}}]})",
+        R"({"timing": {"synchronization": {"locked": true, "source": "ptp", "ptp": {"profile": "IEEE Std 1588-2019", "domain": 1}}}})",
+        R"({"tracker": {"notes": "a", "unknown": [{"b": 1}]}, "static": {"tracker": {"make": "b"}, "lens": 1}})",
+        R"({"lens": {"distortion": [{"radial": [1, 2, 3, 4, 5, 6, 7, 8], "tangential": [1, 2, 3]}]}, "transforms": [
+            {"translation": {"x": 1, "y": 2, "z": 3}, "rotation": {"pan": 1, "tilt": 2, "roll": 3}, "id": "A"},
+            {"translation": {"x": 1, "y": 2, "z": 3}, "rotation": {"pan": 1, "tilt": 2, "roll": 3}, "id": "B"},
+            {"translation": {"x": 1, "y": 2, "z": 3}, "rotation": {"pan": 1, "tilt": 2, "roll": 3}, "id": "C"},
+            {"translation": {"x": 1, "y": 2, "z": 3}, "rotation": {"pan": 1, "tilt": 2, "roll": 3}, "id": "A long transform id"}]})",
+        R"([1, 2, 3])",
+    })
+    {
+        opentrackio::OpenTrackIOSample fromText;
+        opentrackio::OpenTrackIOSample fromCbor;
+        opentrackio::OpenTrackIOSample fromDom;
+        opentrackio::OpenTrackIOSample fromMovedDom;
+        const json dom = json::parse(text);
+        const std::vector<uint8_t> cbor = json::to_cbor(dom);
+        const bool textResult = fromText.initialise(text);
+        const bool cborResult = fromCbor.initialise(std::span<const uint8_t>(cbor));
+        const bool domResult = fromDom.initialise(dom);
+        const bool movedDomResult = fromMovedDom.initialise(json::parse(text));
+
+        REQUIRE(textResult == domResult);
+        REQUIRE(cborResult == domResult);
+        REQUIRE(movedDomResult == domResult);
+        REQUIRE(fromText.getErrors() == fromDom.getErrors());
+        REQUIRE(fromCbor.getErrors() == fromDom.getErrors());
+        REQUIRE(fromMovedDom.getErrors() == fromDom.getErrors());
+        REQUIRE(fromText.getWarnings() == fromDom.getWarnings());
+        REQUIRE(fromCbor.getWarnings() == fromDom.getWarnings());
+        REQUIRE(fromMovedDom.getWarnings() == fromDom.getWarnings());
+        if (textResult)
+        {
+            REQUIRE(fromText.getJson() == fromDom.getJson());
+            REQUIRE(fromCbor.getJson() == fromDom.getJson());
+            REQUIRE(fromMovedDom.getJson() == fromDom.getJson());
+        }
+    }
+
+    // The paths above are only compared with each other, so a field every path leaves unmarked, e.g. a rational
+    // nested in a timecode, would warn identically. A well formed sample mustn't warn at all.
+    const json valid = json::parse(R"({
+        "timing": {"sampleRate": {"num": 24000, "denom": 1001},
+                   "timecode": {"hours": 1, "minutes": 2, "seconds": 3, "frames": 4, "frameRate": {"num": 24000, "denom": 1001}}},
+        "transforms": [{"translation": {"x": 1, "y": 2, "z": 3}, "rotation": {"pan": 1, "tilt": 2, "roll": 3},
+                        "scale": {"x": 1, "y": 1, "z": 1}, "id": "A"}]
+    })");
+    opentrackio::OpenTrackIOSample fromDom;
+    REQUIRE(fromDom.initialise(valid));
+    REQUIRE(fromDom.getErrors().empty());
+    REQUIRE(fromDom.getWarnings().empty());
+}
+
+TEST_CASE("OpenTrackIOSample moves strings out of a DOM it's handed", "[init]")
+{
+    const std::string_view text = R"({
+        "static": {"lens": {"calibrationHistory": ["A calibration with a long enough name"]}},
+        "protocol": {"name": "OpenTrackIO with a long enough name", "version": [1, 0, 1]},
+        "relatedSampleIds": ["urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a34"],
+        "tracker": {"notes": "Notes that are too long for small string storage"},
+        "transforms": [{"translation": {"x": 1, "y": 2, "z": 3}, "rotation": {"pan": 1, "tilt": 2, "roll": 3}, "id": "A transform with a long id"}],
+        "unknown": "A leftover field with a long value"
+    })";
+
+    json expected = json::parse(text);
+    expected.erase("unknown");
+
+    // A DOM that is only lent is read and left as it was.
+    const json lent = json::parse(text);
+    opentrackio::OpenTrackIOSample fromLent;
+    REQUIRE(fromLent.initialise(lent));
+    REQUIRE(lent == json::parse(text));
+
+    json dom = json::parse(text);
+    const char* notes = dom["tracker"]["notes"].get_ref<const std::string&>().data();
+    const char* id = dom["transforms"][0]["id"].get_ref<const std::string&>().data();
+
+    opentrackio::OpenTrackIOSample moved;
+    REQUIRE(moved.initialise(std::move(dom)));
+    REQUIRE(dom.is_null());
+    REQUIRE(moved.getWarnings() == fromLent.getWarnings());
+    REQUIRE(moved.getWarnings().size() == 1);
+    REQUIRE(moved.getJson() == expected);
+    REQUIRE(fromLent.getJson() == expected);
+#ifndef OPENTRACKIO_PMR
+    REQUIRE(moved.tracker->notes->data() == notes);
+    REQUIRE(moved.transforms->transforms[0].id->data() == id);
+#endif
+}
+
+TEST_CASE("OpenTrackIOSample parses only the requested fields", "[init]")
+{
+    using opentrackio::SampleFields;
+
+    // Fields outside the mask aren't validated, so the bad shutterAngle and the unknown camera field go unreported.
+    const std::string_view text = R"({
+        "static": {"camera": {"label": "A", "shutterAngle": "bad", "unknown": 1}, "tracker": {"make": "b"}},
+        "tracker": {"notes": "a", "recording": true},
+        "lens": {
+            "fStop": 2.8, "encoders": {"focus": 0.1, "iris": 0.2, "zoom": 0.3},
+            "distortion": [{"radial": [1.0, 2.0], "model": "m"}], "distortionOffset": {"x": 1.0, "y": 2.0}
+        },
+        "timing": {"mode": "internal", "sampleTimestamp": {"seconds": 10, "nanoseconds": 20}, "sequenceNumber": 3,
+                   "synchronization": {"locked": true, "source": "ptp", "ptp": {"vlan": "bad"}}},
+        "transforms": [{"translation": {"x": 1, "y": 2, "z": 3}, "rotation": {"pan": 4, "tilt": 5, "roll": 6}, "id": "a"}],
+        "unknownTopLevel": true
+    })";
+    const std::vector<uint8_t> cbor = json::to_cbor(json::parse(text));
+    const SampleFields fields = SampleFields::TRANSFORMS | SampleFields::LENS_ENCODERS | SampleFields::LENS_DISTORTION |
+                                SampleFields::TIMING_SAMPLE_TIMESTAMP;
+
+    opentrackio::OpenTrackIOSample fromText;
+    opentrackio::OpenTrackIOSample fromCbor;
+    REQUIRE(fromText.initialise(text, fields));
+    REQUIRE(fromCbor.initialise(std::span<const uint8_t>(cbor), fields));
+
+    for (auto* sample : {&fromText, &fromCbor})
+    {
+        REQUIRE(sample->getErrors().empty());
+        REQUIRE(sample->getWarnings() == std::vector<std::string>{"Key: unknownTopLevel was still remaining after parsing."});
+
+        REQUIRE_FALSE(sample->camera.has_value());
+        REQUIRE_FALSE(sample->tracker.has_value());
+
+        REQUIRE(sample->lens.has_value());
+        REQUIRE(sample->lens->encoders->zoom == 0.3);
+        REQUIRE(sample->lens->distortion->size() == 1);
+        REQUIRE(sample->lens->distortion->at(0).model == "m");
+        REQUIRE(sample->lens->distortionOffset->y == 2.0);
+        REQUIRE_FALSE(sample->lens->fStop.has_value());
+
+        REQUIRE(sample->timing.has_value());
+        REQUIRE(sample->timing->sampleTimestamp->nanoseconds == 20);
+        REQUIRE_FALSE(sample->timing->mode.has_value());
+        REQUIRE_FALSE(sample->timing->sequenceNumber.has_value());
+        REQUIRE_FALSE(sample->timing->synchronization.has_value());
+
+        REQUIRE(sample->transforms->transforms.size() == 1);
+        REQUIRE(sample->transforms->transforms[0].id == "a");
+    }
+
+    // Everything is parsed by default, which reports the invalid values.
+    opentrackio::OpenTrackIOSample all;
+    REQUIRE_FALSE(all.initialise(std::span<const uint8_t>(cbor), SampleFields::ALL));
+    REQUIRE_FALSE(all.getErrors().empty());
+
+    // Values that are skipped still have to be well formed.
+    std::vector<uint8_t> truncated = json::to_cbor(json::parse(R"({"static": {"camera": {"label": "A"}}})"));
+    truncated.pop_back();
+    REQUIRE_FALSE(opentrackio::OpenTrackIOSample{}.initialise(std::span<const uint8_t>(truncated), SampleFields::TRANSFORMS));
+}
+
+TEST_CASE("Reused OpenTrackIOSamples are reset and parse CBOR without allocating", "[init]")
+{
+    const std::string_view large = R"({
+        "static": {
+            "camera": {"label": "Camera with a long label", "fdlLink": "urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a33"},
+            "lens": {"make": "A lens maker with a long name", "calibrationHistory": ["First calibration of the lens", "B"]},
+            "tracker": {"make": "A tracker maker with a long name", "serialNumber": "1234567890ABCDEFGH"}
+        },
+        "tracker": {"notes": "Notes that are too long for small string storage", "recording": true, "status": "Optical Good"},
+        "lens": {
+            "custom": [1.0, 2.0, 3.0],
+            "distortion": [{"model": "Brown-Conrady U-D", "radial": [1.0, 2.0, 3.0, 4.0, 5.0, 6.0], "tangential": [1.0, 2.0]},
+                           {"radial": [1.0, 2.0, 3.0]}],
+            "encoders": {"focus": 0.1, "iris": 0.2, "zoom": 0.3}
+        },
+        "protocol": {"name": "OpenTrackIO", "version": [1, 0, 1]},
+        "relatedSampleIds": ["urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a34", "urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a35"],
+        "sampleId": "urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a33",
+        "timing": {
+            "mode": "internal", "sampleTimestamp": {"seconds": 1718806554, "nanoseconds": 500000000},
+            "synchronization": {"locked": true, "source": "ptp", "ptp": {
+                "profile": "SMPTE ST2059-2:2021", "domain": 1, "leaderIdentity": "00:11:22:33:44:55",
+                "leaderPriorities": {"priority1": 128, "priority2": 128}, "leaderAccuracy": 5e-08, "meanPathDelay": 0.000123}}
+        },
+        "transforms": [
+            {"translation": {"x": 1, "y": 2, "z": 3}, "rotation": {"pan": 4, "tilt": 5, "roll": 6}, "id": "A transform with a long id"},
+            {"translation": {"x": 1, "y": 2, "z": 3}, "rotation": {"pan": 4, "tilt": 5, "roll": 6}}
+        ]
+    })";
+    const std::string_view small = R"({
+        "lens": {"distortion": [{"radial": [7.0]}], "custom": [4.0]},
+        "tracker": {"slate": "B"},
+        "transforms": [{"translation": {"x": 7, "y": 8, "z": 9}, "rotation": {"pan": 1, "tilt": 2, "roll": 3}}],
+        "unknown": 1
+    })";
+    const std::vector<uint8_t> largeCbor = json::to_cbor(json::parse(large));
+    const std::vector<uint8_t> smallCbor = json::to_cbor(json::parse(small));
+
+    opentrackio::OpenTrackIOSample reused;
+    const auto expectFresh = [&](std::string_view text, bool fromCbor)
+    {
+        opentrackio::OpenTrackIOSample fresh;
+        REQUIRE(fresh.initialise(text));
+        REQUIRE(reused.getWarnings() == fresh.getWarnings());
+        REQUIRE(reused.getJson() == fresh.getJson());
+
+        if (fromCbor)
+        {
+            REQUIRE(reused.getErrors().empty());
+        }
+    };
+
+    SECTION("Nothing is left over from the previous sample")
+    {
+        REQUIRE_FALSE(reused.initialise(std::string_view(R"({"timing": {"mode": "bad"}})")));
+        REQUIRE(reused.getErrors().size() == 1);
+
+        REQUIRE(reused.initialise(large));
+        expectFresh(large, false);
+        REQUIRE(reused.getErrors().empty());
+
+        REQUIRE(reused.initialise(std::span<const uint8_t>(smallCbor)));
+        expectFresh(small, true);
+        REQUIRE(reused.getWarnings().size() == 1);
+
+        REQUIRE(reused.initialise(std::span<const uint8_t>(largeCbor)));
+        expectFresh(large, true);
+        REQUIRE(reused.getWarnings().empty());
+
+        reused.reset();
+        REQUIRE_FALSE(reused.lens.has_value());
+        REQUIRE_FALSE(reused.timing.has_value());
+        REQUIRE(reused.getErrors().empty());
+        REQUIRE(reused.getJson().is_null());
+    }
+
+    SECTION("Steady state parsing doesn't allocate")
+    {
+        // The recycled buffers are handed out in a different order to the one they were taken in, so it takes a
+        // few samples for all of them to grow to fit.
+        for (int i = 0; i < 8; ++i)
+        {
+            REQUIRE(reused.initialise(std::span<const uint8_t>(largeCbor)));
+        }
+
+        const opentrackio::tests::AllocationScope allocations;
+        for (int i = 0; i < 4; ++i)
+        {
+            REQUIRE(reused.initialise(std::span<const uint8_t>(largeCbor)));
+        }
+        REQUIRE(allocations.count() == 0);
+    }
+
+    SECTION("Steady state text parsing only allocates for the tokeniser")
+    {
+        for (int i = 0; i < 8; ++i)
+        {
+            REQUIRE(reused.initialise(large));
+        }
+
+        // nlohmann's lexer and parser are built afresh for each call, so text never reaches zero, but the properties
+        // are refilled in place and every call makes the same few allocations.
+        std::vector<std::size_t> counts;
+        for (int i = 0; i < 4; ++i)
+        {
+            const opentrackio::tests::AllocationScope allocations;
+            REQUIRE(reused.initialise(large));
+            counts.push_back(allocations.count());
+        }
+        REQUIRE(std::ranges::all_of(counts, [&counts](std::size_t count) { return count == counts.front(); }));
+        REQUIRE(counts.front() < 16);
+    }
+}
+
+TEST_CASE("OpenTrackIOSample records errors and only formats them on request", "[init]")
+{
+    using opentrackio::ErrorCode;
+
+    const std::string_view invalid = R"({
+        "static": {"camera": {"fdlLink": 5}},
+        "protocol": {"name": "OpenTrackIO", "version": [1, 0]},
+        "sampleId": "not a urn",
+        "timing": {"mode": "bad"}
+    })";
+    const std::vector<uint8_t> cbor = json::to_cbor(json::parse(invalid));
+
+    opentrackio::OpenTrackIOSample sample;
+    for (int i = 0; i < 4; ++i)
+    {
+        REQUIRE_FALSE(sample.initialise(std::span<const uint8_t>(cbor)));
+    }
+
+    {
+        const opentrackio::tests::AllocationScope allocations;
+        REQUIRE_FALSE(sample.initialise(std::span<const uint8_t>(cbor)));
+        REQUIRE(allocations.count() == 0);
+    }
+
+    const auto records = sample.getParseErrors().errors();
+    REQUIRE(records.size() == 4);
+    REQUIRE(records[0] == opentrackio::ParseError{ErrorCode::NOT_OF_TYPE, "fdlLink", "string"});
+    REQUIRE(records[1] == opentrackio::ParseError{ErrorCode::WRONG_SIZE, "protocol version", "[int, int, int]", 3});
+    REQUIRE(records[2] == opentrackio::ParseError{ErrorCode::PATTERN_MISMATCH, "sampleId"});
+    REQUIRE(records[3] == opentrackio::ParseError{ErrorCode::INVALID_STRING, "timing/mode"});
+
+    REQUIRE(sample.getErrors() == std::vector<std::string>{
+        "field: fdlLink isn't of type: string",
+        "field: protocol version isn't of size 3: [int, int, int]",
+        "field: sampleId doesn't match the required pattern",
+        "field: timing/mode has an invalid string value.",
+    });
+
+    opentrackio::OpenTrackIOSample fromDom;
+    REQUIRE_FALSE(fromDom.initialise(json::parse(invalid)));
+    REQUIRE(fromDom.getParseErrors().errors().size() == records.size());
+    REQUIRE(std::equal(records.begin(), records.end(), fromDom.getParseErrors().errors().begin()));
+
+    REQUIRE(sample.initialise(std::string_view(R"({"sourceNumber": 1})")));
+    REQUIRE(sample.getParseErrors().empty());
+    REQUIRE(sample.getErrors().empty());
+
+    SECTION("Errors past the capacity are counted but not stored")
+    {
+        opentrackio::ParseErrors errors;
+        for (std::size_t i = 0; i < opentrackio::ParseErrors::CAPACITY + 2; ++i)
+        {
+            errors.add(ErrorCode::MISSING_FIELDS, "duration");
+        }
+
+        REQUIRE(errors.size() == opentrackio::ParseErrors::CAPACITY + 2);
+        REQUIRE(errors.errors().size() == opentrackio::ParseErrors::CAPACITY);
+        REQUIRE(errors.dropped() == 2);
+
+        std::vector<std::string> messages;
+        errors.render(messages);
+        REQUIRE(messages.size() == opentrackio::ParseErrors::CAPACITY + 1);
+        REQUIRE(messages.back() == "2 further errors weren't recorded.");
+    }
+}
+
+TEST_CASE("OpenTrackIOSample reuses the static block of a source until its static object changes", "[init]")
+{
+    const auto withStatic = [](std::string_view cameraLabel, std::string_view sourceId, int sourceNumber)
+    {
+        return std::format(R"({{
+            "static": {{
+                "camera": {{"label": "{}", "make": "A camera maker with a long name"}},
+                "duration": {{"num": 1, "denom": 25}},
+                "lens": {{"make": "A lens maker with a long name", "calibrationHistory": ["Static calibration"]}},
+                "tracker": {{"serialNumber": "1234567890ABCDEFGH"}}
+            }},
+            "lens": {{"encoders": {{"focus": 0.1, "iris": 0.2, "zoom": 0.3}}}},
+            "tracker": {{"status": "Optical Good"}},
+            "sourceId": "{}",
+            "sourceNumber": {}
+        }})", cameraLabel, sourceId, sourceNumber);
+    };
+    const std::string sourceA = "urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a33";
+    const std::string sourceB = "urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a34";
+
+    opentrackio::OpenTrackIOSample sample;
+    const auto expectFresh = [&](std::string_view text, opentrackio::SampleFields fields)
+    {
+        opentrackio::OpenTrackIOSample fresh;
+        REQUIRE(fresh.initialise(text, fields));
+        REQUIRE(sample.getWarnings() == fresh.getWarnings());
+        REQUIRE(sample.getJson() == fresh.getJson());
+    };
+    const auto expectStats = [&](uint64_t hits, uint64_t misses)
+    {
+        REQUIRE(sample.getStaticCacheStats().hits == hits);
+        REQUIRE(sample.getStaticCacheStats().misses == misses);
+    };
+
+    SECTION("Text")
+    {
+        const std::string first = withStatic("A", sourceA, 1);
+        REQUIRE(sample.initialise(std::string_view(first)));
+        expectFresh(first, opentrackio::SampleFields::ALL);
+        expectStats(0, 1);
+
+        const auto block = sample.getStaticBlock();
+        REQUIRE(block != nullptr);
+        REQUIRE(block->camera->label == "A");
+        REQUIRE(block->lens->calibrationHistory == opentrackio::opentrackiotypes::Vector<opentrackio::opentrackiotypes::String>{"Static calibration"});
+        REQUIRE_FALSE(block->lens->encoders.has_value());
+        REQUIRE_FALSE(block->tracker->status.has_value());
+
+        const std::string second = withStatic("A", sourceA, 2);
+        REQUIRE(sample.initialise(std::string_view(second)));
+        expectFresh(second, opentrackio::SampleFields::ALL);
+        expectStats(1, 1);
+        REQUIRE(sample.getStaticBlock() == block);
+
+        // A sourceId the scanner can't read is only matched once the document has been parsed.
+        const std::string escaped = withStatic("A", R"(urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a3\u0033)", 3);
+        REQUIRE(sample.initialise(std::string_view(escaped)));
+        expectFresh(escaped, opentrackio::SampleFields::ALL);
+        expectStats(2, 1);
+        REQUIRE(sample.getStaticBlock() == block);
+
+        const auto fields = opentrackio::SampleFields::CAMERA | opentrackio::SampleFields::LENS_ENCODERS;
+        REQUIRE(sample.initialise(std::string_view(second), fields));
+        expectFresh(second, fields);
+        expectStats(3, 1);
+
+        const std::string changed = withStatic("B", sourceA, 4);
+        REQUIRE(sample.initialise(std::string_view(changed)));
+        expectFresh(changed, opentrackio::SampleFields::ALL);
+        expectStats(3, 2);
+        REQUIRE(sample.getStaticBlock() != block);
+        REQUIRE(sample.getStaticBlock()->camera->label == "B");
+        REQUIRE(block->camera->label == "A");
+
+        const std::string otherSource = withStatic("B", sourceB, 5);
+        REQUIRE(sample.initialise(std::string_view(otherSource)));
+        expectStats(3, 3);
+        REQUIRE(sample.initialise(std::string_view(changed)));
+        expectStats(4, 3);
+
+        REQUIRE(sample.initialise(std::string_view(R"({"static": {"camera": {"label": "A"}}, "sourceNumber": 1})")));
+        REQUIRE(sample.getStaticBlock() == nullptr);
+        expectStats(4, 4);
+    }
+
+    SECTION("CBOR")
+    {
+        const std::vector<uint8_t> first = json::to_cbor(json::parse(withStatic("A", sourceA, 1)));
+        const std::vector<uint8_t> second = json::to_cbor(json::parse(withStatic("A", sourceA, 2)));
+
+        REQUIRE(sample.initialise(std::span<const uint8_t>(first)));
+        expectStats(0, 1);
+        const auto block = sample.getStaticBlock();
+
+        for (int i = 0; i < 8; ++i)
+        {
+            REQUIRE(sample.initialise(std::span<const uint8_t>(second)));
+        }
+        expectStats(8, 1);
+        REQUIRE(sample.getStaticBlock() == block);
+
+        {
+            const opentrackio::tests::AllocationScope allocations;
+            REQUIRE(sample.initialise(std::span<const uint8_t>(second)));
+            REQUIRE(allocations.count() == 0);
+        }
+        expectFresh(withStatic("A", sourceA, 2), opentrackio::SampleFields::ALL);
+    }
+
+    SECTION("More sources in rotation than fit")
+    {
+        constexpr std::size_t capacity = opentrackio::OpenTrackIOSaxParser::DEFAULT_STATIC_CACHE_CAPACITY;
+        std::vector<std::string> sources;
+        for (std::size_t i = 0; i <= capacity; ++i)
+        {
+            sources.push_back(withStatic("A", std::format("urn:uuid:5ca5f233-11b5-4f43-8815-{:012x}", i), 1));
+        }
+
+        constexpr std::size_t rounds = 10;
+        for (std::size_t round = 0; round < rounds; ++round)
+        {
+            for (const std::string& source : sources)
+            {
+                REQUIRE(sample.initialise(std::string_view(source)));
+            }
+        }
+
+        // Clearing or evicting the least recently used source on a miss would never hit.
+        const auto stats = sample.getStaticCacheStats();
+        REQUIRE(stats.hits + stats.misses == rounds * sources.size());
+        REQUIRE(stats.hits > 2 * stats.misses);
+        expectFresh(sources.back(), opentrackio::SampleFields::ALL);
+
+        sample.setStaticCacheCapacity(0);
+        REQUIRE(sample.initialise(std::string_view(sources.front())));
+        REQUIRE(sample.initialise(std::string_view(sources.front())));
+        expectStats(stats.hits, stats.misses + 2);
+        REQUIRE(sample.getStaticBlock() == nullptr);
+    }
+}
+
+TEST_CASE("OpenTrackIOSample serialises JSON text and CBOR identically to the DOM", "[json]")
+{
+    std::vector<opentrackio::OpenTrackIOSample> samples(5);
+    REQUIRE(samples[0].initialise(std::string_view(R"({
+        "static": {"camera": {"label": "A\"\\\n\u0001", "isoSpeed": 800}, "duration": {"num": 1, "denom": 25}},
+        "lens": {"encoders": {"focus": 0.1}, "distortion": [{"radial": [1.0, -0.0, 1e-300, 123456789012345678.0]}]},
+        "timing": {"mode": "external", "sampleRate": {"num": 24, "denom": 1}},
+        "transforms": [{"translation": {"x": 1, "y": 2, "z": 3}, "rotation": {"pan": 1, "tilt": 2, "roll": 3}}]
+    })")));
+    REQUIRE(samples[1].initialise(std::string_view(R"({"tracker": {"recording": true}, "sourceNumber": 4})")));
+
+    samples[2].camera.emplace();
+    samples[2].timing.emplace();
+    samples[2].tracker.emplace();
+    samples[2].lens.emplace().encoders.emplace();
+    samples[2].lens->rawEncoders.emplace();
+    samples[2].globalStage = opentrackio::opentrackioproperties::GlobalStage{
+        std::numeric_limits<double>::quiet_NaN(), 0.1, 1e21, -1e-7, 0.0, 5.0};
+    samples[2].timing->sampleTimestamp = opentrackio::opentrackiotypes::Timestamp{1ull << 40, 70000};
+    samples[2].timing->synchronization.emplace().ptp.emplace().vlan = -300;
+
+    samples[3].lens.emplace().calibrationHistory.emplace();
+    samples[3].tracker.emplace();
+
+    // Doubles either side of where dump() switches to exponents, negative zero and a whole number.
+    samples[4].globalStage = opentrackio::opentrackioproperties::GlobalStage{1e15, 5e-8, -0.0, 1e-5, 42.0, 1e-4};
+    std::string edges;
+    samples[4].serializeJson(edges);
+    REQUIRE(edges == R"({"globalStage":{"E":1e+15,"N":5e-08,"U":-0.0,"h0":0.0001,"lat0":1e-05,"lon0":42.0}})");
+
+    for (const opentrackio::OpenTrackIOSample& sample : samples)
+    {
+        const std::string expected = opentrackio::OpenTrackIOSample{sample}.getJson().dump();
+
+        std::string text = "prefix";
+        sample.serializeJson(text);
+        REQUIRE(text == "prefix" + expected);
+
+        std::vector<char> buffer(expected.size());
+        REQUIRE(sample.serializeJson(std::span<char>(buffer)) == expected.size());
+        REQUIRE(std::string_view(buffer.data(), buffer.size()) == expected);
+
+        buffer.pop_back();
+        REQUIRE_FALSE(sample.serializeJson(std::span<char>(buffer)).has_value());
+
+        const std::vector<uint8_t> expectedCbor = json::to_cbor(opentrackio::OpenTrackIOSample{sample}.getJson());
+        REQUIRE(sample.serializedCborSize() == expectedCbor.size());
+
+        std::vector<uint8_t> cbor(expectedCbor.size());
+        REQUIRE(sample.serializeCbor(std::span<uint8_t>(cbor)) == expectedCbor.size());
+        REQUIRE(cbor == expectedCbor);
+
+        cbor.pop_back();
+        REQUIRE_FALSE(sample.serializeCbor(std::span<uint8_t>(cbor)).has_value());
+
+        text.clear();
+        const opentrackio::tests::AllocationScope allocations;
+        sample.serializeJson(text);
+        sample.serializeCbor(std::span<uint8_t>(cbor));
+        REQUIRE(allocations.count() == 0);
+    }
+}
+
+TEST_CASE("getJson() regenerates only the sections marked dirty", "[json]")
+{
+    using opentrackio::SampleFields;
+
+    opentrackio::OpenTrackIOSample sample;
+    REQUIRE(sample.initialise(std::string_view(R"({
+        "static": {"camera": {"label": "A"}, "lens": {"make": "B"}, "tracker": {"serialNumber": "C"}},
+        "lens": {"encoders": {"focus": 0.1, "iris": 0.2, "zoom": 0.3}},
+        "tracker": {"status": "Optical Good"},
+        "sourceNumber": 1,
+        "transforms": [{"translation": {"x": 1, "y": 2, "z": 3}, "rotation": {"pan": 1, "tilt": 2, "roll": 3}}]
+    })")));
+
+    const auto expectCurrent = [&]()
+    {
+        std::string expected;
+        sample.serializeJson(expected);
+        REQUIRE(sample.getJson().dump() == expected);
+    };
+
+    expectCurrent();
+    const nlohmann::json* cameraJson = &sample.getJson().at("static").at("camera");
+
+    sample.transforms->transforms[0].translation.x = 4;
+    sample.sourceNumber->value = 2;
+    sample.lens->encoders->focus = 0.5;
+    sample.markDirty(SampleFields::TRANSFORMS | SampleFields::SOURCE_NUMBER | SampleFields::LENS_ENCODERS);
+    expectCurrent();
+    REQUIRE(&sample.getJson().at("static").at("camera") == cameraJson);
+    REQUIRE(sample.getJson().at("static").at("lens").at("make") == "B");
+
+    // Sections that are unset are removed, along with the static object once nothing is left in it.
+    sample.camera = std::nullopt;
+    sample.lens = std::nullopt;
+    sample.markDirty(SampleFields::CAMERA | SampleFields::LENS);
+    expectCurrent();
+
+    sample.tracker = std::nullopt;
+    sample.markDirty(SampleFields::TRACKER);
+    expectCurrent();
+    REQUIRE_FALSE(sample.getJson().contains("static"));
+
+    sample.sourceNumber = std::nullopt;
+    sample.transforms = std::nullopt;
+    sample.markDirty(SampleFields::ALL);
+    REQUIRE(sample.getJson().is_null());
+
+    sample.globalStage = opentrackio::opentrackioproperties::GlobalStage{1.0, 2.0, 3.0, 4.0, 5.0, 6.0};
+    sample.markDirty(SampleFields::GLOBAL_STAGE);
+    expectCurrent();
+
+    // The mutate accessors mark their section themselves, with no markDirty() call.
+    sample.mutateGlobalStage()->e = 7.0;
+    expectCurrent();
+    REQUIRE(sample.getJson().at("globalStage").at("E") == 7.0);
+
+    sample.mutateLens() = opentrackio::opentrackioproperties::Lens{};
+    sample.mutateLens()->custom = opentrackio::opentrackioproperties::Lens::Coefficients{1.0, 2.0};
+    expectCurrent();
+    REQUIRE(sample.getJson().at("lens").at("custom") == nlohmann::json{1.0, 2.0});
+
+    sample.mutateSourceNumber() = opentrackio::opentrackioproperties::SourceNumber{3};
+    expectCurrent();
+    REQUIRE(sample.getJson().at("sourceNumber") == 3);
+}
+
+#ifdef OPENTRACKIO_PMR
+TEST_CASE("OpenTrackIOSample allocates its properties from its memory resource", "[init][pmr]")
+{
+    const std::string_view text = R"({
+        "static": {
+            "camera": {"label": "A camera label long enough to leave the string", "make": "A camera maker with a long name"},
+            "lens": {"make": "A lens maker with a long name", "calibrationHistory": ["A calibration with a long name"]},
+            "tracker": {"serialNumber": "A tracker serial number with a long name"}
+        },
+        "lens": {"custom": [1.0, 2.0], "distortion": [{"radial": [1.0, 2.0, 3.0], "tangential": [1.0, 2.0], "model": "A distortion model with a long name"}]},
+        "protocol": {"name": "OpenTrackIO with a name long enough", "version": [1, 0, 1]},
+        "relatedSampleIds": ["urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a34"],
+        "sourceId": "urn:uuid:5ca5f233-11b5-dead-beef-948d73e48a33",
+        "timing": {"synchronization": {"locked": true, "source": "ptp", "present": true, "ptp": {
+            "profile": "IEEE Std 1588-2019", "domain": 1, "leaderIdentity": "00:11:22:33:44:55", "leaderAccuracy": 5e-08,
+            "leaderPriorities": {"priority1": 128, "priority2": 128}, "meanPathDelay": 0.000123
+        }}},
+        "tracker": {"notes": "Notes long enough to leave the string buffer"},
+        "transforms": [{"translation": {"x": 1, "y": 2, "z": 3}, "rotation": {"pan": 1, "tilt": 2, "roll": 3}, "id": "A transform id with a long name"}]
+    })";
+    const std::vector<uint8_t> cbor = json::to_cbor(json::parse(text));
+
+    std::vector<std::byte> buffer(64 * 1024);
+    std::pmr::monotonic_buffer_resource resource{buffer.data(), buffer.size(), std::pmr::null_memory_resource()};
+
+    const auto expectIn = [](const opentrackio::OpenTrackIOSample& sample, std::pmr::memory_resource* expected)
+    {
+        const auto in = [&](const auto& value) { return value.get_allocator().resource() == expected; };
+        REQUIRE(in(*sample.lens->custom));
+        REQUIRE(in(*sample.lens->distortion));
+        REQUIRE(in(sample.lens->distortion->front().radial));
+        REQUIRE(in(*sample.lens->distortion->front().tangential));
+        REQUIRE(in(*sample.lens->distortion->front().model));
+        REQUIRE(in(sample.protocol->name));
+        REQUIRE(in(sample.protocol->version));
+        REQUIRE(in(sample.relatedSampleIds->samples));
+        REQUIRE(in(sample.timing->synchronization->ptp->leaderIdentity));
+        REQUIRE(in(*sample.tracker->notes));
+        REQUIRE(in(sample.transforms->transforms));
+        REQUIRE(in(*sample.transforms->transforms.front().id));
+    };
+
+    {
+        opentrackio::OpenTrackIOSample sample{&resource};
+        REQUIRE(sample.initialise(text));
+        expectIn(sample, &resource);
+
+        // Parsing again refills the same storage, and the static block found in the cache is assigned to it.
+        REQUIRE(sample.initialise(std::span<const uint8_t>(cbor)));
+        REQUIRE(sample.initialise(std::span<const uint8_t>(cbor)));
+        REQUIRE(sample.getStaticCacheStats().hits == 1);
+        expectIn(sample, &resource);
+        REQUIRE(sample.getJson() == json::parse(text));
+
+        const opentrackio::OpenTrackIOSample copy{sample};
+        expectIn(copy, std::pmr::get_default_resource());
+
+        // Properties held copy-on-write can be shared with other samples, so they never use the resource.
+        const auto& calibrationHistory = sample.lens->calibrationHistory;
+        REQUIRE(calibrationHistory->get_allocator().resource() == std::pmr::get_default_resource());
+        REQUIRE(calibrationHistory->front().get_allocator().resource() == std::pmr::get_default_resource());
+    }
+    resource.release();
+}
+#endif
+
+TEST_CASE("getJson(JsonArena&) generates the same JSON from an arena", "[json]")
+{
+    opentrackio::OpenTrackIOSample sample;
+    REQUIRE(sample.initialise(std::string_view(R"({
+        "static": {"camera": {"label": "A", "make": "A camera maker with a long name"}, "duration": {"num": 1, "denom": 25}},
+        "lens": {"encoders": {"focus": 0.1, "iris": 0.2, "zoom": 0.3}, "distortion": [{"radial": [1, 2, 3]}]},
+        "timing": {"mode": "internal", "sampleTimestamp": {"seconds": 1, "nanoseconds": 2}},
+        "transforms": [{"translation": {"x": 1, "y": 2, "z": 3}, "rotation": {"pan": 1, "tilt": 2, "roll": 3}}]
+    })")));
+    const std::string expected = sample.getJson().dump();
+
+    opentrackio::JsonArena arena{1024};
+    {
+        const opentrackio::ArenaJson json = sample.getJson(arena);
+        REQUIRE(std::string_view{json.dump()} == expected);
+        REQUIRE(arena.stats().allocations > 0);
+        REQUIRE(opentrackio::JsonArena::current() == nullptr);
+    }
+    arena.reset();
+
+    // Once the arena has grown to fit, generating into it again doesn't touch the heap.
+    const auto blocks = arena.stats().blocks;
+    {
+        std::optional<opentrackio::ArenaJson> json;
+        {
+            const opentrackio::tests::AllocationScope allocations;
+            json = sample.getJson(arena);
+            REQUIRE(allocations.count() == 0);
+        }
+        json.reset();
+        arena.reset();
+    }
+    REQUIRE(arena.stats().blocks == blocks);
+    REQUIRE(arena.stats().resets == 2);
+
+    // Nodes added outside of a scope come from the heap and are freed as usual alongside the arena's.
+    opentrackio::ArenaJson json = sample.getJson(arena);
+    json["sourceNumber"] = 3;
+    json["static"]["camera"]["label"] = "A label too long for the small string buffer";
+    json.erase("transforms");
+    REQUIRE(json.at("static").at("camera").at("label") == "A label too long for the small string buffer");
+    json = nullptr;
+    arena.reset();
+}
+
+TEST_CASE("DynamicFrames hold the per-frame fields of a sample", "[frame]")
+{
+    constexpr std::string_view text = R"({
+        "sampleId": "urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a33",
+        "sourceId": "urn:uuid:5ca5f233-11b5-dead-beef-948d73e48a33",
+        "sourceNumber": 3,
+        "timing": {"sampleTimestamp": {"seconds": 1718806554, "nanoseconds": 500000000}, "sequenceNumber": 7},
+        "lens": {
+            "encoders": {"focus": 0.1, "iris": 0.2, "zoom": 0.3}, "rawEncoders": {"focus": 1000, "iris": 2000, "zoom": 3000},
+            "pinholeFocalLength": 24.305, "focusDistance": 10.0, "fStop": 4.0, "tStop": 4.1,
+            "distortionOffset": {"x": 1.0, "y": 2.0}, "projectionOffset": {"x": 0.1, "y": 0.2},
+            "distortion": [{"model": "Brown-Conrady D-U", "radial": [1.0, 2.0, 3.0], "tangential": [1.0, 2.0], "overscan": 1.1},
+                           {"radial": [1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0]}]
+        },
+        "transforms": [
+            {"translation": {"x": 1.0, "y": 2.0, "z": 3.0}, "rotation": {"pan": 180.0, "tilt": 90.0, "roll": 45.0}, "id": "Dolly"},
+            {"translation": {"x": 1.0, "y": 2.0, "z": 3.0}, "rotation": {"pan": 1.0, "tilt": 2.0, "roll": 3.0},
+             "scale": {"x": 1.0, "y": 2.0, "z": 3.0}}
+        ]
+    })";
+
+    opentrackio::OpenTrackIOSample sample;
+    REQUIRE(sample.initialise(text));
+
+    opentrackio::DynamicFrame frame{};
+    REQUIRE(frame.assign(sample));
+    REQUIRE(frame.has(opentrackio::FrameFields::SAMPLE_TIMESTAMP | opentrackio::FrameFields::SEQUENCE_NUMBER));
+    REQUIRE_FALSE(frame.has(opentrackio::FrameFields::RECORDED_TIMESTAMP));
+    REQUIRE(frame.encoders.iris == 0.2);
+    REQUIRE_FALSE(frame.has(opentrackio::FrameFields::ENTRANCE_PUPIL_OFFSET));
+    REQUIRE(frame.distortionCount == 2);
+    REQUIRE(frame.distortions[0].model.view() == "Brown-Conrady D-U");
+    REQUIRE(frame.distortions[1].radial.count == 8);
+    REQUIRE(frame.transformView().size() == 2);
+    REQUIRE(frame.transforms[0].id.view() == "Dolly");
+    REQUIRE_FALSE(frame.transforms[1].id.present);
+
+    // Frames are plain bytes, e.g. for a ring buffer, and come back to the same sample.
+    opentrackio::DynamicFrame copy;
+    std::memcpy(&copy, &frame, sizeof(frame));
+    opentrackio::OpenTrackIOSample applied;
+    copy.applyTo(applied);
+    REQUIRE(applied.getJson() == sample.getJson());
+
+    // Applying leaves the static properties alone and drops per-frame fields the frame doesn't have.
+    opentrackio::OpenTrackIOSample withStatic;
+    REQUIRE(withStatic.initialise(std::string_view(R"({"static": {"lens": {"make": "LensMaker"}, "camera": {"label": "A"}},
+                                                       "lens": {"tStop": 2.0, "custom": [1.0]}, "tracker": {"notes": "n"}})")));
+    withStatic.getJson();
+    copy.applyTo(withStatic);
+    REQUIRE(withStatic.camera->label == "A");
+    REQUIRE(withStatic.lens->make == "LensMaker");
+    REQUIRE(withStatic.lens->custom == opentrackio::opentrackioproperties::Lens::Coefficients{1.0});
+    REQUIRE(withStatic.lens->tStop == 4.1);
+    REQUIRE(withStatic.getJson()["lens"]["tStop"] == 4.1);
+    REQUIRE(withStatic.getJson()["transforms"] == sample.getJson()["transforms"]);
+
+    opentrackio::DynamicFrame empty{};
+    empty.applyTo(withStatic);
+    REQUIRE_FALSE(withStatic.transforms.has_value());
+    REQUIRE_FALSE(withStatic.lens->tStop.has_value());
+    REQUIRE(withStatic.lens->make == "LensMaker");
+
+    // The decoder parses only the per-frame properties, and doesn't allocate for CBOR once warmed up.
+    const std::vector<uint8_t> cbor = json::to_cbor(json::parse(text));
+    opentrackio::DynamicFrameDecoder decoder;
+    opentrackio::DynamicFrame decoded{};
+    REQUIRE(decoder.decode(text, decoded));
+    REQUIRE(decoder.decode(std::span<const uint8_t>(cbor), decoded));
+    {
+        const opentrackio::tests::AllocationScope allocations;
+        REQUIRE(decoder.decode(std::span<const uint8_t>(cbor), decoded));
+        REQUIRE(allocations.count() == 0);
+    }
+    opentrackio::OpenTrackIOSample fromDecoded;
+    decoded.applyTo(fromDecoded);
+    REQUIRE(fromDecoded.getJson() == sample.getJson());
+
+    // Samples that don't fit are refused rather than truncated.
+    opentrackio::OpenTrackIOSample tooLong{sample};
+    tooLong.transforms->transforms[0].id = opentrackio::opentrackiotypes::String(opentrackio::DynamicFrame::MAX_STRING_LENGTH + 1, 'a');
+    REQUIRE_FALSE(frame.assign(tooLong));
+    REQUIRE(frame.present == opentrackio::FrameFields::NONE);
+
+    opentrackio::OpenTrackIOSample tooMany{sample};
+    tooMany.lens->distortion->at(1).radial.push_back(9.0);
+    REQUIRE_FALSE(frame.assign(tooMany));
+
+    REQUIRE_FALSE(decoder.decode(std::string_view(R"({"transforms": 1})"), decoded));
+    REQUIRE_FALSE(decoder.getParseErrors().empty());
+}
+
+TEST_CASE("getJson() is generated once for concurrent readers", "[json][threads]")
+{
+    // Most useful when built with -DOPENTRACKIO_SANITIZE_THREADS=ON.
+    constexpr int READERS = 4;
+    constexpr int ROUNDS = 50;
+
+    opentrackio::OpenTrackIOSample sample;
+    REQUIRE(sample.initialise(std::string_view(R"({
+        "static": {"camera": {"label": "A", "make": "A camera maker with a long name"}},
+        "lens": {"encoders": {"focus": 0.1, "iris": 0.2, "zoom": 0.3}},
+        "timing": {"mode": "internal", "sampleTimestamp": {"seconds": 1, "nanoseconds": 2}},
+        "transforms": [{"translation": {"x": 1, "y": 2, "z": 3}, "rotation": {"pan": 1, "tilt": 2, "roll": 3}}]
+    })")));
+
+    for (int round = 0; round < ROUNDS; ++round)
+    {
+        // Alternate between regenerating one section and the whole of the JSON.
+        sample.transforms->transforms[0].translation.x = round;
+        sample.markDirty(round % 2 == 0 ? opentrackio::SampleFields::TRANSFORMS : opentrackio::SampleFields::ALL);
+
+        std::string expected;
+        sample.serializeJson(expected);
+
+        std::atomic<int> mismatches = 0;
+        std::atomic<bool> start = false;
+        std::vector<std::thread> readers;
+        for (int i = 0; i < READERS; ++i)
+        {
+            readers.emplace_back([&, i]()
+            {
+                while (!start.load())
+                {
+                    std::this_thread::yield();
+                }
+
+                const nlohmann::json* first = &sample.getJson();
+                for (int read = 0; read < 20; ++read)
+                {
+                    // Copying reads the cache too, the copy takes the JSON with it.
+                    if (i == 0)
+                    {
+                        const opentrackio::OpenTrackIOSample copy{sample};
+                        mismatches += copy.getJson().dump() != expected;
+                        continue;
+                    }
+
+                    const nlohmann::json& json = sample.getJson();
+                    mismatches += &json != first || json.dump() != expected;
+                }
+            });
+        }
+
+        start = true;
+        for (std::thread& reader : readers)
+        {
+            reader.join();
+        }
+        REQUIRE(mismatches == 0);
+    }
+}
+
+TEST_CASE("Pattern validators accept exactly what the schema regexes accept", "[validate]")
+{
+    const std::regex urnPattern{R"(^urn:uuid:[0-9a-f]{8}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{4}-[0-9a-f]{12}$)"};
+    const std::regex macPattern{R"((?:^[0-9a-f]{2}(?::[0-9a-f]{2}){5}$)|(?:^[0-9a-f]{2}(?:-[0-9a-f]{2}){5}$))"};
+
+    // Every single character substitution, deletion and insertion of valid strings.
+    const std::string substitutes = std::string("09afAFg-:/ \n") + '\0' + '\x7f' + '\x80' + '\xb0' + '\xff';
+    std::vector<std::string> candidates = {"", "urn:uuid:", "00:11:22:33:44:55:", "0:11:22:33:44:55"};
+    for (const std::string valid : {"urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a33",
+                                    "00:11:22:33:44:55",
+                                    "aa-bb-cc-dd-ee-ff"})
+    {
+        candidates.push_back(valid);
+        for (std::size_t i = 0; i <= valid.size(); ++i)
+        {
+            for (const char c : substitutes)
+            {
+                if (i < valid.size())
+                {
+                    std::string substituted = valid;
+                    substituted[i] = c;
+                    candidates.push_back(substituted);
+                }
+                candidates.push_back(std::string(valid).insert(i, 1, c));
+            }
+
+            if (i < valid.size())
+            {
+                candidates.push_back(std::string(valid).erase(i, 1));
+            }
+        }
+    }
+
+    for (const std::string& candidate : candidates)
+    {
+        INFO(candidate);
+        const bool isUrn = std::regex_match(candidate, urnPattern);
+        REQUIRE(opentrackio::opentrackiovalidation::isUrnUuid(candidate) == isUrn);
+        REQUIRE(opentrackio::opentrackiovalidation::isMacAddress(candidate) == std::regex_match(candidate, macPattern));
+
+        const std::optional<opentrackio::opentrackiotypes::Uuid> uuid = opentrackio::opentrackiotypes::Uuid::fromUrn(candidate);
+        REQUIRE(uuid.has_value() == isUrn);
+        if (uuid.has_value())
+        {
+            REQUIRE(uuid->toUrn() == candidate);
+        }
+    }
+}
+
+TEST_CASE("Uuids compare, order and hash like their URNs", "[types]")
+{
+    using opentrackio::opentrackiotypes::Uuid;
+
+    const std::vector<std::string> urns = {
+        "urn:uuid:00000000-0000-0000-0000-000000000000",
+        "urn:uuid:00000000-0000-0000-0000-0000000000ff",
+        "urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a33",
+        "urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a34",
+        "urn:uuid:5ca5f233-11b5-dead-beef-948d73e48a33",
+        "urn:uuid:ffffffff-ffff-ffff-ffff-ffffffffffff",
+    };
+
+    std::unordered_map<Uuid, std::size_t> indices{};
+    for (std::size_t i = 0; i < urns.size(); ++i)
+    {
+        const Uuid uuid = Uuid::fromUrn(urns[i]).value();
+        indices.emplace(uuid, i);
+
+        for (std::size_t j = 0; j < urns.size(); ++j)
+        {
+            const Uuid other = Uuid::fromUrn(urns[j]).value();
+            REQUIRE((uuid == other) == (i == j));
+            REQUIRE((uuid < other) == (urns[i] < urns[j]));
+        }
+    }
+
+    REQUIRE(indices.size() == urns.size());
+    REQUIRE(indices.at(Uuid::fromUrn(urns[2]).value()) == 2);
+}
+
+TEST_CASE("SmallVectors keep short arrays inline and allocate past them", "[types]")
+{
+    using Chain = opentrackio::opentrackioproperties::Transforms::Chain;
+    using Coefficients = opentrackio::opentrackioproperties::Lens::Coefficients;
+    using String = opentrackio::opentrackiotypes::String;
+
+    Coefficients radial{1.0, 2.0, 3.0};
+    REQUIRE(radial.size() == 3);
+    REQUIRE(radial.capacity() == Coefficients::INLINE_CAPACITY);
+    REQUIRE_FALSE(radial.isSpilled());
+
+    {
+        const opentrackio::tests::AllocationScope allocations;
+        Coefficients copy{radial};
+        Coefficients moved{std::move(copy)};
+        moved.resize(Coefficients::INLINE_CAPACITY);
+        REQUIRE(moved == Coefficients{1.0, 2.0, 3.0, 0.0, 0.0, 0.0});
+        REQUIRE(allocations.count() == 0);
+    }
+
+    for (double k = 4.0; k <= 8.0; ++k)
+    {
+        radial.push_back(k);
+    }
+    REQUIRE(radial.isSpilled());
+    REQUIRE(radial == Coefficients{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0});
+
+    // Spilled storage is handed over by a move, inline elements are moved one by one.
+    const double* storage = radial.data();
+    Coefficients moved{std::move(radial)};
+    REQUIRE(moved.data() == storage);
+    REQUIRE(radial.empty());
+    REQUIRE_FALSE(radial.isSpilled());
+
+    radial = moved;
+    REQUIRE(radial == moved);
+    REQUIRE(radial.data() != moved.data());
+
+    // Elements that are themselves allocated survive being moved out of the inline storage.
+    Chain chain{};
+    for (int i = 0; i < 5; ++i)
+    {
+        chain.emplace_back().id = String(32, static_cast<char>('a' + i));
+        chain.push_back(chain.front());
+    }
+    REQUIRE(chain.size() == 10);
+    REQUIRE(chain.isSpilled());
+    REQUIRE(chain[8].id == String(32, 'e'));
+    REQUIRE(chain[9].id == String(32, 'a'));
+
+    REQUIRE(json(Coefficients{1.0, 2.0}) == json::array({1.0, 2.0}));
+    REQUIRE(json::array({1.0, 2.0, 3.0}).get<Coefficients>() == Coefficients{1.0, 2.0, 3.0});
+}
+
+TEST_CASE("Static metadata strings are interned", "[types][threads]")
+{
+    using opentrackio::opentrackiotypes::InternedString;
+    using opentrackio::opentrackiotypes::StringPool;
+
+    const std::string_view text = R"({
+        "static": {
+            "camera": {"label": "A", "make": "An interned camera maker", "model": "An interned camera model"},
+            "lens": {"make": "An interned lens maker", "serialNumber": "An interned lens serial number"},
+            "tracker": {"make": "An interned tracker maker", "firmwareVersion": "1.2.3"}
+        },
+        "tracker": {"notes": "Notes aren't interned"}
+    })";
+    const std::vector<uint8_t> cbor = json::to_cbor(json::parse(text));
+
+    opentrackio::OpenTrackIOSample fromText;
+    opentrackio::OpenTrackIOSample fromCbor;
+    opentrackio::OpenTrackIOSample fromDom;
+    REQUIRE(fromText.initialise(text));
+    REQUIRE(fromCbor.initialise(std::span<const uint8_t>(cbor)));
+    REQUIRE(fromDom.initialise(json::parse(text)));
+
+    // Every path hands out the same string, so metadata compares by pointer.
+    REQUIRE(fromText.camera->make == "An interned camera maker");
+    REQUIRE(fromText.camera->make->data() == fromCbor.camera->make->data());
+    REQUIRE(fromText.camera->make->data() == fromDom.camera->make->data());
+    REQUIRE(fromText.lens->serialNumber == fromDom.lens->serialNumber);
+    REQUIRE(fromText.tracker->make == fromCbor.tracker->make);
+    REQUIRE(fromText.camera->make != fromText.camera->model);
+    REQUIRE(fromText.getJson() == json::parse(text));
+    REQUIRE(fromCbor.getJson() == json::parse(text));
+
+    StringPool pool;
+    const InternedString first = pool.intern("A lens maker");
+    REQUIRE(pool.size() == 1);
+    {
+        const opentrackio::tests::AllocationScope allocations;
+        REQUIRE(pool.intern(std::string_view("A lens maker")) == first);
+        REQUIRE(allocations.count() == 0);
+    }
+    REQUIRE(pool.intern("Another lens maker") != first);
+    REQUIRE(pool.size() == 2);
+    REQUIRE(pool.intern("").empty());
+    REQUIRE(pool.intern("") == InternedString{});
+
+    // Threads interning the same strings all get the one entry for each.
+    constexpr int threadCount = 8;
+    constexpr int stringCount = 64;
+    std::vector<std::vector<InternedString>> results(threadCount);
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&pool, &results, t]
+            {
+                for (int i = 0; i < stringCount; ++i)
+                {
+                    results[t].push_back(pool.intern("Serial number " + std::to_string((i * 7 + t) % stringCount)));
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+    REQUIRE(pool.size() == 2 + stringCount);
+    for (int t = 0; t < threadCount; ++t)
+    {
+        for (int i = 0; i < stringCount; ++i)
+        {
+            const std::string expected = "Serial number " + std::to_string((i * 7 + t) % stringCount);
+            REQUIRE(results[t][i] == expected);
+            REQUIRE(results[t][i] == pool.intern(expected));
+        }
+    }
+
+    // A pool that is full hands out strings that aren't pooled, which still compare by their contents.
+    REQUIRE(StringPool::global().capacity() == StringPool::DEFAULT_CAPACITY);
+    StringPool small{16};
+    const InternedString pooled = small.intern("Twelve bytes");
+    const InternedString unpooled = small.intern("Nine more");
+    REQUIRE(pooled.isPooled());
+    REQUIRE_FALSE(unpooled.isPooled());
+    REQUIRE(small.size() == 1);
+    REQUIRE(small.bytes() == 12);
+    REQUIRE(unpooled == "Nine more");
+    REQUIRE(unpooled == small.intern("Nine more"));
+    REQUIRE(unpooled.data() != small.intern("Nine more").data());
+    REQUIRE(unpooled != pooled);
+    REQUIRE(small.intern("Twelve bytes").data() == pooled.data());
+    REQUIRE(small.intern("Four").isPooled());
+    REQUIRE(small.bytes() == 16);
+
+    small.setCapacity(0);
+    REQUIRE_FALSE(small.intern("More").isPooled());
+    REQUIRE(small.intern("Four").isPooled());
+    REQUIRE(small.size() == 2);
+}
+
+TEST_CASE("Copies of a sample share its static properties until one of them writes to them", "[types][threads]")
+{
+    using opentrackio::opentrackiotypes::InternedString;
+
+    const std::string_view text = R"({
+        "static": {
+            "camera": {"label": "A", "fdlLink": "urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a33", "isoSpeed": 800},
+            "lens": {"calibrationHistory": ["A calibration with a long enough name", "B"]}
+        },
+        "sourceId": "urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a34",
+        "sourceNumber": 1
+    })";
+    const auto cameraOf = [](const opentrackio::OpenTrackIOSample& sample) { return &sample.camera.value(); };
+
+    opentrackio::OpenTrackIOSample sample;
+    REQUIRE(sample.initialise(text));
+    REQUIRE_FALSE(sample.camera.isShared());
+
+    opentrackio::OpenTrackIOSample copy{sample};
+    REQUIRE(cameraOf(copy) == cameraOf(sample));
+    REQUIRE(copy.camera.isShared());
+    REQUIRE(&copy.lens->calibrationHistory.value() == &sample.lens->calibrationHistory.value());
+
+    // Reading through a handle that isn't const neither copies nor allocates.
+    {
+        const opentrackio::tests::AllocationScope allocations;
+        REQUIRE(copy.camera->label == "A");
+        REQUIRE(copy.camera.value().isoSpeed == 800);
+        REQUIRE((*copy.lens).calibrationHistory->size() == 2);
+        REQUIRE(allocations.count() == 0);
+    }
+    REQUIRE(copy.camera.isShared());
+    REQUIRE(cameraOf(copy) == cameraOf(sample));
+
+    // Writing detaches the copy, leaving the sample as it was.
+    copy.camera.mutate().label = InternedString::intern("B");
+    copy.markDirty(opentrackio::SampleFields::CAMERA);
+    REQUIRE(cameraOf(copy) != cameraOf(sample));
+    REQUIRE_FALSE(sample.camera.isShared());
+    REQUIRE(sample.camera->label == "A");
+    REQUIRE(copy.camera->isoSpeed == 800);
+    REQUIRE(copy.getJson()["static"]["camera"]["label"] == "B");
+    REQUIRE(sample.getJson()["static"]["camera"]["label"] == "A");
+
+    // A camera that isn't shared is kept when unset, for the next one to be assigned into.
+    const opentrackio::opentrackioproperties::Camera* kept = cameraOf(copy);
+    copy.camera = std::nullopt;
+    REQUIRE_FALSE(copy.camera.has_value());
+    REQUIRE(copy.camera == std::nullopt);
+    copy.camera.emplace();
+    REQUIRE(cameraOf(copy) == kept);
+    REQUIRE_FALSE(copy.camera->label.has_value());
+
+    // Once the static object of the source is cached, every sample parsed from it shares the block's camera.
+    REQUIRE(sample.initialise(text));
+    const auto block = sample.getStaticBlock();
+    REQUIRE(block != nullptr);
+    REQUIRE(cameraOf(sample) == &block->camera.value());
+    REQUIRE(&sample.lens->calibrationHistory.value() == &block->lens->calibrationHistory.value());
+    REQUIRE(block->lens->calibrationHistory == opentrackio::opentrackiotypes::Vector<opentrackio::opentrackiotypes::String>{
+        "A calibration with a long enough name", "B"});
+    REQUIRE(sample.camera->fdlLink == block->camera->fdlLink);
+    opentrackio::OpenTrackIOSample cborSample;
+    const std::vector<uint8_t> cbor = json::to_cbor(json::parse(text));
+    REQUIRE(cborSample.initialise(std::span<const uint8_t>(cbor)));
+    REQUIRE(cborSample.initialise(std::span<const uint8_t>(cbor)));
+    REQUIRE(cameraOf(cborSample) == &cborSample.getStaticBlock()->camera.value());
+
+    // Threads copying the sample and writing to their copies never see each other's writes.
+    constexpr int threadCount = 8;
+    constexpr int copyCount = 256;
+    std::atomic<int> mismatches = 0;
+    {
+        std::vector<std::thread> threads;
+        for (int t = 0; t < threadCount; ++t)
+        {
+            threads.emplace_back([&sample, &mismatches, t]
+            {
+                const InternedString label = InternedString::intern("Thread " + std::to_string(t));
+                for (int i = 0; i < copyCount; ++i)
+                {
+                    opentrackio::OpenTrackIOSample mine{sample};
+                    opentrackio::opentrackioproperties::Camera& camera = mine.camera.mutate();
+                    camera.label = label;
+                    camera.isoSpeed = t;
+                    if (mine.camera->label != label || mine.camera->isoSpeed != t)
+                    {
+                        ++mismatches;
+                    }
+                }
+            });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+    }
+    REQUIRE(mismatches == 0);
+    REQUIRE(sample.camera->label == "A");
+    REQUIRE(block->camera->isoSpeed == 800);
+}
+
+TEST_CASE("Packets frame payloads in the OpenTrackIO transport header", "[packet]")
+{
+    using opentrackio::PacketError;
+    using opentrackio::PacketHeader;
+    using opentrackio::PayloadEncoding;
+
+    const auto bytes = [](std::string_view text)
+    {
+        return std::span<const uint8_t>(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+    };
+
+    const std::string_view text = R"({
+        "sampleId": "urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a33",
+        "sourceId": "urn:uuid:5ca5f233-11b5-dead-beef-948d73e48a33",
+        "timing": {"sampleTimestamp": {"seconds": 1718806554, "nanoseconds": 500000000}, "sequenceNumber": 7},
+        "lens": {"encoders": {"focus": 0.1, "iris": 0.2, "zoom": 0.3}}
+    })";
+
+    opentrackio::OpenTrackIOSample expected;
+    REQUIRE(expected.initialise(text));
+
+    SECTION("Fletcher-16 matches the reference values and the byte-at-a-time loop")
+    {
+        REQUIRE(opentrackio::Fletcher16::compute(bytes("abcde")) == 0xC8F0);
+        REQUIRE(opentrackio::Fletcher16::compute(bytes("abcdef")) == 0x2057);
+        REQUIRE(opentrackio::Fletcher16::compute(bytes("abcdefgh")) == 0x0627);
+        REQUIRE(opentrackio::fletcher16Scalar(bytes("abcdefgh")) == 0x0627);
+
+        // All 0xFF is the worst case for the deferred modulo, the rest cover every tail length and block count.
+        std::vector<uint8_t> data(40000, 0xFF);
+        REQUIRE(opentrackio::Fletcher16::compute(data) == opentrackio::fletcher16Scalar(data));
+
+        uint32_t state = 12345;
+        for (uint8_t& byte : data)
+        {
+            state = state * 1103515245u + 12345u;
+            byte = static_cast<uint8_t>(state >> 16);
+        }
+        for (std::size_t size = 0; size < 4200; size += (size < 300 ? 1 : 97))
+        {
+            const std::span<const uint8_t> prefix(data.data(), size);
+            REQUIRE(opentrackio::Fletcher16::compute(prefix) == opentrackio::fletcher16Scalar(prefix));
+        }
+
+        opentrackio::Fletcher16 running;
+        const std::span<const uint8_t> all(data);
+        running.update(all.first(7));
+        running.update(all.subspan(7, 2049));
+        running.update(all.subspan(2056));
+        REQUIRE(running.value() == opentrackio::fletcher16Scalar(all));
+    }
+
+    SECTION("A packet round-trips and its payload parses with the initialise() for its encoding")
+    {
+        PacketHeader header{};
+        header.encoding = PayloadEncoding::JSON;
+        header.sequenceNumber = 0x1234;
+
+        std::vector<uint8_t> datagram(PacketHeader::SIZE + text.size());
+        REQUIRE(opentrackio::encodePacket(header, bytes(text), datagram) == datagram.size());
+        REQUIRE_FALSE(opentrackio::encodePacket(header, bytes(text), std::span(datagram).first(datagram.size() - 1)));
+
+        REQUIRE(std::memcmp(datagram.data(), "OTrk", 4) == 0);
+        REQUIRE(datagram[4] == 0x00);
+        REQUIRE(datagram[5] == 0x01);
+        REQUIRE(datagram[6] == 0x12);
+        REQUIRE(datagram[7] == 0x34);
+        REQUIRE(datagram[12] == (0x80 | (text.size() >> 8)));
+        REQUIRE(datagram[13] == (text.size() & 0xFF));
+
+        opentrackio::Packet packet{};
+        {
+            const opentrackio::tests::AllocationScope allocations;
+            REQUIRE(opentrackio::decodePacket(datagram, packet) == PacketError::NONE);
+            REQUIRE(allocations.count() == 0);
+        }
+        REQUIRE(packet.header.sequenceNumber == 0x1234);
+        REQUIRE(packet.header.lastSegment);
+        REQUIRE(packet.header.isComplete());
+        REQUIRE(packet.header.payloadLength == text.size());
+        REQUIRE(packet.payload.data() == datagram.data() + PacketHeader::SIZE);
+
+        opentrackio::OpenTrackIOSample sample;
+        REQUIRE(opentrackio::initialiseFromPacket(sample, packet));
+        REQUIRE(sample.getJson() == expected.getJson());
+
+        std::vector<uint8_t> cbor(expected.serializedCborSize());
+        expected.serializeCbor(cbor);
+        header.encoding = PayloadEncoding::CBOR;
+        datagram.resize(PacketHeader::SIZE + cbor.size());
+        REQUIRE(opentrackio::encodePacket(header, cbor, datagram) == datagram.size());
+        REQUIRE(opentrackio::decodePacket(datagram, packet) == PacketError::NONE);
+        REQUIRE(packet.header.encoding == PayloadEncoding::CBOR);
+
+        opentrackio::OpenTrackIOSample fromCbor;
+        REQUIRE(opentrackio::initialiseFromPacket(fromCbor, packet));
+        REQUIRE(fromCbor.getJson() == expected.getJson());
+    }
+
+    SECTION("Malformed datagrams are rejected and leave the packet as it was")
+    {
+        std::vector<uint8_t> datagram(PacketHeader::SIZE + text.size());
+        REQUIRE(opentrackio::encodePacket(PacketHeader{}, bytes(text), datagram));
+
+        const auto decode = [](std::vector<uint8_t> corrupted)
+        {
+            opentrackio::Packet packet{};
+            packet.header.sequenceNumber = 99;
+            const PacketError error = opentrackio::decodePacket(corrupted, packet);
+            REQUIRE(packet.header.sequenceNumber == 99);
+            return error;
+        };
+
+        REQUIRE(decode({datagram.begin(), datagram.begin() + 15}) == PacketError::TOO_SHORT);
+
+        auto corrupted = datagram;
+        corrupted[0] = 'o';
+        REQUIRE(decode(corrupted) == PacketError::BAD_IDENTIFIER);
+
+        corrupted = datagram;
+        corrupted[5] = 0x03;
+        REQUIRE(decode(corrupted) == PacketError::UNKNOWN_ENCODING);
+
+        corrupted = datagram;
+        corrupted.push_back(0);
+        REQUIRE(decode(corrupted) == PacketError::LENGTH_MISMATCH);
+        REQUIRE(decode({datagram.begin(), datagram.end() - 1}) == PacketError::LENGTH_MISMATCH);
+
+        corrupted = datagram;
+        corrupted[PacketHeader::SIZE + 10] ^= 0x01;
+        REQUIRE(decode(corrupted) == PacketError::BAD_CHECKSUM);
+
+        corrupted = datagram;
+        corrupted[7] ^= 0x01;
+        REQUIRE(decode(corrupted) == PacketError::BAD_CHECKSUM);
+    }
+
+    SECTION("Payloads too large for a datagram are split into segments")
+    {
+        opentrackio::PacketSegmenter segmenter(PayloadEncoding::JSON, 7, bytes(text), 100);
+        REQUIRE(segmenter.segmentCount() == (text.size() + 83) / 84);
+
+        std::array<uint8_t, 100> datagram{};
+        REQUIRE_FALSE(segmenter.next(std::span(datagram).first(99)).has_value());
+
+        std::string reassembled;
+        std::size_t segments = 0;
+        while (!segmenter.done())
+        {
+            const std::optional<std::size_t> size = segmenter.next(datagram);
+            REQUIRE(size.has_value());
+
+            opentrackio::Packet packet{};
+            REQUIRE(opentrackio::decodePacket(std::span(datagram).first(*size), packet) == PacketError::NONE);
+            REQUIRE(packet.header.sequenceNumber == 7);
+            REQUIRE(packet.header.segmentOffset == reassembled.size());
+            REQUIRE(packet.header.lastSegment == segmenter.done());
+
+            opentrackio::OpenTrackIOSample sample;
+            REQUIRE_FALSE(opentrackio::initialiseFromPacket(sample, packet));
+
+            reassembled.append(reinterpret_cast<const char*>(packet.payload.data()), packet.payload.size());
+            ++segments;
+        }
+        REQUIRE(segments == segmenter.segmentCount());
+        REQUIRE(reassembled == text);
+        REQUIRE_FALSE(segmenter.next(datagram).has_value());
+
+        opentrackio::PacketSegmenter empty(PayloadEncoding::CBOR, 0, {});
+        REQUIRE(empty.segmentCount() == 1);
+        opentrackio::Packet packet{};
+        REQUIRE(opentrackio::decodePacket(std::span(datagram).first(*empty.next(datagram)), packet) == PacketError::NONE);
+        REQUIRE(packet.header.isComplete());
+        REQUIRE(packet.payload.empty());
+        REQUIRE(empty.done());
+    }
+}
+
+TEST_CASE("PacketReassembler reassembles segmented payloads", "[packet]")
+{
+    using opentrackio::Packet;
+    using opentrackio::PacketReassembler;
+    using opentrackio::PayloadEncoding;
+    using opentrackio::SegmentResult;
+
+    std::string text = R"({"sampleId": "urn:uuid:5ca5f233-11b5-4f43-8815-948d73e48a33", "tracker": {"notes": ")";
+    text.append(900, 'n');
+    text.append(R"("}, "lens": {"encoders": {"focus": 0.1, "iris": 0.2, "zoom": 0.3}}})");
+    const std::span<const uint8_t> payload(reinterpret_cast<const uint8_t*>(text.data()), text.size());
+
+    // The packets view the datagrams, which are kept here.
+    std::vector<std::vector<uint8_t>> datagrams;
+    const auto segment = [&datagrams](std::span<const uint8_t> payload, uint16_t sequenceNumber,
+                                      PayloadEncoding encoding = PayloadEncoding::JSON)
+    {
+        std::vector<Packet> packets;
+        opentrackio::PacketSegmenter segmenter(encoding, sequenceNumber, payload, 300);
+        datagrams.reserve(datagrams.size() + segmenter.segmentCount());
+        while (!segmenter.done())
+        {
+            std::vector<uint8_t>& datagram = datagrams.emplace_back(300);
+            datagram.resize(*segmenter.next(datagram));
+            REQUIRE(opentrackio::decodePacket(datagram, packets.emplace_back()) == opentrackio::PacketError::NONE);
+        }
+        return packets;
+    };
+
+    const std::vector<Packet> packets = segment(payload, 1);
+    REQUIRE(packets.size() == 4);
+
+    PacketReassembler::Clock::time_point now{};
+    PacketReassembler::Payload complete{};
+
+    const auto matches = [&text](const PacketReassembler::Payload& complete)
+    {
+        return std::string_view(reinterpret_cast<const char*>(complete.payload.data()), complete.payload.size()) == text;
+    };
+
+    SECTION("Whole packets pass straight through")
+    {
+        PacketReassembler reassembler;
+        std::vector<uint8_t> datagram(opentrackio::PacketHeader::SIZE + 10);
+        Packet packet{};
+        REQUIRE(opentrackio::encodePacket({}, payload.first(10), datagram));
+        REQUIRE(opentrackio::decodePacket(datagram, packet) == opentrackio::PacketError::NONE);
+        REQUIRE(reassembler.add(7, packet, now, complete) == SegmentResult::COMPLETE);
+        REQUIRE(complete.source == 7);
+        REQUIRE(complete.payload.data() == packet.payload.data());
+    }
+
+    SECTION("Segments complete the payload in any order without allocating")
+    {
+        const std::array<std::array<std::size_t, 4>, 4> orders{{{0, 1, 2, 3}, {3, 2, 1, 0}, {2, 0, 3, 1}, {3, 0, 1, 2}}};
+        for (const std::array<std::size_t, 4>& order : orders)
+        {
+            PacketReassembler reassembler;
+            std::array<SegmentResult, 4> results{};
+            {
+                const opentrackio::tests::AllocationScope allocations;
+                for (std::size_t i = 0; i < order.size(); ++i)
+                {
+                    results[i] = reassembler.add(1, packets[order[i]], now, complete);
+                }
+                REQUIRE(allocations.count() == 0);
+            }
+            REQUIRE(results == std::array{SegmentResult::PENDING, SegmentResult::PENDING, SegmentResult::PENDING,
+                                          SegmentResult::COMPLETE});
+            REQUIRE(matches(complete));
+            REQUIRE(complete.sequenceNumber == 1);
+            REQUIRE(complete.encoding == PayloadEncoding::JSON);
+            REQUIRE(reassembler.stats().completed == 1);
+
+            opentrackio::OpenTrackIOSample sample;
+            REQUIRE(opentrackio::initialiseFromPayload(sample, complete.encoding, complete.payload));
+            REQUIRE(sample.tracker->notes->size() == 900);
+        }
+    }
+
+    SECTION("Sources and sequence numbers are reassembled separately")
+    {
+        const std::vector<Packet> next = segment(payload, 2);
+
+        PacketReassembler reassembler;
+        for (std::size_t i = 0; i < 3; ++i)
+        {
+            REQUIRE(reassembler.add(1, packets[i], now, complete) == SegmentResult::PENDING);
+            REQUIRE(reassembler.add(2, packets[i], now, complete) == SegmentResult::PENDING);
+            REQUIRE(reassembler.add(1, next[i], now, complete) == SegmentResult::PENDING);
+        }
+        REQUIRE(reassembler.add(2, packets[3], now, complete) == SegmentResult::COMPLETE);
+        REQUIRE(complete.source == 2);
+        REQUIRE(matches(complete));
+        REQUIRE(reassembler.add(1, next[3], now, complete) == SegmentResult::COMPLETE);
+        REQUIRE(complete.sequenceNumber == 2);
+        REQUIRE(matches(complete));
+        REQUIRE(reassembler.add(1, packets[3], now, complete) == SegmentResult::COMPLETE);
+        REQUIRE(complete.sequenceNumber == 1);
+        REQUIRE(matches(complete));
+    }
+
+    SECTION("Duplicated and overlapping segments are dropped")
+    {
+        PacketReassembler reassembler;
+        REQUIRE(reassembler.add(1, packets[3], now, complete) == SegmentResult::PENDING);
+        REQUIRE(reassembler.add(1, packets[3], now, complete) == SegmentResult::DUPLICATE);
+        REQUIRE(reassembler.add(1, packets[1], now, complete) == SegmentResult::PENDING);
+        REQUIRE(reassembler.add(1, packets[1], now, complete) == SegmentResult::DUPLICATE);
+
+        // Shifted by a byte, cut short, or as JSON then CBOR.
+        Packet shifted = packets[0];
+        shifted.header.segmentOffset = 1;
+        REQUIRE(reassembler.add(1, shifted, now, complete) == SegmentResult::CONFLICTING);
+        Packet shortened = packets[0];
+        shortened.payload = shortened.payload.first(10);
+        REQUIRE(reassembler.add(1, shortened, now, complete) == SegmentResult::CONFLICTING);
+        Packet cbor = packets[0];
+        cbor.header.encoding = PayloadEncoding::CBOR;
+        REQUIRE(reassembler.add(1, cbor, now, complete) == SegmentResult::CONFLICTING);
+
+        // A segment past the last, or a second last segment elsewhere.
+        Packet past = packets[1];
+        past.header.segmentOffset = packets[3].header.segmentOffset + packets[1].header.payloadLength;
+        REQUIRE(reassembler.add(1, past, now, complete) == SegmentResult::CONFLICTING);
+        Packet lastAgain = packets[3];
+        lastAgain.header.segmentOffset = packets[2].header.segmentOffset;
+        REQUIRE(reassembler.add(1, lastAgain, now, complete) == SegmentResult::CONFLICTING);
+
+        REQUIRE(reassembler.add(1, packets[0], now, complete) == SegmentResult::PENDING);
+        REQUIRE(reassembler.add(1, packets[2], now, complete) == SegmentResult::COMPLETE);
+        REQUIRE(matches(complete));
+
+        // Late copies of the segments of a completed payload.
+        REQUIRE(reassembler.add(1, packets[0], now, complete) == SegmentResult::DUPLICATE);
+        REQUIRE(reassembler.stats().duplicates == 3);
+        REQUIRE(reassembler.stats().conflicting == 5);
+        REQUIRE(reassembler.stats().completed == 1);
+    }
+
+    SECTION("A last segment that doesn't line up with the others conflicts")
+    {
+        PacketReassembler reassembler;
+        Packet last = packets[3];
+        last.header.segmentOffset += 1;
+        REQUIRE(reassembler.add(1, last, now, complete) == SegmentResult::PENDING);
+        REQUIRE(reassembler.add(1, packets[0], now, complete) == SegmentResult::CONFLICTING);
+    }
+
+    SECTION("Payloads that don't fit a slot are dropped")
+    {
+        PacketReassembler reassembler(4, 512);
+        REQUIRE(reassembler.add(1, packets[0], now, complete) == SegmentResult::PENDING);
+        REQUIRE(reassembler.add(1, packets[3], now, complete) == SegmentResult::TOO_LARGE);
+        REQUIRE(reassembler.stats().tooLarge == 1);
+    }
+
+    SECTION("Incomplete payloads time out")
+    {
+        PacketReassembler reassembler(4, PacketReassembler::DEFAULT_MAX_PAYLOAD_SIZE, std::chrono::milliseconds(50));
+        REQUIRE(reassembler.add(1, packets[0], now, complete) == SegmentResult::PENDING);
+        REQUIRE(reassembler.add(1, packets[1], now, complete) == SegmentResult::PENDING);
+        REQUIRE(reassembler.expire(now + std::chrono::milliseconds(50)) == 0);
+        REQUIRE(reassembler.expire(now + std::chrono::milliseconds(51)) == 1);
+
+        now += std::chrono::milliseconds(51);
+        REQUIRE(reassembler.add(1, packets[2], now, complete) == SegmentResult::PENDING);
+        REQUIRE(reassembler.add(1, packets[3], now, complete) == SegmentResult::PENDING);
+
+        // Timed out on meeting it again, rather than by expire().
+        now += std::chrono::milliseconds(51);
+        REQUIRE(reassembler.add(1, packets[0], now, complete) == SegmentResult::PENDING);
+        REQUIRE(reassembler.stats().timedOut == 2);
+        REQUIRE(reassembler.stats().completed == 0);
+    }
+
+    SECTION("The oldest payload in progress makes way for a new one")
+    {
+        // A single bucket, so every payload competes for the same four slots.
+        PacketReassembler reassembler(1);
+        REQUIRE(reassembler.slotCount() == PacketReassembler::WAYS);
+
+        std::vector<std::vector<Packet>> payloads;
+        for (uint16_t sequenceNumber = 10; sequenceNumber < 15; ++sequenceNumber)
+        {
+            payloads.push_back(segment(payload, sequenceNumber));
+            REQUIRE(reassembler.add(1, payloads.back()[0], now, complete) == SegmentResult::PENDING);
+            now += std::chrono::milliseconds(1);
+        }
+        REQUIRE(reassembler.stats().evicted == 1);
+
+        // The first was evicted, so it starts again.
+        for (std::size_t i = 1; i < 4; ++i)
+        {
+            REQUIRE(reassembler.add(1, payloads[0][i], now, complete) == SegmentResult::PENDING);
+            REQUIRE(reassembler.add(1, payloads[4][i], now, complete) == (i == 3 ? SegmentResult::COMPLETE : SegmentResult::PENDING));
+        }
+        REQUIRE(complete.sequenceNumber == 14);
+    }
+}
+
+#ifdef __linux__
+namespace
+{
+    /**
+    * Sends datagrams to the OpenTrackIO multicast groups over loopback. */
+    class LoopbackSender
+    {
+    public:
+        explicit LoopbackSender(uint16_t port) : m_port{port}
+        {
+            const in_addr loopback{htonl(INADDR_LOOPBACK)};
+            setsockopt(m_socket, IPPROTO_IP, IP_MULTICAST_IF, &loopback, sizeof(loopback));
+        }
+
+        ~LoopbackSender() { close(m_socket); }
+
+        void send(uint8_t sourceNumber, std::span<const uint8_t> datagram) const
+        {
+            sockaddr_in group{};
+            group.sin_family = AF_INET;
+            group.sin_port = htons(m_port);
+            group.sin_addr.s_addr = htonl(opentrackio::multicastGroup(sourceNumber));
+            REQUIRE(sendto(m_socket, datagram.data(), datagram.size(), 0, reinterpret_cast<const sockaddr*>(&group),
+                           sizeof(group)) == static_cast<ssize_t>(datagram.size()));
+        }
+
+        /**
+        * Sends payload in segments of at most maxDatagramSize bytes. */
+        void send(uint8_t sourceNumber, opentrackio::PayloadEncoding encoding, uint16_t sequenceNumber,
+                  std::span<const uint8_t> payload, std::size_t maxDatagramSize = 1472) const
+        {
+            opentrackio::PacketSegmenter segmenter(encoding, sequenceNumber, payload, maxDatagramSize);
+            std::vector<uint8_t> datagram(maxDatagramSize);
+            while (!segmenter.done())
+            {
+                const std::optional<std::size_t> size = segmenter.next(datagram);
+                REQUIRE(size.has_value());
+                send(sourceNumber, std::span(datagram).first(*size));
+            }
+        }
+
+        /**
+        * The port the kernel bound the socket to on its first send. */
+        uint16_t localPort() const
+        {
+            sockaddr_in address{};
+            socklen_t size = sizeof(address);
+            REQUIRE(getsockname(m_socket, reinterpret_cast<sockaddr*>(&address), &size) == 0);
+            return ntohs(address.sin_port);
+        }
+
+    private:
+        int m_socket = socket(AF_INET, SOCK_DGRAM, 0);
+        uint16_t m_port;
+    };
+
+    std::string sourceSample(uint8_t sourceNumber)
+    {
+        return std::format(R"({{"sourceNumber": {}, "tracker": {{"notes": "{}"}}}})", sourceNumber,
+                           std::string(600, static_cast<char>('a' + sourceNumber)));
+    }
+} // namespace
+
+TEST_CASE("OpenTrackIOReceiver receives samples from the multicast groups it joins", "[receiver]")
+{
+    constexpr uint16_t port = 55600;
+
+    opentrackio::OpenTrackIOReceiver::Settings settings{};
+    settings.sourceNumbers = {1, 2};
+    settings.port = port;
+    settings.interfaceAddress = INADDR_LOOPBACK;
+    settings.workers = 4;
+
+    opentrackio::OpenTrackIOReceiver receiver{settings};
+    REQUIRE(receiver.open());
+    REQUIRE(receiver.workerCount() == 2);
+
+    const LoopbackSender sender{port};
+    const std::string first = sourceSample(1);
+    const std::string second = sourceSample(2);
+    const std::vector<uint8_t> secondCbor = json::to_cbor(json::parse(second));
+
+    // A whole JSON packet for source 1, a CBOR payload split over several for source 2, a corrupt datagram, and a
+    // packet for source 3 that nobody joined.
+    sender.send(1, opentrackio::PayloadEncoding::JSON, 1,
+                std::span(reinterpret_cast<const uint8_t*>(first.data()), first.size()));
+    sender.send(2, opentrackio::PayloadEncoding::CBOR, 1, secondCbor, 200);
+    sender.send(1, std::vector<uint8_t>(20, 0));
+    sender.send(3, opentrackio::PayloadEncoding::JSON, 1,
+                std::span(reinterpret_cast<const uint8_t*>(first.data()), first.size()));
+    const uint16_t senderPort = sender.localPort();
+
+    // Which worker received each source number.
+    std::map<uint32_t, std::size_t> received;
+    const auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (received.size() < 2 && std::chrono::steady_clock::now() < deadline)
+    {
+        for (std::size_t worker = 0; worker < receiver.workerCount(); ++worker)
+        {
+            receiver.receive(worker, [&received, worker, senderPort](const opentrackio::OpenTrackIOSample& sample,
+                                                                     uint64_t source)
+            {
+                // The sender's address in the high 32 bits and its port in the low 16.
+                REQUIRE(source >> 32 == INADDR_LOOPBACK);
+                REQUIRE((source & 0xFFFF) == senderPort);
+                REQUIRE(sample.sourceNumber.has_value());
+                received[sample.sourceNumber->value] = worker;
+            }, std::chrono::milliseconds(50));
+        }
+    }
+
+    // Anything for source 3 would have arrived alongside the rest.
+    for (std::size_t worker = 0; worker < receiver.workerCount(); ++worker)
+    {
+        receiver.receive(worker, [](const auto&, uint64_t) { FAIL("Received a sample from a group not joined"); },
+                         std::chrono::milliseconds(50));
+    }
+
+    REQUIRE(received == std::map<uint32_t, std::size_t>{{1, 0}, {2, 1}});
+
+    const opentrackio::OpenTrackIOReceiver::Stats stats = receiver.stats();
+    REQUIRE(stats.samples == 2);
+    REQUIRE(stats.badPackets == 1);
+    REQUIRE(stats.datagrams == 2 + (secondCbor.size() + 183) / 184);
+    REQUIRE(stats.parseFailures == 0);
+    REQUIRE(stats.receiveErrors == 0);
+    REQUIRE(!receiver.error(0));
+
+    SECTION("Started workers receive on their own threads until stopped")
+    {
+        std::mutex mutex;
+        std::vector<std::string> notes;
+        REQUIRE(receiver.start([&](const opentrackio::OpenTrackIOSample& sample, uint64_t)
+        {
+            std::scoped_lock lock{mutex};
+            notes.emplace_back(1, sample.tracker->notes->front());
+        }));
+
+        sender.send(2, opentrackio::PayloadEncoding::CBOR, 2, secondCbor, 200);
+        sender.send(1, opentrackio::PayloadEncoding::JSON, 2,
+                    std::span(reinterpret_cast<const uint8_t*>(first.data()), first.size()));
+
+        const auto started = std::chrono::steady_clock::now();
+        while (receiver.stats().samples < 4 && std::chrono::steady_clock::now() - started < std::chrono::seconds(5))
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        receiver.stop();
+
+        std::scoped_lock lock{mutex};
+        std::sort(notes.begin(), notes.end());
+        REQUIRE(notes == std::vector<std::string>{"b", "c"});
+    }
+}
+
+TEST_CASE("OpenTrackIOSender queues samples and sends them in batches", "[receiver]")
+{
+    constexpr uint16_t port = 55602;
+    using Clock = std::chrono::steady_clock;
+
+    opentrackio::OpenTrackIOReceiver::Settings receiverSettings{};
+    receiverSettings.sourceNumbers = {1, 2};
+    receiverSettings.port = port;
+    receiverSettings.interfaceAddress = INADDR_LOOPBACK;
+    opentrackio::OpenTrackIOReceiver receiver{receiverSettings};
+    REQUIRE(receiver.open());
+
+    opentrackio::OpenTrackIOSender::Settings settings{};
+    settings.port = port;
+    settings.interfaceAddress = INADDR_LOOPBACK;
+    settings.maxDatagramSize = 200;
+    settings.queueCapacity = 8;
+    settings.burstSize = 2;
+    opentrackio::OpenTrackIOSender sender{settings};
+    REQUIRE(sender.open());
+
+    std::array<opentrackio::OpenTrackIOSample, 2> samples{};
+    for (uint8_t i = 0; i < samples.size(); ++i)
+    {
+        REQUIRE(samples[i].initialise(std::string_view(sourceSample(i + 1))));
+    }
+    const std::size_t segments = (samples[0].serializedCborSize() + 183) / 184;
+    REQUIRE(segments == 4);
+
+    std::vector<std::string> notes;
+    const auto receiveSamples = [&](std::size_t count)
+    {
+        notes.clear();
+        const auto deadline = Clock::now() + std::chrono::seconds(5);
+        while (notes.size() < count && Clock::now() < deadline)
+        {
+            receiver.receive(0, [&notes](const opentrackio::OpenTrackIOSample& sample, uint64_t)
+            {
+                notes.emplace_back(1, sample.tracker->notes->front());
+            }, std::chrono::milliseconds(50));
+        }
+        std::sort(notes.begin(), notes.end());
+    };
+
+    REQUIRE(sender.queue(samples[0], 1));
+    REQUIRE(sender.queue(samples[1], 2));
+    REQUIRE(sender.queued() == 2 * segments);
+
+    SECTION("flush() sends the queue in one system call")
+    {
+        REQUIRE(sender.flush() == 2 * segments);
+        REQUIRE(sender.queued() == 0);
+        REQUIRE(sender.stats().sendCalls == 1);
+        REQUIRE(sender.stats().datagrams == 2 * segments);
+        REQUIRE(sender.stats().samples == 2);
+
+        receiveSamples(2);
+        REQUIRE(notes == std::vector<std::string>{"b", "c"});
+        REQUIRE(receiver.stats().droppedSegments == 0);
+
+        // Both sources were sent from the same socket, so they must not have shared a sequence number, and the
+        // next sample of source 1 mustn't be mistaken for a duplicate of the first.
+        REQUIRE(sender.queue(samples[0], 1));
+        REQUIRE(sender.flush() == segments);
+        receiveSamples(1);
+        REQUIRE(notes == std::vector<std::string>{"b"});
+    }
+
+    SECTION("flushPaced() spreads the queue over the interval in bursts")
+    {
+        const auto started = Clock::now();
+        REQUIRE(sender.flushPaced(std::chrono::milliseconds(40)) == 2 * segments);
+        REQUIRE(Clock::now() - started >= std::chrono::milliseconds(30));
+        REQUIRE(sender.stats().sendCalls == 2 * segments / settings.burstSize);
+
+        receiveSamples(2);
+        REQUIRE(notes == std::vector<std::string>{"b", "c"});
+    }
+
+    SECTION("A full queue is flushed to make room, a sample larger than it is refused")
+    {
+        REQUIRE(sender.queue(samples[0], 1));
+        REQUIRE(sender.stats().overflowFlushes == 1);
+        REQUIRE(sender.stats().datagrams == 2 * segments);
+        REQUIRE(sender.queued() == segments);
+
+        const std::vector<uint8_t> large(settings.queueCapacity * 184 + 1);
+        REQUIRE_FALSE(sender.queue(opentrackio::PayloadEncoding::CBOR, large, 1));
+        REQUIRE(sender.queued() == segments);
+        REQUIRE(sender.stats().samples == 3);
+    }
+
+    SECTION("The frame interval comes from the sample rate")
+    {
+        REQUIRE_FALSE(opentrackio::OpenTrackIOSender::frameInterval(samples[0]).has_value());
+
+        opentrackio::OpenTrackIOSample timed{};
+        REQUIRE(timed.initialise(std::string_view(R"({"timing": {"sampleRate": {"num": 24000, "denom": 1001}}})")));
+        REQUIRE(opentrackio::OpenTrackIOSender::frameInterval(timed) == std::chrono::nanoseconds(41708333));
+    }
+}
+
+TEST_CASE("The io_uring backend sends and receives like the socket one", "[receiver]")
+{
+    constexpr uint16_t port = 55604;
+    using Clock = std::chrono::steady_clock;
+
+    opentrackio::OpenTrackIOReceiver::Settings receiverSettings{};
+    receiverSettings.sourceNumbers = {1, 2};
+    receiverSettings.port = port;
+    receiverSettings.interfaceAddress = INADDR_LOOPBACK;
+    receiverSettings.batchSize = 8;
+    receiverSettings.backend = opentrackio::TransportBackend::IO_URING;
+    opentrackio::OpenTrackIOReceiver receiver{receiverSettings};
+    REQUIRE(receiver.open());
+
+    opentrackio::OpenTrackIOSender::Settings settings{};
+    settings.port = port;
+    settings.interfaceAddress = INADDR_LOOPBACK;
+    settings.maxDatagramSize = 200;
+    settings.backend = opentrackio::TransportBackend::IO_URING;
+    opentrackio::OpenTrackIOSender sender{settings};
+    REQUIRE(sender.open());
+
+    // Kernels without io_uring fall back to sockets, which must behave the same.
+    const bool ring = receiver.backend() == opentrackio::TransportBackend::IO_URING;
+    REQUIRE(sender.backend() == receiver.backend());
+
+    std::array<opentrackio::OpenTrackIOSample, 2> samples{};
+    for (uint8_t i = 0; i < samples.size(); ++i)
+    {
+        REQUIRE(samples[i].initialise(std::string_view(sourceSample(i + 1))));
+    }
+
+    std::vector<std::string> notes;
+    const auto handler = [&notes](const opentrackio::OpenTrackIOSample& sample, uint64_t source)
+    {
+        REQUIRE(source >> 32 == INADDR_LOOPBACK);
+        notes.emplace_back(1, sample.tracker->notes->front());
+    };
+    const auto receiveSamples = [&](std::size_t count)
+    {
+        notes.clear();
+        const auto deadline = Clock::now() + std::chrono::seconds(5);
+        while (notes.size() < count && Clock::now() < deadline)
+        {
+            receiver.receive(0, handler, std::chrono::milliseconds(50));
+        }
+        std::sort(notes.begin(), notes.end());
+    };
+
+    // The first receive() arms the ring's receive on this thread.
+    REQUIRE(receiver.receive(0, handler, std::chrono::milliseconds(1)) == 0);
+    const uint64_t systemCalls = receiver.stats().systemCalls;
+
+    REQUIRE(sender.queue(samples[0], 1));
+    REQUIRE(sender.queue(samples[1], 2));
+    REQUIRE(sender.flush() == 8);
+    REQUIRE(sender.stats().sendCalls == 1);
+    REQUIRE(sender.stats().failed == 0);
+
+    SECTION("Received completions are handled without entering the kernel")
+    {
+        // Give the datagrams time to complete into the ring.
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        REQUIRE(receiver.receive(0, handler, std::chrono::milliseconds(50)) == 8);
+        REQUIRE(notes.size() == 2);
+        if (ring)
+        {
+            REQUIRE(receiver.stats().systemCalls == systemCalls);
+        }
+    }
+
+    SECTION("A receive that ran out of buffers is armed again")
+    {
+        // 48 datagrams for the 16 buffers of a batch size of 8, all sent before any are handled.
+        for (std::size_t i = 0; i < 10; ++i)
+        {
+            REQUIRE(sender.queue(samples[i % 2], static_cast<uint8_t>(i % 2 + 1)));
+        }
+        REQUIRE(sender.flush() == 40);
+
+        receiveSamples(12);
+        REQUIRE(notes.size() == 12);
+        REQUIRE(std::count(notes.begin(), notes.end(), "b") == 6);
+
+        const opentrackio::OpenTrackIOReceiver::Stats stats = receiver.stats();
+        REQUIRE(stats.datagrams == 48);
+        REQUIRE(stats.droppedSegments == 0);
+        REQUIRE(stats.parseFailures == 0);
+    }
+
+    SECTION("A zero timeout polls an idle socket rather than waiting")
+    {
+        receiveSamples(2);
+        REQUIRE(notes.size() == 2);
+
+        const auto start = Clock::now();
+        REQUIRE(receiver.receive(0, handler, std::chrono::milliseconds(0)) == 0);
+        REQUIRE(receiver.receive(0, handler, std::chrono::milliseconds(0)) == 0);
+        REQUIRE(Clock::now() - start < std::chrono::milliseconds(500));
+    }
+
+    SECTION("Started workers take the receive over from the thread that armed it")
+    {
+        receiveSamples(2);
+        REQUIRE(notes.size() == 2);
+
+        std::atomic<uint64_t> started = 0;
+        REQUIRE(receiver.start([&started](const opentrackio::OpenTrackIOSample&, uint64_t) { ++started; }));
+        for (std::size_t i = 0; i < 4; ++i)
+        {
+            REQUIRE(sender.queue(samples[i % 2], static_cast<uint8_t>(i % 2 + 1)));
+        }
+        REQUIRE(sender.flush() == 16);
+
+        const auto deadline = Clock::now() + std::chrono::seconds(5);
+        while (started < 4 && Clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        receiver.stop();
+        REQUIRE(started == 4);
+    }
+}
+#endif
+
 //Convert curl out to string
 size_t curlToString(const char* ptr, size_t size, size_t nmemb, void* data)
 {
@@ -106,7 +2153,7 @@ bool getStringExample(const std::string& name, std::string& response)
     return getString(url, response);
 }
 
-void testVersion(const std::vector<uint16_t>& version)
+void testVersion(const opentrackio::opentrackiotypes::Vector<uint16_t>& version)
 {
     REQUIRE(version.size() == 3);
     REQUIRE(version[0] == OPEN_TRACK_IO_PROTOCOL_MAJOR_VERSION);
@@ -150,8 +2197,8 @@ void testRecommendedDynamic(const std::string& response)
     REQUIRE_FALSE(sample.timing->timecode->dropFrame.has_value());
 
     REQUIRE(sample.lens->distortion->size() == 1);
-    REQUIRE(sample.lens->distortion->at(0).radial == std::vector<double>{1.0, 2.0, 3.0});
-    REQUIRE(sample.lens->distortion->at(0).tangential == std::vector<double>{1.0, 2.0});
+    REQUIRE(sample.lens->distortion->at(0).radial == opentrackio::opentrackioproperties::Lens::Coefficients{1.0, 2.0, 3.0});
+    REQUIRE(sample.lens->distortion->at(0).tangential == opentrackio::opentrackioproperties::Lens::Coefficients{1.0, 2.0});
     REQUIRE(sample.lens->distortion->at(0).overscan == 3.1);
     REQUIRE(sample.lens->encoders->focus == 0.1);
     REQUIRE(sample.lens->encoders->iris == 0.2);
@@ -166,8 +2213,8 @@ void testRecommendedDynamic(const std::string& response)
     REQUIRE(sample.protocol->name == OPEN_TRACK_IO_PROTOCOL_NAME);
     testVersion(sample.protocol->version);
 
-    REQUIRE(sample.sampleId->id.substr(0, 9) == "urn:uuid:");
-    REQUIRE(sample.sourceId->id.substr(0, 9) == "urn:uuid:");
+    REQUIRE(sample.sampleId->urn().substr(0, 9) == "urn:uuid:");
+    REQUIRE(sample.sourceId->urn().substr(0, 9) == "urn:uuid:");
     REQUIRE(sample.sourceNumber->value == 1);
 
     REQUIRE(sample.transforms->transforms.size() == 1);
@@ -234,14 +2281,14 @@ void testCompleteDynamic(const std::string& response)
     REQUIRE(sample.timing->timecode->dropFrame == true);
 
     REQUIRE(sample.lens->custom->size() == 2);
-    REQUIRE(sample.lens->custom == std::vector<double>{1.0, 2.0});
+    REQUIRE(sample.lens->custom == opentrackio::opentrackioproperties::Lens::Coefficients{1.0, 2.0});
     REQUIRE(sample.lens->distortion->size() == 2);
     REQUIRE(sample.lens->distortion->at(0).model == "Brown-Conrady U-D");
-    REQUIRE(sample.lens->distortion->at(0).radial == std::vector<double>{1.0, 2.0, 3.0, 4.0, 5.0, 6.0});
-    REQUIRE(sample.lens->distortion->at(0).tangential == std::vector<double>{1.0, 2.0});
+    REQUIRE(sample.lens->distortion->at(0).radial == opentrackio::opentrackioproperties::Lens::Coefficients{1.0, 2.0, 3.0, 4.0, 5.0, 6.0});
+    REQUIRE(sample.lens->distortion->at(0).tangential == opentrackio::opentrackioproperties::Lens::Coefficients{1.0, 2.0});
     REQUIRE(sample.lens->distortion->at(0).overscan == 3.0);
-    REQUIRE(sample.lens->distortion->at(1).radial == std::vector<double>{1.0, 2.0, 3.0, 4.0, 5.0, 6.0});
-    REQUIRE(sample.lens->distortion->at(1).tangential == std::vector<double>{1.0, 2.0});
+    REQUIRE(sample.lens->distortion->at(1).radial == opentrackio::opentrackioproperties::Lens::Coefficients{1.0, 2.0, 3.0, 4.0, 5.0, 6.0});
+    REQUIRE(sample.lens->distortion->at(1).tangential == opentrackio::opentrackioproperties::Lens::Coefficients{1.0, 2.0});
     REQUIRE(sample.lens->distortion->at(1).overscan == 2.0);
     REQUIRE(sample.lens->distortionOffset->x == 1.0);
     REQUIRE(sample.lens->distortionOffset->y == 2.0);
@@ -265,12 +2312,12 @@ void testCompleteDynamic(const std::string& response)
     REQUIRE(sample.protocol->name == OPEN_TRACK_IO_PROTOCOL_NAME);
     testVersion(sample.protocol->version);
 
-    REQUIRE(sample.sourceId->id.substr(0, 9) == "urn:uuid:");
-    REQUIRE(sample.sampleId->id.substr(0, 9) == "urn:uuid:");
+    REQUIRE(sample.sourceId->urn().substr(0, 9) == "urn:uuid:");
+    REQUIRE(sample.sampleId->urn().substr(0, 9) == "urn:uuid:");
     REQUIRE(sample.sourceNumber->value == 1);
     REQUIRE(sample.relatedSampleIds->samples.size() == 2);
-    REQUIRE(sample.relatedSampleIds->samples[0].substr(0, 9) == "urn:uuid:");
-    REQUIRE(sample.relatedSampleIds->samples[1].substr(0, 9) == "urn:uuid:");
+    REQUIRE(sample.relatedSampleIds->samples[0].toUrn().substr(0, 9) == "urn:uuid:");
+    REQUIRE(sample.relatedSampleIds->samples[1].toUrn().substr(0, 9) == "urn:uuid:");
 
     REQUIRE(sample.globalStage->e == 100.0);
     REQUIRE(sample.globalStage->n == 200.0);